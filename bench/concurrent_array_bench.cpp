@@ -0,0 +1,137 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares appending events from several producer threads to a
+ * SeeConcurrentArray with appending them to a SeeDynamicArray that is
+ * guarded by a mutex.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../src/see_init.h"
+#include "../src/ConcurrentArray.h"
+
+#define NEVENTS     (4 * 1000 * 1000)
+#define REPEAT      5
+
+struct event {
+    uint64_t time;
+    uint32_t producer;
+    uint32_t value;
+};
+
+template<class Producer>
+static double
+time_producers(unsigned nthreads, const Producer& produce)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < nthreads; t++)
+        threads.emplace_back(produce, t, NEVENTS / nthreads);
+    for (auto& thread : threads)
+        thread.join();
+
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+    return dur.count();
+}
+
+static double
+bench_mutex(unsigned nthreads)
+{
+    double total = 0;
+
+    for (int r = 0; r < REPEAT; r++) {
+        SeeError* error = nullptr;
+        SeeDynamicArray* array = nullptr;
+        std::mutex mutex;
+
+        see_dynamic_array_new(
+            &array, sizeof(event), nullptr, nullptr, nullptr, &error
+            );
+
+        total += time_producers(nthreads, [&](unsigned t, unsigned n) {
+            SeeError* err = nullptr;
+            for (unsigned i = 0; i < n; i++) {
+                event ev = {i, t, i * 3};
+                std::lock_guard<std::mutex> lock(mutex);
+                see_dynamic_array_add(array, &ev, &err);
+            }
+        });
+
+        see_object_decref(SEE_OBJECT(array));
+    }
+    return total / REPEAT;
+}
+
+static double
+bench_concurrent(unsigned nthreads)
+{
+    double total = 0;
+
+    for (int r = 0; r < REPEAT; r++) {
+        SeeError* error = nullptr;
+        SeeConcurrentArray* array = nullptr;
+
+        see_concurrent_array_new(&array, sizeof(event), &error);
+
+        total += time_producers(nthreads, [&](unsigned t, unsigned n) {
+            SeeError* err = nullptr;
+            for (unsigned i = 0; i < n; i++) {
+                event ev = {i, t, i * 3};
+                see_concurrent_array_push_back(array, &ev, nullptr, &err);
+            }
+        });
+
+        see_object_decref(SEE_OBJECT(array));
+    }
+    return total / REPEAT;
+}
+
+int main()
+{
+    if (see_init()) {
+        fprintf(stderr, "Unable to initialize see-object\n");
+        return 1;
+    }
+
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0)
+        max_threads = 4;
+
+    printf("%d events, average of %d runs\n", NEVENTS, REPEAT);
+    for (unsigned n = 1; n <= max_threads; n *= 2) {
+        double t_mutex = bench_mutex(n);
+        double t_concurrent = bench_concurrent(n);
+        printf("%2u producers  mutex %8.1f Mevents/s  "
+               "concurrent %8.1f Mevents/s  speedup %5.1fx\n",
+               n,
+               NEVENTS / t_mutex / 1e6,
+               NEVENTS / t_concurrent / 1e6,
+               t_mutex / t_concurrent
+               );
+    }
+
+    see_deinit();
+    return 0;
+}
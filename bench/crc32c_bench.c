@@ -0,0 +1,184 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the throughput of see_crc32c and what the CRC32C trailer costs
+ * when messages are serialized and parsed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../src/see_init.h"
+#include "../src/Clock.h"
+#include "../src/Crc32c.h"
+#include "../src/MsgBuffer.h"
+
+#define NBYTES      (64 * 1024 * 1024)
+#define FRAME_BYTES (64 * 1024)
+#define NFRAMES     1000
+#define REPEAT      10
+
+static SeeClock* g_clock = NULL;
+
+static int
+start_timer(SeeError** error)
+{
+    return see_clock_set_base_time(g_clock, NULL, error);
+}
+
+static double
+stop_timer(SeeError** error)
+{
+    SeeDuration* dur = NULL;
+    double seconds = -1;
+
+    if (see_clock_duration(g_clock, &dur, error) == SEE_SUCCESS)
+        seconds = see_duration_seconds_f(dur);
+
+    see_object_decref(SEE_OBJECT(dur));
+    return seconds / REPEAT;
+}
+
+static void
+report(const char* what, double seconds, double nbytes)
+{
+    printf("%-24s %10.3f ms  %10.1f MB/s\n",
+           what,
+           seconds * 1000,
+           nbytes / seconds / (1024 * 1024)
+           );
+}
+
+static int
+bench_crc32c(SeeError** error)
+{
+    unsigned char* bytes = malloc(NBYTES);
+    uint32_t crc = 0;
+    double t;
+
+    if (!bytes) {
+        fprintf(stderr, "Unable to allocate %d bytes\n", NBYTES);
+        return SEE_ERROR_RUNTIME;
+    }
+    for (size_t i = 0; i < NBYTES; i++)
+        bytes[i] = (unsigned char) (i * 131);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++)
+        crc = see_crc32c(crc, bytes, NBYTES);
+    t = stop_timer(error);
+    report("see_crc32c", t, NBYTES);
+    printf("crc = %08x\n", (unsigned) crc);
+
+    free(bytes);
+    return SEE_SUCCESS;
+}
+
+/*
+ * Serializes and parses a message with a 64 KB image frame NFRAMES times.
+ */
+static int
+bench_msg(int with_crc, SeeError** error)
+{
+    SeeMsgBuffer* msg = NULL, *parsed = NULL;
+    unsigned char* image = malloc(FRAME_BYTES);
+    char* bytes = malloc(FRAME_BYTES + 1024);
+    size_t written = 0;
+    double t;
+    int ret = SEE_ERROR_RUNTIME;
+
+    if (!image || !bytes)
+        goto done;
+    for (size_t i = 0; i < FRAME_BYTES; i++)
+        image[i] = (unsigned char) (i * 7);
+
+    ret = see_msg_buffer_new(&msg, 1, error);
+    if (!ret)
+        ret = see_msg_buffer_add_int32(msg, 640, error);
+    if (!ret)
+        ret = see_msg_buffer_add_int32(msg, 100, error);
+    if (!ret)
+        ret = see_msg_buffer_add_bytes_ref(
+            msg, image, FRAME_BYTES, NULL, NULL, error
+            );
+    if (!ret)
+        ret = see_msg_buffer_set_crc(msg, with_crc, error);
+    if (ret)
+        goto done;
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT && !ret; r++)
+        for (int i = 0; i < NFRAMES && !ret; i++)
+            ret = see_msg_buffer_write_into(
+                msg, bytes, FRAME_BYTES + 1024, &written, error
+                );
+    t = stop_timer(error);
+    if (ret)
+        goto done;
+    report(with_crc ? "write_into crc" : "write_into", t, (double) written * NFRAMES);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT && !ret; r++) {
+        for (int i = 0; i < NFRAMES && !ret; i++) {
+            see_object_decref(SEE_OBJECT(parsed));
+            parsed = NULL;
+            ret = see_msg_buffer_from_buffer(&parsed, bytes, written, error);
+        }
+    }
+    t = stop_timer(error);
+    if (!ret)
+        report(with_crc ? "from_buffer crc" : "from_buffer", t, (double) written * NFRAMES);
+
+done:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(parsed));
+    free(image);
+    free(bytes);
+    return ret;
+}
+
+int main()
+{
+    SeeError* error = NULL;
+    int ret = see_init();
+    if (ret) {
+        fprintf(stderr, "Unable to initialize see-object\n");
+        return 1;
+    }
+
+    ret = see_clock_new(&g_clock, &error);
+    if (ret)
+        goto done;
+
+    printf("crc32c uses %s, average of %d runs\n", see_crc32c_isa(), REPEAT);
+
+    ret = bench_crc32c(&error);
+    if (!ret)
+        ret = bench_msg(0, &error);
+    if (!ret)
+        ret = bench_msg(1, &error);
+
+done:
+    if (error)
+        fprintf(stderr, "%s\n", see_error_msg(error));
+
+    see_object_decref(SEE_OBJECT(error));
+    see_object_decref(SEE_OBJECT(g_clock));
+    see_deinit();
+    return ret ? 1 : 0;
+}
@@ -0,0 +1,233 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the kernels of DynamicArrayKernels.h with computing the same
+ * result by retrieving the elements one by one with see_dynamic_array_get.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../src/see_init.h"
+#include "../src/Clock.h"
+#include "../src/DynamicArrayKernels.h"
+
+#define NELEM   (10 * 1000 * 1000)
+#define REPEAT  10
+
+static SeeClock* g_clock = NULL;
+
+static int
+start_timer(SeeError** error)
+{
+    return see_clock_set_base_time(g_clock, NULL, error);
+}
+
+static double
+stop_timer(SeeError** error)
+{
+    SeeDuration* dur = NULL;
+    double seconds = -1;
+
+    if (see_clock_duration(g_clock, &dur, error) == SEE_SUCCESS)
+        seconds = see_duration_seconds_f(dur);
+
+    see_object_decref(SEE_OBJECT(dur));
+    return seconds / REPEAT;
+}
+
+static void
+report(const char* what, double get_loop, double kernel)
+{
+    printf("%-16s get loop %10.3f ms  kernel %10.3f ms  speedup %6.1fx\n",
+           what,
+           get_loop * 1000,
+           kernel * 1000,
+           get_loop / kernel
+           );
+}
+
+static int
+bench_int32(SeeError** error)
+{
+    SeeDynamicArray* array = NULL;
+    int64_t sum = 0, ksum = 0;
+    int32_t lo = 0, hi = 0;
+    size_t index = 0;
+    double t_get, t_kernel;
+
+    int ret = see_dynamic_array_new_capacity(
+        &array, sizeof(int32_t), NULL, NULL, NULL, NELEM, error
+        );
+    for (int64_t i = 0; i < NELEM && !ret; i++) {
+        int32_t v = (int32_t) ((i * 7919) % 100003);
+        ret = see_dynamic_array_add(array, &v, error);
+    }
+    if (ret)
+        goto done;
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++) {
+        sum = 0;
+        for (size_t i = 0; i < NELEM; i++) {
+            int32_t v;
+            see_dynamic_array_get(array, i, &v, error);
+            sum += v;
+        }
+    }
+    t_get = stop_timer(error);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++)
+        see_dynamic_array_sum_int32(array, &ksum, error);
+    t_kernel = stop_timer(error);
+    report("sum int32", t_get, t_kernel);
+    if (sum != ksum)
+        fprintf(stderr, "sum int32 differs: %lld != %lld\n",
+                (long long) sum, (long long) ksum);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++) {
+        see_dynamic_array_get(array, 0, &lo, error);
+        hi = lo;
+        for (size_t i = 1; i < NELEM; i++) {
+            int32_t v;
+            see_dynamic_array_get(array, i, &v, error);
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+        }
+    }
+    t_get = stop_timer(error);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++)
+        see_dynamic_array_minmax_int32(array, &lo, &hi, error);
+    t_kernel = stop_timer(error);
+    report("minmax int32", t_get, t_kernel);
+
+    // Search a value that isn't present, so the whole array is visited.
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++) {
+        for (index = 0; index < NELEM; index++) {
+            int32_t v;
+            see_dynamic_array_get(array, index, &v, error);
+            if (v == -1)
+                break;
+        }
+    }
+    t_get = stop_timer(error);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++)
+        see_dynamic_array_find_int32(array, -1, &index, error);
+    t_kernel = stop_timer(error);
+    report("find int32", t_get, t_kernel);
+
+done:
+    see_object_decref(SEE_OBJECT(array));
+    return ret;
+}
+
+static int
+bench_double(SeeError** error)
+{
+    SeeDynamicArray* array = NULL;
+    double sum = 0, ksum = 0;
+    size_t count = 0, kcount = 0;
+    double t_get, t_kernel;
+
+    int ret = see_dynamic_array_new_capacity(
+        &array, sizeof(double), NULL, NULL, NULL, NELEM, error
+        );
+    for (size_t i = 0; i < NELEM && !ret; i++) {
+        double v = (i % 1000) * 0.5;
+        ret = see_dynamic_array_add(array, &v, error);
+    }
+    if (ret)
+        goto done;
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++) {
+        sum = 0;
+        for (size_t i = 0; i < NELEM; i++) {
+            double v;
+            see_dynamic_array_get(array, i, &v, error);
+            sum += v;
+        }
+    }
+    t_get = stop_timer(error);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++)
+        see_dynamic_array_sum_double(array, &ksum, error);
+    t_kernel = stop_timer(error);
+    report("sum double", t_get, t_kernel);
+    (void) sum;
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++) {
+        count = 0;
+        for (size_t i = 0; i < NELEM; i++) {
+            double v;
+            see_dynamic_array_get(array, i, &v, error);
+            count += v == 100.0;
+        }
+    }
+    t_get = stop_timer(error);
+
+    start_timer(error);
+    for (int r = 0; r < REPEAT; r++)
+        see_dynamic_array_count_double(array, 100.0, &kcount, error);
+    t_kernel = stop_timer(error);
+    report("count double", t_get, t_kernel);
+    if (count != kcount)
+        fprintf(stderr, "count double differs: %zu != %zu\n", count, kcount);
+
+done:
+    see_object_decref(SEE_OBJECT(array));
+    return ret;
+}
+
+int main()
+{
+    SeeError* error = NULL;
+    int ret = see_init();
+    if (ret) {
+        fprintf(stderr, "Unable to initialize see-object\n");
+        return 1;
+    }
+
+    ret = see_clock_new(&g_clock, &error);
+    if (ret)
+        goto done;
+
+    printf("kernels use %s, %d elements, average of %d runs\n",
+           see_dynamic_array_kernels_isa(), NELEM, REPEAT);
+
+    ret = bench_int32(&error);
+    if (!ret)
+        ret = bench_double(&error);
+
+done:
+    if (error)
+        fprintf(stderr, "%s\n", see_error_msg(error));
+
+    see_object_decref(SEE_OBJECT(error));
+    see_object_decref(SEE_OBJECT(g_clock));
+    see_deinit();
+    return ret ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the round trip of an object that is bounced between two
+ * threads via two SeeObjectQueues, half of it is the hand-off latency.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "../src/see_init.h"
+#include "../src/ObjectQueue.h"
+
+#define NROUNDS     200000
+
+static double
+bench_ping_pong(see_object_queue_kind kind)
+{
+    SeeError* error = nullptr;
+    SeeObjectQueue* ping = nullptr;
+    SeeObjectQueue* pong = nullptr;
+    SeeObject* ball = nullptr;
+
+    see_object_queue_new(&ping, kind, 16, &error);
+    see_object_queue_new(&pong, kind, 16, &error);
+    see_object_new(&ball);
+
+    std::thread echo([&]() {
+        SeeError* err = nullptr;
+        for (int i = 0; i < NROUNDS; i++) {
+            SeeObject* obj = nullptr;
+            see_object_queue_pop(ping, &obj, nullptr, &err);
+            see_object_queue_push(pong, &obj, nullptr, &err);
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NROUNDS; i++) {
+        see_object_queue_push(ping, &ball, nullptr, &error);
+        see_object_queue_pop(pong, &ball, nullptr, &error);
+    }
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    echo.join();
+    see_object_decref(ball);
+    see_object_decref(SEE_OBJECT(ping));
+    see_object_decref(SEE_OBJECT(pong));
+
+    return dur.count() / NROUNDS;
+}
+
+int main()
+{
+    if (see_init()) {
+        fprintf(stderr, "Unable to initialize see-object\n");
+        return 1;
+    }
+
+    printf("%d round trips\n", NROUNDS);
+    printf("spsc  %8.1f ns per hand-off\n",
+           bench_ping_pong(SEE_OBJECT_QUEUE_SPSC) / 2 * 1e9
+           );
+    printf("mpmc  %8.1f ns per hand-off\n",
+           bench_ping_pong(SEE_OBJECT_QUEUE_MPMC) / 2 * 1e9
+           );
+
+    see_deinit();
+    return 0;
+}
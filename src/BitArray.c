@@ -0,0 +1,819 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file BitArray.c
+ * \brief implements SeeBitArray.
+ *
+ * The bits past the size of the array are always 0, also in the words
+ * that are allocated but not in use. Hence, whole words can be counted and
+ * combined without masking the last one.
+ *
+ * \private
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MetaClass.h"
+#include "BitArray.h"
+#include "IndexError.h"
+#include "RuntimeError.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define SEE_BITS_X86 1
+#   include <immintrin.h>
+#endif
+
+#define WORD_BITS 64
+#define NUM_WORDS(nbits) ((nbits) / WORD_BITS + ((nbits) % WORD_BITS != 0))
+
+/* **** bit helpers **** */
+
+/*
+ * The bits [lo, hi) of a word, lo < hi <= 64.
+ */
+static uint64_t
+word_mask(unsigned lo, unsigned hi)
+{
+    uint64_t high = hi == WORD_BITS ? ~(uint64_t) 0 : ((uint64_t) 1 << hi) - 1;
+    return high & ~(((uint64_t) 1 << lo) - 1);
+}
+
+static unsigned
+word_count(uint64_t word)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (unsigned) ((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static unsigned
+first_bit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_ctzll(word);
+#else
+    unsigned n = 0;
+    while (!(word & 1u)) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* **** the kernels that count and combine words **** */
+
+typedef struct bit_kernels {
+    const char* isa;
+    size_t (*count)(const uint64_t* words, size_t n);
+    void (*combine)(uint64_t* a, const uint64_t* b, size_t n, see_bit_op op);
+} bit_kernels;
+
+static size_t
+scalar_count(const uint64_t* words, size_t n)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++)
+        count += word_count(words[i]);
+    return count;
+}
+
+static void
+scalar_combine(uint64_t* a, const uint64_t* b, size_t n, see_bit_op op)
+{
+    size_t i;
+    switch (op) {
+        case SEE_BIT_AND:
+            for (i = 0; i < n; i++)
+                a[i] &= b[i];
+            break;
+        case SEE_BIT_OR:
+            for (i = 0; i < n; i++)
+                a[i] |= b[i];
+            break;
+        case SEE_BIT_XOR:
+            for (i = 0; i < n; i++)
+                a[i] ^= b[i];
+            break;
+    }
+}
+
+static const bit_kernels g_scalar_kernels = {
+    .isa        = "scalar",
+    .count      = scalar_count,
+    .combine    = scalar_combine
+};
+
+#if defined(SEE_BITS_X86)
+
+__attribute__((target("popcnt")))
+static size_t
+popcnt_count(const uint64_t* words, size_t n)
+{
+    // Four sums hide the latency of popcnt.
+    size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0, i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        c0 += (size_t) __builtin_popcountll(words[i]);
+        c1 += (size_t) __builtin_popcountll(words[i + 1]);
+        c2 += (size_t) __builtin_popcountll(words[i + 2]);
+        c3 += (size_t) __builtin_popcountll(words[i + 3]);
+    }
+    for (; i < n; i++)
+        c0 += (size_t) __builtin_popcountll(words[i]);
+
+    return c0 + c1 + c2 + c3;
+}
+
+__attribute__((target("avx2")))
+static void
+avx2_combine(uint64_t* a, const uint64_t* b, size_t n, see_bit_op op)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256((const __m256i*) (a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*) (b + i));
+        switch (op) {
+            case SEE_BIT_AND: va = _mm256_and_si256(va, vb); break;
+            case SEE_BIT_OR:  va = _mm256_or_si256(va, vb);  break;
+            case SEE_BIT_XOR: va = _mm256_xor_si256(va, vb); break;
+        }
+        _mm256_storeu_si256((__m256i*) (a + i), va);
+    }
+    scalar_combine(a + i, b + i, n - i, op);
+}
+
+static const bit_kernels g_popcnt_kernels = {
+    .isa        = "popcnt",
+    .count      = popcnt_count,
+    .combine    = scalar_combine
+};
+
+static const bit_kernels g_avx2_kernels = {
+    .isa        = "avx2",
+    .count      = popcnt_count,
+    .combine    = avx2_combine
+};
+
+#endif // defined(SEE_BITS_X86)
+
+static const bit_kernels* g_kernels = &g_scalar_kernels;
+
+static void
+select_kernels(void)
+{
+#if defined(SEE_BITS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        g_kernels = &g_avx2_kernels;
+    else if (__builtin_cpu_supports("popcnt"))
+        g_kernels = &g_popcnt_kernels;
+    else
+        g_kernels = &g_scalar_kernels;
+#else
+    g_kernels = &g_scalar_kernels;
+#endif
+}
+
+/* **** private helpers **** */
+
+/*
+ * Make sure nwords words are allocated, the new words are cleared.
+ */
+static int
+bit_array_reserve(SeeBitArray* array, size_t nwords, SeeError** error_out)
+{
+    if (nwords <= array->capacity)
+        return SEE_SUCCESS;
+
+    if (nwords > SIZE_MAX / sizeof(uint64_t)) {
+        see_runtime_error_new(error_out, EOVERFLOW);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    uint64_t* words = realloc(array->words, nwords * sizeof(uint64_t));
+    if (!words) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    memset(
+        words + array->capacity,
+        0,
+        (nwords - array->capacity) * sizeof(uint64_t)
+        );
+    array->words    = words;
+    array->capacity = nwords;
+
+    return SEE_SUCCESS;
+}
+
+static int
+check_range(
+    const SeeBitArray*  array,
+    size_t              begin,
+    size_t              end,
+    SeeError**          error_out
+    )
+{
+    if (end > array->size) {
+        see_index_error_new(error_out, end);
+        return SEE_ERROR_INDEX;
+    }
+    if (begin > end) {
+        see_index_error_new(error_out, begin);
+        return SEE_ERROR_INDEX;
+    }
+    return SEE_SUCCESS;
+}
+
+/* **** functions that implement SeeBitArray or override SeeObject **** */
+
+static int
+bit_array_init(
+    SeeBitArray*                array,
+    const SeeBitArrayClass*     array_cls,
+    size_t                      size,
+    SeeError**                  error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(array);
+
+    parent_cls->object_init(
+            SEE_OBJECT(array),
+            SEE_OBJECT_CLASS(array_cls)
+            );
+
+    int ret = bit_array_reserve(array, NUM_WORDS(size), error_out);
+    if (ret)
+        return ret;
+
+    array->size = size;
+    return SEE_SUCCESS;
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeBitArrayClass* array_cls = SEE_BIT_ARRAY_CLASS(cls);
+    SeeBitArray* array = SEE_BIT_ARRAY(obj);
+
+    size_t size             = va_arg(args, size_t);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return array_cls->bit_array_init(array, array_cls, size, error_out);
+}
+
+static void
+bit_array_destroy(SeeObject* obj)
+{
+    SeeBitArray* array = SEE_BIT_ARRAY(obj);
+    free(array->words);
+
+    see_object_class()->destroy(obj);
+}
+
+static int
+bit_array_copy(const SeeObject* self, SeeObject** out, SeeError** error_out)
+{
+    const SeeBitArray* array = SEE_BIT_ARRAY(self);
+    SeeBitArray* copy = NULL;
+
+    int ret = see_bit_array_new(&copy, array->size, error_out);
+    if (ret)
+        return ret;
+
+    memcpy(
+        copy->words,
+        array->words,
+        NUM_WORDS(array->size) * sizeof(uint64_t)
+        );
+
+    *out = SEE_OBJECT(copy);
+    return SEE_SUCCESS;
+}
+
+static int
+bit_array_resize(SeeBitArray* array, size_t size, SeeError** error_out)
+{
+    size_t nwords = NUM_WORDS(size);
+
+    if (size > array->size) {
+        // The words that are reserved already have their bits cleared.
+        int ret = bit_array_reserve(array, nwords, error_out);
+        if (ret)
+            return ret;
+        array->size = size;
+        return SEE_SUCCESS;
+    }
+
+    // Clear the bits that are dropped, the invariant of this file.
+    size_t old_nwords = NUM_WORDS(array->size);
+    if (size % WORD_BITS)
+        array->words[nwords - 1] &= word_mask(0, size % WORD_BITS);
+    memset(
+        array->words + nwords,
+        0,
+        (old_nwords - nwords) * sizeof(uint64_t)
+        );
+    array->size = size;
+
+    return SEE_SUCCESS;
+}
+
+static int
+bit_array_set_range(
+    SeeBitArray*    array,
+    size_t          begin,
+    size_t          end,
+    int             value,
+    SeeError**      error_out
+    )
+{
+    int ret = check_range(array, begin, end, error_out);
+    if (ret || begin == end)
+        return ret;
+
+    size_t first = begin / WORD_BITS, last = (end - 1) / WORD_BITS;
+    unsigned lo = begin % WORD_BITS, hi = (unsigned) ((end - 1) % WORD_BITS + 1);
+    uint64_t* words = array->words;
+
+    if (first == last) {
+        uint64_t mask = word_mask(lo, hi);
+        words[first] = value ? words[first] | mask : words[first] & ~mask;
+        return SEE_SUCCESS;
+    }
+
+    uint64_t head = word_mask(lo, WORD_BITS), tail = word_mask(0, hi);
+    if (value) {
+        words[first] |= head;
+        memset(words + first + 1, 0xff, (last - first - 1) * sizeof(uint64_t));
+        words[last] |= tail;
+    }
+    else {
+        words[first] &= ~head;
+        memset(words + first + 1, 0, (last - first - 1) * sizeof(uint64_t));
+        words[last] &= ~tail;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+bit_array_count_range(
+    const SeeBitArray*  array,
+    size_t              begin,
+    size_t              end,
+    size_t*             count_out,
+    SeeError**          error_out
+    )
+{
+    int ret = check_range(array, begin, end, error_out);
+    if (ret)
+        return ret;
+
+    if (begin == end) {
+        *count_out = 0;
+        return SEE_SUCCESS;
+    }
+
+    size_t first = begin / WORD_BITS, last = (end - 1) / WORD_BITS;
+    unsigned lo = begin % WORD_BITS, hi = (unsigned) ((end - 1) % WORD_BITS + 1);
+    const uint64_t* words = array->words;
+
+    if (first == last) {
+        *count_out = word_count(words[first] & word_mask(lo, hi));
+        return SEE_SUCCESS;
+    }
+
+    *count_out =
+        word_count(words[first] & word_mask(lo, WORD_BITS)) +
+        g_kernels->count(words + first + 1, last - first - 1) +
+        word_count(words[last] & word_mask(0, hi));
+
+    return SEE_SUCCESS;
+}
+
+static int
+bit_array_find_first_set(
+    const SeeBitArray*  array,
+    size_t              start,
+    size_t*             index_out,
+    SeeError**          error_out
+    )
+{
+    if (start > array->size) {
+        see_index_error_new(error_out, start);
+        return SEE_ERROR_INDEX;
+    }
+
+    size_t nwords = NUM_WORDS(array->size);
+    size_t w = start / WORD_BITS;
+
+    *index_out = array->size;
+    if (w == nwords)
+        return SEE_SUCCESS;
+
+    uint64_t word = array->words[w] & word_mask(start % WORD_BITS, WORD_BITS);
+    while (!word) {
+        if (++w == nwords)
+            return SEE_SUCCESS;
+        word = array->words[w];
+    }
+
+    // The bits past the size are 0, so this is a valid index.
+    *index_out = w * WORD_BITS + first_bit(word);
+    return SEE_SUCCESS;
+}
+
+static int
+bit_array_combine(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    see_bit_op          op,
+    SeeError**          error_out
+    )
+{
+    (void) error_out;
+
+    if (array->size != other->size)
+        return SEE_INVALID_ARGUMENT;
+
+    g_kernels->combine(array->words, other->words, NUM_WORDS(array->size), op);
+    return SEE_SUCCESS;
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_bit_array_new(SeeBitArray** out, size_t size, SeeError** error_out)
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(see_bit_array_class());
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(cls, 0, SEE_OBJECT_REF(out), size, error_out);
+}
+
+int
+see_bit_array_from_bytes(
+    SeeBitArray**           out,
+    const SeeDynamicArray*  bytes,
+    SeeError**              error_out
+    )
+{
+    if (!bytes || bytes->element_size != 1)
+        return SEE_INVALID_ARGUMENT;
+
+    size_t size = see_dynamic_array_size(bytes);
+    int ret = see_bit_array_new(out, size, error_out);
+    if (ret)
+        return ret;
+
+    const unsigned char* src = (const unsigned char*) bytes->elements;
+    uint64_t* words = (*out)->words;
+
+    for (size_t w = 0; w < NUM_WORDS(size); w++) {
+        size_t n = size - w * WORD_BITS;
+        if (n > WORD_BITS)
+            n = WORD_BITS;
+
+        uint64_t word = 0;
+        for (size_t j = 0; j < n; j++)
+            word |= (uint64_t) (src[j] != 0) << j;
+        words[w] = word;
+        src += n;
+    }
+
+    return SEE_SUCCESS;
+}
+
+int
+see_bit_array_to_bytes(
+    const SeeBitArray*  array,
+    SeeDynamicArray**   out,
+    SeeError**          error_out
+    )
+{
+    if (!array || !out || *out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    SeeDynamicArray* result = NULL;
+    int ret = see_dynamic_array_new_capacity(
+        &result, 1, NULL, NULL, NULL, array->size, error_out
+        );
+    if (ret)
+        return ret;
+
+    ret = see_dynamic_array_resize(result, array->size, NULL, error_out);
+    if (ret) {
+        see_object_decref(SEE_OBJECT(result));
+        return ret;
+    }
+
+    unsigned char* dest = see_dynamic_array_data(result);
+    for (size_t i = 0; i < array->size; i++)
+        dest[i] = (unsigned char) ((array->words[i / WORD_BITS] >> (i % WORD_BITS)) & 1u);
+
+    *out = result;
+    return SEE_SUCCESS;
+}
+
+int
+see_bit_array_resize(SeeBitArray* array, size_t size, SeeError** error_out)
+{
+    if (!array || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeBitArrayClass* cls = SEE_BIT_ARRAY_GET_CLASS(array);
+    return cls->resize(array, size, error_out);
+}
+
+int
+see_bit_array_push_back(SeeBitArray* array, int value, SeeError** error_out)
+{
+    if (!array || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    size_t size = array->size;
+    if (size == array->capacity * WORD_BITS) {
+        size_t nwords = array->capacity ? array->capacity * 2 : 1;
+        int ret = bit_array_reserve(array, nwords, error_out);
+        if (ret)
+            return ret;
+    }
+
+    if (value)
+        array->words[size / WORD_BITS] |= (uint64_t) 1 << (size % WORD_BITS);
+    array->size = size + 1;
+
+    return SEE_SUCCESS;
+}
+
+int
+see_bit_array_set(SeeBitArray* array, size_t i, SeeError** error_out)
+{
+    if (!array || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (i >= array->size) {
+        see_index_error_new(error_out, i);
+        return SEE_ERROR_INDEX;
+    }
+
+    array->words[i / WORD_BITS] |= (uint64_t) 1 << (i % WORD_BITS);
+    return SEE_SUCCESS;
+}
+
+int
+see_bit_array_clear(SeeBitArray* array, size_t i, SeeError** error_out)
+{
+    if (!array || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (i >= array->size) {
+        see_index_error_new(error_out, i);
+        return SEE_ERROR_INDEX;
+    }
+
+    array->words[i / WORD_BITS] &= ~((uint64_t) 1 << (i % WORD_BITS));
+    return SEE_SUCCESS;
+}
+
+int
+see_bit_array_test(
+    const SeeBitArray*  array,
+    size_t              i,
+    int*                value_out,
+    SeeError**          error_out
+    )
+{
+    if (!array || !value_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (i >= array->size) {
+        see_index_error_new(error_out, i);
+        return SEE_ERROR_INDEX;
+    }
+
+    *value_out = (int) ((array->words[i / WORD_BITS] >> (i % WORD_BITS)) & 1u);
+    return SEE_SUCCESS;
+}
+
+int
+see_bit_array_set_range(
+    SeeBitArray*    array,
+    size_t          begin,
+    size_t          end,
+    int             value,
+    SeeError**      error_out
+    )
+{
+    if (!array || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeBitArrayClass* cls = SEE_BIT_ARRAY_GET_CLASS(array);
+    return cls->set_range(array, begin, end, value, error_out);
+}
+
+int
+see_bit_array_count_range(
+    const SeeBitArray*  array,
+    size_t              begin,
+    size_t              end,
+    size_t*             count_out,
+    SeeError**          error_out
+    )
+{
+    if (!array || !count_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeBitArrayClass* cls = SEE_BIT_ARRAY_GET_CLASS(array);
+    return cls->count_range(array, begin, end, count_out, error_out);
+}
+
+size_t
+see_bit_array_count(const SeeBitArray* array)
+{
+    if (!array)
+        return 0;
+
+    return g_kernels->count(array->words, NUM_WORDS(array->size));
+}
+
+int
+see_bit_array_find_first_set(
+    const SeeBitArray*  array,
+    size_t              start,
+    size_t*             index_out,
+    SeeError**          error_out
+    )
+{
+    if (!array || !index_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeBitArrayClass* cls = SEE_BIT_ARRAY_GET_CLASS(array);
+    return cls->find_first_set(array, start, index_out, error_out);
+}
+
+static int
+combine(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    see_bit_op          op,
+    SeeError**          error_out
+    )
+{
+    if (!array || !other || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeBitArrayClass* cls = SEE_BIT_ARRAY_GET_CLASS(array);
+    return cls->combine(array, other, op, error_out);
+}
+
+int
+see_bit_array_and(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    SeeError**          error_out
+    )
+{
+    return combine(array, other, SEE_BIT_AND, error_out);
+}
+
+int
+see_bit_array_or(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    SeeError**          error_out
+    )
+{
+    return combine(array, other, SEE_BIT_OR, error_out);
+}
+
+int
+see_bit_array_xor(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    SeeError**          error_out
+    )
+{
+    return combine(array, other, SEE_BIT_XOR, error_out);
+}
+
+size_t
+see_bit_array_size(const SeeBitArray* array)
+{
+    return array ? array->size : 0;
+}
+
+const uint64_t*
+see_bit_array_words(const SeeBitArray* array)
+{
+    return array ? array->words : NULL;
+}
+
+const char*
+see_bit_array_isa()
+{
+    return g_kernels->isa;
+}
+
+/* **** initialization of the class **** */
+
+SeeBitArrayClass* g_SeeBitArrayClass = NULL;
+
+static int
+bit_array_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init       = init;
+    new_cls->destroy    = bit_array_destroy;
+    new_cls->copy       = bit_array_copy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeBitArray";
+
+    /* Set the function pointers of the own class here */
+    SeeBitArrayClass* cls = (SeeBitArrayClass*) new_cls;
+
+    cls->bit_array_init = bit_array_init;
+    cls->resize         = bit_array_resize;
+    cls->set_range      = bit_array_set_range;
+    cls->count_range    = bit_array_count_range;
+    cls->find_first_set = bit_array_find_first_set;
+    cls->combine        = bit_array_combine;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeBitArray(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_bit_array_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    select_kernels();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeBitArrayClass,
+        sizeof(SeeBitArrayClass),
+        sizeof(SeeBitArray),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        bit_array_class_init
+        );
+
+    return ret;
+}
+
+void
+see_bit_array_deinit()
+{
+    if(!g_SeeBitArrayClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeBitArrayClass));
+    g_SeeBitArrayClass = NULL;
+}
+
+const SeeBitArrayClass*
+see_bit_array_class()
+{
+    return g_SeeBitArrayClass;
+}
@@ -0,0 +1,409 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file BitArray.h
+ * \brief An array of bits that are stored in 64 bit words.
+ *
+ * A SeeBitArray stores flags eight times more compactly than a
+ * SeeDynamicArray of char. Single bits are set, cleared and tested, and
+ * ranges of bits are set, counted and searched a word at a time. Two
+ * arrays of the same size can be combined with and, or and xor.
+ *
+ * When the library is initialized, the implementation that counts bits and
+ * combines arrays is selected for the cpu: the popcnt instruction and AVX2
+ * are used on x86 cpus that have them.
+ *
+ * @code
+ * SeeBitArray* valid = NULL;
+ * ret = see_bit_array_new(&valid, nsamples, &error);
+ * ...
+ * ret = see_bit_array_set(valid, i, &error);
+ * ...
+ * size_t nvalid = see_bit_array_count(valid);
+ * @endcode
+ */
+
+#ifndef SEE_BIT_ARRAY_H
+#define SEE_BIT_ARRAY_H
+
+#include <stdint.h>
+#include "SeeObject.h"
+#include "Error.h"
+#include "DynamicArray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SeeBitArray SeeBitArray;
+typedef struct SeeBitArrayClass SeeBitArrayClass;
+
+/**
+ * \brief The operations that combine two SeeBitArrays.
+ */
+typedef enum see_bit_op {
+    SEE_BIT_AND,    /**< Keep the bits that are set in both arrays. */
+    SEE_BIT_OR,     /**< Keep the bits that are set in either array. */
+    SEE_BIT_XOR     /**< Keep the bits that are set in one of the arrays. */
+} see_bit_op;
+
+struct SeeBitArray {
+    SeeObject parent_obj;
+
+    /** \brief The bits, bit i is bit i % 64 of word i / 64. \private */
+    uint64_t*   words;
+    /** \brief The number of bits. \private */
+    size_t      size;
+    /** \brief The number of allocated words. \private */
+    size_t      capacity;
+};
+
+struct SeeBitArrayClass {
+    SeeObjectClass parent_cls;
+
+    int (*bit_array_init)(
+        SeeBitArray*                array,
+        const SeeBitArrayClass*     array_cls,
+        size_t                      size,
+        SeeError**                  error_out
+        );
+
+    int (*resize)(SeeBitArray* array, size_t size, SeeError** error_out);
+
+    int (*set_range)(
+        SeeBitArray*    array,
+        size_t          begin,
+        size_t          end,
+        int             value,
+        SeeError**      error_out
+        );
+
+    int (*count_range)(
+        const SeeBitArray*  array,
+        size_t              begin,
+        size_t              end,
+        size_t*             count_out,
+        SeeError**          error_out
+        );
+
+    int (*find_first_set)(
+        const SeeBitArray*  array,
+        size_t              start,
+        size_t*             index_out,
+        SeeError**          error_out
+        );
+
+    int (*combine)(
+        SeeBitArray*        array,
+        const SeeBitArray*  other,
+        see_bit_op          op,
+        SeeError**          error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeBitArray derived instance back to a
+ *        pointer to SeeBitArray.
+ */
+#define SEE_BIT_ARRAY(obj)                      \
+    ((SeeBitArray*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeBitArray derived instance back
+ *        to a reference to SeeBitArray*.
+ */
+#define SEE_BIT_ARRAY_REF(ref)                      \
+    ((SeeBitArray**) ref)
+
+/**
+ * \brief cast a pointer to SeeBitArrayClass derived class back to a
+ *        pointer to SeeBitArrayClass.
+ */
+#define SEE_BIT_ARRAY_CLASS(cls)                      \
+    ((const SeeBitArrayClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeBitArrayClass from a instance of
+ *        derived from SeeBitArray. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_BIT_ARRAY_GET_CLASS(obj)                \
+    (SEE_BIT_ARRAY_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new bit array whose bits are all cleared.
+ *
+ * @param [out] out         A pointer to a SeeBitArray* that is NULL.
+ * @param [in]  size        The number of bits.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_bit_array_new(SeeBitArray** out, size_t size, SeeError** error_out);
+
+/**
+ * \brief Create a bit array from a SeeDynamicArray of bytes.
+ *
+ * Bit i is set when byte i is not 0.
+ *
+ * @param [out] out         A pointer to a SeeBitArray* that is NULL.
+ * @param [in]  bytes       An array whose element size is 1.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_bit_array_from_bytes(
+    SeeBitArray**           out,
+    const SeeDynamicArray*  bytes,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Convert the bits to a new SeeDynamicArray with a byte per bit.
+ *
+ * @param [in]  array       The bit array.
+ * @param [out] out         A pointer to a SeeDynamicArray* that is NULL, it
+ *                          receives an array with a 1 for every bit that
+ *                          is set and a 0 for every other bit.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_bit_array_to_bytes(
+    const SeeBitArray*  array,
+    SeeDynamicArray**   out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Change the number of bits, the new bits are cleared.
+ *
+ * @param [in]  array       The bit array.
+ * @param [in]  size        The new number of bits.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_bit_array_resize(SeeBitArray* array, size_t size, SeeError** error_out);
+
+/**
+ * \brief Append a bit, the storage grows by doubling.
+ *
+ * @param [in]  array       The bit array.
+ * @param [in]  value       The bit is set when value is not 0.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_bit_array_push_back(SeeBitArray* array, int value, SeeError** error_out);
+
+/**
+ * \brief Set bit i.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_bit_array_set(SeeBitArray* array, size_t i, SeeError** error_out);
+
+/**
+ * \brief Clear bit i.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_bit_array_clear(SeeBitArray* array, size_t i, SeeError** error_out);
+
+/**
+ * \brief Test bit i.
+ *
+ * @param [in]  array       The bit array.
+ * @param [in]  i           The index of the bit.
+ * @param [out] value_out   1 when the bit is set, 0 otherwise.
+ * @param [out] error_out   An index error when i is out of range.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_bit_array_test(
+    const SeeBitArray*  array,
+    size_t              i,
+    int*                value_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Set or clear the bits in [begin, end).
+ *
+ * @param [in]  array       The bit array.
+ * @param [in]  begin       The first bit.
+ * @param [in]  end         One past the last bit.
+ * @param [in]  value       The bits are set when value is not 0, otherwise
+ *                          they are cleared.
+ * @param [out] error_out   An index error when the range isn't valid.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_bit_array_set_range(
+    SeeBitArray*    array,
+    size_t          begin,
+    size_t          end,
+    int             value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Count the bits that are set in [begin, end).
+ *
+ * @param [in]  array       The bit array.
+ * @param [in]  begin       The first bit.
+ * @param [in]  end         One past the last bit.
+ * @param [out] count_out   The number of bits that are set.
+ * @param [out] error_out   An index error when the range isn't valid.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_bit_array_count_range(
+    const SeeBitArray*  array,
+    size_t              begin,
+    size_t              end,
+    size_t*             count_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Count all bits that are set.
+ */
+SEE_EXPORT size_t
+see_bit_array_count(const SeeBitArray* array);
+
+/**
+ * \brief Find the first bit that is set at or after start.
+ *
+ * @param [in]  array       The bit array.
+ * @param [in]  start       The first bit to examine.
+ * @param [out] index_out   The index of the bit, or the size of the array
+ *                          when no bit is set.
+ * @param [out] error_out   An index error when start is past the end.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_bit_array_find_first_set(
+    const SeeBitArray*  array,
+    size_t              start,
+    size_t*             index_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief array = array & other, both arrays must have the same size.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_bit_array_and(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief array = array | other, both arrays must have the same size.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_bit_array_or(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief array = array ^ other, both arrays must have the same size.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_bit_array_xor(
+    SeeBitArray*        array,
+    const SeeBitArray*  other,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the number of bits.
+ */
+SEE_EXPORT size_t
+see_bit_array_size(const SeeBitArray* array);
+
+/**
+ * \brief Obtain the words that store the bits.
+ *
+ * Bit i is bit i % 64 of word i / 64. The bits past the size in the last
+ * word are 0.
+ */
+SEE_EXPORT const uint64_t*
+see_bit_array_words(const SeeBitArray* array);
+
+/**
+ * \brief The name of the implementation that counts and combines the bits,
+ *        e.g. "avx2", "popcnt" or "scalar".
+ */
+SEE_EXPORT const char*
+see_bit_array_isa();
+
+/**
+ * Gets the pointer to the SeeBitArrayClass table.
+ */
+SEE_EXPORT const SeeBitArrayClass*
+see_bit_array_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeBitArray; make it ready for use.
+ */
+SEE_EXPORT
+int see_bit_array_init();
+
+/**
+ * Deinitialize SeeBitArray, after SeeBitArray has been deinitialized,
+ * all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_bit_array_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_BIT_ARRAY_H
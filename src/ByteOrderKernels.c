@@ -0,0 +1,342 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ByteOrderKernels.c
+ * \brief implements the conversion of arrays to and from network byte order.
+ *
+ * Like DynamicArrayKernels.c, every instruction set provides a table with
+ * kernels that is selected once by see_byte_order_kernels_init(). The
+ * vector kernels only process whole vectors and leave the remainder to
+ * the scalar kernels.
+ *
+ * \private
+ */
+
+#include "see_object_config.h"
+#include <stdint.h>
+#include <string.h>
+#include "ByteOrderKernels.h"
+#include "utilities.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   if defined(__GNUC__) || defined(_MSC_VER)
+#       define SEE_KERNELS_SSSE3 1
+#       define SEE_KERNELS_AVX2 1
+#   endif
+#   include <immintrin.h>
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define SEE_KERNELS_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__)
+#   define SEE_TARGET_SSSE3 __attribute__((target("ssse3")))
+#   define SEE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define SEE_TARGET_SSSE3
+#   define SEE_TARGET_AVX2
+#endif
+
+/* **** the table with kernels for one instruction set **** */
+
+typedef struct see_byte_order_kernels {
+    const char* isa;
+
+    // Reverse the bytes of n 32 or 64 bit values, dst may be equal to src.
+    void (*swap32)(unsigned char* dst, const unsigned char* src, size_t n);
+    void (*swap64)(unsigned char* dst, const unsigned char* src, size_t n);
+} see_byte_order_kernels;
+
+/* **** scalar kernels **** */
+
+static void
+scalar_swap32(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    uint32_t v;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(&v, src + i * sizeof(v), sizeof(v));
+        v = see_swap_endianess32(v);
+        memcpy(dst + i * sizeof(v), &v, sizeof(v));
+    }
+}
+
+static void
+scalar_swap64(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    uint64_t v;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(&v, src + i * sizeof(v), sizeof(v));
+        v = see_swap_endianess64(v);
+        memcpy(dst + i * sizeof(v), &v, sizeof(v));
+    }
+}
+
+static const see_byte_order_kernels g_scalar_kernels = {
+    .isa    = "scalar",
+    .swap32 = scalar_swap32,
+    .swap64 = scalar_swap64
+};
+
+/* **** SSSE3 kernels **** */
+
+#if defined(SEE_KERNELS_SSSE3)
+
+SEE_TARGET_SSSE3 static void
+ssse3_swap32(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    const __m128i shuffle = _mm_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+        );
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i * 4));
+        _mm_storeu_si128((__m128i*) (dst + i * 4), _mm_shuffle_epi8(v, shuffle));
+    }
+    scalar_swap32(dst + i * 4, src + i * 4, n - i);
+}
+
+SEE_TARGET_SSSE3 static void
+ssse3_swap64(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    const __m128i shuffle = _mm_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+        );
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i * 8));
+        _mm_storeu_si128((__m128i*) (dst + i * 8), _mm_shuffle_epi8(v, shuffle));
+    }
+    scalar_swap64(dst + i * 8, src + i * 8, n - i);
+}
+
+static const see_byte_order_kernels g_ssse3_kernels = {
+    .isa    = "ssse3",
+    .swap32 = ssse3_swap32,
+    .swap64 = ssse3_swap64
+};
+
+static int
+cpu_has_ssse3(void)
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return 0;
+#endif
+}
+
+#endif // defined(SEE_KERNELS_SSSE3)
+
+/* **** AVX2 kernels **** */
+
+#if defined(SEE_KERNELS_AVX2)
+
+// vpshufb shuffles within each 128 bit lane, so the pattern is repeated.
+
+SEE_TARGET_AVX2 static void
+avx2_swap32(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    const __m256i shuffle = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+        );
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + i * 4));
+        _mm256_storeu_si256(
+            (__m256i*) (dst + i * 4), _mm256_shuffle_epi8(v, shuffle)
+            );
+    }
+    scalar_swap32(dst + i * 4, src + i * 4, n - i);
+}
+
+SEE_TARGET_AVX2 static void
+avx2_swap64(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    const __m256i shuffle = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+        );
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + i * 8));
+        _mm256_storeu_si256(
+            (__m256i*) (dst + i * 8), _mm256_shuffle_epi8(v, shuffle)
+            );
+    }
+    scalar_swap64(dst + i * 8, src + i * 8, n - i);
+}
+
+static const see_byte_order_kernels g_avx2_kernels = {
+    .isa    = "avx2",
+    .swap32 = avx2_swap32,
+    .swap64 = avx2_swap64
+};
+
+static int
+cpu_has_avx2(void)
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+
+    // The OS must save the ymm registers.
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))
+        return 0;
+    if ((_xgetbv(0) & 6) != 6)
+        return 0;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return 0;
+#endif
+}
+
+#endif // defined(SEE_KERNELS_AVX2)
+
+/* **** NEON kernels **** */
+
+#if defined(SEE_KERNELS_NEON)
+
+static void
+neon_swap32(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_u8(dst + i * 4, vrev32q_u8(vld1q_u8(src + i * 4)));
+    scalar_swap32(dst + i * 4, src + i * 4, n - i);
+}
+
+static void
+neon_swap64(unsigned char* dst, const unsigned char* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        vst1q_u8(dst + i * 8, vrev64q_u8(vld1q_u8(src + i * 8)));
+    scalar_swap64(dst + i * 8, src + i * 8, n - i);
+}
+
+static const see_byte_order_kernels g_neon_kernels = {
+    .isa    = "neon",
+    .swap32 = neon_swap32,
+    .swap64 = neon_swap64
+};
+
+#endif // defined(SEE_KERNELS_NEON)
+
+/* **** selection of the kernels **** */
+
+static const see_byte_order_kernels* g_kernels = &g_scalar_kernels;
+
+int
+see_byte_order_kernels_init()
+{
+    const see_byte_order_kernels* selected = &g_scalar_kernels;
+
+#if defined(SEE_KERNELS_SSSE3)
+    if (cpu_has_ssse3())
+        selected = &g_ssse3_kernels;
+#endif
+#if defined(SEE_KERNELS_AVX2)
+    if (cpu_has_avx2())
+        selected = &g_avx2_kernels;
+#endif
+#if defined(SEE_KERNELS_NEON)
+    selected = &g_neon_kernels;
+#endif
+
+    g_kernels = selected;
+    return SEE_SUCCESS;
+}
+
+const char*
+see_byte_order_kernels_isa()
+{
+    return g_kernels->isa;
+}
+
+/* **** implementation of the public API **** */
+
+/*
+ * Network order is big endian, so on big endian hosts there is nothing
+ * to swap.
+ */
+static void
+convert32(void* dst, const void* src, size_t n)
+{
+#if SEE_LITTLE_ENDIAN
+    g_kernels->swap32(dst, src, n);
+#else
+    if (n && dst != src)
+        memcpy(dst, src, n * sizeof(uint32_t));
+#endif
+}
+
+static void
+convert64(void* dst, const void* src, size_t n)
+{
+#if SEE_LITTLE_ENDIAN
+    g_kernels->swap64(dst, src, n);
+#else
+    if (n && dst != src)
+        memcpy(dst, src, n * sizeof(uint64_t));
+#endif
+}
+
+void
+see_host_to_network32_array(void* dst, const void* src, size_t n)
+{
+    convert32(dst, src, n);
+}
+
+void
+see_network_to_host32_array(void* dst, const void* src, size_t n)
+{
+    convert32(dst, src, n);
+}
+
+void
+see_host_to_network64_array(void* dst, const void* src, size_t n)
+{
+    convert64(dst, src, n);
+}
+
+void
+see_network_to_host64_array(void* dst, const void* src, size_t n)
+{
+    convert64(dst, src, n);
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ByteOrderKernels.h
+ * \brief Convert arrays of 32 or 64 bit values between host and network
+ *        byte order.
+ *
+ * These are the bulk versions of see_host_to_network32() and friends from
+ * utilities.h. When the library is initialized, the best implementation
+ * for the cpu is selected: AVX2 or SSSE3 on x86, NEON on 64 bit ARM,
+ * otherwise a plain C implementation is used. On big endian hosts the
+ * values are only copied.
+ *
+ * The source and destination don't need to be aligned. They may be the
+ * same buffer in order to convert in place, but they must not overlap
+ * otherwise.
+ */
+
+#ifndef SEE_BYTE_ORDER_KERNELS_H
+#define SEE_BYTE_ORDER_KERNELS_H
+
+#include <stddef.h>
+#include "SeeObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Convert n 32 bit values from host to network byte order.
+ *
+ * @param [out] dst The converted values are written here.
+ * @param [in]  src The values in host byte order.
+ * @param [in]  n   The number of values, not bytes.
+ */
+SEE_EXPORT void
+see_host_to_network32_array(void* dst, const void* src, size_t n);
+
+/**
+ * \brief Convert n 32 bit values from network to host byte order.
+ * \copydetails see_host_to_network32_array
+ */
+SEE_EXPORT void
+see_network_to_host32_array(void* dst, const void* src, size_t n);
+
+/**
+ * \brief Convert n 64 bit values from host to network byte order.
+ * \copydetails see_host_to_network32_array
+ */
+SEE_EXPORT void
+see_host_to_network64_array(void* dst, const void* src, size_t n);
+
+/**
+ * \brief Convert n 64 bit values from network to host byte order.
+ * \copydetails see_host_to_network32_array
+ */
+SEE_EXPORT void
+see_network_to_host64_array(void* dst, const void* src, size_t n);
+
+/**
+ * \brief Obtain the name of the instruction set that is used to swap
+ *        the bytes, e.g. "avx2", "ssse3", "neon" or "scalar".
+ */
+SEE_EXPORT const char*
+see_byte_order_kernels_isa();
+
+/* **** initialization **** */
+
+/**
+ * \private
+ * \brief Select the kernels for the cpu, this is called from the library
+ * initialization. Until then the scalar kernels are used.
+ */
+SEE_EXPORT int
+see_byte_order_kernels_init();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_BYTE_ORDER_KERNELS_H
@@ -0,0 +1,406 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MetaClass.h"
+#include "ColumnTable.h"
+#include "IndexError.h"
+
+/* **** private helpers **** */
+
+static SeeDynamicArray*
+table_column(const SeeColumnTable* table, size_t column)
+{
+    SeeDynamicArray** columns = see_dynamic_array_data(table->columns);
+    return columns[column];
+}
+
+static size_t
+table_num_columns(const SeeColumnTable* table)
+{
+    return see_dynamic_array_size(table->columns);
+}
+
+/* **** functions that implement SeeColumnTable or override SeeObject **** */
+
+static int
+column_table_init(
+    SeeColumnTable*             table,
+    const SeeColumnTableClass*  table_cls,
+    size_t                      num_columns,
+    const size_t*               element_sizes,
+    SeeError**                  error_out
+    )
+{
+    int ret = SEE_SUCCESS;
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(
+        table
+        );
+
+    parent_cls->object_init(
+            SEE_OBJECT(table),
+            SEE_OBJECT_CLASS(table_cls)
+            );
+
+    table->num_rows = 0;
+
+    ret = see_dynamic_array_new_capacity(
+        &table->columns,
+        sizeof(SeeDynamicArray*),
+        see_copy_by_ref,
+        NULL,
+        see_free_see_object,
+        num_columns,
+        error_out
+        );
+    if (ret)
+        return ret;
+
+    for (size_t i = 0; i < num_columns; i++) {
+        SeeDynamicArray* column = NULL;
+        ret = see_dynamic_array_new_aligned(
+            &column,
+            element_sizes[i],
+            NULL,
+            NULL,
+            NULL,
+            SEE_COLUMN_TABLE_ALIGNMENT,
+            error_out
+            );
+        if (ret)
+            return ret;
+
+        // The array of columns takes its own reference.
+        ret = see_dynamic_array_add(table->columns, &column, error_out);
+        see_object_decref(SEE_OBJECT(column));
+        if (ret)
+            return ret;
+    }
+
+    return ret;
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeColumnTableClass* table_cls = SEE_COLUMN_TABLE_CLASS(cls);
+    SeeColumnTable* table = SEE_COLUMN_TABLE(obj);
+
+    /*Extract parameters here from va_list args here.*/
+    size_t          num_columns     = va_arg(args, size_t);
+    const size_t*   element_sizes   = va_arg(args, const size_t*);
+    SeeError**      error_out       = va_arg(args, SeeError**);
+
+    return table_cls->column_table_init(
+        table,
+        table_cls,
+        num_columns,
+        element_sizes,
+        error_out
+        );
+}
+
+static void
+column_table_destroy(SeeObject* obj)
+{
+    SeeColumnTable* table = SEE_COLUMN_TABLE(obj);
+
+    see_object_decref(SEE_OBJECT(table->columns));
+    see_object_class()->destroy(obj);
+}
+
+static int
+column_table_add_row(
+    SeeColumnTable*     table,
+    const void* const*  values,
+    SeeError**          error_out
+    )
+{
+    int ret = SEE_SUCCESS;
+    size_t ncols = table_num_columns(table);
+    size_t i;
+
+    for (i = 0; i < ncols; i++) {
+        ret = see_dynamic_array_add(table_column(table, i), values[i], error_out);
+        if (ret)
+            break;
+    }
+
+    if (ret) {
+        // Undo the columns to which the value has been appended. Shrinking
+        // doesn't fail, but a resize refuses to run with an error set, so
+        // any error is released right away.
+        for (size_t j = 0; j < i; j++) {
+            SeeError* dummy = NULL;
+            see_dynamic_array_resize(
+                table_column(table, j), table->num_rows, NULL, &dummy
+                );
+            see_object_decref(SEE_OBJECT(dummy));
+        }
+        return ret;
+    }
+
+    table->num_rows++;
+    return ret;
+}
+
+static int
+column_table_reserve(
+    SeeColumnTable*     table,
+    size_t              num_rows,
+    SeeError**          error_out
+    )
+{
+    int ret = SEE_SUCCESS;
+    size_t ncols = table_num_columns(table);
+
+    for (size_t i = 0; i < ncols; i++) {
+        ret = see_dynamic_array_reserve(table_column(table, i), num_rows, error_out);
+        if (ret)
+            return ret;
+    }
+    return ret;
+}
+
+static int
+column_table_get_column(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    SeeDynamicArray**       column_out,
+    SeeError**              error_out
+    )
+{
+    if (column >= table_num_columns(table)) {
+        see_index_error_new(error_out, column);
+        return SEE_ERROR_INDEX;
+    }
+
+    *column_out = table_column(table, column);
+    return SEE_SUCCESS;
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_column_table_new(
+    SeeColumnTable**    out,
+    size_t              num_columns,
+    const size_t*       element_sizes,
+    SeeError**          error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_column_table_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (num_columns == 0 || !element_sizes)
+        return SEE_INVALID_ARGUMENT;
+
+    for (size_t i = 0; i < num_columns; i++)
+        if (element_sizes[i] == 0)
+            return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(out),
+            num_columns,
+            element_sizes,
+            error_out
+            );
+}
+
+size_t
+see_column_table_num_columns(const SeeColumnTable* table)
+{
+    return table_num_columns(table);
+}
+
+size_t
+see_column_table_num_rows(const SeeColumnTable* table)
+{
+    return table->num_rows;
+}
+
+int
+see_column_table_add_row(
+    SeeColumnTable*     table,
+    const void* const*  values,
+    SeeError**          error_out
+    )
+{
+    if (!table || !values || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeColumnTableClass* cls = SEE_COLUMN_TABLE_GET_CLASS(table);
+    return cls->add_row(table, values, error_out);
+}
+
+int
+see_column_table_reserve(
+    SeeColumnTable*     table,
+    size_t              num_rows,
+    SeeError**          error_out
+    )
+{
+    if (!table || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeColumnTableClass* cls = SEE_COLUMN_TABLE_GET_CLASS(table);
+    return cls->reserve(table, num_rows, error_out);
+}
+
+int
+see_column_table_column(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    SeeDynamicArray**       column_out,
+    SeeError**              error_out
+    )
+{
+    if (!table || !column_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeColumnTableClass* cls = SEE_COLUMN_TABLE_GET_CLASS(table);
+    return cls->get_column(table, column, column_out, error_out);
+}
+
+int
+see_column_table_column_view(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    SeeColumnView*          view,
+    SeeError**              error_out
+    )
+{
+    SeeDynamicArray* array = NULL;
+
+    if (!view)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = see_column_table_column(table, column, &array, error_out);
+    if (ret)
+        return ret;
+
+    view->data          = see_dynamic_array_data(array);
+    view->size          = see_dynamic_array_size(array);
+    view->element_size  = array->element_size;
+
+    return ret;
+}
+
+int
+see_column_table_foreach(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    see_column_func         func,
+    void*                   data,
+    SeeError**              error_out
+    )
+{
+    SeeColumnView view;
+
+    if (!func)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = see_column_table_column_view(table, column, &view, error_out);
+    if (ret)
+        return ret;
+
+    const char* element = view.data;
+    for (size_t row = 0; row < view.size; row++) {
+        ret = func(element, row, data);
+        if (ret)
+            return ret;
+        element += view.element_size;
+    }
+
+    return ret;
+}
+
+/* **** initialization of the class **** */
+
+SeeColumnTableClass* g_SeeColumnTableClass = NULL;
+
+static int column_table_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init       = init;
+    new_cls->destroy    = column_table_destroy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeColumnTable";
+
+    /* Set the function pointers of the own class here */
+    SeeColumnTableClass* cls = (SeeColumnTableClass*) new_cls;
+
+    cls->column_table_init  = column_table_init;
+    cls->add_row            = column_table_add_row;
+    cls->reserve            = column_table_reserve;
+    cls->get_column         = column_table_get_column;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeColumnTable(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_column_table_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeColumnTableClass,
+        sizeof(SeeColumnTableClass),
+        sizeof(SeeColumnTable),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        column_table_class_init
+        );
+
+    return ret;
+}
+
+void
+see_column_table_deinit()
+{
+    if(!g_SeeColumnTableClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeColumnTableClass));
+    g_SeeColumnTableClass = NULL;
+}
+
+const SeeColumnTableClass*
+see_column_table_class()
+{
+    return g_SeeColumnTableClass;
+}
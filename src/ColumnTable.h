@@ -0,0 +1,341 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ColumnTable.h
+ * \brief A table that stores its records column by column.
+ *
+ * Records such as (timestamp, channel, value) are often stored as an array
+ * of structs. When a scan only touches one of the fields, the other fields
+ * are loaded into the cache as well. A SeeColumnTable stores every field in
+ * its own SeeDynamicArray, so a filter or aggregate over one column is a
+ * linear scan over densely packed and aligned memory.
+ *
+ * @code
+ * SeeColumnTable* table = NULL;
+ * SeeError* error = NULL;
+ * const size_t sizes[] = {sizeof(int64_t), sizeof(uint16_t), sizeof(double)};
+ *
+ * int ret = see_column_table_new(&table, 3, sizes, &error);
+ *
+ * int64_t  ts = 1; uint16_t channel = 3; double value = 2.0;
+ * const void* row[] = {&ts, &channel, &value};
+ * ret = see_column_table_add_row(table, row, &error);
+ *
+ * SeeColumnView view;
+ * ret = see_column_table_column_view(table, 2, &view, &error);
+ * const double* values = view.data;
+ * for (size_t i = 0; i < view.size; i++)
+ *      sum += values[i];
+ * @endcode
+ */
+
+#ifndef SEE_COLUMN_TABLE_H
+#define SEE_COLUMN_TABLE_H
+
+#include "SeeObject.h"
+#include "Error.h"
+#include "DynamicArray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief The alignment in bytes of the data of every column.
+ *
+ * This is sufficient for loading whole cache lines and every SIMD register
+ * width in use today.
+ */
+#define SEE_COLUMN_TABLE_ALIGNMENT 64
+
+typedef struct SeeColumnTable SeeColumnTable;
+typedef struct SeeColumnTableClass SeeColumnTableClass;
+
+/**
+ * \brief A read only view on the elements of one column.
+ */
+typedef struct SeeColumnView {
+    /** \brief pointer to the first element, aligned at
+     * SEE_COLUMN_TABLE_ALIGNMENT. */
+    const void* data;
+    /** \brief the number of elements in the column. */
+    size_t      size;
+    /** \brief the size of one element in bytes. */
+    size_t      element_size;
+} SeeColumnView;
+
+/**
+ * \brief Callback used to iterate over a column.
+ *
+ * @param [in] element  A pointer to the element.
+ * @param [in] row      The row of the element.
+ * @param [in] data     The user data passed to see_column_table_foreach.
+ *
+ * @return SEE_SUCCESS to continue, any other value stops the iteration and
+ *         is returned from see_column_table_foreach.
+ */
+typedef int (*see_column_func)(const void* element, size_t row, void* data);
+
+struct SeeColumnTable {
+    SeeObject       parent_obj;
+
+    /**
+     * \brief A SeeDynamicArray with a SeeDynamicArray* for every column.
+     * \private
+     */
+    SeeDynamicArray* columns;
+
+    /**
+     * \brief The number of rows in the table.
+     * \private
+     */
+    size_t          num_rows;
+};
+
+struct SeeColumnTableClass {
+    SeeObjectClass parent_cls;
+
+    int (*column_table_init)(
+        SeeColumnTable*            table,
+        const SeeColumnTableClass* table_cls,
+        size_t                     num_columns,
+        const size_t*              element_sizes,
+        SeeError**                 error_out
+        );
+
+    /**
+     * \brief Append one row, values contains a pointer to the value
+     * for every column.
+     */
+    int (*add_row)(
+        SeeColumnTable*     table,
+        const void* const*  values,
+        SeeError**          error_out
+        );
+
+    /**
+     * \brief Make room for at least num_rows rows in every column.
+     */
+    int (*reserve)(
+        SeeColumnTable*     table,
+        size_t              num_rows,
+        SeeError**          error_out
+        );
+
+    /**
+     * \brief Obtain a borrowed pointer to the array of a column.
+     */
+    int (*get_column)(
+        const SeeColumnTable*   table,
+        size_t                  column,
+        SeeDynamicArray**       column_out,
+        SeeError**              error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeColumnTable derived instance back to a
+ *        pointer to SeeColumnTable.
+ */
+#define SEE_COLUMN_TABLE(obj)                      \
+    ((SeeColumnTable*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeColumnTable derived instance back
+ *        to a reference to SeeColumnTable*.
+ */
+#define SEE_COLUMN_TABLE_REF(ref)                      \
+    ((SeeColumnTable**) ref)
+
+/**
+ * \brief cast a pointer to SeeColumnTableClass derived class back to a
+ *        pointer to SeeColumnTableClass.
+ */
+#define SEE_COLUMN_TABLE_CLASS(cls)                      \
+    ((const SeeColumnTableClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeColumnTableClass from a instance of
+ *        derived from SeeColumnTable. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_COLUMN_TABLE_GET_CLASS(obj)                \
+    (SEE_COLUMN_TABLE_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new and empty column table.
+ *
+ * The elements of the columns are copied with memcpy, so the columns
+ * should contain plain data.
+ *
+ * @param [out] out             The new table is returned here, *out must
+ *                              be NULL.
+ * @param [in]  num_columns     The number of columns, must be larger than 0.
+ * @param [in]  element_sizes   An array of num_columns sizes, for the size
+ *                              in bytes of an element in each column.
+ * @param [out] error_out       An error is returned here when something
+ *                              goes wrong.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME.
+ */
+SEE_EXPORT int
+see_column_table_new(
+    SeeColumnTable**    out,
+    size_t              num_columns,
+    const size_t*       element_sizes,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the number of columns of the table.
+ */
+SEE_EXPORT size_t
+see_column_table_num_columns(const SeeColumnTable* table);
+
+/**
+ * \brief Obtain the number of rows of the table.
+ */
+SEE_EXPORT size_t
+see_column_table_num_rows(const SeeColumnTable* table);
+
+/**
+ * \brief Append one row to the table.
+ *
+ * If the row cannot be added to one of the columns, the values that were
+ * already appended to the other columns are removed again, so all columns
+ * keep the same length.
+ *
+ * @param [in, out] table       The table to which a row is added.
+ * @param [in]      values      An array with a pointer to the value of
+ *                              every column.
+ * @param [out]     error_out   An error is returned here when something
+ *                              goes wrong.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME.
+ */
+SEE_EXPORT int
+see_column_table_add_row(
+    SeeColumnTable*     table,
+    const void* const*  values,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Reserve room for a number of rows in every column.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME.
+ */
+SEE_EXPORT int
+see_column_table_reserve(
+    SeeColumnTable*     table,
+    size_t              num_rows,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the array that holds the elements of a column.
+ *
+ * The returned array is borrowed from the table, it is not incref'ed. It
+ * shouldn't be resized, otherwise the columns of the table get a different
+ * length.
+ *
+ * @param [in]  table       The table.
+ * @param [in]  column      The index of the column.
+ * @param [out] column_out  The column is returned here.
+ * @param [out] error_out   An index error is returned when column is out of
+ *                          range.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX.
+ */
+SEE_EXPORT int
+see_column_table_column(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    SeeDynamicArray**       column_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Obtain a view on the elements of a column.
+ *
+ * The view remains valid until a row is added to the table.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX.
+ */
+SEE_EXPORT int
+see_column_table_column_view(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    SeeColumnView*          view,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Call a function for every element of a column in row order.
+ *
+ * @param [in] table        The table.
+ * @param [in] column       The index of the column.
+ * @param [in] func         The function that is called for every element.
+ * @param [in] data         User data passed to func.
+ * @param [out] error_out   An index error is returned when column is out of
+ *                          range.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX or the first
+ *         non SEE_SUCCESS value returned by func.
+ */
+SEE_EXPORT int
+see_column_table_foreach(
+    const SeeColumnTable*   table,
+    size_t                  column,
+    see_column_func         func,
+    void*                   data,
+    SeeError**              error_out
+    );
+
+/**
+ * Gets the pointer to the SeeColumnTableClass table.
+ */
+SEE_EXPORT const SeeColumnTableClass*
+see_column_table_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeColumnTable; make it ready for use.
+ */
+SEE_EXPORT
+int see_column_table_init();
+
+/**
+ * Deinitialize SeeColumnTable, after SeeColumnTable has been deinitialized,
+ * all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_column_table_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_COLUMN_TABLE_H
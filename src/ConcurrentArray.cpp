@@ -0,0 +1,343 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "MetaClass.h"
+#include "ConcurrentArray.h"
+#include "IndexError.h"
+#include "RuntimeError.h"
+#include "cpp/ConcurrentArray.hpp"
+
+// The number of elements in the first segment when none is specified.
+#define DEFAULT_FIRST_SEGMENT 64
+
+/* **** functions that implement SeeConcurrentArray or override SeeObject **** */
+
+static int
+concurrent_array_init(
+    SeeConcurrentArray*             array,
+    const SeeConcurrentArrayClass*  array_cls,
+    size_t                          element_size,
+    size_t                          first_segment,
+    SeeError**                      error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(array);
+
+    parent_cls->object_init(
+            SEE_OBJECT(array),
+            SEE_OBJECT_CLASS(array_cls)
+            );
+
+    try {
+        array->priv = static_cast<void*>(
+            new see::ConcurrentArray(element_size, first_segment)
+            );
+    } catch (const std::bad_alloc&) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+concurrent_array_push_back(
+    SeeConcurrentArray*     array,
+    const void*             element,
+    size_t*                 index_out,
+    SeeError**              error_out
+    )
+{
+    auto* priv = static_cast<see::ConcurrentArray*>(array->priv);
+
+    try {
+        size_t index = priv->push_back(element);
+        if (index_out)
+            *index_out = index;
+    } catch (const std::bad_alloc&) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+concurrent_array_get(
+    const SeeConcurrentArray*   array,
+    size_t                      index,
+    void*                       element_out,
+    SeeError**                  error_out
+    )
+{
+    auto* priv = static_cast<const see::ConcurrentArray*>(array->priv);
+
+    const void* element = priv->at(index);
+    if (!element) {
+        see_index_error_new(error_out, index);
+        return SEE_ERROR_INDEX;
+    }
+
+    memcpy(element_out, element, priv->element_size());
+    return SEE_SUCCESS;
+}
+
+static void
+concurrent_array_destroy(SeeObject* obj)
+{
+    SeeConcurrentArray* array = SEE_CONCURRENT_ARRAY(obj);
+    auto* priv = static_cast<see::ConcurrentArray*>(array->priv);
+    delete priv;
+
+    see_object_class()->destroy(obj);
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeConcurrentArrayClass* array_cls = SEE_CONCURRENT_ARRAY_CLASS(cls);
+    SeeConcurrentArray* array = SEE_CONCURRENT_ARRAY(obj);
+
+    size_t element_size     = va_arg(args, size_t);
+    size_t first_segment    = va_arg(args, size_t);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return array_cls->concurrent_array_init(
+        array,
+        array_cls,
+        element_size,
+        first_segment,
+        error_out
+        );
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_concurrent_array_new(
+    SeeConcurrentArray**    out,
+    size_t                  element_size,
+    SeeError**              error_out
+    )
+{
+    return see_concurrent_array_new_capacity(
+        out, element_size, DEFAULT_FIRST_SEGMENT, error_out
+        );
+}
+
+int
+see_concurrent_array_new_capacity(
+    SeeConcurrentArray**    out,
+    size_t                  element_size,
+    size_t                  first_segment,
+    SeeError**              error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_concurrent_array_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (element_size == 0 || first_segment == 0 ||
+        first_segment > (SIZE_MAX >> 1) / element_size)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(out),
+            element_size,
+            first_segment,
+            error_out
+            );
+}
+
+int
+see_concurrent_array_push_back(
+    SeeConcurrentArray*     array,
+    const void*             element,
+    size_t*                 index_out,
+    SeeError**              error_out
+    )
+{
+    if (!array || !element || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeConcurrentArrayClass* cls = SEE_CONCURRENT_ARRAY_GET_CLASS(array);
+    return cls->push_back(array, element, index_out, error_out);
+}
+
+int
+see_concurrent_array_get(
+    const SeeConcurrentArray*   array,
+    size_t                      index,
+    void*                       element_out,
+    SeeError**                  error_out
+    )
+{
+    if (!array || !element_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeConcurrentArrayClass* cls = SEE_CONCURRENT_ARRAY_GET_CLASS(array);
+    return cls->get(array, index, element_out, error_out);
+}
+
+const void*
+see_concurrent_array_at(const SeeConcurrentArray* array, size_t index)
+{
+    if (!array)
+        return nullptr;
+
+    return static_cast<const see::ConcurrentArray*>(array->priv)->at(index);
+}
+
+size_t
+see_concurrent_array_size(const SeeConcurrentArray* array)
+{
+    if (!array)
+        return 0;
+
+    return static_cast<const see::ConcurrentArray*>(array->priv)->size();
+}
+
+size_t
+see_concurrent_array_element_size(const SeeConcurrentArray* array)
+{
+    if (!array)
+        return 0;
+
+    return static_cast<const see::ConcurrentArray*>(
+        array->priv
+        )->element_size();
+}
+
+int
+see_concurrent_array_to_dynamic_array(
+    const SeeConcurrentArray*   array,
+    SeeDynamicArray**           out,
+    SeeError**                  error_out
+    )
+{
+    if (!array || !out || *out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    auto* priv = static_cast<const see::ConcurrentArray*>(array->priv);
+    size_t n = priv->size();
+    SeeDynamicArray* result = nullptr;
+
+    int ret = see_dynamic_array_new_capacity(
+        &result, priv->element_size(), nullptr, nullptr, nullptr, n, error_out
+        );
+    if (ret)
+        return ret;
+
+    for (size_t i = 0; i < n; i++) {
+        const void* element = priv->at(i);
+        if (!element) {
+            see_index_error_new(error_out, i);
+            ret = SEE_ERROR_INDEX;
+            break;
+        }
+        ret = see_dynamic_array_add(result, element, error_out);
+        if (ret)
+            break;
+    }
+
+    if (ret) {
+        see_object_decref(SEE_OBJECT(result));
+        return ret;
+    }
+
+    *out = result;
+    return SEE_SUCCESS;
+}
+
+/* **** initialization of the class **** */
+
+SeeConcurrentArrayClass* g_SeeConcurrentArrayClass = NULL;
+
+static int
+concurrent_array_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init    = init;
+    new_cls->destroy = concurrent_array_destroy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeConcurrentArray";
+
+    /* Set the function pointers of the own class here */
+    SeeConcurrentArrayClass* cls = (SeeConcurrentArrayClass*) new_cls;
+    cls->concurrent_array_init  = concurrent_array_init;
+    cls->push_back              = concurrent_array_push_back;
+    cls->get                    = concurrent_array_get;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeConcurrentArray(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_concurrent_array_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeConcurrentArrayClass,
+        sizeof(SeeConcurrentArrayClass),
+        sizeof(SeeConcurrentArray),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        concurrent_array_class_init
+        );
+
+    return ret;
+}
+
+void
+see_concurrent_array_deinit()
+{
+    if(!g_SeeConcurrentArrayClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeConcurrentArrayClass));
+    g_SeeConcurrentArrayClass = NULL;
+}
+
+const SeeConcurrentArrayClass*
+see_concurrent_array_class()
+{
+    return g_SeeConcurrentArrayClass;
+}
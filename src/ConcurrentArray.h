@@ -0,0 +1,276 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ConcurrentArray.h
+ * @brief An append only array to which many threads may add elements.
+ *
+ * A SeeConcurrentArray hands out indices with one atomic operation, so
+ * multiple threads can call see_concurrent_array_push_back() without a
+ * lock. The elements are stored in segments that double in size, elements
+ * are never moved, hence other threads may read elements while the array
+ * grows.
+ *
+ * An element is published once the push_back that added it has returned.
+ * see_concurrent_array_size() counts the indices that have been handed out,
+ * so it may include a few elements that are still being written by another
+ * thread. see_concurrent_array_get() returns SEE_ERROR_INDEX for those.
+ *
+ * The elements are copied bitwise, the array is intended for plain data
+ * like events or samples. It is not possible to remove elements.
+ *
+ * @code
+ * // in every producer thread
+ * event ev = {...};
+ * size_t index;
+ * ret = see_concurrent_array_push_back(events, &ev, &index, &error);
+ *
+ * // when the producers are done
+ * SeeDynamicArray* all = NULL;
+ * ret = see_concurrent_array_to_dynamic_array(events, &all, &error);
+ * @endcode
+ */
+
+#ifndef SEE_CONCURRENT_ARRAY_H
+#define SEE_CONCURRENT_ARRAY_H
+
+#include "SeeObject.h"
+#include "DynamicArray.h"
+#include "Error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SeeConcurrentArray SeeConcurrentArray;
+typedef struct SeeConcurrentArrayClass SeeConcurrentArrayClass;
+
+struct SeeConcurrentArray {
+    SeeObject parent_obj;
+    void* priv;
+};
+
+struct SeeConcurrentArrayClass {
+    SeeObjectClass parent_cls;
+
+    int (*concurrent_array_init)(
+        SeeConcurrentArray*             array,
+        const SeeConcurrentArrayClass*  array_cls,
+        size_t                          element_size,
+        size_t                          first_segment,
+        SeeError**                      error_out
+        );
+
+    int (*push_back)(
+        SeeConcurrentArray*     array,
+        const void*             element,
+        size_t*                 index_out,
+        SeeError**              error_out
+        );
+
+    int (*get)(
+        const SeeConcurrentArray*   array,
+        size_t                      index,
+        void*                       element_out,
+        SeeError**                  error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeConcurrentArray derived instance back to a
+ *        pointer to SeeConcurrentArray.
+ */
+#define SEE_CONCURRENT_ARRAY(obj)                      \
+    ((SeeConcurrentArray*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeConcurrentArray derived instance
+ *        back to a reference to SeeConcurrentArray*.
+ */
+#define SEE_CONCURRENT_ARRAY_REF(ref)                      \
+    ((SeeConcurrentArray**) ref)
+
+/**
+ * \brief cast a pointer to SeeConcurrentArrayClass derived class back to a
+ *        pointer to SeeConcurrentArrayClass.
+ */
+#define SEE_CONCURRENT_ARRAY_CLASS(cls)                      \
+    ((const SeeConcurrentArrayClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeConcurrentArrayClass from a instance of
+ *        derived from SeeConcurrentArray. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_CONCURRENT_ARRAY_GET_CLASS(obj)                \
+    (SEE_CONCURRENT_ARRAY_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new empty concurrent array.
+ *
+ * @param [out] out             A pointer to a SeeConcurrentArray* that is NULL.
+ * @param [in]  element_size    The size of the elements in bytes.
+ * @param [out] error_out       A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_array_new(
+    SeeConcurrentArray**    out,
+    size_t                  element_size,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Create a new empty concurrent array with a given first segment.
+ *
+ * @param [out] out             see doc for see_concurrent_array_new()
+ * @param [in]  element_size    see doc for see_concurrent_array_new()
+ * @param [in]  first_segment   The number of elements in the first segment,
+ *                              it is rounded up to a power of two. The
+ *                              following segments are twice as large as
+ *                              their predecessor.
+ * @param [out] error_out       see doc for see_concurrent_array_new()
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_array_new_capacity(
+    SeeConcurrentArray**    out,
+    size_t                  element_size,
+    size_t                  first_segment,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Append a copy of element, this may be called by many threads at
+ *        once.
+ *
+ * @param [in]  array       The array to append to.
+ * @param [in]  element     A pointer to the element to copy.
+ * @param [out] index_out   When not NULL, it receives the index of the new
+ *                          element.
+ * @param [out] error_out   A runtime error when a new segment cannot be
+ *                          allocated, the index that was reserved for the
+ *                          element then remains unpublished.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_array_push_back(
+    SeeConcurrentArray*     array,
+    const void*             element,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Copy a published element out of the array.
+ *
+ * @param [in]  array       The array to read from.
+ * @param [in]  index       The index of the element.
+ * @param [out] element_out Receives a copy of the element.
+ * @param [out] error_out   An index error when the element doesn't exist
+ *                          or hasn't been published yet.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_concurrent_array_get(
+    const SeeConcurrentArray*   array,
+    size_t                      index,
+    void*                       element_out,
+    SeeError**                  error_out
+    );
+
+/**
+ * \brief Get a pointer to a published element.
+ *
+ * Since elements never move, the pointer stays valid as long as the array
+ * exists.
+ *
+ * @return a pointer to the element or NULL when it doesn't exist or hasn't
+ *         been published yet.
+ */
+SEE_EXPORT const void*
+see_concurrent_array_at(const SeeConcurrentArray* array, size_t index);
+
+/**
+ * \brief Get the number of indices that have been handed out.
+ */
+SEE_EXPORT size_t
+see_concurrent_array_size(const SeeConcurrentArray* array);
+
+/**
+ * \brief Get the size of the elements in bytes.
+ */
+SEE_EXPORT size_t
+see_concurrent_array_element_size(const SeeConcurrentArray* array);
+
+/**
+ * \brief Copy all elements into a new SeeDynamicArray.
+ *
+ * This is meant to be called once the producers are finished.
+ *
+ * @param [in]  array       The array to copy.
+ * @param [out] out         A pointer to a SeeDynamicArray* that is NULL.
+ * @param [out] error_out   An index error when an element hasn't been
+ *                          published or a runtime error when no memory is
+ *                          available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX or
+ *         SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_array_to_dynamic_array(
+    const SeeConcurrentArray*   array,
+    SeeDynamicArray**           out,
+    SeeError**                  error_out
+    );
+
+/**
+ * Gets the pointer to the SeeConcurrentArrayClass table.
+ */
+SEE_EXPORT const SeeConcurrentArrayClass*
+see_concurrent_array_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeConcurrentArray; make it ready for use.
+ */
+SEE_EXPORT
+int see_concurrent_array_init();
+
+/**
+ * Deinitialize SeeConcurrentArray, after SeeConcurrentArray has been
+ * deinitialized, all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_concurrent_array_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_CONCURRENT_ARRAY_H
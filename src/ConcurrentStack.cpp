@@ -0,0 +1,304 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#include "MetaClass.h"
+#include "ConcurrentStack.h"
+#include "IndexError.h"
+#include "RuntimeError.h"
+#include "cpp/ConcurrentStack.hpp"
+
+/* **** functions that implement SeeConcurrentStack or override SeeObject **** */
+
+static int
+concurrent_stack_init(
+    SeeConcurrentStack*             stack,
+    const SeeConcurrentStackClass*  stack_cls,
+    size_t                          element_size,
+    SeeError**                      error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(stack);
+
+    parent_cls->object_init(
+            SEE_OBJECT(stack),
+            SEE_OBJECT_CLASS(stack_cls)
+            );
+
+    try {
+        stack->priv = static_cast<void*>(
+            new see::ConcurrentStack(element_size)
+            );
+    } catch (const std::bad_alloc&) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+concurrent_stack_push_n(
+    SeeConcurrentStack*     stack,
+    const void*             elements,
+    size_t                  n,
+    SeeError**              error_out
+    )
+{
+    auto* priv = static_cast<see::ConcurrentStack*>(stack->priv);
+
+    try {
+        priv->push_n(elements, n);
+    } catch (const std::bad_alloc&) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    } catch (const std::length_error&) {
+        see_runtime_error_new(error_out, ENOSPC);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+concurrent_stack_try_pop(
+    SeeConcurrentStack*     stack,
+    void*                   element_out,
+    int*                    popped,
+    SeeError**              error_out
+    )
+{
+    (void) error_out;
+    auto* priv = static_cast<see::ConcurrentStack*>(stack->priv);
+
+    *popped = priv->try_pop(element_out) ? 1 : 0;
+    return SEE_SUCCESS;
+}
+
+static void
+concurrent_stack_destroy(SeeObject* obj)
+{
+    SeeConcurrentStack* stack = SEE_CONCURRENT_STACK(obj);
+    auto* priv = static_cast<see::ConcurrentStack*>(stack->priv);
+    delete priv;
+
+    see_object_class()->destroy(obj);
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeConcurrentStackClass* stack_cls = SEE_CONCURRENT_STACK_CLASS(cls);
+    SeeConcurrentStack* stack = SEE_CONCURRENT_STACK(obj);
+
+    size_t element_size     = va_arg(args, size_t);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return stack_cls->concurrent_stack_init(
+        stack,
+        stack_cls,
+        element_size,
+        error_out
+        );
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_concurrent_stack_new(
+    SeeConcurrentStack**    out,
+    size_t                  element_size,
+    SeeError**              error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_concurrent_stack_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (element_size == 0 ||
+        element_size > (SIZE_MAX >> 1) / see::ConcurrentStack::MAX_NODES)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(out),
+            element_size,
+            error_out
+            );
+}
+
+int
+see_concurrent_stack_push(
+    SeeConcurrentStack*     stack,
+    const void*             element,
+    SeeError**              error_out
+    )
+{
+    return see_concurrent_stack_push_n(stack, element, 1, error_out);
+}
+
+int
+see_concurrent_stack_push_n(
+    SeeConcurrentStack*     stack,
+    const void*             elements,
+    size_t                  n,
+    SeeError**              error_out
+    )
+{
+    if (!stack || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (!elements && n)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeConcurrentStackClass* cls = SEE_CONCURRENT_STACK_GET_CLASS(stack);
+    return cls->push_n(stack, elements, n, error_out);
+}
+
+int
+see_concurrent_stack_pop(
+    SeeConcurrentStack*     stack,
+    void*                   element_out,
+    SeeError**              error_out
+    )
+{
+    int popped = 0;
+    int ret = see_concurrent_stack_try_pop(
+        stack, element_out, &popped, error_out
+        );
+    if (ret)
+        return ret;
+
+    if (!popped) {
+        see_index_error_new(error_out, 0);
+        return SEE_ERROR_INDEX;
+    }
+
+    return SEE_SUCCESS;
+}
+
+int
+see_concurrent_stack_try_pop(
+    SeeConcurrentStack*     stack,
+    void*                   element_out,
+    int*                    popped,
+    SeeError**              error_out
+    )
+{
+    if (!stack || !popped || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeConcurrentStackClass* cls = SEE_CONCURRENT_STACK_GET_CLASS(stack);
+    return cls->try_pop(stack, element_out, popped, error_out);
+}
+
+size_t
+see_concurrent_stack_size(const SeeConcurrentStack* stack)
+{
+    if (!stack)
+        return 0;
+
+    return static_cast<const see::ConcurrentStack*>(stack->priv)->size();
+}
+
+size_t
+see_concurrent_stack_element_size(const SeeConcurrentStack* stack)
+{
+    if (!stack)
+        return 0;
+
+    return static_cast<const see::ConcurrentStack*>(
+        stack->priv
+        )->element_size();
+}
+
+/* **** initialization of the class **** */
+
+SeeConcurrentStackClass* g_SeeConcurrentStackClass = NULL;
+
+static int
+concurrent_stack_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init    = init;
+    new_cls->destroy = concurrent_stack_destroy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeConcurrentStack";
+
+    /* Set the function pointers of the own class here */
+    SeeConcurrentStackClass* cls = (SeeConcurrentStackClass*) new_cls;
+    cls->concurrent_stack_init  = concurrent_stack_init;
+    cls->push_n                 = concurrent_stack_push_n;
+    cls->try_pop                = concurrent_stack_try_pop;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeConcurrentStack(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_concurrent_stack_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeConcurrentStackClass,
+        sizeof(SeeConcurrentStackClass),
+        sizeof(SeeConcurrentStack),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        concurrent_stack_class_init
+        );
+
+    return ret;
+}
+
+void
+see_concurrent_stack_deinit()
+{
+    if(!g_SeeConcurrentStackClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeConcurrentStackClass));
+    g_SeeConcurrentStackClass = NULL;
+}
+
+const SeeConcurrentStackClass*
+see_concurrent_stack_class()
+{
+    return g_SeeConcurrentStackClass;
+}
@@ -0,0 +1,255 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ConcurrentStack.h
+ * @brief A stack that many threads may push to and pop from without a lock.
+ *
+ * A SeeConcurrentStack is a lock free (Treiber) stack. Every push and pop
+ * is a single compare and swap of the top of the stack, so threads never
+ * block each other. It is a good fit for a free list of buffers that is
+ * shared by several threads.
+ *
+ * The elements are copied bitwise. Pointers to SeeObjects may be stored,
+ * the reference then moves into the stack on a push and out of it on a
+ * pop. Elements that are left when the stack is destroyed are not freed.
+ *
+ * Unlike SeeStack there is no see_stack_top(), since another thread may
+ * pop the element meanwhile, pop returns the element instead.
+ *
+ * @code
+ * // any thread
+ * ret = see_concurrent_stack_push(free_list, &buffer, &error);
+ *
+ * // any other thread
+ * int popped;
+ * ret = see_concurrent_stack_try_pop(free_list, &buffer, &popped, &error);
+ * if (!popped)
+ *     ... allocate a new buffer
+ * @endcode
+ */
+
+#ifndef SEE_CONCURRENT_STACK_H
+#define SEE_CONCURRENT_STACK_H
+
+#include "SeeObject.h"
+#include "Error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SeeConcurrentStack SeeConcurrentStack;
+typedef struct SeeConcurrentStackClass SeeConcurrentStackClass;
+
+struct SeeConcurrentStack {
+    SeeObject parent_obj;
+    void* priv;
+};
+
+struct SeeConcurrentStackClass {
+    SeeObjectClass parent_cls;
+
+    int (*concurrent_stack_init)(
+        SeeConcurrentStack*             stack,
+        const SeeConcurrentStackClass*  stack_cls,
+        size_t                          element_size,
+        SeeError**                      error_out
+        );
+
+    int (*push_n)(
+        SeeConcurrentStack*     stack,
+        const void*             elements,
+        size_t                  n,
+        SeeError**              error_out
+        );
+
+    int (*try_pop)(
+        SeeConcurrentStack*     stack,
+        void*                   element_out,
+        int*                    popped,
+        SeeError**              error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeConcurrentStack derived instance back to a
+ *        pointer to SeeConcurrentStack.
+ */
+#define SEE_CONCURRENT_STACK(obj)                      \
+    ((SeeConcurrentStack*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeConcurrentStack derived instance
+ *        back to a reference to SeeConcurrentStack*.
+ */
+#define SEE_CONCURRENT_STACK_REF(ref)                      \
+    ((SeeConcurrentStack**) ref)
+
+/**
+ * \brief cast a pointer to SeeConcurrentStackClass derived class back to a
+ *        pointer to SeeConcurrentStackClass.
+ */
+#define SEE_CONCURRENT_STACK_CLASS(cls)                      \
+    ((const SeeConcurrentStackClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeConcurrentStackClass from a instance of
+ *        derived from SeeConcurrentStack. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_CONCURRENT_STACK_GET_CLASS(obj)                \
+    (SEE_CONCURRENT_STACK_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new empty concurrent stack.
+ *
+ * @param [out] out             A pointer to a SeeConcurrentStack* that is
+ *                              NULL.
+ * @param [in]  element_size    The size of the elements in bytes.
+ * @param [out] error_out       A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_stack_new(
+    SeeConcurrentStack**    out,
+    size_t                  element_size,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Push a copy of element on the stack.
+ *
+ * @param [in]  stack       The stack to push on.
+ * @param [in]  element     A pointer to the element to copy.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_stack_push(
+    SeeConcurrentStack*     stack,
+    const void*             element,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Push n elements at once, the last one ends up on top.
+ *
+ * The elements appear on the stack together, another thread never sees a
+ * part of them. When there is no memory none of them are pushed.
+ *
+ * @param [in]  stack       The stack to push on.
+ * @param [in]  elements    A pointer to n consecutive elements.
+ * @param [in]  n           The number of elements.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_concurrent_stack_push_n(
+    SeeConcurrentStack*     stack,
+    const void*             elements,
+    size_t                  n,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Pop the top element.
+ *
+ * @param [in]  stack       The stack to pop from.
+ * @param [out] element_out If not NULL, it receives the element.
+ * @param [out] error_out   An index error when the stack is empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_concurrent_stack_pop(
+    SeeConcurrentStack*     stack,
+    void*                   element_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Pop the top element when there is one.
+ *
+ * This is see_concurrent_stack_pop() for when an empty stack is expected,
+ * it doesn't create an error.
+ *
+ * @param [in]  stack       The stack to pop from.
+ * @param [out] element_out If not NULL, it receives the element.
+ * @param [out] popped      Is set to 1 when an element was popped, else 0.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_concurrent_stack_try_pop(
+    SeeConcurrentStack*     stack,
+    void*                   element_out,
+    int*                    popped,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Obtain the number of elements on the stack.
+ *
+ * When other threads push or pop at the same time, the number may already
+ * be outdated when it's returned.
+ */
+SEE_EXPORT size_t
+see_concurrent_stack_size(const SeeConcurrentStack* stack);
+
+/**
+ * \brief Get the size of the elements in bytes.
+ */
+SEE_EXPORT size_t
+see_concurrent_stack_element_size(const SeeConcurrentStack* stack);
+
+/**
+ * Gets the pointer to the SeeConcurrentStackClass table.
+ */
+SEE_EXPORT const SeeConcurrentStackClass*
+see_concurrent_stack_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeConcurrentStack; make it ready for use.
+ */
+SEE_EXPORT
+int see_concurrent_stack_init();
+
+/**
+ * Deinitialize SeeConcurrentStack, after SeeConcurrentStack has been
+ * deinitialized, all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_concurrent_stack_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_CONCURRENT_STACK_H
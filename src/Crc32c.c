@@ -0,0 +1,386 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file Crc32c.c
+ * \brief implements the CRC32C checksum.
+ *
+ * Like ByteOrderKernels.c, every instruction set provides a table with
+ * kernels that is selected once by see_crc32c_init(). The kernels work on
+ * the inverted crc, see_crc32c() inverts it before and after.
+ *
+ * The crc instructions have a latency of a few cycles, but a new one can
+ * start every cycle. So the hardware kernels compute the crc of three
+ * adjacent blocks at once and combine them afterwards: the crc of the
+ * first block is shifted over the length of the next block, as if zeros
+ * were appended, and the crc of the next block is added.
+ *
+ * \private
+ */
+
+#include "see_object_config.h"
+#include <stdint.h>
+#include <string.h>
+#include "Crc32c.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#   if defined(__GNUC__) || defined(_MSC_VER)
+#       define SEE_KERNELS_SSE42 1
+#   endif
+#   include <nmmintrin.h>
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#   define SEE_KERNELS_ARMV8 1
+#   include <arm_acle.h>
+#endif
+
+#if defined(__GNUC__)
+#   define SEE_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#   define SEE_TARGET_SSE42
+#endif
+
+/*
+ * The reversed Castagnoli polynomial.
+ */
+#define CRC32C_POLY 0x82F63B78u
+
+/* **** the table with kernels for one instruction set **** */
+
+typedef struct see_crc32c_kernels {
+    const char* isa;
+
+    // Update the inverted crc with n bytes.
+    uint32_t (*update)(uint32_t crc, const unsigned char* p, size_t n);
+} see_crc32c_kernels;
+
+/* **** bitwise kernel, used until the tables are computed **** */
+
+static uint32_t
+bitwise_update(uint32_t crc, const unsigned char* p, size_t n)
+{
+    while (n--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++)
+            crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+    }
+    return crc;
+}
+
+static const see_crc32c_kernels g_bitwise_kernels = {
+    .isa    = "bitwise",
+    .update = bitwise_update
+};
+
+/* **** slice-by-8 kernel **** */
+
+static uint32_t g_table[8][256];
+
+/*
+ * Multiplies the 32x32 bit matrix mat with vec in GF(2).
+ */
+static uint32_t
+gf2_matrix_times(const uint32_t* mat, uint32_t vec)
+{
+    uint32_t sum = 0;
+    for (; vec; vec >>= 1, mat++)
+        if (vec & 1)
+            sum ^= *mat;
+    return sum;
+}
+
+static void
+gf2_matrix_square(uint32_t* square, const uint32_t* mat)
+{
+    for (int n = 0; n < 32; n++)
+        square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
+/*
+ * Fills a table that appends len zero bytes to a crc, len must be a
+ * power of two.
+ */
+static void
+make_shift_table(uint32_t table[4][256], size_t len)
+{
+    uint32_t even[32], odd[32];
+    uint32_t row = 1;
+
+    // The operator for one zero bit.
+    odd[0] = CRC32C_POLY;
+    for (int n = 1; n < 32; n++, row <<= 1)
+        odd[n] = row;
+
+    // Two zero bits, then four zero bits.
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+
+    // Keep squaring from one zero byte until len is reached.
+    const uint32_t* op = even;
+    for (;;) {
+        gf2_matrix_square(even, odd);
+        op = even;
+        len >>= 1;
+        if (!len)
+            break;
+        gf2_matrix_square(odd, even);
+        op = odd;
+        len >>= 1;
+        if (!len)
+            break;
+    }
+
+    for (uint32_t n = 0; n < 256; n++) {
+        table[0][n] = gf2_matrix_times(op, n);
+        table[1][n] = gf2_matrix_times(op, n << 8);
+        table[2][n] = gf2_matrix_times(op, n << 16);
+        table[3][n] = gf2_matrix_times(op, n << 24);
+    }
+}
+
+/*
+ * The block sizes of the hardware kernels and the tables that shift a crc
+ * over a block.
+ */
+#define CRC32C_LONG     8192
+#define CRC32C_SHORT    256
+
+static uint32_t g_long_shift[4][256];
+static uint32_t g_short_shift[4][256];
+
+static uint32_t
+shift_crc(uint32_t table[4][256], uint32_t crc)
+{
+    return table[0][crc & 0xff]         ^ table[1][(crc >> 8) & 0xff] ^
+           table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+}
+
+static void
+make_tables(void)
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        unsigned char byte = (unsigned char) i;
+        g_table[0][i] = bitwise_update(0, &byte, 1);
+    }
+
+    for (int s = 1; s < 8; s++)
+        for (int i = 0; i < 256; i++)
+            g_table[s][i] = (g_table[s - 1][i] >> 8) ^
+                            g_table[0][g_table[s - 1][i] & 0xff];
+
+    make_shift_table(g_long_shift, CRC32C_LONG);
+    make_shift_table(g_short_shift, CRC32C_SHORT);
+}
+
+/*
+ * The bytes are assembled one by one, so this works on big endian hosts
+ * too.
+ */
+static uint32_t
+slice8_update(uint32_t crc, const unsigned char* p, size_t n)
+{
+    for (; n >= 8; n -= 8, p += 8) {
+        uint32_t lo = crc ^ ((uint32_t) p[0]         | (uint32_t) p[1] << 8 |
+                             (uint32_t) p[2] << 16   | (uint32_t) p[3] << 24);
+        uint32_t hi =        (uint32_t) p[4]         | (uint32_t) p[5] << 8 |
+                             (uint32_t) p[6] << 16   | (uint32_t) p[7] << 24;
+
+        crc = g_table[7][lo & 0xff]         ^ g_table[6][(lo >> 8) & 0xff]  ^
+              g_table[5][(lo >> 16) & 0xff] ^ g_table[4][lo >> 24]          ^
+              g_table[3][hi & 0xff]         ^ g_table[2][(hi >> 8) & 0xff]  ^
+              g_table[1][(hi >> 16) & 0xff] ^ g_table[0][hi >> 24];
+    }
+
+    while (n--)
+        crc = g_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+static const see_crc32c_kernels g_slice8_kernels = {
+    .isa    = "slice-by-8",
+    .update = slice8_update
+};
+
+/* **** SSE4.2 kernel **** */
+
+#if defined(SEE_KERNELS_SSE42)
+
+/*
+ * Computes the crc of three adjacent blocks of size bytes at once.
+ */
+SEE_TARGET_SSE42 static uint32_t
+sse42_blocks(
+    uint32_t                crc,
+    const unsigned char*    p,
+    size_t                  size,
+    uint32_t                shift[4][256]
+    )
+{
+    uint64_t crc0 = crc, crc1 = 0, crc2 = 0;
+
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t v0, v1, v2;
+        memcpy(&v0, p + i, sizeof(v0));
+        memcpy(&v1, p + size + i, sizeof(v1));
+        memcpy(&v2, p + 2 * size + i, sizeof(v2));
+        crc0 = _mm_crc32_u64(crc0, v0);
+        crc1 = _mm_crc32_u64(crc1, v1);
+        crc2 = _mm_crc32_u64(crc2, v2);
+    }
+
+    crc = shift_crc(shift, (uint32_t) crc0) ^ (uint32_t) crc1;
+    return shift_crc(shift, crc) ^ (uint32_t) crc2;
+}
+
+SEE_TARGET_SSE42 static uint32_t
+sse42_update(uint32_t crc, const unsigned char* p, size_t n)
+{
+    for (; n >= 3 * CRC32C_LONG; n -= 3 * CRC32C_LONG, p += 3 * CRC32C_LONG)
+        crc = sse42_blocks(crc, p, CRC32C_LONG, g_long_shift);
+    for (; n >= 3 * CRC32C_SHORT; n -= 3 * CRC32C_SHORT, p += 3 * CRC32C_SHORT)
+        crc = sse42_blocks(crc, p, CRC32C_SHORT, g_short_shift);
+
+    uint64_t crc64 = crc;
+    for (; n >= 8; n -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+
+    crc = (uint32_t) crc64;
+    while (n--)
+        crc = _mm_crc32_u8(crc, *p++);
+
+    return crc;
+}
+
+static const see_crc32c_kernels g_sse42_kernels = {
+    .isa    = "sse4.2",
+    .update = sse42_update
+};
+
+static int
+cpu_has_sse42(void)
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return 0;
+#endif
+}
+
+#endif // defined(SEE_KERNELS_SSE42)
+
+/* **** ARMv8 kernel **** */
+
+#if defined(SEE_KERNELS_ARMV8)
+
+static uint32_t
+armv8_blocks(
+    uint32_t                crc,
+    const unsigned char*    p,
+    size_t                  size,
+    uint32_t                shift[4][256]
+    )
+{
+    uint32_t crc0 = crc, crc1 = 0, crc2 = 0;
+
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t v0, v1, v2;
+        memcpy(&v0, p + i, sizeof(v0));
+        memcpy(&v1, p + size + i, sizeof(v1));
+        memcpy(&v2, p + 2 * size + i, sizeof(v2));
+        crc0 = __crc32cd(crc0, v0);
+        crc1 = __crc32cd(crc1, v1);
+        crc2 = __crc32cd(crc2, v2);
+    }
+
+    crc = shift_crc(shift, crc0) ^ crc1;
+    return shift_crc(shift, crc) ^ crc2;
+}
+
+static uint32_t
+armv8_update(uint32_t crc, const unsigned char* p, size_t n)
+{
+    for (; n >= 3 * CRC32C_LONG; n -= 3 * CRC32C_LONG, p += 3 * CRC32C_LONG)
+        crc = armv8_blocks(crc, p, CRC32C_LONG, g_long_shift);
+    for (; n >= 3 * CRC32C_SHORT; n -= 3 * CRC32C_SHORT, p += 3 * CRC32C_SHORT)
+        crc = armv8_blocks(crc, p, CRC32C_SHORT, g_short_shift);
+
+    for (; n >= 8; n -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        crc = __crc32cd(crc, v);
+    }
+
+    while (n--)
+        crc = __crc32cb(crc, *p++);
+
+    return crc;
+}
+
+static const see_crc32c_kernels g_armv8_kernels = {
+    .isa    = "armv8",
+    .update = armv8_update
+};
+
+#endif // defined(SEE_KERNELS_ARMV8)
+
+/* **** selection of the kernels **** */
+
+static const see_crc32c_kernels* g_kernels = &g_bitwise_kernels;
+
+int
+see_crc32c_init()
+{
+    const see_crc32c_kernels* selected = &g_slice8_kernels;
+
+    make_tables();
+
+#if defined(SEE_KERNELS_SSE42)
+    if (cpu_has_sse42())
+        selected = &g_sse42_kernels;
+#endif
+#if defined(SEE_KERNELS_ARMV8)
+    selected = &g_armv8_kernels;
+#endif
+
+    g_kernels = selected;
+    return SEE_SUCCESS;
+}
+
+const char*
+see_crc32c_isa()
+{
+    return g_kernels->isa;
+}
+
+/* **** implementation of the public API **** */
+
+uint32_t
+see_crc32c(uint32_t crc, const void* data, size_t n)
+{
+    return ~g_kernels->update(~crc, data, n);
+}
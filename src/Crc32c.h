@@ -0,0 +1,81 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file Crc32c.h
+ * \brief Compute CRC32C (Castagnoli) checksums.
+ *
+ * The CRC32C is used to detect corrupted messages, see
+ * see_msg_buffer_set_crc(). When the library is initialized, the fastest
+ * implementation for the cpu is selected: the crc32 instruction of SSE4.2
+ * on x86_64 or the CRC instructions of ARMv8 when the library is compiled
+ * for a cpu that has them. Otherwise a slice-by-8 table is used.
+ */
+
+#ifndef SEE_CRC32C_H
+#define SEE_CRC32C_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SeeObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Update a CRC32C with n bytes.
+ *
+ * Start with a crc of 0, the CRC32C of data that is split in chunks can
+ * be computed by passing the result of the previous chunk:
+ *
+ * @code
+ * uint32_t crc = see_crc32c(0, "1234", 4);
+ * crc = see_crc32c(crc, "56789", 5); // crc == see_crc32c(0, "123456789", 9)
+ * @endcode
+ *
+ * @param [in] crc  The CRC32C of the preceding bytes or 0.
+ * @param [in] data The bytes to add.
+ * @param [in] n    The number of bytes.
+ *
+ * @return The CRC32C of the preceding bytes and data.
+ */
+SEE_EXPORT uint32_t
+see_crc32c(uint32_t crc, const void* data, size_t n);
+
+/**
+ * \brief Obtain the name of the implementation that is used, e.g.
+ *        "sse4.2", "armv8" or "slice-by-8".
+ */
+SEE_EXPORT const char*
+see_crc32c_isa();
+
+/* **** initialization **** */
+
+/**
+ * \private
+ * \brief Select the implementation for the cpu, this is called from the
+ * library initialization. Until then a bitwise implementation is used.
+ */
+SEE_EXPORT int
+see_crc32c_init();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_CRC32C_H
@@ -25,12 +25,25 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <errno.h>
-
+#include <stdio.h>
+#include <stdint.h>
+
+#include "see_object_config.h"
+
+#if defined(HAVE_SYS_MMAN_H)
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#elif defined(HAVE_WINDOWS_H)
+#   include <windows.h>
+#endif
 #include "MetaClass.h"
 #include "DynamicArray.h"
 #include "IndexError.h"
 #include "see_functions.h"
 #include "RuntimeError.h"
+#include "Span.h"
 
 /* **** some private helper macro's **** */
 
@@ -52,6 +65,286 @@
 #define ARRAY_NUM_BYTES(array, n)\
     ((array)->element_size * (n))
 
+/**
+ * @brief Return from the calling function when the array is memory mapped
+ *        and thus cannot be modified.
+ */
+#define ARRAY_CHECK_WRITABLE(array, error)\
+    do {\
+        if ((array)->mapping) {\
+            see_runtime_error_new(error, EROFS);\
+            return SEE_ERROR_RUNTIME;\
+        }\
+    } while (0)
+
+
+/* **** private helpers that manage the storage of the elements **** */
+
+/**
+ * @brief The alignment of the inline storage that directly follows the
+ *        members of an array created with see_dynamic_array_new_inline.
+ */
+#define ARRAY_INLINE_ALIGNMENT 16
+
+/**
+ * @brief Obtain the offset of the inline storage from the start of an
+ *        instance of cls.
+ */
+static size_t
+array_inline_offset(const SeeObjectClass* cls)
+{
+    return (cls->inst_size + ARRAY_INLINE_ALIGNMENT - 1) &
+        ~((size_t) ARRAY_INLINE_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Obtain the storage that is allocated together with the array.
+ */
+static char*
+array_inline_storage(const SeeDynamicArray* array)
+{
+    const SeeObjectClass* cls = see_object_get_class(SEE_OBJECT(array));
+    return ((char*) array) + array_inline_offset(cls);
+}
+
+/**
+ * @brief Check whether the elements are in the inline storage.
+ */
+static int
+array_is_inline(const SeeDynamicArray* array)
+{
+    return array->inline_capacity &&
+        array->elements == array_inline_storage(array);
+}
+
+/**
+ * @brief Allocate a new buffer for the elements, that respects the alignment
+ *        of the array.
+ */
+static char*
+array_storage_alloc(const SeeDynamicArray* array, size_t n_bytes)
+{
+    void* mem = NULL;
+
+    if (!array->alignment)
+        return malloc(n_bytes);
+
+#if defined(HAVE_WINDOWS_H)
+    mem = _aligned_malloc(n_bytes, array->alignment);
+#else
+    int ret = posix_memalign(&mem, array->alignment, n_bytes);
+    if (ret) {
+        errno = ret;
+        mem = NULL;
+    }
+#endif
+    return mem;
+}
+
+/**
+ * @brief Free a buffer obtained from array_storage_alloc.
+ */
+static void
+array_storage_free(const SeeDynamicArray* array, char* mem)
+{
+    // The inline storage is freed with the array.
+    if (array->inline_capacity && mem == array_inline_storage(array))
+        return;
+
+#if defined(HAVE_WINDOWS_H)
+    if (array->alignment) {
+        _aligned_free(mem);
+        return;
+    }
+#endif
+    free(mem);
+}
+
+/**
+ * @brief Move the elements of the array to a buffer of n_bytes.
+ *
+ * @return the new buffer, or NULL when out of memory, then the old
+ *         buffer is still valid.
+ */
+static char*
+array_storage_realloc(SeeDynamicArray* array, size_t n_bytes)
+{
+    if (!array->alignment && !array_is_inline(array))
+        return realloc(array->elements, n_bytes);
+
+    char* new_mem = array_storage_alloc(array, n_bytes);
+    if (!new_mem)
+        return NULL;
+
+    size_t used = ARRAY_NUM_BYTES(array, array->size);
+    if (array->elements)
+        memcpy(new_mem, array->elements, used < n_bytes ? used : n_bytes);
+    array_storage_free(array, array->elements);
+    return new_mem;
+}
+
+/* **** private helpers for arrays that are saved to a file **** */
+
+#define ARRAY_FILE_MAGIC        "SEEARRAY"
+#define ARRAY_FILE_VERSION      1
+#define ARRAY_FILE_BYTE_ORDER   0x01020304u
+
+/**
+ * @brief The header of a file written by see_dynamic_array_save().
+ *
+ * The header is 64 bytes, so the elements in a mapped file are 64 byte
+ * aligned. The byte order is written in the native order of the machine
+ * that saved the array, it doesn't read back as ARRAY_FILE_BYTE_ORDER on
+ * a machine with another order.
+ */
+typedef struct array_file_header {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    byte_order;
+    uint64_t    element_size;
+    uint64_t    count;
+    uint8_t     reserved[32];
+} array_file_header;
+
+/**
+ * @brief Check whether the header is valid and fits within a file of
+ *        file_size bytes.
+ *
+ * @return 0 or EINVAL
+ */
+static int
+array_file_check_header(const array_file_header* header, size_t file_size)
+{
+    if (memcmp(header->magic, ARRAY_FILE_MAGIC, sizeof(header->magic)) != 0)
+        return EINVAL;
+    if (header->version != ARRAY_FILE_VERSION)
+        return EINVAL;
+    if (header->byte_order != ARRAY_FILE_BYTE_ORDER)
+        return EINVAL;
+    if (header->element_size == 0 ||
+        (size_t) header->element_size != header->element_size)
+        return EINVAL;
+    if (header->count > (file_size - sizeof(*header)) / header->element_size)
+        return EINVAL;
+    return 0;
+}
+
+/**
+ * @brief Map a file read only into memory.
+ *
+ * @return 0 or an errno value.
+ */
+static int
+array_file_map(const char* path, void** mem_out, size_t* size_out)
+{
+#if defined(HAVE_SYS_MMAN_H)
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return errno;
+
+    if (fstat(fd, &st) != 0) {
+        int errnum = errno;
+        close(fd);
+        return errnum;
+    }
+    if ((uint64_t) st.st_size < sizeof(array_file_header) ||
+        (uint64_t) st.st_size > SIZE_MAX) {
+        close(fd);
+        return EINVAL;
+    }
+
+    void* mem = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int errnum = errno;
+    // The mapping keeps the file open.
+    close(fd);
+    if (mem == MAP_FAILED)
+        return errnum;
+
+    *mem_out  = mem;
+    *size_out = (size_t) st.st_size;
+    return 0;
+#elif defined(HAVE_WINDOWS_H)
+    LARGE_INTEGER size;
+    HANDLE file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, NULL
+        );
+    if (file == INVALID_HANDLE_VALUE)
+        return ENOENT;
+
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return EIO;
+    }
+    if ((uint64_t) size.QuadPart < sizeof(array_file_header) ||
+        (uint64_t) size.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return EINVAL;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return EIO;
+
+    // The view keeps the mapping and the file open.
+    void* mem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!mem)
+        return EIO;
+
+    *mem_out  = mem;
+    *size_out = (size_t) size.QuadPart;
+    return 0;
+#else
+    // Without memory mapped files, read the entire file instead.
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return errno;
+
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0)
+        size = ftell(file);
+    if (size < (long) sizeof(array_file_header) || fseek(file, 0, SEEK_SET)) {
+        fclose(file);
+        return EINVAL;
+    }
+
+    void* mem = malloc((size_t) size);
+    if (!mem) {
+        fclose(file);
+        return ENOMEM;
+    }
+    if (fread(mem, 1, (size_t) size, file) != (size_t) size) {
+        free(mem);
+        fclose(file);
+        return EIO;
+    }
+    fclose(file);
+
+    *mem_out  = mem;
+    *size_out = (size_t) size;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Release memory obtained with array_file_map().
+ */
+static void
+array_file_unmap(void* mem, size_t size)
+{
+#if defined(HAVE_SYS_MMAN_H)
+    munmap(mem, size);
+#elif defined(HAVE_WINDOWS_H)
+    (void) size;
+    UnmapViewOfFile(mem);
+#else
+    (void) size;
+    free(mem);
+#endif
+}
 
 /* **** functions that implement SeeDynamicArray or override SeeObject **** */
 
@@ -83,6 +376,10 @@ dynamic_array_init(
     array->init_element = init_func;
     array->free_element = free_func;
     array->elements     = NULL;
+    array->alignment    = 0;
+    array->inline_capacity = 0;
+    array->mapping      = NULL;
+    array->mapping_size = 0;
 
     return SEE_SUCCESS;
 }
@@ -120,7 +417,10 @@ dynamic_array_destroy(SeeObject* obj)
                 array->free_element(*element_ptr);
             }
         }
-        free(array->elements);
+        if (array->mapping)
+            array_file_unmap(array->mapping, array->mapping_size);
+        else
+            array_storage_free(array, array->elements);
     }
 
     // Let the parent destructor handle the rest.
@@ -141,18 +441,24 @@ see_dynamic_array_copy(
     if (!array_in || !array_out || !error_out || *error_out)
         return SEE_INVALID_ARGUMENT;
 
-    ret = see_dynamic_array_new_capacity(
+    ret = see_dynamic_array_new_inline(
         &out,
         a_in->element_size,
         a_in->copy_element,
         a_in->init_element,
         a_in->free_element,
-        a_in->size,
+        a_in->inline_capacity,
         error_out
         );
     if (ret)
         goto fail;
 
+    // The copy keeps the alignment of the original.
+    out->alignment = a_in->alignment;
+    ret = see_dynamic_array_reserve(out, a_in->size, error_out);
+    if (ret)
+        goto fail;
+
     size = see_dynamic_array_size(a_in);
     for (size_t i = 0; i < size; i++) {
         const void* element = ARRAY_ELEM_ADDRESS(a_in, i);
@@ -181,6 +487,7 @@ array_set(
     )
 {
     int ret = SEE_SUCCESS;
+    ARRAY_CHECK_WRITABLE(array, error);
     if (pos < array->size) {
         char *elem = ARRAY_ELEM_ADDRESS(array, pos);
         if (array->free_element)
@@ -220,6 +527,8 @@ array_reserve(
     if (n_elements <= array->capacity)
         return SEE_SUCCESS;
 
+    ARRAY_CHECK_WRITABLE(array, error);
+
     size_t a = n_elements, b = array->element_size;
     size_t x = a * b;
 
@@ -231,7 +540,7 @@ array_reserve(
 
     size_t num_bytes = ARRAY_NUM_BYTES(array, n_elements);
 
-    char* new_mem = realloc(array->elements, num_bytes);
+    char* new_mem = array_storage_realloc(array, num_bytes);
 
     if (new_mem == NULL && num_bytes != 0) {
         see_runtime_error_new(error, errno);
@@ -247,11 +556,31 @@ array_reserve(
 static int
 array_shrink_to_fit(SeeDynamicArray* array, SeeError** error)
 {
-    if (array->size == array->capacity)
+    ARRAY_CHECK_WRITABLE(array, error);
+
+    if (array->size == array->capacity || array_is_inline(array))
         return SEE_SUCCESS;
 
+    // Move the elements back into the array when they fit.
+    if (array->inline_capacity && array->size <= array->inline_capacity) {
+        char* storage = array_inline_storage(array);
+        memcpy(storage, array->elements, ARRAY_NUM_BYTES(array, array->size));
+        array_storage_free(array, array->elements);
+        array->elements = storage;
+        array->capacity = array->inline_capacity;
+        return SEE_SUCCESS;
+    }
+
+    // realloc to 0 bytes may return NULL, so an empty array is released.
+    if (array->size == 0) {
+        array_storage_free(array, array->elements);
+        array->elements = NULL;
+        array->capacity = 0;
+        return SEE_SUCCESS;
+    }
+
     size_t n_bytes = ARRAY_NUM_BYTES(array, array->size);
-    char* new_mem = realloc(array->elements, n_bytes);
+    char* new_mem = array_storage_realloc(array, n_bytes);
     if (new_mem == NULL) {
         see_runtime_error_new(error, errno);
         return SEE_ERROR_RUNTIME;
@@ -267,6 +596,7 @@ static int
 array_add(SeeDynamicArray* array, const void* element, SeeError** error)
 {
     int result = SEE_SUCCESS;
+    ARRAY_CHECK_WRITABLE(array, error);
     if (array->size < array->capacity) {
         array->copy_element(
             ARRAY_ELEM_ADDRESS(array, array->size),
@@ -293,6 +623,9 @@ array_add(SeeDynamicArray* array, const void* element, SeeError** error)
 static int
 array_pop_back(SeeDynamicArray* array, void* element)
 {
+    if (array->mapping)
+        return SEE_ERROR_RUNTIME;
+
     array->copy_element(
         element,
         ARRAY_ELEM_ADDRESS(array, array->size-1),
@@ -309,6 +642,8 @@ array_resize(SeeDynamicArray* array, size_t n, void* init_data, SeeError** error
 {
     const SeeDynamicArrayClass* cls = SEE_DYNAMIC_ARRAY_GET_CLASS(array);
 
+    ARRAY_CHECK_WRITABLE(array, error);
+
     if (n == array->size)
         return SEE_SUCCESS;
     else if (n < array->size)
@@ -320,6 +655,9 @@ array_resize(SeeDynamicArray* array, size_t n, void* init_data, SeeError** error
 static int
 array_shrink(SeeDynamicArray* array, size_t size)
 {
+    if (array->mapping)
+        return SEE_ERROR_RUNTIME;
+
     if (array->free_element) {
         for (size_t i = size; i < array->size; i++) {
             void* element = ARRAY_ELEM_ADDRESS(array, i);
@@ -341,14 +679,16 @@ array_grow (
     int success;
     const SeeDynamicArrayClass* cls = SEE_DYNAMIC_ARRAY_GET_CLASS(array);
 
+    ARRAY_CHECK_WRITABLE(array, error);
+
     success = cls->reserve(array, count, error);
     if (success != SEE_SUCCESS)
         return success;
 
-    size_t diff = count - array->size;
     if (array->init_element) {
-        for (size_t i = array->size; i < array->size + diff; i++) {
-            void* element = ARRAY_ELEM_ADDRESS(array, i);
+        // Only count the elements that have been initialized.
+        while (array->size < count) {
+            void* element = ARRAY_ELEM_ADDRESS(array, array->size);
             success = array->init_element(
                 element,
                 array->element_size,
@@ -356,8 +696,10 @@ array_grow (
                 );
             if (success != SEE_SUCCESS)
                 return success;
+            array->size++;
         }
     }
+    array->size = count;
     return success;
 }
 
@@ -374,6 +716,8 @@ array_insert(
     const SeeDynamicArrayClass* cls;
     cls = SEE_DYNAMIC_ARRAY_GET_CLASS(array);
 
+    ARRAY_CHECK_WRITABLE(array, error);
+
     if (pos > array->size) {
         see_index_error_new(error, pos);
         return SEE_ERROR_INDEX;
@@ -407,6 +751,27 @@ array_insert(
     return SEE_SUCCESS;
 }
 
+static int
+dynamic_array_next_span(
+    const SeeObject*    self,
+    size_t*             cursor,
+    SeeSpan*            span_out,
+    SeeError**          error_out
+    )
+{
+    (void) error_out;
+    const SeeDynamicArray* array = (const SeeDynamicArray*) self;
+    size_t start = *cursor < array->size ? *cursor : array->size;
+
+    // All elements are contiguous, so they fit in one span.
+    span_out->data      = ARRAY_ELEM_ADDRESS(array, start);
+    span_out->size      = array->size - start;
+    span_out->stride    = array->element_size;
+    *cursor             = array->size;
+
+    return SEE_SUCCESS;
+}
+
 /* **** implementation of the public API **** */
 
 int
@@ -477,6 +842,90 @@ see_dynamic_array_new_capacity(
     return ret;
 }
 
+int
+see_dynamic_array_new_aligned(
+    SeeDynamicArray**   array,
+    size_t              element_size,
+    see_copy_func       copy_func,
+    see_init_func       init_func,
+    see_free_func       free_func,
+    size_t              alignment,
+    SeeError**          error
+    )
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 ||
+        alignment % sizeof(void*) != 0)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = see_dynamic_array_new(
+        array,
+        element_size,
+        copy_func,
+        init_func,
+        free_func,
+        error
+        );
+
+    if (ret != SEE_SUCCESS)
+        return ret;
+
+    // The array is still empty, hence no storage needs to be moved.
+    (*array)->alignment = alignment;
+
+    return ret;
+}
+
+int
+see_dynamic_array_new_inline(
+    SeeDynamicArray**   array,
+    size_t              element_size,
+    see_copy_func       copy_func,
+    see_init_func       init_func,
+    see_free_func       free_func,
+    size_t              inline_capacity,
+    SeeError**          error
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(see_dynamic_array_class());
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!array || *array)
+        return SEE_INVALID_ARGUMENT;
+
+    if (element_size == 0)
+        return SEE_INVALID_ARGUMENT;
+
+    size_t offset = array_inline_offset(cls);
+    size_t n_bytes = element_size * inline_capacity;
+    if (inline_capacity != 0 &&
+        (n_bytes / inline_capacity != element_size || n_bytes + offset < offset)
+        ) {
+        see_runtime_error_new(error, EOVERFLOW);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    int ret = cls->new_obj(
+        cls,
+        offset + n_bytes,
+        (SeeObject**) array,
+        element_size,
+        copy_func,
+        init_func,
+        free_func,
+        error
+        );
+    if (ret != SEE_SUCCESS || inline_capacity == 0)
+        return ret;
+
+    (*array)->inline_capacity = inline_capacity;
+    (*array)->capacity        = inline_capacity;
+    (*array)->elements        = array_inline_storage(*array);
+
+    return ret;
+}
+
 size_t
 see_dynamic_array_size(const SeeDynamicArray* array)
 {
@@ -632,51 +1081,29 @@ see_dynamic_array_shuffle_range(
     SeeError**          error_out
     )
 {
-    int ret = SEE_SUCCESS;
-    size_t size = see_dynamic_array_size(array);
     if (!array || !error_out || *error_out)
         return SEE_INVALID_ARGUMENT;
 
-    if (end > size) {
+    ARRAY_CHECK_WRITABLE(array, error_out);
+
+    if (end > array->size) {
         see_index_error_new(error_out, end);
         return SEE_ERROR_INDEX;
     }
 
-    void* temp = malloc(array->element_size);
-    if (!temp) {
-        see_runtime_error_new(error_out, errno);
-        return SEE_ERROR_RUNTIME;
-    }
-
-    for (size_t i = start; i < end; i++) {
-        size_t rindex = see_random_uint64_range(rgen, i, end - 1);
-
-        array->copy_element(
-            temp,
-            ARRAY_ELEM_ADDRESS(array, rindex),
-            array->element_size
-            );
-        if (array->free_element)
-            array->free_element(ARRAY_ELEM_ADDRESS(array, rindex));
-
-        array->copy_element(
-            ARRAY_ELEM_ADDRESS(array, rindex),
-            ARRAY_ELEM_ADDRESS(array, i),
-            array->element_size
-            );
-        if (array->free_element)
-            array->free_element(ARRAY_ELEM_ADDRESS(array, i));
-
-        array->copy_element(
-            ARRAY_ELEM_ADDRESS(array, i),
-            temp,
-            array->element_size
-            );
-        if (array->free_element)
-            array->free_element(temp);
-    }
-    free(temp);
+    if (end <= start)
+        return SEE_SUCCESS;
 
+    // Shuffling only changes the positions of the elements, not their
+    // ownership, so the elements are moved bitwise like in array_insert.
+    int ret = see_random_shuffle(
+        rgen,
+        ARRAY_ELEM_ADDRESS(array, start),
+        end - start,
+        array->element_size
+        );
+    if (ret == SEE_ERROR_RUNTIME)
+        see_runtime_error_new(error_out, ENOMEM);
     return ret;
 }
 
@@ -693,6 +1120,104 @@ see_dynamic_array_shuffle(
     return see_dynamic_array_shuffle_range(array, 0, size, rgen, error_out);
 }
 
+int
+see_dynamic_array_save(
+    const SeeDynamicArray*  array,
+    const char*             path,
+    SeeError**              error_out
+    )
+{
+    array_file_header header;
+
+    if (!array || !path || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    // Only plain data can be restored from its bytes.
+    if (array->copy_element != memcpy)
+        return SEE_INVALID_ARGUMENT;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic));
+    header.version      = ARRAY_FILE_VERSION;
+    header.byte_order   = ARRAY_FILE_BYTE_ORDER;
+    header.element_size = array->element_size;
+    header.count        = array->size;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    size_t n_bytes = ARRAY_NUM_BYTES(array, array->size);
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && n_bytes)
+        ok = fwrite(array->elements, n_bytes, 1, file) == 1;
+    int errnum = errno;
+    if (fclose(file) != 0 && ok) {
+        ok = 0;
+        errnum = errno;
+    }
+
+    if (!ok) {
+        remove(path);
+        see_runtime_error_new(error_out, errnum);
+        return SEE_ERROR_RUNTIME;
+    }
+    return SEE_SUCCESS;
+}
+
+int
+see_dynamic_array_map(
+    SeeDynamicArray**   out,
+    const char*         path,
+    SeeError**          error_out
+    )
+{
+    void* mem = NULL;
+    size_t size = 0;
+    array_file_header header;
+    SeeDynamicArray* array = NULL;
+
+    if (!out || *out || !path || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    int errnum = array_file_map(path, &mem, &size);
+    if (!errnum) {
+        memcpy(&header, mem, sizeof(header));
+        errnum = array_file_check_header(&header, size);
+        if (errnum)
+            array_file_unmap(mem, size);
+    }
+    if (errnum) {
+        see_runtime_error_new(error_out, errnum);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    int ret = see_dynamic_array_new(
+        &array, (size_t) header.element_size, NULL, NULL, NULL, error_out
+        );
+    if (ret) {
+        array_file_unmap(mem, size);
+        return ret;
+    }
+
+    array->mapping      = mem;
+    array->mapping_size = size;
+    array->elements     = (char*) mem + sizeof(header);
+    array->size         = (size_t) header.count;
+    array->capacity     = (size_t) header.count;
+
+    *out = array;
+    return SEE_SUCCESS;
+}
+
+int
+see_dynamic_array_is_mapped(const SeeDynamicArray* array)
+{
+    return array && array->mapping != NULL;
+}
+
 /* **** initialization of the class **** */
 
 /**
@@ -708,6 +1233,7 @@ static int see_dynamic_array_class_init(SeeObjectClass* new_cls) {
     new_cls->init   = init;
     new_cls->destroy= dynamic_array_destroy;
     new_cls->copy   = see_dynamic_array_copy;
+    new_cls->next_span = dynamic_array_next_span;
 
     /* Set the function pointers of the own class here */
     SeeDynamicArrayClass* cls = (SeeDynamicArrayClass*) new_cls;
@@ -100,6 +100,33 @@ struct SeeDynamicArray {
      * @param element [in] a pointer to the element to be copied into the array.
      */
     void*       (*copy_element)(void* destination, const void* source, size_t n);
+
+    /**
+     * \brief The alignment in bytes of the storage of the elements, 0 when
+     * the default alignment of malloc is sufficient.
+     * \private
+     */
+    size_t      alignment;
+
+    /**
+     * \brief The number of elements that fit in the storage that is
+     * allocated together with the array, 0 if there is no such storage.
+     * \private
+     */
+    size_t      inline_capacity;
+
+    /**
+     * \brief The start of the memory mapped file that holds the elements,
+     * NULL when the elements are allocated on the heap.
+     * \private
+     */
+    void*       mapping;
+
+    /**
+     * \brief The number of bytes that are mapped.
+     * \private
+     */
+    size_t      mapping_size;
 };
 
 /**
@@ -410,6 +437,66 @@ see_dynamic_array_new_capacity(
     SeeError**          error
     );
 
+/**
+ * \brief create a new array whose elements are stored in memory with
+ * a given alignment.
+ *
+ * This is handy when the data of the array is processed with SIMD
+ * instructions, the first element starts at a multiple of alignment
+ * also after the array has grown.
+ *
+ * @param [out] out             see doc for "see_dynamic_array_new()"
+ * @param [in]  element_size    see doc for "see_dynamic_array_new()"
+ * @param [in]  copy_func       see doc for "see_dynamic_array_new()"
+ * @param [in]  init_func       see doc for "see_dynamic_array_new()"
+ * @param [in]  free_func       see doc for "see_dynamic_array_new()"
+ * @param [in]  alignment       The alignment in bytes, this must be a power
+ *                              of two and a multiple of sizeof(void*).
+ * @param [out] error           If an error occurs it will be returned here.
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT when the alignment isn't valid or
+ *         another value indicating what went wrong.
+ */
+SEE_EXPORT int
+see_dynamic_array_new_aligned(
+    SeeDynamicArray**   out,
+    size_t              element_size,
+    see_copy_func       copy_func,
+    see_init_func       init_func,
+    see_free_func       free_func,
+    size_t              alignment,
+    SeeError**          error
+    );
+
+/**
+ * \brief create a new array with room for a few elements inside the array
+ * itself.
+ *
+ * The storage for the first inline_capacity elements is allocated together
+ * with the array, so small arrays need just one allocation. When the array
+ * grows beyond inline_capacity the elements move to the heap, and
+ * see_dynamic_array_shrink_to_fit() moves them back when they fit again.
+ *
+ * @param [out] out             see doc for "see_dynamic_array_new()"
+ * @param [in]  element_size    see doc for "see_dynamic_array_new()"
+ * @param [in]  copy_func       see doc for "see_dynamic_array_new()"
+ * @param [in]  init_func       see doc for "see_dynamic_array_new()"
+ * @param [in]  free_func       see doc for "see_dynamic_array_new()"
+ * @param [in]  inline_capacity The number of elements that are stored
+ *                              inside of the array.
+ * @param [out] error           If an error occurs it will be returned here.
+ * @return SEE_SUCCESS or another value indicating what went wrong.
+ */
+SEE_EXPORT int
+see_dynamic_array_new_inline(
+    SeeDynamicArray**   out,
+    size_t              element_size,
+    see_copy_func       copy_func,
+    see_init_func       init_func,
+    see_free_func       free_func,
+    size_t              inline_capacity,
+    SeeError**          error
+    );
+
 /**
  * \brief return the current size of the array.
  * @param array
@@ -600,8 +687,11 @@ see_dynamic_array_insert(
 /**
  * \brief shuffle a sub selection of an array.
  *
- * Shuffles the array using the provided copy function. items in the
- * range [start, end) will be shuffled.
+ * Items in the range [start, end) will be shuffled. The elements are
+ * moved bitwise, hence the copy and free functions of the array are not
+ * used. See see_random_shuffle for how the random numbers are drawn; the
+ * permutation is reproducible for a generator with a fixed seed and large
+ * ranges are shuffled on multiple threads.
  *
  * @param [in,out] array The array to be shuffled
  * @param [in]     start The index of the start of the range
@@ -612,7 +702,7 @@ see_dynamic_array_insert(
  *                       you should provide your own.
  * @param [out]    error_out If an error occurres a message might provided here.
  *
- * @return SEE_SUCCESS, SEE_ERROR_INDEX
+ * @return SEE_SUCCESS, SEE_ERROR_INDEX, SEE_ERROR_RUNTIME
  */
 SEE_EXPORT int
 see_dynamic_array_shuffle_range(
@@ -629,7 +719,7 @@ see_dynamic_array_shuffle_range(
  * @param [in,out] rgen  A random generator, if NULL, the default global
  *                       random generator will be used. For thread safety
  *                       you should provide your own.
- * @return SEE_SUCCESS, SEE_ERROR_INDEX
+ * @return SEE_SUCCESS, SEE_ERROR_INDEX, SEE_ERROR_RUNTIME
  */
 SEE_EXPORT int
 see_dynamic_array_shuffle(
@@ -638,6 +728,64 @@ see_dynamic_array_shuffle(
     SeeError**       error_out
     );
 
+/**
+ * \brief Write the elements of the array to a file.
+ *
+ * The file starts with a small header that describes the size and
+ * number of the elements and the byte order of the machine, followed by
+ * the raw bytes of the elements. Hence this is only suitable for arrays
+ * of plain data, whose copy function is memcpy.
+ *
+ * @param [in]  array       The array to save, its copy function must be
+ *                          memcpy.
+ * @param [in]  path        The file to write, it is overwritten when it
+ *                          exists.
+ * @param [out] error_out   A runtime error when writing the file fails.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_dynamic_array_save(
+    const SeeDynamicArray*  array,
+    const char*             path,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Open a file written by see_dynamic_array_save() as a read only
+ * array.
+ *
+ * The file is mapped into memory, hence this takes constant time and only
+ * the pages that are touched are read from disk; the elements are 64 byte
+ * aligned. Every function that would modify the array returns
+ * SEE_ERROR_RUNTIME with EROFS, a copy obtained with see_object_copy()
+ * is an ordinary array that can be modified. On platforms without
+ * memory mapped files, the file is read into memory instead.
+ *
+ * @param [out] out         A pointer to a SeeDynamicArray* that is NULL.
+ * @param [in]  path        The file to open.
+ * @param [out] error_out   A runtime error when the file cannot be opened
+ *                          or isn't written by see_dynamic_array_save()
+ *                          on a machine with the same byte order (EINVAL).
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_dynamic_array_map(
+    SeeDynamicArray**   out,
+    const char*         path,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Check whether the array is backed by a file opened with
+ * see_dynamic_array_map(), such arrays cannot be modified.
+ *
+ * @return non zero when the array is memory mapped.
+ */
+SEE_EXPORT int
+see_dynamic_array_is_mapped(const SeeDynamicArray* array);
+
 /**
  * Gets the pointer to the SeeDynamicArrayClass table.
  */
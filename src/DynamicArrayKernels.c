@@ -0,0 +1,1379 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file DynamicArrayKernels.c
+ * \brief implements the reductions and searches over SeeDynamicArray data.
+ *
+ * Every instruction set provides a table with kernels, the table is selected
+ * once by see_dynamic_array_kernels_init(). Kernels only process whole
+ * vectors and leave the remainder to the scalar kernels.
+ *
+ * \private
+ */
+
+#include "see_object_config.h"
+#include <math.h>
+#include <string.h>
+#include "DynamicArrayKernels.h"
+#include "IndexError.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define SEE_KERNELS_X86 1
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define SEE_KERNELS_SSE2 1
+#   endif
+#   if defined(__GNUC__) || defined(_MSC_VER)
+#       define SEE_KERNELS_AVX2 1
+#   endif
+#   include <immintrin.h>
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define SEE_KERNELS_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__)
+#   define SEE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define SEE_TARGET_AVX2
+#endif
+
+/* **** the table with kernels for one instruction set **** */
+
+typedef struct see_kernels {
+    const char* isa;
+
+    int64_t (*sum_i32)(const int32_t* p, size_t n);
+    int64_t (*sum_i64)(const int64_t* p, size_t n);
+    double  (*sum_f32)(const float* p, size_t n);
+    double  (*sum_f64)(const double* p, size_t n);
+
+    // These may assume n > 0 and that p[0] is a number, the NaN's after it
+    // must be skipped.
+    void (*minmax_i32)(const int32_t* p, size_t n, int32_t* lo, int32_t* hi);
+    void (*minmax_i64)(const int64_t* p, size_t n, int64_t* lo, int64_t* hi);
+    void (*minmax_f32)(const float* p, size_t n, float* lo, float* hi);
+    void (*minmax_f64)(const double* p, size_t n, double* lo, double* hi);
+
+    size_t (*count_i32)(const int32_t* p, size_t n, int32_t v);
+    size_t (*count_i64)(const int64_t* p, size_t n, int64_t v);
+    size_t (*count_f32)(const float* p, size_t n, float v);
+    size_t (*count_f64)(const double* p, size_t n, double v);
+
+    // return n when v is not found.
+    size_t (*find_i32)(const int32_t* p, size_t n, int32_t v);
+    size_t (*find_i64)(const int64_t* p, size_t n, int64_t v);
+    size_t (*find_f32)(const float* p, size_t n, float v);
+    size_t (*find_f64)(const double* p, size_t n, double v);
+} see_kernels;
+
+/* **** bit helpers **** */
+
+static unsigned
+bit_count(unsigned mask)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_popcount(mask);
+#else
+    unsigned n = 0;
+    for (; mask; mask &= mask - 1)
+        n++;
+    return n;
+#endif
+}
+
+static unsigned
+first_bit(unsigned mask)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned n = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* **** scalar kernels **** */
+
+static int64_t
+scalar_sum_i32(const int32_t* p, size_t n)
+{
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += p[i];
+    return sum;
+}
+
+static int64_t
+scalar_sum_i64(const int64_t* p, size_t n)
+{
+    // unsigned arithmetic wraps instead of overflowing.
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += (uint64_t) p[i];
+    return (int64_t) sum;
+}
+
+static double
+scalar_sum_f32(const float* p, size_t n)
+{
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += p[i];
+    return sum;
+}
+
+static double
+scalar_sum_f64(const double* p, size_t n)
+{
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += p[i];
+    return sum;
+}
+
+#define SCALAR_MINMAX(name, T)                                              \
+static void                                                                 \
+name(const T* p, size_t n, T* lo_out, T* hi_out)                            \
+{                                                                           \
+    T lo = p[0], hi = p[0];                                                 \
+    for (size_t i = 1; i < n; i++) {                                        \
+        if (p[i] < lo)                                                      \
+            lo = p[i];                                                      \
+        if (p[i] > hi)                                                      \
+            hi = p[i];                                                      \
+    }                                                                       \
+    *lo_out = lo;                                                           \
+    *hi_out = hi;                                                           \
+}
+
+SCALAR_MINMAX(scalar_minmax_i32, int32_t)
+SCALAR_MINMAX(scalar_minmax_i64, int64_t)
+SCALAR_MINMAX(scalar_minmax_f32, float)
+SCALAR_MINMAX(scalar_minmax_f64, double)
+
+#define SCALAR_COUNT(name, T)                                               \
+static size_t                                                               \
+name(const T* p, size_t n, T v)                                             \
+{                                                                           \
+    size_t count = 0;                                                       \
+    for (size_t i = 0; i < n; i++)                                          \
+        count += p[i] == v;                                                 \
+    return count;                                                           \
+}
+
+SCALAR_COUNT(scalar_count_i32, int32_t)
+SCALAR_COUNT(scalar_count_i64, int64_t)
+SCALAR_COUNT(scalar_count_f32, float)
+SCALAR_COUNT(scalar_count_f64, double)
+
+#define SCALAR_FIND(name, T)                                                \
+static size_t                                                               \
+name(const T* p, size_t n, T v)                                             \
+{                                                                           \
+    for (size_t i = 0; i < n; i++)                                          \
+        if (p[i] == v)                                                      \
+            return i;                                                       \
+    return n;                                                               \
+}
+
+SCALAR_FIND(scalar_find_i32, int32_t)
+SCALAR_FIND(scalar_find_i64, int64_t)
+SCALAR_FIND(scalar_find_f32, float)
+SCALAR_FIND(scalar_find_f64, double)
+
+/**
+ * \brief Merge the elements that didn't fill a whole vector into the result
+ *        of a kernel. The comparisons are false for NaN, so NaN's are
+ *        skipped as long as lo and hi are numbers.
+ */
+#define MINMAX_TAIL(p, i, n, lo, hi)                                        \
+    do {                                                                    \
+        for (size_t tail = (i); tail < (n); tail++) {                       \
+            if ((p)[tail] < (lo))                                           \
+                (lo) = (p)[tail];                                           \
+            if ((p)[tail] > (hi))                                           \
+                (hi) = (p)[tail];                                           \
+        }                                                                   \
+    } while (0)
+
+static const see_kernels g_scalar_kernels = {
+    .isa        = "scalar",
+    .sum_i32    = scalar_sum_i32,
+    .sum_i64    = scalar_sum_i64,
+    .sum_f32    = scalar_sum_f32,
+    .sum_f64    = scalar_sum_f64,
+    .minmax_i32 = scalar_minmax_i32,
+    .minmax_i64 = scalar_minmax_i64,
+    .minmax_f32 = scalar_minmax_f32,
+    .minmax_f64 = scalar_minmax_f64,
+    .count_i32  = scalar_count_i32,
+    .count_i64  = scalar_count_i64,
+    .count_f32  = scalar_count_f32,
+    .count_f64  = scalar_count_f64,
+    .find_i32   = scalar_find_i32,
+    .find_i64   = scalar_find_i64,
+    .find_f32   = scalar_find_f32,
+    .find_f64   = scalar_find_f64
+};
+
+/* **** SSE2 kernels **** */
+
+#if defined(SEE_KERNELS_SSE2)
+
+static int64_t
+sse2_sum_i32(const int32_t* p, size_t n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    int64_t lanes[2];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (p + i));
+        // sign extend to 64 bits.
+        __m128i sign = _mm_cmpgt_epi32(zero, v);
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(v, sign));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(v, sign));
+    }
+    _mm_storeu_si128((__m128i*) lanes, _mm_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + scalar_sum_i32(p + i, n - i);
+}
+
+static int64_t
+sse2_sum_i64(const int64_t* p, size_t n)
+{
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    uint64_t lanes[2];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_epi64(acc0, _mm_loadu_si128((const __m128i*) (p + i)));
+        acc1 = _mm_add_epi64(acc1, _mm_loadu_si128((const __m128i*) (p + i + 2)));
+    }
+    _mm_storeu_si128((__m128i*) lanes, _mm_add_epi64(acc0, acc1));
+    return (int64_t) (
+        lanes[0] + lanes[1] + (uint64_t) scalar_sum_i64(p + i, n - i)
+        );
+}
+
+static double
+sse2_sum_f32(const float* p, size_t n)
+{
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    double lanes[2];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + scalar_sum_f32(p + i, n - i);
+}
+
+static double
+sse2_sum_f64(const double* p, size_t n)
+{
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    double lanes[2];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(p + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(p + i + 2));
+    }
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + scalar_sum_f64(p + i, n - i);
+}
+
+static void
+sse2_minmax_i32(const int32_t* p, size_t n, int32_t* lo_out, int32_t* hi_out)
+{
+    __m128i lo = _mm_set1_epi32(p[0]), hi = lo;
+    int32_t lanes_lo[4], lanes_hi[4];
+    size_t i = 0;
+
+    // SSE2 has no pminsd, so select with masks.
+    for (; i + 4 <= n; i += 4) {
+        __m128i v  = _mm_loadu_si128((const __m128i*) (p + i));
+        __m128i lt = _mm_cmplt_epi32(v, lo);
+        __m128i gt = _mm_cmpgt_epi32(v, hi);
+        lo = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, lo));
+        hi = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, hi));
+    }
+    _mm_storeu_si128((__m128i*) lanes_lo, lo);
+    _mm_storeu_si128((__m128i*) lanes_hi, hi);
+
+    int32_t rlo = lanes_lo[0], rhi = lanes_hi[0];
+    for (int j = 1; j < 4; j++) {
+        rlo = lanes_lo[j] < rlo ? lanes_lo[j] : rlo;
+        rhi = lanes_hi[j] > rhi ? lanes_hi[j] : rhi;
+    }
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+/*
+ * minps returns its second operand when one of them is NaN, so with the
+ * loaded values first, NaN's are skipped.
+ */
+static void
+sse2_minmax_f32(const float* p, size_t n, float* lo_out, float* hi_out)
+{
+    __m128 lo = _mm_set1_ps(p[0]), hi = lo;
+    float lanes_lo[4], lanes_hi[4];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+        lo = _mm_min_ps(v, lo);
+        hi = _mm_max_ps(v, hi);
+    }
+    _mm_storeu_ps(lanes_lo, lo);
+    _mm_storeu_ps(lanes_hi, hi);
+
+    float rlo = lanes_lo[0], rhi = lanes_hi[0];
+    for (int j = 1; j < 4; j++) {
+        rlo = lanes_lo[j] < rlo ? lanes_lo[j] : rlo;
+        rhi = lanes_hi[j] > rhi ? lanes_hi[j] : rhi;
+    }
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+static void
+sse2_minmax_f64(const double* p, size_t n, double* lo_out, double* hi_out)
+{
+    __m128d lo = _mm_set1_pd(p[0]), hi = lo;
+    double lanes_lo[2], lanes_hi[2];
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(p + i);
+        lo = _mm_min_pd(v, lo);
+        hi = _mm_max_pd(v, hi);
+    }
+    _mm_storeu_pd(lanes_lo, lo);
+    _mm_storeu_pd(lanes_hi, hi);
+
+    double rlo = lanes_lo[1] < lanes_lo[0] ? lanes_lo[1] : lanes_lo[0];
+    double rhi = lanes_hi[1] > lanes_hi[0] ? lanes_hi[1] : lanes_hi[0];
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+/**
+ * \brief SSE2 has no 64 bit compare, two 64 bit integers are equal when both
+ *        32 bit halves are equal.
+ */
+static __m128i
+sse2_cmpeq_epi64(__m128i a, __m128i b)
+{
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static size_t
+sse2_count_i32(const int32_t* p, size_t n, int32_t v)
+{
+    const __m128i k = _mm_set1_epi32(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (p + i)), k);
+        count += bit_count((unsigned) _mm_movemask_ps(_mm_castsi128_ps(eq)));
+    }
+    return count + scalar_count_i32(p + i, n - i, v);
+}
+
+static size_t
+sse2_count_i64(const int64_t* p, size_t n, int64_t v)
+{
+    const __m128i k = _mm_set1_epi64x(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i eq = sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i*) (p + i)), k);
+        count += bit_count((unsigned) _mm_movemask_pd(_mm_castsi128_pd(eq)));
+    }
+    return count + scalar_count_i64(p + i, n - i, v);
+}
+
+static size_t
+sse2_count_f32(const float* p, size_t n, float v)
+{
+    const __m128 k = _mm_set1_ps(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(p + i), k);
+        count += bit_count((unsigned) _mm_movemask_ps(eq));
+    }
+    return count + scalar_count_f32(p + i, n - i, v);
+}
+
+static size_t
+sse2_count_f64(const double* p, size_t n, double v)
+{
+    const __m128d k = _mm_set1_pd(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(p + i), k);
+        count += bit_count((unsigned) _mm_movemask_pd(eq));
+    }
+    return count + scalar_count_f64(p + i, n - i, v);
+}
+
+static size_t
+sse2_find_i32(const int32_t* p, size_t n, int32_t v)
+{
+    const __m128i k = _mm_set1_epi32(v);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (p + i)), k);
+        unsigned mask = (unsigned) _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_i32(p + i, n - i, v);
+}
+
+static size_t
+sse2_find_i64(const int64_t* p, size_t n, int64_t v)
+{
+    const __m128i k = _mm_set1_epi64x(v);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i eq = sse2_cmpeq_epi64(_mm_loadu_si128((const __m128i*) (p + i)), k);
+        unsigned mask = (unsigned) _mm_movemask_pd(_mm_castsi128_pd(eq));
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_i64(p + i, n - i, v);
+}
+
+static size_t
+sse2_find_f32(const float* p, size_t n, float v)
+{
+    const __m128 k = _mm_set1_ps(v);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        unsigned mask = (unsigned) _mm_movemask_ps(
+            _mm_cmpeq_ps(_mm_loadu_ps(p + i), k)
+            );
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_f32(p + i, n - i, v);
+}
+
+static size_t
+sse2_find_f64(const double* p, size_t n, double v)
+{
+    const __m128d k = _mm_set1_pd(v);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        unsigned mask = (unsigned) _mm_movemask_pd(
+            _mm_cmpeq_pd(_mm_loadu_pd(p + i), k)
+            );
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_f64(p + i, n - i, v);
+}
+
+static const see_kernels g_sse2_kernels = {
+    .isa        = "sse2",
+    .sum_i32    = sse2_sum_i32,
+    .sum_i64    = sse2_sum_i64,
+    .sum_f32    = sse2_sum_f32,
+    .sum_f64    = sse2_sum_f64,
+    .minmax_i32 = sse2_minmax_i32,
+    .minmax_i64 = scalar_minmax_i64, // needs SSE4.2 for a 64 bit compare
+    .minmax_f32 = sse2_minmax_f32,
+    .minmax_f64 = sse2_minmax_f64,
+    .count_i32  = sse2_count_i32,
+    .count_i64  = sse2_count_i64,
+    .count_f32  = sse2_count_f32,
+    .count_f64  = sse2_count_f64,
+    .find_i32   = sse2_find_i32,
+    .find_i64   = sse2_find_i64,
+    .find_f32   = sse2_find_f32,
+    .find_f64   = sse2_find_f64
+};
+
+#endif // defined(SEE_KERNELS_SSE2)
+
+/* **** AVX2 kernels **** */
+
+#if defined(SEE_KERNELS_AVX2)
+
+SEE_TARGET_AVX2 static int64_t
+avx2_sum_i32(const int32_t* p, size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    int64_t lanes[4];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (p + i));
+        acc0 = _mm256_add_epi64(
+            acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v))
+            );
+        acc1 = _mm256_add_epi64(
+            acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1))
+            );
+    }
+    _mm256_storeu_si256((__m256i*) lanes, _mm256_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           scalar_sum_i32(p + i, n - i);
+}
+
+SEE_TARGET_AVX2 static int64_t
+avx2_sum_i64(const int64_t* p, size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    uint64_t lanes[4];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256((const __m256i*) (p + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256((const __m256i*) (p + i + 4)));
+    }
+    _mm256_storeu_si256((__m256i*) lanes, _mm256_add_epi64(acc0, acc1));
+    return (int64_t) (
+        lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+        (uint64_t) scalar_sum_i64(p + i, n - i)
+        );
+}
+
+SEE_TARGET_AVX2 static double
+avx2_sum_f32(const float* p, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    double lanes[4];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(p + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4)));
+    }
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           scalar_sum_f32(p + i, n - i);
+}
+
+SEE_TARGET_AVX2 static double
+avx2_sum_f64(const double* p, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    double lanes[4];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(p + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(p + i + 4));
+    }
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           scalar_sum_f64(p + i, n - i);
+}
+
+SEE_TARGET_AVX2 static void
+avx2_minmax_i32(const int32_t* p, size_t n, int32_t* lo_out, int32_t* hi_out)
+{
+    __m256i lo = _mm256_set1_epi32(p[0]), hi = lo;
+    int32_t lanes_lo[8], lanes_hi[8];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (p + i));
+        lo = _mm256_min_epi32(lo, v);
+        hi = _mm256_max_epi32(hi, v);
+    }
+    _mm256_storeu_si256((__m256i*) lanes_lo, lo);
+    _mm256_storeu_si256((__m256i*) lanes_hi, hi);
+
+    int32_t rlo = lanes_lo[0], rhi = lanes_hi[0];
+    for (int j = 1; j < 8; j++) {
+        rlo = lanes_lo[j] < rlo ? lanes_lo[j] : rlo;
+        rhi = lanes_hi[j] > rhi ? lanes_hi[j] : rhi;
+    }
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+SEE_TARGET_AVX2 static void
+avx2_minmax_i64(const int64_t* p, size_t n, int64_t* lo_out, int64_t* hi_out)
+{
+    __m256i lo = _mm256_set1_epi64x(p[0]), hi = lo;
+    int64_t lanes_lo[4], lanes_hi[4];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (p + i));
+        lo = _mm256_blendv_epi8(lo, v, _mm256_cmpgt_epi64(lo, v));
+        hi = _mm256_blendv_epi8(hi, v, _mm256_cmpgt_epi64(v, hi));
+    }
+    _mm256_storeu_si256((__m256i*) lanes_lo, lo);
+    _mm256_storeu_si256((__m256i*) lanes_hi, hi);
+
+    int64_t rlo = lanes_lo[0], rhi = lanes_hi[0];
+    for (int j = 1; j < 4; j++) {
+        rlo = lanes_lo[j] < rlo ? lanes_lo[j] : rlo;
+        rhi = lanes_hi[j] > rhi ? lanes_hi[j] : rhi;
+    }
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+SEE_TARGET_AVX2 static void
+avx2_minmax_f32(const float* p, size_t n, float* lo_out, float* hi_out)
+{
+    __m256 lo = _mm256_set1_ps(p[0]), hi = lo;
+    float lanes_lo[8], lanes_hi[8];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(p + i);
+        lo = _mm256_min_ps(v, lo);
+        hi = _mm256_max_ps(v, hi);
+    }
+    _mm256_storeu_ps(lanes_lo, lo);
+    _mm256_storeu_ps(lanes_hi, hi);
+
+    float rlo = lanes_lo[0], rhi = lanes_hi[0];
+    for (int j = 1; j < 8; j++) {
+        rlo = lanes_lo[j] < rlo ? lanes_lo[j] : rlo;
+        rhi = lanes_hi[j] > rhi ? lanes_hi[j] : rhi;
+    }
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+SEE_TARGET_AVX2 static void
+avx2_minmax_f64(const double* p, size_t n, double* lo_out, double* hi_out)
+{
+    __m256d lo = _mm256_set1_pd(p[0]), hi = lo;
+    double lanes_lo[4], lanes_hi[4];
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(p + i);
+        lo = _mm256_min_pd(v, lo);
+        hi = _mm256_max_pd(v, hi);
+    }
+    _mm256_storeu_pd(lanes_lo, lo);
+    _mm256_storeu_pd(lanes_hi, hi);
+
+    double rlo = lanes_lo[0], rhi = lanes_hi[0];
+    for (int j = 1; j < 4; j++) {
+        rlo = lanes_lo[j] < rlo ? lanes_lo[j] : rlo;
+        rhi = lanes_hi[j] > rhi ? lanes_hi[j] : rhi;
+    }
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_count_i32(const int32_t* p, size_t n, int32_t v)
+{
+    const __m256i k = _mm256_set1_epi32(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256((const __m256i*) (p + i)), k
+            );
+        count += bit_count((unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+    }
+    return count + scalar_count_i32(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_count_i64(const int64_t* p, size_t n, int64_t v)
+{
+    const __m256i k = _mm256_set1_epi64x(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(
+            _mm256_loadu_si256((const __m256i*) (p + i)), k
+            );
+        count += bit_count((unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+    }
+    return count + scalar_count_i64(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_count_f32(const float* p, size_t n, float v)
+{
+    const __m256 k = _mm256_set1_ps(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(p + i), k, _CMP_EQ_OQ);
+        count += bit_count((unsigned) _mm256_movemask_ps(eq));
+    }
+    return count + scalar_count_f32(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_count_f64(const double* p, size_t n, double v)
+{
+    const __m256d k = _mm256_set1_pd(v);
+    size_t count = 0, i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(p + i), k, _CMP_EQ_OQ);
+        count += bit_count((unsigned) _mm256_movemask_pd(eq));
+    }
+    return count + scalar_count_f64(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_find_i32(const int32_t* p, size_t n, int32_t v)
+{
+    const __m256i k = _mm256_set1_epi32(v);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256((const __m256i*) (p + i)), k
+            );
+        unsigned mask = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_i32(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_find_i64(const int64_t* p, size_t n, int64_t v)
+{
+    const __m256i k = _mm256_set1_epi64x(v);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(
+            _mm256_loadu_si256((const __m256i*) (p + i)), k
+            );
+        unsigned mask = (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_i64(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_find_f32(const float* p, size_t n, float v)
+{
+    const __m256 k = _mm256_set1_ps(v);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        unsigned mask = (unsigned) _mm256_movemask_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(p + i), k, _CMP_EQ_OQ)
+            );
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_f32(p + i, n - i, v);
+}
+
+SEE_TARGET_AVX2 static size_t
+avx2_find_f64(const double* p, size_t n, double v)
+{
+    const __m256d k = _mm256_set1_pd(v);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        unsigned mask = (unsigned) _mm256_movemask_pd(
+            _mm256_cmp_pd(_mm256_loadu_pd(p + i), k, _CMP_EQ_OQ)
+            );
+        if (mask)
+            return i + first_bit(mask);
+    }
+    return i + scalar_find_f64(p + i, n - i, v);
+}
+
+static const see_kernels g_avx2_kernels = {
+    .isa        = "avx2",
+    .sum_i32    = avx2_sum_i32,
+    .sum_i64    = avx2_sum_i64,
+    .sum_f32    = avx2_sum_f32,
+    .sum_f64    = avx2_sum_f64,
+    .minmax_i32 = avx2_minmax_i32,
+    .minmax_i64 = avx2_minmax_i64,
+    .minmax_f32 = avx2_minmax_f32,
+    .minmax_f64 = avx2_minmax_f64,
+    .count_i32  = avx2_count_i32,
+    .count_i64  = avx2_count_i64,
+    .count_f32  = avx2_count_f32,
+    .count_f64  = avx2_count_f64,
+    .find_i32   = avx2_find_i32,
+    .find_i64   = avx2_find_i64,
+    .find_f32   = avx2_find_f32,
+    .find_f64   = avx2_find_f64
+};
+
+static int
+cpu_has_avx2(void)
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+
+    // The OS must save the ymm registers.
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))
+        return 0;
+    if ((_xgetbv(0) & 6) != 6)
+        return 0;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return 0;
+#endif
+}
+
+#endif // defined(SEE_KERNELS_AVX2)
+
+/* **** NEON kernels **** */
+
+#if defined(SEE_KERNELS_NEON)
+
+static int64_t
+neon_sum_i32(const int32_t* p, size_t n)
+{
+    int64x2_t acc0 = vdupq_n_s64(0), acc1 = vdupq_n_s64(0);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vpadalq_s32(acc0, vld1q_s32(p + i));
+        acc1 = vpadalq_s32(acc1, vld1q_s32(p + i + 4));
+    }
+    return vaddvq_s64(vaddq_s64(acc0, acc1)) + scalar_sum_i32(p + i, n - i);
+}
+
+static int64_t
+neon_sum_i64(const int64_t* p, size_t n)
+{
+    uint64x2_t acc0 = vdupq_n_u64(0), acc1 = vdupq_n_u64(0);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 = vaddq_u64(acc0, vld1q_u64((const uint64_t*) (p + i)));
+        acc1 = vaddq_u64(acc1, vld1q_u64((const uint64_t*) (p + i + 2)));
+    }
+    return (int64_t) (
+        vaddvq_u64(vaddq_u64(acc0, acc1)) +
+        (uint64_t) scalar_sum_i64(p + i, n - i)
+        );
+}
+
+static double
+neon_sum_f32(const float* p, size_t n)
+{
+    float64x2_t acc0 = vdupq_n_f64(0), acc1 = vdupq_n_f64(0);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(p + i);
+        acc0 = vaddq_f64(acc0, vcvt_f64_f32(vget_low_f32(v)));
+        acc1 = vaddq_f64(acc1, vcvt_high_f64_f32(v));
+    }
+    return vaddvq_f64(vaddq_f64(acc0, acc1)) + scalar_sum_f32(p + i, n - i);
+}
+
+static double
+neon_sum_f64(const double* p, size_t n)
+{
+    float64x2_t acc0 = vdupq_n_f64(0), acc1 = vdupq_n_f64(0);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 = vaddq_f64(acc0, vld1q_f64(p + i));
+        acc1 = vaddq_f64(acc1, vld1q_f64(p + i + 2));
+    }
+    return vaddvq_f64(vaddq_f64(acc0, acc1)) + scalar_sum_f64(p + i, n - i);
+}
+
+static void
+neon_minmax_i32(const int32_t* p, size_t n, int32_t* lo_out, int32_t* hi_out)
+{
+    int32x4_t lo = vdupq_n_s32(p[0]), hi = lo;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t v = vld1q_s32(p + i);
+        lo = vminq_s32(lo, v);
+        hi = vmaxq_s32(hi, v);
+    }
+    int32_t rlo = vminvq_s32(lo), rhi = vmaxvq_s32(hi);
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+static void
+neon_minmax_i64(const int64_t* p, size_t n, int64_t* lo_out, int64_t* hi_out)
+{
+    int64x2_t lo = vdupq_n_s64(p[0]), hi = lo;
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        int64x2_t v = vld1q_s64(p + i);
+        lo = vbslq_s64(vcgtq_s64(lo, v), v, lo);
+        hi = vbslq_s64(vcgtq_s64(v, hi), v, hi);
+    }
+    int64_t lo0 = vgetq_lane_s64(lo, 0), lo1 = vgetq_lane_s64(lo, 1);
+    int64_t hi0 = vgetq_lane_s64(hi, 0), hi1 = vgetq_lane_s64(hi, 1);
+    int64_t rlo = lo1 < lo0 ? lo1 : lo0;
+    int64_t rhi = hi1 > hi0 ? hi1 : hi0;
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+// The IEEE minNum and maxNum instructions skip NaN's.
+static void
+neon_minmax_f32(const float* p, size_t n, float* lo_out, float* hi_out)
+{
+    float32x4_t lo = vdupq_n_f32(p[0]), hi = lo;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(p + i);
+        lo = vminnmq_f32(lo, v);
+        hi = vmaxnmq_f32(hi, v);
+    }
+    float rlo = vminnmvq_f32(lo), rhi = vmaxnmvq_f32(hi);
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+static void
+neon_minmax_f64(const double* p, size_t n, double* lo_out, double* hi_out)
+{
+    float64x2_t lo = vdupq_n_f64(p[0]), hi = lo;
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t v = vld1q_f64(p + i);
+        lo = vminnmq_f64(lo, v);
+        hi = vmaxnmq_f64(hi, v);
+    }
+    double rlo = vminnmvq_f64(lo), rhi = vmaxnmvq_f64(hi);
+    MINMAX_TAIL(p, i, n, rlo, rhi);
+    *lo_out = rlo;
+    *hi_out = rhi;
+}
+
+static size_t
+neon_count_i32(const int32_t* p, size_t n, int32_t v)
+{
+    const int32x4_t k = vdupq_n_s32(v);
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t eq = vceqq_s32(vld1q_s32(p + i), k);
+        acc = vpadalq_u32(acc, vshrq_n_u32(eq, 31));
+    }
+    return vaddvq_u64(acc) + scalar_count_i32(p + i, n - i, v);
+}
+
+static size_t
+neon_count_i64(const int64_t* p, size_t n, int64_t v)
+{
+    const int64x2_t k = vdupq_n_s64(v);
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t eq = vceqq_s64(vld1q_s64(p + i), k);
+        acc = vaddq_u64(acc, vshrq_n_u64(eq, 63));
+    }
+    return vaddvq_u64(acc) + scalar_count_i64(p + i, n - i, v);
+}
+
+static size_t
+neon_count_f32(const float* p, size_t n, float v)
+{
+    const float32x4_t k = vdupq_n_f32(v);
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t eq = vceqq_f32(vld1q_f32(p + i), k);
+        acc = vpadalq_u32(acc, vshrq_n_u32(eq, 31));
+    }
+    return vaddvq_u64(acc) + scalar_count_f32(p + i, n - i, v);
+}
+
+static size_t
+neon_count_f64(const double* p, size_t n, double v)
+{
+    const float64x2_t k = vdupq_n_f64(v);
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t eq = vceqq_f64(vld1q_f64(p + i), k);
+        acc = vaddq_u64(acc, vshrq_n_u64(eq, 63));
+    }
+    return vaddvq_u64(acc) + scalar_count_f64(p + i, n - i, v);
+}
+
+static size_t
+neon_find_i32(const int32_t* p, size_t n, int32_t v)
+{
+    const int32x4_t k = vdupq_n_s32(v);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        if (vmaxvq_u32(vceqq_s32(vld1q_s32(p + i), k)))
+            return i + scalar_find_i32(p + i, 4, v);
+    }
+    return i + scalar_find_i32(p + i, n - i, v);
+}
+
+static size_t
+neon_find_i64(const int64_t* p, size_t n, int64_t v)
+{
+    const int64x2_t k = vdupq_n_s64(v);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t eq = vceqq_s64(vld1q_s64(p + i), k);
+        if (vmaxvq_u32(vreinterpretq_u32_u64(eq)))
+            return i + scalar_find_i64(p + i, 2, v);
+    }
+    return i + scalar_find_i64(p + i, n - i, v);
+}
+
+static size_t
+neon_find_f32(const float* p, size_t n, float v)
+{
+    const float32x4_t k = vdupq_n_f32(v);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        if (vmaxvq_u32(vceqq_f32(vld1q_f32(p + i), k)))
+            return i + scalar_find_f32(p + i, 4, v);
+    }
+    return i + scalar_find_f32(p + i, n - i, v);
+}
+
+static size_t
+neon_find_f64(const double* p, size_t n, double v)
+{
+    const float64x2_t k = vdupq_n_f64(v);
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t eq = vceqq_f64(vld1q_f64(p + i), k);
+        if (vmaxvq_u32(vreinterpretq_u32_u64(eq)))
+            return i + scalar_find_f64(p + i, 2, v);
+    }
+    return i + scalar_find_f64(p + i, n - i, v);
+}
+
+static const see_kernels g_neon_kernels = {
+    .isa        = "neon",
+    .sum_i32    = neon_sum_i32,
+    .sum_i64    = neon_sum_i64,
+    .sum_f32    = neon_sum_f32,
+    .sum_f64    = neon_sum_f64,
+    .minmax_i32 = neon_minmax_i32,
+    .minmax_i64 = neon_minmax_i64,
+    .minmax_f32 = neon_minmax_f32,
+    .minmax_f64 = neon_minmax_f64,
+    .count_i32  = neon_count_i32,
+    .count_i64  = neon_count_i64,
+    .count_f32  = neon_count_f32,
+    .count_f64  = neon_count_f64,
+    .find_i32   = neon_find_i32,
+    .find_i64   = neon_find_i64,
+    .find_f32   = neon_find_f32,
+    .find_f64   = neon_find_f64
+};
+
+#endif // defined(SEE_KERNELS_NEON)
+
+/* **** selection of the kernels **** */
+
+static const see_kernels* g_kernels = &g_scalar_kernels;
+
+int
+see_dynamic_array_kernels_init()
+{
+    const see_kernels* selected = &g_scalar_kernels;
+
+#if defined(SEE_KERNELS_SSE2)
+    selected = &g_sse2_kernels;
+#endif
+#if defined(SEE_KERNELS_AVX2)
+    if (cpu_has_avx2())
+        selected = &g_avx2_kernels;
+#endif
+#if defined(SEE_KERNELS_NEON)
+    selected = &g_neon_kernels;
+#endif
+
+    g_kernels = selected;
+    return SEE_SUCCESS;
+}
+
+const char*
+see_dynamic_array_kernels_isa()
+{
+    return g_kernels->isa;
+}
+
+int
+see_dynamic_array_kernels_select(const char* isa)
+{
+    const see_kernels* available[4];
+    size_t n = 0;
+
+    if (!isa)
+        return SEE_INVALID_ARGUMENT;
+
+    available[n++] = &g_scalar_kernels;
+#if defined(SEE_KERNELS_SSE2)
+    available[n++] = &g_sse2_kernels;
+#endif
+#if defined(SEE_KERNELS_AVX2)
+    if (cpu_has_avx2())
+        available[n++] = &g_avx2_kernels;
+#endif
+#if defined(SEE_KERNELS_NEON)
+    available[n++] = &g_neon_kernels;
+#endif
+
+    for (size_t i = 0; i < n; i++) {
+        if (strcmp(available[i]->isa, isa) == 0) {
+            g_kernels = available[i];
+            return SEE_SUCCESS;
+        }
+    }
+    return SEE_INVALID_ARGUMENT;
+}
+
+/* **** implementation of the public API **** */
+
+/**
+ * \brief Check the arguments of the public functions below.
+ */
+#define CHECK_ARRAY(array, T, error_out)                                    \
+    do {                                                                    \
+        if (!(array) || !(error_out) || *(error_out))                       \
+            return SEE_INVALID_ARGUMENT;                                    \
+        if ((array)->element_size != sizeof(T))                             \
+            return SEE_INVALID_ARGUMENT;                                    \
+    } while (0)
+
+#define DEFINE_SUM(suffix, T, ACC, kernel)                                  \
+int                                                                         \
+see_dynamic_array_sum_##suffix(                                             \
+    const SeeDynamicArray*  array,                                          \
+    ACC*                    sum_out,                                        \
+    SeeError**              error_out                                       \
+    )                                                                       \
+{                                                                           \
+    CHECK_ARRAY(array, T, error_out);                                       \
+    if (!sum_out)                                                           \
+        return SEE_INVALID_ARGUMENT;                                        \
+                                                                            \
+    *sum_out = g_kernels->kernel(                                           \
+        (const T*) array->elements, array->size                             \
+        );                                                                  \
+    return SEE_SUCCESS;                                                     \
+}
+
+DEFINE_SUM(int32,   int32_t,    int64_t,    sum_i32)
+DEFINE_SUM(int64,   int64_t,    int64_t,    sum_i64)
+DEFINE_SUM(float,   float,      double,     sum_f32)
+DEFINE_SUM(double,  double,     double,     sum_f64)
+
+/*
+ * The kernels need a number to start from, so leading NaN's are skipped
+ * here. Returns n when there are only NaN's.
+ */
+static size_t
+first_number_int32(const int32_t* p, size_t n)
+{
+    (void) p;
+    (void) n;
+    return 0;
+}
+
+static size_t
+first_number_int64(const int64_t* p, size_t n)
+{
+    (void) p;
+    (void) n;
+    return 0;
+}
+
+static size_t
+first_number_float(const float* p, size_t n)
+{
+    size_t i = 0;
+    while (i < n && isnan(p[i]))
+        i++;
+    return i;
+}
+
+static size_t
+first_number_double(const double* p, size_t n)
+{
+    size_t i = 0;
+    while (i < n && isnan(p[i]))
+        i++;
+    return i;
+}
+
+#define DEFINE_MINMAX(suffix, T, kernel)                                    \
+int                                                                         \
+see_dynamic_array_minmax_##suffix(                                          \
+    const SeeDynamicArray*  array,                                          \
+    T*                      min_out,                                        \
+    T*                      max_out,                                        \
+    SeeError**              error_out                                       \
+    )                                                                       \
+{                                                                           \
+    CHECK_ARRAY(array, T, error_out);                                       \
+    if (!min_out || !max_out)                                               \
+        return SEE_INVALID_ARGUMENT;                                        \
+                                                                            \
+    if (array->size == 0) {                                                 \
+        see_index_error_new(error_out, 0);                                  \
+        return SEE_ERROR_INDEX;                                             \
+    }                                                                       \
+    const T* data = (const T*) array->elements;                             \
+    size_t start = first_number_##suffix(data, array->size);                \
+    if (start == array->size) {                                             \
+        *min_out = *max_out = data[0];                                      \
+        return SEE_SUCCESS;                                                 \
+    }                                                                       \
+    g_kernels->kernel(data + start, array->size - start, min_out, max_out); \
+    return SEE_SUCCESS;                                                     \
+}
+
+DEFINE_MINMAX(int32,    int32_t,    minmax_i32)
+DEFINE_MINMAX(int64,    int64_t,    minmax_i64)
+DEFINE_MINMAX(float,    float,      minmax_f32)
+DEFINE_MINMAX(double,   double,     minmax_f64)
+
+/*
+ * The arg functions look for the extreme value first and search for its
+ * first occurrence afterwards, both passes are vectorized. The elements
+ * before start are NaN's, so the extreme value isn't among them.
+ */
+#define DEFINE_ARG(name, suffix, T, minmax, find, use_min)                  \
+int                                                                         \
+see_dynamic_array_##name##_##suffix(                                        \
+    const SeeDynamicArray*  array,                                          \
+    size_t*                 index_out,                                      \
+    SeeError**              error_out                                       \
+    )                                                                       \
+{                                                                           \
+    T lo, hi;                                                               \
+    CHECK_ARRAY(array, T, error_out);                                       \
+    if (!index_out)                                                         \
+        return SEE_INVALID_ARGUMENT;                                        \
+                                                                            \
+    const T* data = (const T*) array->elements;                             \
+    size_t start = first_number_##suffix(data, array->size);                \
+    if (start == array->size) {                                             \
+        see_index_error_new(error_out, 0);                                  \
+        return SEE_ERROR_INDEX;                                             \
+    }                                                                       \
+    size_t n = array->size - start;                                         \
+    g_kernels->minmax(data + start, n, &lo, &hi);                           \
+    *index_out = start +                                                    \
+        g_kernels->find(data + start, n, use_min ? lo : hi);                \
+    return SEE_SUCCESS;                                                     \
+}
+
+DEFINE_ARG(argmin, int32,   int32_t,    minmax_i32, find_i32, 1)
+DEFINE_ARG(argmin, int64,   int64_t,    minmax_i64, find_i64, 1)
+DEFINE_ARG(argmin, float,   float,      minmax_f32, find_f32, 1)
+DEFINE_ARG(argmin, double,  double,     minmax_f64, find_f64, 1)
+DEFINE_ARG(argmax, int32,   int32_t,    minmax_i32, find_i32, 0)
+DEFINE_ARG(argmax, int64,   int64_t,    minmax_i64, find_i64, 0)
+DEFINE_ARG(argmax, float,   float,      minmax_f32, find_f32, 0)
+DEFINE_ARG(argmax, double,  double,     minmax_f64, find_f64, 0)
+
+#define DEFINE_SEARCH(name, suffix, T, kernel)                              \
+int                                                                         \
+see_dynamic_array_##name##_##suffix(                                        \
+    const SeeDynamicArray*  array,                                          \
+    T                       value,                                          \
+    size_t*                 result_out,                                     \
+    SeeError**              error_out                                       \
+    )                                                                       \
+{                                                                           \
+    CHECK_ARRAY(array, T, error_out);                                       \
+    if (!result_out)                                                        \
+        return SEE_INVALID_ARGUMENT;                                        \
+                                                                            \
+    *result_out = g_kernels->kernel(                                        \
+        (const T*) array->elements, array->size, value                      \
+        );                                                                  \
+    return SEE_SUCCESS;                                                     \
+}
+
+DEFINE_SEARCH(count,    int32,  int32_t,    count_i32)
+DEFINE_SEARCH(count,    int64,  int64_t,    count_i64)
+DEFINE_SEARCH(count,    float,  float,      count_f32)
+DEFINE_SEARCH(count,    double, double,     count_f64)
+DEFINE_SEARCH(find,     int32,  int32_t,    find_i32)
+DEFINE_SEARCH(find,     int64,  int64_t,    find_i64)
+DEFINE_SEARCH(find,     float,  float,      find_f32)
+DEFINE_SEARCH(find,     double, double,     find_f64)
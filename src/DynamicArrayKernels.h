@@ -0,0 +1,353 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file DynamicArrayKernels.h
+ * \brief Reductions and searches over the data of a SeeDynamicArray.
+ *
+ * The functions in this file operate directly on see_dynamic_array_data()
+ * of arrays whose elements are int32_t, int64_t, float or double. They are
+ * much faster than retrieving the elements one by one with
+ * see_dynamic_array_get(). When the library is initialized, the best
+ * implementation for the cpu is selected: AVX2 or SSE2 on x86, NEON on
+ * 64 bit ARM, otherwise a plain C implementation is used.
+ *
+ * All functions check whether the element size of the array matches the
+ * type of the function, SEE_INVALID_ARGUMENT is returned when it doesn't.
+ *
+ * \note The order in which floating point values are summed is unspecified,
+ *       so the result may differ in the last bits between cpus.
+ *       minmax, argmin and argmax skip NaN's. When all elements are NaN,
+ *       minmax returns NaN and argmin and argmax return an index error.
+ */
+
+#ifndef SEE_DYNAMIC_ARRAY_KERNELS_H
+#define SEE_DYNAMIC_ARRAY_KERNELS_H
+
+#include <stdint.h>
+#include "DynamicArray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* **** sums **** */
+
+/**
+ * \brief Compute the sum of all elements.
+ *
+ * The integer sums are computed with 64 bit integers, the sum of an int64
+ * array wraps around on overflow. Floating point elements are summed as
+ * doubles.
+ *
+ * @param [in]  array       The array, whose elements are of the given type.
+ * @param [out] sum_out     The sum is returned here, 0 for an empty array.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_dynamic_array_sum_int32(
+    const SeeDynamicArray*  array,
+    int64_t*                sum_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_sum_int32 */
+SEE_EXPORT int
+see_dynamic_array_sum_int64(
+    const SeeDynamicArray*  array,
+    int64_t*                sum_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_sum_int32 */
+SEE_EXPORT int
+see_dynamic_array_sum_float(
+    const SeeDynamicArray*  array,
+    double*                 sum_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_sum_int32 */
+SEE_EXPORT int
+see_dynamic_array_sum_double(
+    const SeeDynamicArray*  array,
+    double*                 sum_out,
+    SeeError**              error_out
+    );
+
+/* **** minimum and maximum **** */
+
+/**
+ * \brief Compute the minimum and maximum of all elements in one pass.
+ *
+ * @param [in]  array       The array, whose elements are of the given type.
+ * @param [out] min_out     The minimum is returned here.
+ * @param [out] max_out     The maximum is returned here.
+ * @param [out] error_out   An index error is returned when the array is
+ *                          empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_dynamic_array_minmax_int32(
+    const SeeDynamicArray*  array,
+    int32_t*                min_out,
+    int32_t*                max_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_minmax_int32 */
+SEE_EXPORT int
+see_dynamic_array_minmax_int64(
+    const SeeDynamicArray*  array,
+    int64_t*                min_out,
+    int64_t*                max_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_minmax_int32 */
+SEE_EXPORT int
+see_dynamic_array_minmax_float(
+    const SeeDynamicArray*  array,
+    float*                  min_out,
+    float*                  max_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_minmax_int32 */
+SEE_EXPORT int
+see_dynamic_array_minmax_double(
+    const SeeDynamicArray*  array,
+    double*                 min_out,
+    double*                 max_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Obtain the index of the first occurrence of the minimum.
+ *
+ * @param [in]  array       The array, whose elements are of the given type.
+ * @param [out] index_out   The index of the minimum is returned here.
+ * @param [out] error_out   An index error is returned when the array is
+ *                          empty or contains only NaN's.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_dynamic_array_argmin_int32(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_argmin_int32 */
+SEE_EXPORT int
+see_dynamic_array_argmin_int64(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_argmin_int32 */
+SEE_EXPORT int
+see_dynamic_array_argmin_float(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_argmin_int32 */
+SEE_EXPORT int
+see_dynamic_array_argmin_double(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Obtain the index of the first occurrence of the maximum.
+ *
+ * @param [in]  array       The array, whose elements are of the given type.
+ * @param [out] index_out   The index of the maximum is returned here.
+ * @param [out] error_out   An index error is returned when the array is
+ *                          empty or contains only NaN's.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_dynamic_array_argmax_int32(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_argmax_int32 */
+SEE_EXPORT int
+see_dynamic_array_argmax_int64(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_argmax_int32 */
+SEE_EXPORT int
+see_dynamic_array_argmax_float(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_argmax_int32 */
+SEE_EXPORT int
+see_dynamic_array_argmax_double(
+    const SeeDynamicArray*  array,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/* **** searching **** */
+
+/**
+ * \brief Count the elements that are equal to value.
+ *
+ * @param [in]  array       The array, whose elements are of the given type.
+ * @param [in]  value       The value to look for.
+ * @param [out] count_out   The number of elements equal to value.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_dynamic_array_count_int32(
+    const SeeDynamicArray*  array,
+    int32_t                 value,
+    size_t*                 count_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_count_int32 */
+SEE_EXPORT int
+see_dynamic_array_count_int64(
+    const SeeDynamicArray*  array,
+    int64_t                 value,
+    size_t*                 count_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_count_int32 */
+SEE_EXPORT int
+see_dynamic_array_count_float(
+    const SeeDynamicArray*  array,
+    float                   value,
+    size_t*                 count_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_count_int32 */
+SEE_EXPORT int
+see_dynamic_array_count_double(
+    const SeeDynamicArray*  array,
+    double                  value,
+    size_t*                 count_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Find the index of the first element that is equal to value.
+ *
+ * @param [in]  array       The array, whose elements are of the given type.
+ * @param [in]  value       The value to look for.
+ * @param [out] index_out   The index of the first element equal to value,
+ *                          or the size of the array when there is no such
+ *                          element.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_dynamic_array_find_int32(
+    const SeeDynamicArray*  array,
+    int32_t                 value,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_find_int32 */
+SEE_EXPORT int
+see_dynamic_array_find_int64(
+    const SeeDynamicArray*  array,
+    int64_t                 value,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_find_int32 */
+SEE_EXPORT int
+see_dynamic_array_find_float(
+    const SeeDynamicArray*  array,
+    float                   value,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/** \copydoc see_dynamic_array_find_int32 */
+SEE_EXPORT int
+see_dynamic_array_find_double(
+    const SeeDynamicArray*  array,
+    double                  value,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Obtain the name of the instruction set that is used by the
+ *        kernels, e.g. "avx2", "sse2", "neon" or "scalar".
+ */
+SEE_EXPORT const char*
+see_dynamic_array_kernels_isa();
+
+/* **** initialization **** */
+
+/**
+ * \private
+ * \brief Select the kernels for the cpu, this is called from the library
+ * initialization. Until then the scalar kernels are used.
+ */
+SEE_EXPORT int
+see_dynamic_array_kernels_init();
+
+/**
+ * \private
+ * \brief Force the kernels of one instruction set, so that the unit tests
+ * can run every implementation. Call see_dynamic_array_kernels_init() to
+ * select the best kernels again.
+ *
+ * @param [in] isa  The name as returned by see_dynamic_array_kernels_isa().
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT when the kernels aren't
+ *         compiled in or the cpu doesn't support them.
+ */
+SEE_EXPORT int
+see_dynamic_array_kernels_select(const char* isa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_DYNAMIC_ARRAY_KERNELS_H
@@ -0,0 +1,263 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file DynamicArrayParallel.c
+ * \brief implements the parallel algorithms on SeeDynamicArrays.
+ *
+ * \private
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "DynamicArrayParallel.h"
+#include "ThreadPool.h"
+#include "RuntimeError.h"
+
+// An automatic grain never makes chunks smaller than this.
+#define PARALLEL_MIN_GRAIN          4096
+// An automatic grain gives every thread about this many chunks, so threads
+// that finish early can steal work from the others.
+#define PARALLEL_CHUNKS_PER_THREAD  4
+
+typedef struct chunks {
+    char*       elements;
+    size_t      element_size;
+    size_t      size;
+    size_t      grain;
+} chunks;
+
+typedef struct for_job {
+    chunks                  src;
+    see_array_chunk_func    fn;
+    void*                   ctx;
+} for_job;
+
+typedef struct map_job {
+    chunks                  src;
+    char*                   out;
+    size_t                  out_size;
+    see_array_map_func      fn;
+    void*                   ctx;
+} map_job;
+
+typedef struct reduce_job {
+    chunks                  src;
+    char*                   partials;
+    size_t                  result_size;
+    see_array_reduce_func   reduce;
+    void*                   ctx;
+} reduce_job;
+
+/* **** private helpers **** */
+
+static void
+chunks_init(chunks* c, const SeeDynamicArray* array, size_t grain)
+{
+    c->elements     = array->elements;
+    c->element_size = array->element_size;
+    c->size         = array->size;
+
+    if (grain == 0) {
+        size_t threads = see_thread_pool_num_threads(NULL);
+        size_t n = threads ? threads * PARALLEL_CHUNKS_PER_THREAD : 1;
+        grain = (c->size + n - 1) / n;
+        if (grain < PARALLEL_MIN_GRAIN)
+            grain = PARALLEL_MIN_GRAIN;
+    }
+    c->grain = grain;
+}
+
+static size_t
+chunks_count(const chunks* c)
+{
+    return (c->size + c->grain - 1) / c->grain;
+}
+
+static size_t
+chunk_first(const chunks* c, size_t index)
+{
+    return index * c->grain;
+}
+
+static size_t
+chunk_length(const chunks* c, size_t index)
+{
+    size_t first = chunk_first(c, index);
+    return c->size - first < c->grain ? c->size - first : c->grain;
+}
+
+static int
+for_task(size_t index, void* data)
+{
+    const for_job* job = data;
+    size_t first = chunk_first(&job->src, index);
+    return job->fn(
+        job->src.elements + first * job->src.element_size,
+        chunk_length(&job->src, index),
+        first,
+        job->ctx
+        );
+}
+
+static int
+map_task(size_t index, void* data)
+{
+    const map_job* job = data;
+    size_t first = chunk_first(&job->src, index);
+    return job->fn(
+        job->src.elements + first * job->src.element_size,
+        job->out + first * job->out_size,
+        chunk_length(&job->src, index),
+        first,
+        job->ctx
+        );
+}
+
+static int
+reduce_task(size_t index, void* data)
+{
+    const reduce_job* job = data;
+    size_t first = chunk_first(&job->src, index);
+    return job->reduce(
+        job->src.elements + first * job->src.element_size,
+        chunk_length(&job->src, index),
+        first,
+        job->partials + index * job->result_size,
+        job->ctx
+        );
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_dynamic_array_parallel_for(
+    SeeDynamicArray*        array,
+    see_array_chunk_func    fn,
+    void*                   ctx,
+    size_t                  grain,
+    SeeError**              error_out
+    )
+{
+    if (!array || !fn || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (see_dynamic_array_is_mapped(array)) {
+        see_runtime_error_new(error_out, EROFS);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    if (array->size == 0)
+        return SEE_SUCCESS;
+
+    for_job job;
+    chunks_init(&job.src, array, grain);
+    job.fn  = fn;
+    job.ctx = ctx;
+
+    return see_thread_pool_run(
+        NULL, chunks_count(&job.src), for_task, &job, error_out
+        );
+}
+
+int
+see_dynamic_array_parallel_map(
+    SeeDynamicArray*        out,
+    const SeeDynamicArray*  in,
+    see_array_map_func      fn,
+    void*                   ctx,
+    size_t                  grain,
+    SeeError**              error_out
+    )
+{
+    int ret;
+    if (!out || !in || out == in || !fn || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    ret = see_dynamic_array_resize(out, in->size, NULL, error_out);
+    if (ret)
+        return ret;
+
+    if (in->size == 0)
+        return SEE_SUCCESS;
+
+    map_job job;
+    chunks_init(&job.src, in, grain);
+    job.out         = out->elements;
+    job.out_size    = out->element_size;
+    job.fn          = fn;
+    job.ctx         = ctx;
+
+    return see_thread_pool_run(
+        NULL, chunks_count(&job.src), map_task, &job, error_out
+        );
+}
+
+int
+see_dynamic_array_parallel_reduce(
+    const SeeDynamicArray*  array,
+    see_array_reduce_func   reduce,
+    see_array_combine_func  combine,
+    const void*             identity,
+    void*                   result,
+    size_t                  result_size,
+    void*                   ctx,
+    size_t                  grain,
+    SeeError**              error_out
+    )
+{
+    int ret;
+    if (!array || !reduce || !combine || !identity || !result ||
+        result_size == 0 || !error_out || *error_out
+        )
+        return SEE_INVALID_ARGUMENT;
+
+    memmove(result, identity, result_size);
+    if (array->size == 0)
+        return SEE_SUCCESS;
+
+    reduce_job job;
+    chunks_init(&job.src, array, grain);
+    job.result_size = result_size;
+    job.reduce      = reduce;
+    job.ctx         = ctx;
+
+    size_t n = chunks_count(&job.src);
+    if (n > SIZE_MAX / result_size) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    job.partials = malloc(n * result_size);
+    if (!job.partials) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+    for (size_t i = 0; i < n; i++)
+        memcpy(job.partials + i * result_size, result, result_size);
+
+    ret = see_thread_pool_run(NULL, n, reduce_task, &job, error_out);
+    if (ret == SEE_SUCCESS) {
+        for (size_t i = 0; i < n; i++)
+            combine(result, job.partials + i * result_size, ctx);
+    }
+
+    free(job.partials);
+    return ret;
+}
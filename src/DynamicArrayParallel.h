@@ -0,0 +1,225 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file DynamicArrayParallel.h
+ * \brief Process the elements of a SeeDynamicArray on all cores.
+ *
+ * The elements of the array are split in chunks of grain elements, the
+ * last chunk may be smaller. Every chunk is handed to the callback as a
+ * pointer into see_dynamic_array_data(), together with the number of
+ * elements in the chunk and the index of its first element. The chunks
+ * are processed by the shared SeeThreadPool, so the callbacks run
+ * concurrently and must not modify anything outside their chunk, unless
+ * they synchronize themselves. The array must not be resized while the
+ * callbacks run.
+ *
+ * When grain is 0, it is chosen such that every thread of the pool gets a
+ * few chunks, but chunks are never made very small.
+ *
+ * A callback that fails returns a value other than SEE_SUCCESS, the other
+ * chunks are still processed. The function then returns the value of the
+ * failing chunk with the lowest index.
+ *
+ * @code
+ * static int
+ * scale(void* chunk, size_t n, size_t first, void* ctx)
+ * {
+ *     (void) first;
+ *     double* values = chunk;
+ *     double factor = *(const double*) ctx;
+ *     for (size_t i = 0; i < n; i++)
+ *         values[i] *= factor;
+ *     return SEE_SUCCESS;
+ * }
+ *
+ * double factor = 2.0;
+ * ret = see_dynamic_array_parallel_for(array, scale, &factor, 0, &error);
+ * @endcode
+ */
+
+#ifndef SEE_DYNAMIC_ARRAY_PARALLEL_H
+#define SEE_DYNAMIC_ARRAY_PARALLEL_H
+
+#include "DynamicArray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Processes a chunk of an array in place.
+ *
+ * @param [in, out] chunk   The first element of the chunk.
+ * @param [in]      n       The number of elements in the chunk.
+ * @param [in]      first   The index of the first element in the array.
+ * @param [in]      ctx     The context handed to the parallel function.
+ *
+ * @return SEE_SUCCESS or another value when the chunk could not be
+ *         processed.
+ */
+typedef int (*see_array_chunk_func)(
+    void*   chunk,
+    size_t  n,
+    size_t  first,
+    void*   ctx
+    );
+
+/**
+ * \brief Computes the elements of a chunk of the output array from the
+ *        same chunk of the input array.
+ *
+ * @param [in]  in      The first element of the input chunk.
+ * @param [out] out     The first element of the output chunk.
+ * @param [in]  n       The number of elements in both chunks.
+ * @param [in]  first   The index of the first element in the arrays.
+ * @param [in]  ctx     The context handed to see_dynamic_array_parallel_map.
+ *
+ * @return SEE_SUCCESS or another value when the chunk could not be mapped.
+ */
+typedef int (*see_array_map_func)(
+    const void* in,
+    void*       out,
+    size_t      n,
+    size_t      first,
+    void*       ctx
+    );
+
+/**
+ * \brief Folds the elements of a chunk into a partial result.
+ *
+ * @param [in]      chunk   The first element of the chunk.
+ * @param [in]      n       The number of elements in the chunk.
+ * @param [in]      first   The index of the first element in the array.
+ * @param [in, out] partial The partial result of this chunk, it starts as
+ *                          a copy of the identity.
+ * @param [in]      ctx     The context handed to
+ *                          see_dynamic_array_parallel_reduce.
+ *
+ * @return SEE_SUCCESS or another value when the chunk could not be reduced.
+ */
+typedef int (*see_array_reduce_func)(
+    const void* chunk,
+    size_t      n,
+    size_t      first,
+    void*       partial,
+    void*       ctx
+    );
+
+/**
+ * \brief Combines a partial result into the accumulated result.
+ */
+typedef void (*see_array_combine_func)(
+    void*       result,
+    const void* partial,
+    void*       ctx
+    );
+
+/**
+ * \brief Call fn for every chunk of the array.
+ *
+ * @param [in, out] array       The array whose elements are processed, it
+ *                              may not be memory mapped.
+ * @param [in]      fn          The function that processes the chunks.
+ * @param [in]      ctx         Is passed to fn.
+ * @param [in]      grain       The number of elements per chunk, or 0.
+ * @param [out]     error_out   A runtime error when the array is memory
+ *                              mapped or the threads cannot be started.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME or the value
+ *         returned by a failing chunk.
+ */
+SEE_EXPORT int
+see_dynamic_array_parallel_for(
+    SeeDynamicArray*        array,
+    see_array_chunk_func    fn,
+    void*                   ctx,
+    size_t                  grain,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Fill out with one element for every element of in.
+ *
+ * out is resized to the size of in first, so its new elements are
+ * initialized with its init function before fn overwrites them.
+ *
+ * @param [out] out         The array that receives the results, it may
+ *                          have another element size than in.
+ * @param [in]  in          The array with the input elements.
+ * @param [in]  fn          The function that maps the chunks.
+ * @param [in]  ctx         Is passed to fn.
+ * @param [in]  grain       The number of elements per chunk, or 0.
+ * @param [out] error_out   A runtime error when out is memory mapped, or
+ *                          when out cannot be resized or the threads
+ *                          cannot be started.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME or the value
+ *         returned by a failing chunk.
+ */
+SEE_EXPORT int
+see_dynamic_array_parallel_map(
+    SeeDynamicArray*        out,
+    const SeeDynamicArray*  in,
+    see_array_map_func      fn,
+    void*                   ctx,
+    size_t                  grain,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Reduce the array to a single value.
+ *
+ * Every chunk is reduced into its own partial result, which starts as a
+ * copy of identity. The partial results are combined into result in the
+ * order of the chunks, so for a given grain the result doesn't depend on
+ * which thread handled which chunk, even when combine isn't associative
+ * like a sum of floating point numbers.
+ *
+ * @param [in]  array       The array to reduce.
+ * @param [in]  reduce      Folds a chunk into its partial result.
+ * @param [in]  combine     Combines a partial result into result.
+ * @param [in]  identity    The value of an empty reduction, of result_size
+ *                          bytes.
+ * @param [out] result      Receives the result, of result_size bytes.
+ * @param [in]  result_size The size of the result in bytes.
+ * @param [in]  ctx         Is passed to reduce and combine.
+ * @param [in]  grain       The number of elements per chunk, or 0.
+ * @param [out] error_out   A runtime error when the partial results cannot
+ *                          be allocated or the threads cannot be started.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME or the value
+ *         returned by a failing chunk.
+ */
+SEE_EXPORT int
+see_dynamic_array_parallel_reduce(
+    const SeeDynamicArray*  array,
+    see_array_reduce_func   reduce,
+    see_array_combine_func  combine,
+    const void*             identity,
+    void*                   result,
+    size_t                  result_size,
+    void*                   ctx,
+    size_t                  grain,
+    SeeError**              error_out
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_DYNAMIC_ARRAY_PARALLEL_H
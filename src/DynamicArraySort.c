@@ -0,0 +1,590 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file DynamicArraySort.c
+ * \brief implements sorting and searching of SeeDynamicArrays.
+ *
+ * \private
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include "DynamicArraySort.h"
+#include "RuntimeError.h"
+
+// Ranges with no more elements than this are sorted with insertion sort.
+#define INSERTION_SORT_MAX 16
+
+#define ELEM(base, i, size) ((base) + (i) * (size))
+
+/* **** private helpers **** */
+
+static void
+swap_elements(char* a, char* b, size_t size)
+{
+    unsigned char tmp[64];
+
+    while (size) {
+        size_t n = size < sizeof(tmp) ? size : sizeof(tmp);
+        memcpy(tmp, a, n);
+        memcpy(a, b, n);
+        memcpy(b, tmp, n);
+        a += n;
+        b += n;
+        size -= n;
+    }
+}
+
+static void
+insertion_sort(
+    char*               base,
+    size_t              n,
+    size_t              size,
+    see_compare_func    cmp,
+    void*               data
+    )
+{
+    for (size_t i = 1; i < n; i++) {
+        for (size_t j = i; j > 0; j--) {
+            char* cur  = ELEM(base, j, size);
+            char* prev = cur - size;
+            if (cmp(prev, cur, data) <= 0)
+                break;
+            swap_elements(prev, cur, size);
+        }
+    }
+}
+
+static void
+sift_down(
+    char*               base,
+    size_t              root,
+    size_t              n,
+    size_t              size,
+    see_compare_func    cmp,
+    void*               data
+    )
+{
+    size_t child;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n &&
+            cmp(ELEM(base, child, size), ELEM(base, child + 1, size), data) < 0)
+            child++;
+        if (cmp(ELEM(base, root, size), ELEM(base, child, size), data) >= 0)
+            return;
+        swap_elements(ELEM(base, root, size), ELEM(base, child, size), size);
+        root = child;
+    }
+}
+
+static void
+heap_sort(
+    char*               base,
+    size_t              n,
+    size_t              size,
+    see_compare_func    cmp,
+    void*               data
+    )
+{
+    for (size_t i = n / 2; i > 0; i--)
+        sift_down(base, i - 1, n, size, cmp, data);
+
+    for (size_t end = n - 1; end > 0; end--) {
+        swap_elements(base, ELEM(base, end, size), size);
+        sift_down(base, 0, end, size, cmp, data);
+    }
+}
+
+/*
+ * The median of the first, middle and last element becomes the pivot and is
+ * moved to the front, afterwards the last element is at least as large as
+ * the pivot, this keeps the partition loop within bounds.
+ */
+static void
+select_pivot(
+    char*               base,
+    size_t              n,
+    size_t              size,
+    see_compare_func    cmp,
+    void*               data
+    )
+{
+    char* first = base;
+    char* mid   = ELEM(base, n / 2, size);
+    char* last  = ELEM(base, n - 1, size);
+
+    if (cmp(mid, first, data) < 0)
+        swap_elements(mid, first, size);
+    if (cmp(last, mid, data) < 0) {
+        swap_elements(last, mid, size);
+        if (cmp(mid, first, data) < 0)
+            swap_elements(mid, first, size);
+    }
+    swap_elements(first, mid, size);
+}
+
+static void
+intro_sort(
+    char*               base,
+    size_t              n,
+    size_t              size,
+    see_compare_func    cmp,
+    void*               data,
+    unsigned            depth
+    )
+{
+    while (n > INSERTION_SORT_MAX) {
+        if (depth == 0) {
+            heap_sort(base, n, size, cmp, data);
+            return;
+        }
+        depth--;
+
+        select_pivot(base, n, size, cmp, data);
+
+        size_t i = 0, j = n;
+        for (;;) {
+            do {
+                i++;
+            } while (i < n && cmp(ELEM(base, i, size), base, data) < 0);
+            do {
+                j--;
+            } while (cmp(ELEM(base, j, size), base, data) > 0);
+            if (i >= j)
+                break;
+            swap_elements(ELEM(base, i, size), ELEM(base, j, size), size);
+        }
+        swap_elements(base, ELEM(base, j, size), size);
+
+        // Recurse into the smaller part, so the stack stays O(log n).
+        char*  right   = ELEM(base, j + 1, size);
+        size_t n_left  = j;
+        size_t n_right = n - j - 1;
+        if (n_left < n_right) {
+            intro_sort(base, n_left, size, cmp, data, depth);
+            base = right;
+            n    = n_right;
+        }
+        else {
+            intro_sort(right, n_right, size, cmp, data, depth);
+            n = n_left;
+        }
+    }
+    insertion_sort(base, n, size, cmp, data);
+}
+
+/*
+ * Sorts base[0, n) stably, tmp must have room for n elements.
+ */
+static void
+merge_sort(
+    char*               base,
+    char*               tmp,
+    size_t              n,
+    size_t              size,
+    see_compare_func    cmp,
+    void*               data
+    )
+{
+    if (n <= INSERTION_SORT_MAX) {
+        // insertion sort only swaps unequal neighbours, hence it is stable.
+        insertion_sort(base, n, size, cmp, data);
+        return;
+    }
+
+    size_t half  = n / 2;
+    char*  right = ELEM(base, half, size);
+    char*  end   = ELEM(base, n, size);
+
+    merge_sort(base, tmp, half, size, cmp, data);
+    merge_sort(right, tmp, n - half, size, cmp, data);
+
+    // Already in order, this makes sorting sorted input linear.
+    if (cmp(right - size, right, data) <= 0)
+        return;
+
+    char* l = base;
+    char* r = right;
+    char* o = tmp;
+    while (l < right && r < end) {
+        if (cmp(r, l, data) < 0) {
+            memcpy(o, r, size);
+            r += size;
+        }
+        else {
+            memcpy(o, l, size);
+            l += size;
+        }
+        o += size;
+    }
+    // The remainder of the right half is already in place.
+    memcpy(o, l, right - l);
+    o += right - l;
+    memcpy(base, tmp, o - tmp);
+}
+
+static uint64_t
+radix_key(const char* element, size_t width)
+{
+    if (width == sizeof(uint32_t)) {
+        uint32_t key;
+        memcpy(&key, element, sizeof(key));
+        return key;
+    }
+    uint64_t key;
+    memcpy(&key, element, sizeof(key));
+    return key;
+}
+
+/*
+ * Sorts the keys, which are stored as unsigned integers of width bytes.
+ * Flipping the sign bit makes signed integers sort as unsigned ones.
+ */
+static int
+radix_sort(SeeDynamicArray* array, size_t width, int is_signed, SeeError** error_out)
+{
+    size_t n = see_dynamic_array_size(array);
+    size_t counts[8][256];
+    uint64_t flip = is_signed ? (uint64_t) 1 << (width * 8 - 1) : 0;
+
+    if (n <= INSERTION_SORT_MAX * 4) {
+        // Clearing and scanning the histograms would dominate here.
+        char* base = see_dynamic_array_data(array);
+        for (size_t i = 1; i < n; i++) {
+            for (size_t j = i; j > 0; j--) {
+                char* cur  = ELEM(base, j, width);
+                char* prev = cur - width;
+                if ((radix_key(prev, width) ^ flip) <= (radix_key(cur, width) ^ flip))
+                    break;
+                swap_elements(prev, cur, width);
+            }
+        }
+        return SEE_SUCCESS;
+    }
+
+    char* tmp = malloc(n * width);
+    if (!tmp) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    memset(counts, 0, sizeof(counts));
+
+    char* src = see_dynamic_array_data(array);
+    char* dst = tmp;
+
+    // Compute the histograms of all digits in one pass.
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = radix_key(ELEM(src, i, width), width) ^ flip;
+        for (size_t d = 0; d < width; d++)
+            counts[d][(key >> (d * 8)) & 0xff]++;
+    }
+
+    for (size_t d = 0; d < width; d++) {
+        size_t offsets[256];
+        size_t total = 0;
+        int trivial = 0;
+
+        for (size_t b = 0; b < 256; b++) {
+            if (counts[d][b] == n) {
+                trivial = 1;
+                break;
+            }
+            offsets[b] = total;
+            total += counts[d][b];
+        }
+        // All keys have the same digit, this pass wouldn't move anything.
+        if (trivial)
+            continue;
+
+        if (width == 4) {
+            const uint32_t* s = (const uint32_t*) src;
+            uint32_t* o = (uint32_t*) dst;
+            for (size_t i = 0; i < n; i++) {
+                uint32_t digit = ((s[i] ^ (uint32_t) flip) >> (d * 8)) & 0xff;
+                o[offsets[digit]++] = s[i];
+            }
+        }
+        else {
+            const uint64_t* s = (const uint64_t*) src;
+            uint64_t* o = (uint64_t*) dst;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t digit = ((s[i] ^ flip) >> (d * 8)) & 0xff;
+                o[offsets[digit]++] = s[i];
+            }
+        }
+
+        char* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != see_dynamic_array_data(array))
+        memcpy(see_dynamic_array_data(array), src, n * width);
+
+    free(tmp);
+    return SEE_SUCCESS;
+}
+
+typedef struct object_compare_data {
+    int         ret;
+    SeeError**  error_out;
+} object_compare_data;
+
+static int
+compare_objects(const void* a, const void* b, void* data)
+{
+    object_compare_data* cmp_data = data;
+    int result = 0;
+
+    // After the first failure every element is considered equal.
+    if (cmp_data->ret)
+        return 0;
+
+    cmp_data->ret = see_object_compare(
+        *(SeeObject* const*) a,
+        *(SeeObject* const*) b,
+        &result,
+        cmp_data->error_out
+        );
+
+    return cmp_data->ret ? 0 : result;
+}
+
+/*
+ * The elements of a memory mapped array cannot be moved.
+ */
+static int
+check_writable(const SeeDynamicArray* array, SeeError** error_out)
+{
+    if (see_dynamic_array_is_mapped(array)) {
+        see_runtime_error_new(error_out, EROFS);
+        return SEE_ERROR_RUNTIME;
+    }
+    return SEE_SUCCESS;
+}
+
+static size_t
+binary_search(
+    const SeeDynamicArray*  array,
+    const void*             value,
+    see_compare_func        cmp,
+    void*                   data,
+    int                     upper
+    )
+{
+    const char* base = array->elements;
+    size_t lo = 0, n = array->size;
+
+    while (n > 0) {
+        size_t half = n / 2;
+        int c = cmp(ELEM(base, lo + half, array->element_size), value, data);
+        if (c < 0 || (upper && c == 0)) {
+            lo += half + 1;
+            n  -= half + 1;
+        }
+        else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_dynamic_array_sort(
+    SeeDynamicArray*    array,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    )
+{
+    if (!array || !cmp || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+    if (check_writable(array, error_out))
+        return SEE_ERROR_RUNTIME;
+
+    size_t n = array->size;
+    unsigned depth = 0;
+    for (size_t i = n; i > 1; i >>= 1)
+        depth += 2;
+
+    intro_sort(array->elements, n, array->element_size, cmp, data, depth);
+    return SEE_SUCCESS;
+}
+
+int
+see_dynamic_array_stable_sort(
+    SeeDynamicArray*    array,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    )
+{
+    if (!array || !cmp || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+    if (check_writable(array, error_out))
+        return SEE_ERROR_RUNTIME;
+
+    size_t n = array->size;
+    if (n <= INSERTION_SORT_MAX) {
+        insertion_sort(array->elements, n, array->element_size, cmp, data);
+        return SEE_SUCCESS;
+    }
+
+    char* tmp = malloc(n * array->element_size);
+    if (!tmp) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    merge_sort(array->elements, tmp, n, array->element_size, cmp, data);
+
+    free(tmp);
+    return SEE_SUCCESS;
+}
+
+#define DEFINE_RADIX_SORT(suffix, T, is_signed)                             \
+int                                                                         \
+see_dynamic_array_sort_##suffix(SeeDynamicArray* array, SeeError** error_out)\
+{                                                                           \
+    if (!array || !error_out || *error_out)                                 \
+        return SEE_INVALID_ARGUMENT;                                        \
+    if (array->element_size != sizeof(T))                                   \
+        return SEE_INVALID_ARGUMENT;                                        \
+    if (check_writable(array, error_out))                                   \
+        return SEE_ERROR_RUNTIME;                                           \
+                                                                            \
+    return radix_sort(array, sizeof(T), is_signed, error_out);              \
+}
+
+DEFINE_RADIX_SORT(int32,    int32_t,    1)
+DEFINE_RADIX_SORT(uint32,   uint32_t,   0)
+DEFINE_RADIX_SORT(int64,    int64_t,    1)
+DEFINE_RADIX_SORT(uint64,   uint64_t,   0)
+
+int
+see_dynamic_array_sort_objects(SeeDynamicArray* array, SeeError** error_out)
+{
+    if (!array || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+    if (array->element_size != sizeof(SeeObject*))
+        return SEE_INVALID_ARGUMENT;
+
+    object_compare_data cmp_data = {SEE_SUCCESS, error_out};
+
+    int ret = see_dynamic_array_stable_sort(
+        array, compare_objects, &cmp_data, error_out
+        );
+    if (ret)
+        return ret;
+
+    return cmp_data.ret;
+}
+
+int
+see_dynamic_array_lower_bound(
+    const SeeDynamicArray*  array,
+    const void*             value,
+    see_compare_func        cmp,
+    void*                   data,
+    size_t*                 index_out,
+    SeeError**              error_out
+    )
+{
+    if (!array || !value || !cmp || !index_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *index_out = binary_search(array, value, cmp, data, 0);
+    return SEE_SUCCESS;
+}
+
+int
+see_dynamic_array_upper_bound(
+    const SeeDynamicArray*  array,
+    const void*             value,
+    see_compare_func        cmp,
+    void*                   data,
+    size_t*                 index_out,
+    SeeError**              error_out
+    )
+{
+    if (!array || !value || !cmp || !index_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *index_out = binary_search(array, value, cmp, data, 1);
+    return SEE_SUCCESS;
+}
+
+int
+see_dynamic_array_merge(
+    SeeDynamicArray**       out,
+    const SeeDynamicArray*  a,
+    const SeeDynamicArray*  b,
+    see_compare_func        cmp,
+    void*                   data,
+    SeeError**              error_out
+    )
+{
+    if (!out || *out || !a || !b || !cmp || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+    if (a->element_size != b->element_size)
+        return SEE_INVALID_ARGUMENT;
+
+    SeeDynamicArray* result = NULL;
+    size_t size = a->element_size;
+    int ret = see_dynamic_array_new_capacity(
+        &result,
+        size,
+        a->copy_element,
+        a->init_element,
+        a->free_element,
+        a->size + b->size,
+        error_out
+        );
+    if (ret)
+        return ret;
+
+    const char* pa = a->elements;
+    const char* pb = b->elements;
+    const char* end_a = ELEM(pa, a->size, size);
+    const char* end_b = ELEM(pb, b->size, size);
+
+    while (!ret && (pa < end_a || pb < end_b)) {
+        const char* next;
+        if (pb == end_b || (pa < end_a && cmp(pb, pa, data) >= 0)) {
+            next = pa;
+            pa  += size;
+        }
+        else {
+            next = pb;
+            pb  += size;
+        }
+        ret = see_dynamic_array_add(result, next, error_out);
+    }
+
+    if (ret) {
+        see_object_decref(SEE_OBJECT(result));
+        return ret;
+    }
+
+    *out = result;
+    return SEE_SUCCESS;
+}
@@ -0,0 +1,206 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file DynamicArraySort.h
+ * \brief Sorting and searching in sorted SeeDynamicArrays.
+ *
+ * The sort functions move the elements bitwise, just like
+ * see_dynamic_array_shuffle(), so the copy and free functions of the array
+ * are not used. Hence they can also be used for arrays of SeeObject pointers.
+ * Memory mapped arrays cannot be sorted, for those SEE_ERROR_RUNTIME is
+ * returned.
+ *
+ * The comparison functions are called as cmp(element, other, data), where
+ * data is the pointer that is handed to the sort or search function.
+ */
+
+#ifndef SEE_DYNAMIC_ARRAY_SORT_H
+#define SEE_DYNAMIC_ARRAY_SORT_H
+
+#include "DynamicArray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* **** sorting **** */
+
+/**
+ * \brief Sort the array in place.
+ *
+ * This is an introsort: a quicksort that switches to heapsort when the
+ * partitioning goes bad, so the worst case is O(n log n). It needs no
+ * extra memory, but the sort isn't stable.
+ *
+ * @param [in, out] array       The array to sort.
+ * @param [in]      cmp         The function that orders the elements.
+ * @param [in]      data        Is passed to cmp.
+ * @param [out]     error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_dynamic_array_sort(
+    SeeDynamicArray*    array,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Sort the array, elements that are equal keep their order.
+ *
+ * This is a merge sort, it needs a temporary buffer as large as the array.
+ *
+ * @param [in, out] array       The array to sort.
+ * @param [in]      cmp         The function that orders the elements.
+ * @param [in]      data        Is passed to cmp.
+ * @param [out]     error_out   A runtime error when the buffer cannot be
+ *                              allocated.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_dynamic_array_stable_sort(
+    SeeDynamicArray*    array,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Sort an array of integers in ascending order.
+ *
+ * This is a least significant digit radix sort, which takes linear time.
+ * Bytes that are equal for all elements are skipped. It needs a temporary
+ * buffer as large as the array.
+ *
+ * @param [in, out] array       The array to sort, its elements must be of
+ *                              the type in the name of the function.
+ * @param [out]     error_out   A runtime error when the buffer cannot be
+ *                              allocated.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_dynamic_array_sort_int32(SeeDynamicArray* array, SeeError** error_out);
+
+/** \copydoc see_dynamic_array_sort_int32 */
+SEE_EXPORT int
+see_dynamic_array_sort_uint32(SeeDynamicArray* array, SeeError** error_out);
+
+/** \copydoc see_dynamic_array_sort_int32 */
+SEE_EXPORT int
+see_dynamic_array_sort_int64(SeeDynamicArray* array, SeeError** error_out);
+
+/** \copydoc see_dynamic_array_sort_int32 */
+SEE_EXPORT int
+see_dynamic_array_sort_uint64(SeeDynamicArray* array, SeeError** error_out);
+
+/**
+ * \brief Sort an array of SeeObject pointers with see_object_compare().
+ *
+ * The sort is stable. When the objects cannot be compared, the error of
+ * see_object_compare() is returned and the order of the elements is
+ * unspecified, although the array still contains all of them.
+ *
+ * @param [in, out] array       An array whose elements are SeeObject*.
+ * @param [out]     error_out   The error of the first comparison that failed.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INCOMPARABLE or
+ *         SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_dynamic_array_sort_objects(SeeDynamicArray* array, SeeError** error_out);
+
+/* **** searching in sorted arrays **** */
+
+/**
+ * \brief Find the first element that isn't ordered before value.
+ *
+ * The array must be sorted with respect to cmp. This is a binary search.
+ *
+ * @param [in]  array       A sorted array.
+ * @param [in]  value       A pointer to the value to look for.
+ * @param [in]  cmp         The function that was used to sort the array.
+ * @param [in]  data        Is passed to cmp.
+ * @param [out] index_out   The index of the element, or the size of the
+ *                          array when all elements are ordered before value.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_dynamic_array_lower_bound(
+    const SeeDynamicArray*  array,
+    const void*             value,
+    see_compare_func        cmp,
+    void*                   data,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Find the first element that is ordered after value.
+ *
+ * Together with see_dynamic_array_lower_bound() this gives the range of
+ * elements that are equal to value.
+ *
+ * \copydetails see_dynamic_array_lower_bound
+ */
+SEE_EXPORT int
+see_dynamic_array_upper_bound(
+    const SeeDynamicArray*  array,
+    const void*             value,
+    see_compare_func        cmp,
+    void*                   data,
+    size_t*                 index_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Merge two sorted arrays into a new sorted array.
+ *
+ * The elements are copied with the copy function of the arrays, when
+ * elements of both arrays are equal, the ones of a come first. The new
+ * array has the element functions of a.
+ *
+ * @param [out] out         A pointer to a SeeDynamicArray* that is NULL.
+ * @param [in]  a           A sorted array.
+ * @param [in]  b           A sorted array with elements of the same size.
+ * @param [in]  cmp         The function that was used to sort the arrays.
+ * @param [in]  data        Is passed to cmp.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_dynamic_array_merge(
+    SeeDynamicArray**       out,
+    const SeeDynamicArray*  a,
+    const SeeDynamicArray*  b,
+    see_compare_func        cmp,
+    void*                   data,
+    SeeError**              error_out
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_DYNAMIC_ARRAY_SORT_H
@@ -37,10 +37,13 @@
 #include <stdbool.h>
 
 #include "MetaClass.h"
+#include "ByteOrderKernels.h"
+#include "Crc32c.h"
 #include "MsgBuffer.h"
 #include "see_object_config.h"
 #include "utilities.h"
 #include "RuntimeError.h"
+#include "Span.h"
 #include "IncomparableError.h"
 #include "IndexError.h"
 
@@ -50,6 +53,94 @@
  */
 const char* g_see_msg_start = "SMSG";
 
+/**
+ * Most messages have only a few parts, the records of the first parts are
+ * stored inside the parts array, so those don't need another allocation.
+ */
+#define MSG_BUFFER_INLINE_PARTS 8
+
+/*
+ * The trailer is the type byte SEE_MSG_PART_TRAILER followed by the CRC32C
+ * of all preceding bytes of the message in network order.
+ */
+#define MSG_BUFFER_TRAILER (sizeof(uint8_t) + sizeof(uint32_t))
+
+/*
+ * While serializing and parsing, the CRC32C is updated every time this many
+ * bytes have been processed, while those are still in the cache.
+ */
+#define MSG_BUFFER_CRC_CHUNK 4096
+
+/*
+ * The type byte and the length that precede the payload of string and
+ * array parts.
+ */
+#define MSG_PART_HEADER (sizeof(uint8_t) + sizeof(uint32_t))
+
+/*
+ * Returns the size of one element of an array type, or 0 when type isn't
+ * an array type. Bytes are treated as an array of octets that don't have
+ * a byte order.
+ */
+static size_t
+msg_part_array_element_size(uint8_t type)
+{
+    switch (type) {
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+            return sizeof(uint32_t);
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+            return sizeof(uint64_t);
+        case SEE_MSG_PART_BYTES_T:
+            return sizeof(uint8_t);
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Converts n elements of an array to network byte order.
+ */
+static void
+msg_part_array_to_network(
+    void*       dst,
+    const void* src,
+    size_t      n,
+    size_t      element_size
+    )
+{
+    if (element_size == sizeof(uint8_t)) {
+        if (n)
+            memcpy(dst, src, n);
+    }
+    else if (element_size == sizeof(uint32_t))
+        see_host_to_network32_array(dst, src, n);
+    else
+        see_host_to_network64_array(dst, src, n);
+}
+
+/*
+ * Converts n elements of an array to host byte order.
+ */
+static void
+msg_part_array_to_host(
+    void*       dst,
+    const void* src,
+    size_t      n,
+    size_t      element_size
+    )
+{
+    if (element_size == sizeof(uint8_t)) {
+        if (n)
+            memcpy(dst, src, n);
+    }
+    else if (element_size == sizeof(uint32_t))
+        see_network_to_host32_array(dst, src, n);
+    else
+        see_network_to_host64_array(dst, src, n);
+}
+
 
 /**
  * \brief If the message part needs to allocate resources they are freed here
@@ -78,6 +169,14 @@ msg_part_destroy_content(SeeMsgPart* mbp)
             free(mbp->value.str_val);
             mbp->value.str_val = NULL;
             break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            free(mbp->value.array_val);
+            mbp->value.array_val = NULL;
+            break;
         default:
             assert(0 == 1);
     }
@@ -202,6 +301,19 @@ static int msg_part_equal(
         case SEE_MSG_PART_DOUBLE_T:
             *result = part->value.double_val == other->value.double_val;
             break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            // Arrays are compared bitwise.
+            *result = part->length == other->length &&
+                memcmp(
+                    part->value.array_val,
+                    other->value.array_val,
+                    part->length - MSG_PART_HEADER
+                    ) == 0;
+            break;
         case SEE_MSG_PART_NOT_INIT:
             *result = 1; // content is irrelevant.
             break;
@@ -283,6 +395,23 @@ msg_part_copy(
             if (ret)
                 goto fail;
             break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            {
+                size_t size = in->length - MSG_PART_HEADER;
+                out->value.array_val = malloc(size ? size : 1);
+                if (!out->value.array_val) {
+                    see_runtime_error_new(error_out, errno);
+                    ret = SEE_ERROR_RUNTIME;
+                    goto fail;
+                }
+                if (size)
+                    memcpy(out->value.array_val, in->value.array_val, size);
+            }
+            break;
         case SEE_MSG_PART_NOT_INIT:
             // just leave the output uninitialized as well.
             break;
@@ -334,6 +463,11 @@ msg_part_length(
             *size = sizeof(int64_t);
             break;
         case SEE_MSG_PART_STRING_T:
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
             *size = part->length - (
                 sizeof(part->value_type) + sizeof(part->length)
                 );
@@ -531,11 +665,14 @@ msg_part_write_string(
     SeeError**    error_out
     )
 {
-    char* duplicate = strdup(value);
+    // value doesn't have to be '\0' terminated, so don't strdup it.
+    char* duplicate = malloc(length + 1);
     if (!duplicate) {
         see_runtime_error_new(error_out, errno);
         return SEE_ERROR_RUNTIME;
     }
+    memcpy(duplicate, value, length);
+    duplicate[length] = '\0';
 
     msg_part_destroy_content(part);
 
@@ -654,6 +791,63 @@ msg_part_get_double(
     return SEE_SUCCESS;
 }
 
+static int
+msg_part_write_array(
+    SeeMsgPart*   part,
+    uint8_t       type,
+    const void*   elements,
+    size_t        n,
+    SeeError**    error_out
+    )
+{
+    size_t element_size = msg_part_array_element_size(type);
+    assert(element_size);
+
+    if (n > (UINT32_MAX - MSG_PART_HEADER) / element_size) {
+        errno = EOVERFLOW;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    size_t size = n * element_size;
+    void* duplicate = malloc(size ? size : 1);
+    if (!duplicate) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+    if (size)
+        memcpy(duplicate, elements, size);
+
+    msg_part_destroy_content(part);
+
+    part->length            = (uint32_t) (MSG_PART_HEADER + size);
+    part->value_type        = type;
+    part->value.array_val   = duplicate;
+
+    return SEE_SUCCESS;
+}
+
+static int
+msg_part_get_array(
+    const SeeMsgPart*   part,
+    uint8_t             type,
+    const void**        elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    if (part->value_type != type) {
+        see_msg_part_type_error_new(error_out, part->value_type, type);
+        return SEE_ERROR_MSG_PART_TYPE;
+    }
+
+    *elements_out   = part->value.array_val;
+    *n_out          = (part->length - MSG_PART_HEADER) /
+                      msg_part_array_element_size(type);
+
+    return SEE_SUCCESS;
+}
+
 static int
 msg_part_buffer_length(
     const SeeMsgPart* part,
@@ -748,6 +942,27 @@ msg_part_write(
             memcpy(&bytes[nwritten], &net_order.dbl, sizeof(net_order.dbl));
             nwritten += sizeof(net_order.dbl);
             break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            {
+                size_t element_size = msg_part_array_element_size(
+                    part->value_type
+                    );
+                uint32_t net_length = see_host_to_network32(part->length);
+                memcpy(&bytes[nwritten], &net_length, sizeof(net_length));
+                nwritten += sizeof(net_length);
+                msg_part_array_to_network(
+                    &bytes[nwritten],
+                    part->value.array_val,
+                    (part->length - MSG_PART_HEADER) / element_size,
+                    element_size
+                    );
+                nwritten += part->length - MSG_PART_HEADER;
+            }
+            break;
         default:
             errno = EINVAL;
             see_runtime_error_new(error_out, errno);
@@ -942,6 +1157,44 @@ msg_part_read(
             nread += sizeof(new_part->value.double_val);
             new_part->length = length;
             break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            {
+                size_t element_size = msg_part_array_element_size(type);
+                if (bufsiz < MSG_PART_HEADER) {
+                    ret = SEE_ERROR_MSG_INVALID;
+                    see_msg_invalid_error_new(error_out);
+                    goto fail;
+                }
+                memcpy(&length, &bytes[nread], sizeof(length));
+                nread += sizeof(length);
+                length = see_network_to_host32(length);
+                if (length < MSG_PART_HEADER || length > bufsiz ||
+                    (length - MSG_PART_HEADER) % element_size != 0)
+                {
+                    ret = SEE_ERROR_MSG_INVALID;
+                    see_msg_invalid_error_new(error_out);
+                    goto fail;
+                }
+
+                size_t size = length - MSG_PART_HEADER;
+                void* elements = malloc(size ? size : 1);
+                if (!elements) {
+                    ret = SEE_ERROR_RUNTIME;
+                    see_runtime_error_new(error_out, errno);
+                    goto fail;
+                }
+                msg_part_array_to_host(
+                    elements, &bytes[nread], size / element_size, element_size
+                    );
+                nread += size;
+                new_part->value.array_val = elements;
+                new_part->length = length;
+            }
+            break;
         default:
             ret = SEE_ERROR_MSG_INVALID;
             see_msg_invalid_error_new(error_out);
@@ -1281,6 +1534,195 @@ see_msg_part_get_double(
     return cls->get_double(part, value, error_out);
 }
 
+/*
+ * Checks the arguments and dispatches the typed array functions below.
+ */
+static int
+msg_part_write_array_checked(
+    SeeMsgPart*     part,
+    uint8_t         type,
+    const void*     elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    if (!part || (!elements && n))
+        return SEE_INVALID_ARGUMENT;
+
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgPartClass* cls = SEE_MSG_PART_GET_CLASS(part);
+
+    return cls->write_array(part, type, elements, n, error_out);
+}
+
+static int
+msg_part_get_array_checked(
+    const SeeMsgPart*   part,
+    uint8_t             type,
+    const void**        elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    if (!part || !elements_out || !n_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgPartClass* cls = SEE_MSG_PART_GET_CLASS(part);
+
+    return cls->get_array(part, type, elements_out, n_out, error_out);
+}
+
+int
+see_msg_part_write_int32_array(
+    SeeMsgPart*     part,
+    const int32_t*  elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_part_write_array_checked(
+        part, SEE_MSG_PART_INT32_ARRAY_T, elements, n, error_out
+        );
+}
+
+int
+see_msg_part_get_int32_array(
+    const SeeMsgPart*   part,
+    const int32_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_part_get_array_checked(
+        part,
+        SEE_MSG_PART_INT32_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
+
+int
+see_msg_part_write_int64_array(
+    SeeMsgPart*     part,
+    const int64_t*  elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_part_write_array_checked(
+        part, SEE_MSG_PART_INT64_ARRAY_T, elements, n, error_out
+        );
+}
+
+int
+see_msg_part_get_int64_array(
+    const SeeMsgPart*   part,
+    const int64_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_part_get_array_checked(
+        part,
+        SEE_MSG_PART_INT64_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
+
+int
+see_msg_part_write_float_array(
+    SeeMsgPart*     part,
+    const float*    elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_part_write_array_checked(
+        part, SEE_MSG_PART_FLOAT_ARRAY_T, elements, n, error_out
+        );
+}
+
+int
+see_msg_part_get_float_array(
+    const SeeMsgPart*   part,
+    const float**       elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_part_get_array_checked(
+        part,
+        SEE_MSG_PART_FLOAT_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
+
+int
+see_msg_part_write_double_array(
+    SeeMsgPart*     part,
+    const double*   elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_part_write_array_checked(
+        part, SEE_MSG_PART_DOUBLE_ARRAY_T, elements, n, error_out
+        );
+}
+
+int
+see_msg_part_get_double_array(
+    const SeeMsgPart*   part,
+    const double**      elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_part_get_array_checked(
+        part,
+        SEE_MSG_PART_DOUBLE_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
+
+int
+see_msg_part_write_bytes(
+    SeeMsgPart*     part,
+    const void*     bytes,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_part_write_array_checked(
+        part, SEE_MSG_PART_BYTES_T, bytes, n, error_out
+        );
+}
+
+int
+see_msg_part_get_bytes(
+    const SeeMsgPart*   part,
+    const void**        bytes_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_part_get_array_checked(
+        part, SEE_MSG_PART_BYTES_T, bytes_out, n_out, error_out
+        );
+}
+
 int
 see_msg_part_buffer_length(
     const SeeMsgPart* part,
@@ -1389,6 +1831,9 @@ static int see_msg_part_class_init(SeeObjectClass* new_cls)
     cls->write_double   = msg_part_write_double;
     cls->get_double     = msg_part_get_double;
 
+    cls->write_array    = msg_part_write_array;
+    cls->get_array      = msg_part_get_array;
+
     cls->buffer_length  = msg_part_buffer_length;
 
     cls->write          = msg_part_write;
@@ -1440,620 +1885,2109 @@ see_msg_part_class()
     return g_SeeMsgPartClass;
 }
 
-/* ********************************************************************* */
-/* **** functions that implement SeeMsgBuffer or override SeeObject **** */
-/* ********************************************************************* */
+/*
+ * Bytes that are added by reference aren't copied into the arena. A message
+ * and its copies share one msg_bytes_ref, the bytes are released when the
+ * last record that refers to them is destroyed.
+ */
+typedef struct msg_bytes_ref {
+    size_t                      refcount;
+    const void*                 bytes;
+    see_msg_bytes_release_func  release;
+    void*                       context;
+} msg_bytes_ref;
 
-static int
-msg_buffer_init(
-    SeeMsgBuffer*               msg_buffer,
-    const SeeMsgBufferClass*    msg_buffer_cls,
-    uint16_t                    id,
-    SeeError**                  error_out
-    )
-{
-    int ret = SEE_SUCCESS;
-    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(
-        msg_buffer
-        );
-        
-    parent_cls->object_init(
-        SEE_OBJECT(msg_buffer),
-        SEE_OBJECT_CLASS(msg_buffer_cls)
-        );
-    
-    ret = see_dynamic_array_new(
-        &msg_buffer->parts,
-        sizeof(SeeMsgPart*),
-        see_copy_by_ref,
-        see_init_memset,
-        see_free_see_object,
-        error_out
-        );
-    if (ret)
-        return ret;
+/*
+ * The parts of a SeeMsgBuffer are not stored as SeeMsgParts, but as
+ * msg_records in the parts array. The characters of a string are stored
+ * in the strings arena of the message, the record refers to them by offset
+ * so the records remain valid when the arena grows.
+ */
+typedef struct msg_record {
+    union {
+        int32_t         int32_val;
+        uint32_t        uint32_val;
+        int64_t         int64_val;
+        uint64_t        uint64_val;
+        float           float_val;
+        double          double_val;
+        uint64_t        str_offset;
+        msg_bytes_ref*  bytes_ref;
+    } value;
+    uint32_t    length;     // The length of the part in the bytestream.
+    uint8_t     value_type;
+    uint8_t     flags;
+} msg_record;
 
-    msg_buffer->id = id;
-    msg_buffer->length = strlen(msg_buffer_cls->msg_start) +
-                         sizeof(msg_buffer->id)            +
-                         sizeof(msg_buffer->length);
+/*
+ * The record refers to the bytes of the caller via value.bytes_ref.
+ */
+#define MSG_RECORD_BYTES_REF 0x01
 
-    return ret;
+/*
+ * The type and length bytes that precede the characters of a string.
+ */
+#define MSG_RECORD_STRING_HEADER (sizeof(uint8_t) + sizeof(uint32_t))
+
+/*
+ * The initial size of the strings arena.
+ */
+#define MSG_BUFFER_MIN_STRINGS 64
+
+static const msg_record*
+msg_buffer_records(const SeeMsgBuffer* msg)
+{
+    return see_dynamic_array_data(msg->parts);
 }
 
-static int
-init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+static const char*
+msg_record_string(const SeeMsgBuffer* msg, const msg_record* record)
 {
-    const SeeMsgBufferClass* msg_buffer_cls = SEE_MSG_BUFFER_CLASS(cls);
-    SeeMsgBuffer* msg_buffer = SEE_MSG_BUFFER(obj);
-    
-    /*Extract parameters here from va_list args here.*/
-    int id           = va_arg(args, int);
-    SeeError** error = va_arg(args, SeeError**);
+    return msg->strings + record->value.str_offset;
+}
 
-    // uint16_t are promoted to int but id should be in the range [0, 65535]
-    assert(id >= 0 && id <= 65535);
+static size_t
+msg_record_string_length(const msg_record* record)
+{
+    return record->length - MSG_RECORD_STRING_HEADER;
+}
 
-    uint16_t short_id = (uint16_t) id;
+/*
+ * The elements of an array are stored in the arena too, aligned so that
+ * they can be handed out as typed pointers.
+ */
+static const void*
+msg_record_array(const SeeMsgBuffer* msg, const msg_record* record)
+{
+    if (record->flags & MSG_RECORD_BYTES_REF)
+        return record->value.bytes_ref->bytes;
+    return msg->strings + record->value.str_offset;
+}
+
+static size_t
+msg_record_array_size(const msg_record* record)
+{
+    return (record->length - MSG_PART_HEADER) /
+           msg_part_array_element_size(record->value_type);
+}
+
+/*
+ * Returns the payload of strings and bytes, these are sent as they are
+ * stored. For other records NULL is returned.
+ */
+static const char*
+msg_record_raw_payload(const SeeMsgBuffer* msg, const msg_record* record)
+{
+    if (record->value_type == SEE_MSG_PART_STRING_T)
+        return msg_record_string(msg, record);
+    if (record->value_type == SEE_MSG_PART_BYTES_T)
+        return msg_record_array(msg, record);
+    return NULL;
+}
+
+static void
+msg_bytes_ref_decref(msg_bytes_ref* ref)
+{
+    assert(ref->refcount > 0);
+    if (--ref->refcount)
+        return;
+
+    if (ref->release)
+        ref->release((void*) ref->bytes, ref->context);
+    free(ref);
+}
+
+/*
+ * The release function of bytes that are owned by a SeeObject.
+ */
+static void
+msg_bytes_release_object(void* bytes, void* owner)
+{
+    (void) bytes;
+    see_object_decref(owner);
+}
+
+/*
+ * Fills a record with the value of a part. For strings and arrays, str_out
+ * points to the characters or elements of the part.
+ */
+static int
+msg_record_from_part(
+    const SeeMsgPart*   part,
+    msg_record*         record,
+    const char**        str_out,
+    SeeError**          error_out
+    )
+{
+    memset(record, 0, sizeof(*record));
+    record->value_type = part->value_type;
+    record->length     = part->length;
+    *str_out           = NULL;
+
+    switch (part->value_type) {
+        case SEE_MSG_PART_INT32_T:
+        case SEE_MSG_PART_UINT32_T:
+        case SEE_MSG_PART_FLOAT_T:
+            record->value.uint32_val = part->value.uint32_val;
+            break;
+        case SEE_MSG_PART_INT64_T:
+        case SEE_MSG_PART_UINT64_T:
+        case SEE_MSG_PART_DOUBLE_T:
+            record->value.uint64_val = part->value.uint64_val;
+            break;
+        case SEE_MSG_PART_STRING_T:
+            *str_out = part->value.str_val;
+            break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            *str_out = part->value.array_val;
+            break;
+        default:
+            errno = EINVAL;
+            see_runtime_error_new(error_out, errno);
+            return SEE_ERROR_RUNTIME;
+    }
+    return SEE_SUCCESS;
+}
+
+/*
+ * Creates a new SeeMsgPart from a record.
+ */
+static int
+msg_record_to_part(
+    const SeeMsgBuffer* msg,
+    const msg_record*   record,
+    SeeMsgPart**        part_out,
+    SeeError**          error_out
+    )
+{
+    SeeMsgPart* part = NULL;
+    int ret = see_msg_part_new(&part, error_out);
+    if (ret)
+        return ret;
+
+    switch (record->value_type) {
+        case SEE_MSG_PART_INT32_T:
+            ret = see_msg_part_write_int32(
+                part, record->value.int32_val, error_out
+                );
+            break;
+        case SEE_MSG_PART_UINT32_T:
+            ret = see_msg_part_write_uint32(
+                part, record->value.uint32_val, error_out
+                );
+            break;
+        case SEE_MSG_PART_INT64_T:
+            ret = see_msg_part_write_int64(
+                part, record->value.int64_val, error_out
+                );
+            break;
+        case SEE_MSG_PART_UINT64_T:
+            ret = see_msg_part_write_uint64(
+                part, record->value.uint64_val, error_out
+                );
+            break;
+        case SEE_MSG_PART_STRING_T:
+            ret = see_msg_part_write_string(
+                part,
+                msg_record_string(msg, record),
+                msg_record_string_length(record),
+                error_out
+                );
+            break;
+        case SEE_MSG_PART_FLOAT_T:
+            ret = see_msg_part_write_float(
+                part, record->value.float_val, error_out
+                );
+            break;
+        case SEE_MSG_PART_DOUBLE_T:
+            ret = see_msg_part_write_double(
+                part, record->value.double_val, error_out
+                );
+            break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            ret = SEE_MSG_PART_GET_CLASS(part)->write_array(
+                part,
+                record->value_type,
+                msg_record_array(msg, record),
+                msg_record_array_size(record),
+                error_out
+                );
+            break;
+        default:
+            assert(0 == 1);
+            ret = SEE_INVALID_ARGUMENT;
+    }
+
+    if (ret) {
+        see_object_decref(SEE_OBJECT(part));
+        return ret;
+    }
+
+    if (*part_out)
+        see_object_decref(SEE_OBJECT(*part_out));
+    *part_out = part;
+    return ret;
+}
+
+static int
+msg_record_equal(
+    const SeeMsgBuffer* self,
+    const msg_record*   record,
+    const SeeMsgBuffer* other,
+    const msg_record*   other_record
+    )
+{
+    if (record->value_type != other_record->value_type)
+        return 0;
+    if (record->length != other_record->length)
+        return 0;
+
+    switch (record->value_type) {
+        case SEE_MSG_PART_INT32_T:
+        case SEE_MSG_PART_UINT32_T:
+            return record->value.uint32_val == other_record->value.uint32_val;
+        case SEE_MSG_PART_INT64_T:
+        case SEE_MSG_PART_UINT64_T:
+            return record->value.uint64_val == other_record->value.uint64_val;
+        case SEE_MSG_PART_STRING_T:
+            return memcmp(
+                msg_record_string(self, record),
+                msg_record_string(other, other_record),
+                msg_record_string_length(record)
+                ) == 0;
+        case SEE_MSG_PART_FLOAT_T:
+            return record->value.float_val == other_record->value.float_val;
+        case SEE_MSG_PART_DOUBLE_T:
+            return record->value.double_val == other_record->value.double_val;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            return memcmp(
+                msg_record_array(self, record),
+                msg_record_array(other, other_record),
+                record->length - MSG_PART_HEADER
+                ) == 0;
+        default:
+            assert(0 == 1);
+            return 0;
+    }
+}
+
+/*
+ * Writes the bytestream representation of a record, returns the number
+ * of bytes written.
+ */
+static size_t
+msg_record_write(
+    const SeeMsgBuffer* msg,
+    const msg_record*   record,
+    char*               bytes
+    )
+{
+    size_t   nwritten = 0;
+    uint32_t net32;
+    uint64_t net64;
+
+    memcpy(&bytes[nwritten], &record->value_type, sizeof(record->value_type));
+    nwritten += sizeof(record->value_type);
+
+    switch (record->value_type) {
+        case SEE_MSG_PART_INT32_T:
+        case SEE_MSG_PART_UINT32_T:
+        case SEE_MSG_PART_FLOAT_T:
+            net32 = see_host_to_network32(record->value.uint32_val);
+            memcpy(&bytes[nwritten], &net32, sizeof(net32));
+            nwritten += sizeof(net32);
+            break;
+        case SEE_MSG_PART_INT64_T:
+        case SEE_MSG_PART_UINT64_T:
+        case SEE_MSG_PART_DOUBLE_T:
+            net64 = see_host_to_network64(record->value.uint64_val);
+            memcpy(&bytes[nwritten], &net64, sizeof(net64));
+            nwritten += sizeof(net64);
+            break;
+        case SEE_MSG_PART_STRING_T:
+            net32 = see_host_to_network32(record->length);
+            memcpy(&bytes[nwritten], &net32, sizeof(net32));
+            nwritten += sizeof(net32);
+            memcpy(
+                &bytes[nwritten],
+                msg_record_string(msg, record),
+                msg_record_string_length(record)
+                );
+            nwritten += msg_record_string_length(record);
+            break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            net32 = see_host_to_network32(record->length);
+            memcpy(&bytes[nwritten], &net32, sizeof(net32));
+            nwritten += sizeof(net32);
+            msg_part_array_to_network(
+                &bytes[nwritten],
+                msg_record_array(msg, record),
+                msg_record_array_size(record),
+                msg_part_array_element_size(record->value_type)
+                );
+            nwritten += record->length - MSG_PART_HEADER;
+            break;
+        default:
+            assert(0 == 1);
+    }
+
+    assert(nwritten == record->length);
+    return nwritten;
+}
+
+/*
+ * Parses a record from a bytestream, this is the inverse of
+ * msg_record_write. For strings and arrays str_out points to the payload
+ * inside the bytestream, the elements of an array are in network order.
+ */
+static int
+msg_record_read(
+    const char*     bytes,
+    size_t          bufsiz,
+    msg_record*     record,
+    const char**    str_out,
+    SeeError**      error_out
+    )
+{
+    uint32_t net32;
+    uint64_t net64;
+    uint32_t length;
+
+    memset(record, 0, sizeof(*record));
+    *str_out = NULL;
+
+    if (bufsiz < sizeof(record->value_type)) {
+        see_msg_invalid_error_new(error_out);
+        return SEE_ERROR_MSG_INVALID;
+    }
+    record->value_type = (uint8_t) bytes[0];
+    bytes += sizeof(record->value_type);
+
+    switch (record->value_type) {
+        case SEE_MSG_PART_INT32_T:
+        case SEE_MSG_PART_UINT32_T:
+        case SEE_MSG_PART_FLOAT_T:
+            length = sizeof(record->value_type) + sizeof(net32);
+            if (length > bufsiz)
+                break;
+            memcpy(&net32, bytes, sizeof(net32));
+            record->value.uint32_val = see_network_to_host32(net32);
+            record->length = length;
+            return SEE_SUCCESS;
+        case SEE_MSG_PART_INT64_T:
+        case SEE_MSG_PART_UINT64_T:
+        case SEE_MSG_PART_DOUBLE_T:
+            length = sizeof(record->value_type) + sizeof(net64);
+            if (length > bufsiz)
+                break;
+            memcpy(&net64, bytes, sizeof(net64));
+            record->value.uint64_val = see_network_to_host64(net64);
+            record->length = length;
+            return SEE_SUCCESS;
+        case SEE_MSG_PART_STRING_T:
+            if (bufsiz < MSG_RECORD_STRING_HEADER)
+                break;
+            memcpy(&net32, bytes, sizeof(net32));
+            length = see_network_to_host32(net32);
+            if (length < MSG_RECORD_STRING_HEADER || length > bufsiz)
+                break;
+            record->length = length;
+            *str_out = bytes + sizeof(net32);
+            return SEE_SUCCESS;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+        case SEE_MSG_PART_BYTES_T:
+            if (bufsiz < MSG_PART_HEADER)
+                break;
+            memcpy(&net32, bytes, sizeof(net32));
+            length = see_network_to_host32(net32);
+            if (length < MSG_PART_HEADER || length > bufsiz)
+                break;
+            if ((length - MSG_PART_HEADER) %
+                    msg_part_array_element_size(record->value_type))
+                break;
+            record->length = length;
+            *str_out = bytes + sizeof(net32);
+            return SEE_SUCCESS;
+        default:
+            break;
+    }
+
+    see_msg_invalid_error_new(error_out);
+    return SEE_ERROR_MSG_INVALID;
+}
+
+/*
+ * Reserves length bytes at the end of the arena, the offset of the
+ * reserved bytes is a multiple of align.
+ */
+static int
+msg_buffer_reserve(
+    SeeMsgBuffer*   msg,
+    size_t          length,
+    size_t          align,
+    uint64_t*       offset_out,
+    SeeError**      error_out
+    )
+{
+    size_t offset = (msg->strings_size + align - 1) / align * align;
+    size_t needed = offset + length;
+
+    // The arena is allocated even for an empty string, so the payload of a
+    // record is never a NULL pointer, not even when it has no bytes.
+    if (needed > msg->strings_capacity || !msg->strings) {
+        size_t capacity = msg->strings_capacity;
+        if (capacity < MSG_BUFFER_MIN_STRINGS)
+            capacity = MSG_BUFFER_MIN_STRINGS;
+        while (capacity < needed)
+            capacity *= 2;
+
+        char* strings = realloc(msg->strings, capacity);
+        if (!strings) {
+            see_runtime_error_new(error_out, errno);
+            return SEE_ERROR_RUNTIME;
+        }
+        msg->strings          = strings;
+        msg->strings_capacity = capacity;
+    }
+
+    *offset_out = offset;
+    msg->strings_size = needed;
+
+    return SEE_SUCCESS;
+}
+
+/*
+ * Copies length characters to the end of the strings arena.
+ */
+static int
+msg_buffer_store_string(
+    SeeMsgBuffer*   msg,
+    const char*     str,
+    size_t          length,
+    uint64_t*       offset_out,
+    SeeError**      error_out
+    )
+{
+    int ret = msg_buffer_reserve(msg, length, 1, offset_out, error_out);
+    if (ret)
+        return ret;
+
+    if (length && str)
+        memcpy(&msg->strings[*offset_out], str, length);
+
+    return SEE_SUCCESS;
+}
+
+/*
+ * Copies the elements of an array to the arena, elements in network order
+ * are converted to host order on the fly.
+ */
+static int
+msg_buffer_store_array(
+    SeeMsgBuffer*       msg,
+    const msg_record*   record,
+    const void*         elements,
+    int                 network_order,
+    uint64_t*           offset_out,
+    SeeError**          error_out
+    )
+{
+    size_t element_size = msg_part_array_element_size(record->value_type);
+    size_t n = msg_record_array_size(record);
+
+    int ret = msg_buffer_reserve(
+        msg, n * element_size, sizeof(uint64_t), offset_out, error_out
+        );
+    if (ret || !n || !elements)
+        return ret;
+
+    void* dst = &msg->strings[*offset_out];
+    if (network_order)
+        msg_part_array_to_host(dst, elements, n, element_size);
+    else
+        memcpy(dst, elements, n * element_size);
+
+    return SEE_SUCCESS;
+}
+
+/*
+ * Appends a record to the message, payload should point to the characters
+ * of string records or the elements of array records. The elements are in
+ * network order when network_order is true. Records that refer to bytes
+ * share the reference instead.
+ */
+static int
+msg_buffer_append_record(
+    SeeMsgBuffer*       msg,
+    const msg_record*   record,
+    const void*         payload,
+    int                 network_order,
+    SeeError**          error_out
+    )
+{
+    int ret = SEE_SUCCESS;
+    msg_record new_record = *record;
+    size_t strings_size   = msg->strings_size;
+
+    if (record->length > UINT32_MAX - msg->length) {
+        errno = EOVERFLOW;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    if (record->value_type == SEE_MSG_PART_STRING_T) {
+        ret = msg_buffer_store_string(
+            msg,
+            payload,
+            msg_record_string_length(record),
+            &new_record.value.str_offset,
+            error_out
+            );
+    }
+    else if (msg_part_array_element_size(record->value_type) &&
+             !(record->flags & MSG_RECORD_BYTES_REF))
+    {
+        ret = msg_buffer_store_array(
+            msg,
+            record,
+            payload,
+            network_order,
+            &new_record.value.str_offset,
+            error_out
+            );
+    }
+    if (ret)
+        return ret;
+
+    ret = see_dynamic_array_add(msg->parts, &new_record, error_out);
+    if (ret) {
+        msg->strings_size = strings_size;
+        return ret;
+    }
+
+    if (new_record.flags & MSG_RECORD_BYTES_REF)
+        new_record.value.bytes_ref->refcount++;
+
+    msg->length += record->length;
+    return SEE_SUCCESS;
+}
+
+/*
+ * Makes sure that the part cache contains a SeeMsgPart for the first n
+ * records. The cache is only used to hand out SeeMsgParts that are owned
+ * by the message, it doesn't alter the value of the message.
+ */
+static int
+msg_buffer_cache_parts(
+    const SeeMsgBuffer* const_msg,
+    size_t              n,
+    SeeError**          error_out
+    )
+{
+    int ret;
+    SeeMsgBuffer* msg = (SeeMsgBuffer*) const_msg;
+    const msg_record* records = msg_buffer_records(msg);
+
+    if (!msg->part_cache) {
+        ret = see_dynamic_array_new(
+            &msg->part_cache,
+            sizeof(SeeMsgPart*),
+            see_copy_by_ref,
+            see_init_memset,
+            see_free_see_object,
+            error_out
+            );
+        if (ret)
+            return ret;
+    }
+
+    for (size_t i = see_dynamic_array_size(msg->part_cache); i < n; i++) {
+        SeeMsgPart* part = NULL;
+        ret = msg_record_to_part(msg, &records[i], &part, error_out);
+        if (ret)
+            return ret;
+
+        ret = see_dynamic_array_add(msg->part_cache, &part, error_out);
+        see_object_decref(SEE_OBJECT(part));
+        if (ret)
+            return ret;
+    }
+
+    return SEE_SUCCESS;
+}
+
+/*
+ * Appends a scalar part of the given type, value points to 4 or 8 bytes.
+ */
+static int
+msg_buffer_add_scalar(
+    SeeMsgBuffer*           msg,
+    see_msg_part_value_t    type,
+    const void*             value,
+    size_t                  size,
+    SeeError**              error_out
+    )
+{
+    msg_record record;
+
+    if (!msg || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    memset(&record, 0, sizeof(record));
+    record.value_type = type;
+    record.length     = (uint32_t) (sizeof(record.value_type) + size);
+    memcpy(&record.value, value, size);
+
+    return msg_buffer_append_record(msg, &record, NULL, 0, error_out);
+}
+
+/*
+ * Obtains the record at index, it must be of the given type.
+ */
+static int
+msg_buffer_record_at(
+    const SeeMsgBuffer*     msg,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    const msg_record**      record_out,
+    SeeError**              error_out
+    )
+{
+    if (!msg || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (index >= see_dynamic_array_size(msg->parts)) {
+        see_index_error_new(error_out, index);
+        return SEE_ERROR_INDEX;
+    }
+
+    const msg_record* record = &msg_buffer_records(msg)[index];
+    if (record->value_type != type) {
+        see_msg_part_type_error_new(error_out, record->value_type, type);
+        return SEE_ERROR_MSG_PART_TYPE;
+    }
+
+    *record_out = record;
+    return SEE_SUCCESS;
+}
+
+/*
+ * Appends an array part of the given type.
+ */
+static int
+msg_buffer_add_array(
+    SeeMsgBuffer*           msg,
+    see_msg_part_value_t    type,
+    const void*             elements,
+    size_t                  n,
+    SeeError**              error_out
+    )
+{
+    msg_record record;
+    size_t element_size = msg_part_array_element_size(type);
+
+    if (!msg || (!elements && n) || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (n > (UINT32_MAX - MSG_PART_HEADER) / element_size) {
+        errno = EOVERFLOW;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    memset(&record, 0, sizeof(record));
+    record.value_type = type;
+    record.length     = (uint32_t) (MSG_PART_HEADER + n * element_size);
+
+    return msg_buffer_append_record(msg, &record, elements, 0, error_out);
+}
+
+/*
+ * Obtains the elements of the array part at index.
+ */
+static int
+msg_buffer_array_at(
+    const SeeMsgBuffer*     msg,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    const void**            elements_out,
+    size_t*                 n_out,
+    SeeError**              error_out
+    )
+{
+    const msg_record* record;
+
+    if (!elements_out || !n_out)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = msg_buffer_record_at(msg, index, type, &record, error_out);
+    if (ret)
+        return ret;
+
+    *elements_out   = msg_record_array(msg, record);
+    *n_out          = msg_record_array_size(record);
+    return SEE_SUCCESS;
+}
+
+/*
+ * Appends a bytes part that refers to the bytes of the caller. When this
+ * fails, the bytes aren't released.
+ */
+static int
+msg_buffer_add_bytes_ref(
+    SeeMsgBuffer*               msg,
+    const void*                 bytes,
+    size_t                      n,
+    see_msg_bytes_release_func  release,
+    void*                       context,
+    SeeError**                  error_out
+    )
+{
+    msg_record record;
+
+    if (!msg || (!bytes && n) || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (n > UINT32_MAX - MSG_PART_HEADER) {
+        errno = EOVERFLOW;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    msg_bytes_ref* ref = malloc(sizeof(msg_bytes_ref));
+    if (!ref) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+    ref->refcount   = 0;
+    ref->bytes      = bytes;
+    ref->release    = release;
+    ref->context    = context;
+
+    memset(&record, 0, sizeof(record));
+    record.value_type       = SEE_MSG_PART_BYTES_T;
+    record.length           = (uint32_t) (MSG_PART_HEADER + n);
+    record.flags            = MSG_RECORD_BYTES_REF;
+    record.value.bytes_ref  = ref;
+
+    int ret = msg_buffer_append_record(msg, &record, NULL, 0, error_out);
+    if (ret)
+        free(ref);
+    return ret;
+}
+
+/* ********************************************************************* */
+/* **** functions that implement SeeMsgBuffer or override SeeObject **** */
+/* ********************************************************************* */
+
+static int
+msg_buffer_init(
+    SeeMsgBuffer*               msg_buffer,
+    const SeeMsgBufferClass*    msg_buffer_cls,
+    uint16_t                    id,
+    SeeError**                  error_out
+    )
+{
+    int ret = SEE_SUCCESS;
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(
+        msg_buffer
+        );
+
+    parent_cls->object_init(
+        SEE_OBJECT(msg_buffer),
+        SEE_OBJECT_CLASS(msg_buffer_cls)
+        );
+
+    ret = see_dynamic_array_new_inline(
+        &msg_buffer->parts,
+        sizeof(msg_record),
+        NULL,
+        NULL,
+        NULL,
+        MSG_BUFFER_INLINE_PARTS,
+        error_out
+        );
+    if (ret)
+        return ret;
+
+    msg_buffer->id = id;
+    msg_buffer->length = strlen(msg_buffer_cls->msg_start) +
+                         sizeof(msg_buffer->id)            +
+                         sizeof(msg_buffer->length);
+
+    msg_buffer->strings             = NULL;
+    msg_buffer->strings_size        = 0;
+    msg_buffer->strings_capacity    = 0;
+    msg_buffer->part_cache          = NULL;
+    msg_buffer->crc                 = 0;
+
+    return ret;
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeMsgBufferClass* msg_buffer_cls = SEE_MSG_BUFFER_CLASS(cls);
+    SeeMsgBuffer* msg_buffer = SEE_MSG_BUFFER(obj);
+
+    /*Extract parameters here from va_list args here.*/
+    int id           = va_arg(args, int);
+    SeeError** error = va_arg(args, SeeError**);
+
+    // uint16_t are promoted to int but id should be in the range [0, 65535]
+    assert(id >= 0 && id <= 65535);
+
+    uint16_t short_id = (uint16_t) id;
+
+    return msg_buffer_cls->msg_buffer_init(
+        msg_buffer,
+        msg_buffer_cls,
+        short_id,
+        error
+        );
+}
+
+static void
+msg_buffer_destroy(SeeObject* obj)
+{
+    const SeeObjectClass* cls = see_object_class();
+    SeeMsgBuffer* msg = SEE_MSG_BUFFER(obj);
+
+    if (msg->parts) {
+        const msg_record* records = msg_buffer_records(msg);
+        for (size_t i = 0; i < see_dynamic_array_size(msg->parts); i++)
+            if (records[i].flags & MSG_RECORD_BYTES_REF)
+                msg_bytes_ref_decref(records[i].value.bytes_ref);
+    }
+
+    see_object_decref(SEE_OBJECT(msg->parts));
+    see_object_decref(SEE_OBJECT(msg->part_cache));
+    free(msg->strings);
+    cls->destroy(obj);
+}
+
+static int
+msg_buffer_equal(
+    const SeeObject*    so_self,
+    const SeeObject*    so_other,
+    int*                result,
+    SeeError**          error
+    )
+{
+    const SeeMsgBuffer* self, *other;
+    int ret, isinstance;
+    size_t npart, npartother;
 
-    return msg_buffer_cls->msg_buffer_init(
-        msg_buffer,
-        msg_buffer_cls,
-        short_id,
-        error
+    if (so_self == so_other) {
+        *result = true;
+        return SEE_SUCCESS;
+    }
+
+#if !defined(NDEBUG)
+    ret = see_object_is_instance_of(
+        so_self,
+        SEE_OBJECT_CLASS(see_msg_buffer_class()),
+        &isinstance
+        );
+    assert(ret == SEE_SUCCESS && isinstance);
+#endif
+
+    ret = see_object_is_instance_of(
+        so_other,
+        SEE_OBJECT_CLASS(see_msg_buffer_class()),
+        &isinstance
+        );
+    assert(ret == SEE_SUCCESS);
+    if (!isinstance) {
+        see_incomparable_error_new(
+            error,
+            see_object_get_class(so_self),
+            see_object_get_class(so_other)
+            );
+        return SEE_ERROR_INCOMPARABLE;
+    }
+
+    self = (const SeeMsgBuffer*) so_self;
+    other= (const SeeMsgBuffer*) so_other;
+
+    if (self->id != other->id) {
+        *result = false;
+        return SEE_SUCCESS;
+    }
+
+    if (self->length != other->length) {
+        *result = false;
+        return SEE_SUCCESS;
+    }
+
+    ret = see_msg_buffer_num_parts(self, &npart);
+    assert(ret == SEE_SUCCESS);
+    ret = see_msg_buffer_num_parts(other,&npartother);
+    assert(ret == SEE_SUCCESS);
+    (void) ret;
+    if (npart != npartother) {
+        *result = false;
+        return SEE_SUCCESS;
+    }
+
+    const msg_record* self_records  = msg_buffer_records(self);
+    const msg_record* other_records = msg_buffer_records(other);
+
+    for (size_t i = 0; i < npart; i++) {
+        if (!msg_record_equal(self, &self_records[i], other, &other_records[i])) {
+            *result = false;
+            return SEE_SUCCESS;
+        }
+    }
+
+    *result = true;
+    return SEE_SUCCESS;
+}
+
+static int
+msg_buffer_not_equal(
+    const SeeObject*    so_self,
+    const SeeObject*    so_other,
+    int*                result,
+    SeeError**          error
+    )
+{
+    int ret, tres;
+    ret = msg_buffer_equal(so_self, so_other, &tres, error);
+    if (ret == SEE_SUCCESS)
+        *result = !tres;
+    return ret;
+}
+
+static int
+msg_buffer_copy(
+    const SeeObject* msg_in,
+    SeeObject**      msg_out,
+    SeeError**       error_out
+    )
+{
+    int ret;
+    uint16_t id;
+    size_t   sz;
+
+    SeeMsgBuffer* out = NULL;
+    const SeeMsgBuffer* in = (const void*) msg_in;
+
+    ret = see_msg_buffer_get_id(in, &id);
+    if (ret)
+        goto fail;
+
+    ret = see_msg_buffer_new(&out, id, error_out);
+    if (ret)
+        goto fail;
+
+    out->crc     = in->crc;
+    out->length += in->crc ? MSG_BUFFER_TRAILER : 0;
+
+    see_msg_buffer_num_parts(in, &sz);
+    ret = see_dynamic_array_reserve(out->parts, sz, error_out);
+    if (ret)
+        goto fail;
+
+    const msg_record* records = msg_buffer_records(in);
+    for (size_t i = 0; i < sz; i++) {
+        const char* str = NULL;
+        if (records[i].value_type == SEE_MSG_PART_STRING_T)
+            str = msg_record_string(in, &records[i]);
+        else if (msg_part_array_element_size(records[i].value_type))
+            str = msg_record_array(in, &records[i]);
+
+        ret = msg_buffer_append_record(out, &records[i], str, 0, error_out);
+        if (ret)
+            goto fail;
+    }
+
+    if (*msg_out)
+        see_object_decref(SEE_OBJECT(*msg_out));
+    *msg_out = SEE_OBJECT(out);
+
+    return ret;
+
+fail:
+    see_object_decref(SEE_OBJECT(out));
+    return ret;
+}
+
+static int
+msg_buffer_set_id(
+    SeeMsgBuffer*       mbuf,
+    uint16_t            id
+    )
+{
+    mbuf->id = id;
+    return SEE_SUCCESS;
+}
+
+static int
+msg_buffer_get_id(
+    const SeeMsgBuffer* mbuf,
+    uint16_t*           id
+    )
+{
+    *id = mbuf->id;
+    return SEE_SUCCESS;
+}
+
+static int
+msg_buffer_calc_length(
+    SeeMsgBuffer*       msg,
+    uint32_t*           length,
+    SeeError**          error
+    )
+{
+    size_t size = 0;
+    size_t num_parts;
+    uint32_t max = 0;
+    max -= 1;
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+
+    size += strlen(cls->msg_start);
+    size += sizeof(msg->id);
+    size += sizeof(uint32_t); // The total length of the message
+
+    int ret = see_msg_buffer_num_parts(msg, &num_parts);
+    assert(ret == SEE_SUCCESS);
+    (void) ret;
+
+    const msg_record* records = msg_buffer_records(msg);
+    for (size_t i = 0; i < num_parts; ++i)
+        size += records[i].length;
+
+    if (msg->crc)
+        size += MSG_BUFFER_TRAILER;
+
+    if (size > max) {
+        errno = EOVERFLOW;
+        see_runtime_error_new(error, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    *length = (uint32_t) size;
+    return SEE_SUCCESS;
+}
+
+static int
+msg_buffer_add_part(
+    SeeMsgBuffer*       mbuf,
+    const SeeMsgPart*   mpart,
+    SeeError**          error_out
+    )
+{
+    int ret;
+    msg_record  record;
+    const char* str;
+#if !defined(NDEBUG)
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(mbuf);
+#endif
+
+    ret = msg_record_from_part(mpart, &record, &str, error_out);
+    if (ret)
+        return ret;
+
+    ret = msg_buffer_append_record(mbuf, &record, str, 0, error_out);
+    if (ret)
+        return ret;
+
+#if !defined(NDEBUG)
+    uint32_t length;
+    ret = cls->calc_length(mbuf, &length, error_out);
+    assert(length == mbuf->length);
+#endif
+
+    return ret;
+}
+
+static int
+msg_buffer_get_part(
+    const SeeMsgBuffer* mbuf,
+    size_t              n,
+    SeeMsgPart**        mbpart,
+    SeeError**          error_out
+    )
+{
+    size_t n_parts = see_dynamic_array_size(mbuf->parts);
+    if (n >= n_parts) {
+        see_index_error_new(error_out, n);
+        return SEE_ERROR_INDEX;
+    }
+
+    return msg_record_to_part(
+        mbuf, &msg_buffer_records(mbuf)[n], mbpart, error_out
         );
 }
 
-static void
-msg_buffer_destroy(SeeObject* obj)
+static int
+msg_buffer_num_parts(
+    const SeeMsgBuffer* msgbuf,
+    size_t*             size
+    )
+{
+    *size = see_dynamic_array_size(msgbuf->parts);
+    return SEE_SUCCESS;
+}
+
+/*
+ * Writes the start, id and length of a message, returns the number of
+ * bytes written.
+ */
+static size_t
+msg_buffer_write_header(const SeeMsgBuffer* msg, char* bytes)
+{
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+    size_t nwritten = 0;
+
+    const char* header = cls->msg_start;
+    size_t start_length = strlen(header);
+    memcpy(&bytes[nwritten], header, start_length);
+    nwritten += start_length;
+
+    uint16_t id = see_host_to_network16(msg->id);
+    memcpy(&bytes[nwritten], &id, sizeof(id));
+    nwritten += sizeof(id);
+
+    uint32_t length = see_host_to_network32(msg->length);
+    memcpy(&bytes[nwritten], &length, sizeof(length));
+    nwritten += sizeof(length);
+
+    return nwritten;
+}
+
+/*
+ * Writes the trailer with the crc, returns the number of bytes written.
+ */
+static size_t
+msg_buffer_write_trailer(uint32_t crc, char* bytes)
 {
-    const SeeObjectClass* cls = see_object_class();
-    SeeMsgBuffer* msg = SEE_MSG_BUFFER(obj);
+    uint32_t net_crc = see_host_to_network32(crc);
 
-    see_object_decref(SEE_OBJECT(msg->parts));
-    cls->destroy(obj);
+    bytes[0] = (char) SEE_MSG_PART_TRAILER;
+    memcpy(&bytes[1], &net_crc, sizeof(net_crc));
+
+    return MSG_BUFFER_TRAILER;
 }
 
-static int
-msg_buffer_equal(
-    const SeeObject*    so_self,
-    const SeeObject*    so_other,
-    int*                result,
-    SeeError**          error
+#if defined(HAVE_SYS_UIO_H)
+
+/*
+ * Strings and bytes shorter than this are copied into the scratch area, for
+ * those an extra iovec costs more than the copy.
+ */
+#define MSG_BUFFER_IOVEC_COPY_MAX 64
+
+/*
+ * Splits a message in iovecs. When iov and scratch are NULL, only the
+ * number of iovecs and scratch bytes are counted. The trailer is computed
+ * over the iovecs, because the long payloads aren't copied.
+ */
+static void
+msg_buffer_fill_iovec(
+    const SeeMsgBuffer* msg,
+    struct iovec*       iov,
+    char*               scratch,
+    int*                n_iov_out,
+    size_t*             scratch_out
     )
 {
-    const SeeMsgBuffer* self, *other;
-    int ret, isinstance;
-    size_t npart, npartother;
+    const msg_record* records = msg_buffer_records(msg);
+    size_t num_parts = see_dynamic_array_size(msg->parts);
+    size_t used = 0, segment = 0;
+    int n = 0;
+
+    if (scratch)
+        used += msg_buffer_write_header(msg, scratch);
+    else
+        used += strlen(SEE_MSG_BUFFER_GET_CLASS(msg)->msg_start) +
+                sizeof(uint16_t) + sizeof(uint32_t);
+
+    for (size_t i = 0; i < num_parts; ++i) {
+        const msg_record* record = &records[i];
+        const char* raw = msg_record_raw_payload(msg, record);
+        size_t raw_length = raw ? record->length - MSG_PART_HEADER : 0;
+
+        if (raw_length < MSG_BUFFER_IOVEC_COPY_MAX) {
+            if (scratch)
+                msg_record_write(msg, record, &scratch[used]);
+            used += record->length;
+            continue;
+        }
 
-    if (so_self == so_other) {
-        *result = true;
-        return SEE_SUCCESS;
+        // Only the type and length go to the scratch area.
+        if (scratch) {
+            uint32_t net32 = see_host_to_network32(record->length);
+            scratch[used] = (char) record->value_type;
+            memcpy(&scratch[used + 1], &net32, sizeof(net32));
+        }
+        used += MSG_PART_HEADER;
+
+        if (iov) {
+            iov[n].iov_base     = &scratch[segment];
+            iov[n].iov_len      = used - segment;
+            iov[n + 1].iov_base = (void*) raw;
+            iov[n + 1].iov_len  = raw_length;
+        }
+        n += 2;
+        segment = used;
     }
 
-#if !defined(NDEBUG)
-    ret = see_object_is_instance_of(
-        so_self,
-        SEE_OBJECT_CLASS(see_msg_buffer_class()),
-        &isinstance
-        );
-    assert(ret == SEE_SUCCESS && isinstance);
-#endif
+    if (msg->crc) {
+        if (iov && scratch) {
+            uint32_t crc = 0;
+            for (int i = 0; i < n; i++)
+                crc = see_crc32c(crc, iov[i].iov_base, iov[i].iov_len);
+            crc = see_crc32c(crc, &scratch[segment], used - segment);
+            msg_buffer_write_trailer(crc, &scratch[used]);
+        }
+        used += MSG_BUFFER_TRAILER;
+    }
 
-    ret = see_object_is_instance_of(
-        so_other,
-        SEE_OBJECT_CLASS(see_msg_buffer_class()),
-        &isinstance
-        );
-    assert(ret == SEE_SUCCESS);
-    if (!isinstance) {
-        see_incomparable_error_new(
-            error,
-            see_object_get_class(so_self),
-            see_object_get_class(so_other)
-            );
-        return SEE_ERROR_INCOMPARABLE;
+    if (used > segment) {
+        if (iov) {
+            iov[n].iov_base = &scratch[segment];
+            iov[n].iov_len  = used - segment;
+        }
+        n++;
     }
 
-    self = (const SeeMsgBuffer*) so_self;
-    other= (const SeeMsgBuffer*) so_other;
+    *n_iov_out      = n;
+    *scratch_out    = used;
+}
 
-    if (self->id != other->id) {
-        *result = false;
-        return SEE_SUCCESS;
-    }
+#endif //if defined(HAVE_SYS_UIO_H)
 
-    if (self->length != other->length) {
-        *result = false;
-        return SEE_SUCCESS;
-    }
+static int
+msg_buffer_write_into(
+    const SeeMsgBuffer* msg,
+    void*               dst,
+    size_t              cap,
+    size_t*             written_out,
+    SeeError**          error_out
+    )
+{
+    char*   bytes = dst;
 
-    ret = see_msg_buffer_num_parts(self, &npart);
-    assert(ret == SEE_SUCCESS);
-    ret = see_msg_buffer_num_parts(other,&npartother);
-    assert(ret == SEE_SUCCESS);
-    if (npart != npartother) {
-        *result = true;
-        return SEE_SUCCESS;
+    uint32_t length;
+    size_t n, nwritten = 0;
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+
+    length = msg->length;
+    if (cap < length) {
+        // Tell the caller how large the buffer should have been.
+        *written_out = length;
+        errno = ENOBUFS;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
     }
 
-    const SeeObject** self_parts = NULL;
-    const SeeObject** other_parts= NULL;
+    cls->num_parts(msg, &n);
 
-    self_parts = see_dynamic_array_data(self->parts);
-    if (!self_parts)
-        return ret;
-    other_parts = see_dynamic_array_data(other->parts);
-    if (!other_parts)
-        return ret;
+    nwritten += msg_buffer_write_header(msg, bytes);
 
-    for (size_t i = 0; i < npart; i++) {
-        int res;
-        ret = see_object_equal(self_parts[i], other_parts[i], &res, error);
-        if (ret != SEE_SUCCESS)
-            return ret;
-        if (!res) {
-            *result = false;
-            return SEE_SUCCESS;
+    uint32_t crc = 0;
+    size_t crc_begin = 0;
+
+    const msg_record* records = msg_buffer_records(msg);
+    for (size_t i = 0; i < n; ++i) {
+        nwritten += msg_record_write(msg, &records[i], &bytes[nwritten]);
+
+        if (msg->crc && nwritten - crc_begin >= MSG_BUFFER_CRC_CHUNK) {
+            crc = see_crc32c(crc, &bytes[crc_begin], nwritten - crc_begin);
+            crc_begin = nwritten;
         }
     }
 
-    *result = true;
+    if (msg->crc) {
+        crc = see_crc32c(crc, &bytes[crc_begin], nwritten - crc_begin);
+        nwritten += msg_buffer_write_trailer(crc, &bytes[nwritten]);
+    }
+
+    assert(nwritten == length);
+
+    *written_out = nwritten;
     return SEE_SUCCESS;
 }
 
 static int
-msg_buffer_not_equal(
-    const SeeObject*    so_self,
-    const SeeObject*    so_other,
-    int*                result,
-    SeeError**          error
+msg_buffer_get_buffer(
+    SeeMsgBuffer*       msg,
+    void**              buffer_out,
+    size_t*             bufsize_out,
+    SeeError**          error_out
     )
 {
-    int ret, tres;
-    ret = msg_buffer_equal(so_self, so_other, &tres, error);
-    if (ret == SEE_SUCCESS)
-        *result = !tres;
+    int     ret;
+    char*   bytes = NULL;
+    size_t  nwritten = 0;
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+
+    bytes = malloc(msg->length);
+    if (!bytes) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    ret = cls->write_into(msg, bytes, msg->length, &nwritten, error_out);
+    if (ret)
+        goto fail;
+
+    *bufsize_out= nwritten;
+    *buffer_out = bytes;
+    return SEE_SUCCESS;
+
+fail:
+
+    free(bytes);
     return ret;
 }
 
 static int
-msg_buffer_copy(
-    const SeeObject* msg_in,
-    SeeObject**      msg_out,
-    SeeError**       error_out
+msg_buffer_from_buffer(
+    SeeMsgBuffer**  new_buf_out,
+    const void*     buffer,
+    size_t          bufsiz,
+    SeeError**      error_out
     )
 {
-    int ret;
-    uint16_t id;
-    size_t   sz;
+    uint16_t        id, id_network;
+    uint32_t        length, length_network;
+    size_t          nread = 0;
+    int             ret;
+    SeeMsgBuffer*   msg = NULL;
+    const char*     bytes = buffer;
+    const char*     msg_start = g_see_msg_start;
+    size_t          start_length = strlen(msg_start);
 
-    SeeMsgBuffer* out = NULL;
-    const SeeMsgBuffer* in = (const void*) msg_in;
+    char start[4] = {0};
 
-    ret = see_msg_buffer_get_id(in, &id);
-    if (ret)
-        goto fail;
+    if (bufsiz < (strlen(g_see_msg_start) + sizeof(id) + sizeof(length))) {
+        see_msg_invalid_error_new(error_out);
+        return SEE_ERROR_MSG_INVALID;
+    }
 
-    ret = see_msg_buffer_new(&out, id, error_out);
+    memcpy(&start[0], &bytes[nread], start_length);
+    if (memcmp(msg_start, start, start_length) != 0) {
+        see_msg_invalid_error_new(error_out);
+        return SEE_ERROR_MSG_INVALID;
+    }
+    nread += start_length;
+
+    memcpy(&id_network, &bytes[nread], sizeof(id_network));
+    id = see_network_to_host16(id_network);
+    nread += sizeof(id_network);
+
+    memcpy(&length_network, &bytes[nread], sizeof(length_network));
+    length = see_network_to_host32(length_network);
+    nread += sizeof(length);
+
+    if (length > bufsiz) {
+        see_msg_invalid_error_new(error_out);
+        return SEE_ERROR_MSG_INVALID;
+    }
+
+    ret = see_msg_buffer_new(&msg, id, error_out);
     if (ret)
-        goto fail;
+        return ret;
 
-    see_msg_buffer_num_parts(in, &sz);
-    SeeDynamicArray* parts = in->parts;
-    for (size_t i = 0; i < sz; i++) {
-        const SeeMsgPart* part = NULL;
-        ret = see_dynamic_array_get(parts, i, &part, error_out);
+    // When the message ends with a trailer, the crc is computed while the
+    // parts are parsed.
+    size_t trailer = length - MSG_BUFFER_TRAILER;
+    int maybe_crc = length >= nread + MSG_BUFFER_TRAILER &&
+                    (uint8_t) bytes[trailer] == SEE_MSG_PART_TRAILER;
+    uint32_t crc = 0;
+    size_t crc_begin = 0;
+
+    while(nread < length) {
+
+        msg_record  record;
+        const char* str = NULL;
+
+        if (maybe_crc && nread == trailer) {
+            uint32_t net_crc;
+            memcpy(&net_crc, &bytes[nread + 1], sizeof(net_crc));
+            crc = see_crc32c(crc, &bytes[crc_begin], nread - crc_begin);
+            if (crc != see_network_to_host32(net_crc)) {
+                see_msg_invalid_error_new(error_out);
+                ret = SEE_ERROR_MSG_INVALID;
+                goto fail;
+            }
+            msg->crc     = 1;
+            msg->length += MSG_BUFFER_TRAILER;
+            break;
+        }
+
+        ret = msg_record_read(
+            &bytes[nread],
+            length - nread,
+            &record,
+            &str,
+            error_out
+            );
         if (ret)
             goto fail;
 
-        ret = see_msg_buffer_add_part(out, part, error_out);
-        if (ret) {
-            see_object_decref(SEE_OBJECT(part));
+        nread += record.length;
+
+        ret = msg_buffer_append_record(msg, &record, str, 1, error_out);
+        if (ret)
             goto fail;
+
+        if (maybe_crc && nread - crc_begin >= MSG_BUFFER_CRC_CHUNK) {
+            crc = see_crc32c(crc, &bytes[crc_begin], nread - crc_begin);
+            crc_begin = nread;
         }
-        see_object_decref(SEE_OBJECT(part));
     }
 
-    if (*msg_out)
-        see_object_decref(SEE_OBJECT(*msg_out));
-    *msg_out = SEE_OBJECT(out);
+    *new_buf_out = msg;
 
     return ret;
 
 fail:
-    see_object_decref(SEE_OBJECT(out));
+
+    see_object_decref(SEE_OBJECT(msg));
     return ret;
 }
 
 static int
-msg_buffer_set_id(
-    SeeMsgBuffer*       mbuf,
-    uint16_t            id
+msg_buffer_next_span(
+    const SeeObject*    self,
+    size_t*             cursor,
+    SeeSpan*            span_out,
+    SeeError**          error_out
     )
 {
-    mbuf->id = id;
-    return SEE_SUCCESS;
+    // The span holds the SeeMsgPart* of the message.
+    const SeeMsgBuffer* msg = (const SeeMsgBuffer*) self;
+    size_t n;
+
+    msg_buffer_num_parts(msg, &n);
+    int ret = msg_buffer_cache_parts(msg, n, error_out);
+    if (ret)
+        return ret;
+
+    return see_object_next_span(
+        SEE_OBJECT(msg->part_cache), cursor, span_out, error_out
+        );
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_msg_buffer_new(SeeMsgBuffer** buf, uint16_t id, SeeError** error_out)
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(see_msg_buffer_class());
+
+    // uint16_t is promoted to int when used in a function taking variable
+    // length aruguments (in "...") so lets promote it more explicitly.
+    int iid = id;
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!buf || *buf || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(cls, 0, SEE_OBJECT_REF(buf), iid, error_out);
+}
+
+int
+see_msg_buffer_set_id(
+    SeeMsgBuffer*   msg,
+    uint16_t        id
+    )
+{
+    if (!msg)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+
+    return cls->set_id(msg, id);
 }
 
-static int
-msg_buffer_get_id(
-    const SeeMsgBuffer* mbuf,
+int
+see_msg_buffer_get_id(
+    const SeeMsgBuffer* msg,
     uint16_t*           id
     )
 {
-    *id = mbuf->id;
-    return SEE_SUCCESS;
+    if (!msg || !id)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+
+    return cls->get_id(msg, id);
 }
 
-static int
-msg_buffer_calc_length(
-    SeeMsgBuffer*       msg,
-    uint32_t*           length,
-    SeeError**          error
+int
+see_msg_buffer_set_crc(
+    SeeMsgBuffer*   msg,
+    int             enable,
+    SeeError**      error_out
     )
 {
-    size_t size = 0;
-    size_t num_parts;
-    uint32_t max = 0;
-    max -= 1;
-    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+    if (!msg || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
 
-    size += strlen(cls->msg_start);
-    size += sizeof(msg->id);
-    size += sizeof(uint32_t); // The total length of the message
+    enable = enable != 0;
+    if (enable == msg->crc)
+        return SEE_SUCCESS;
 
-    int ret = see_msg_buffer_num_parts(msg, &num_parts);
-    assert(ret == SEE_SUCCESS);
+    if (enable) {
+        if (msg->length > UINT32_MAX - MSG_BUFFER_TRAILER) {
+            errno = EOVERFLOW;
+            see_runtime_error_new(error_out, errno);
+            return SEE_ERROR_RUNTIME;
+        }
+        msg->length += MSG_BUFFER_TRAILER;
+    }
+    else {
+        msg->length -= MSG_BUFFER_TRAILER;
+    }
 
-    for (size_t i = 0; i < num_parts; ++i)
-    {
-        SeeMsgPart* part = NULL;
-        size_t part_length;
-        ret = cls->get_part(msg, i, &part, error);
-        if (ret)
-            return ret;
+    msg->crc = enable;
+    return SEE_SUCCESS;
+}
 
-        ret = see_msg_part_buffer_length(part, &part_length, error);
-        if (ret)
-            return ret;
+int
+see_msg_buffer_get_crc(const SeeMsgBuffer* msg, int* enabled_out)
+{
+    if (!msg || !enabled_out)
+        return SEE_INVALID_ARGUMENT;
 
-        see_object_decref(SEE_OBJECT(part));
+    *enabled_out = msg->crc;
+    return SEE_SUCCESS;
+}
 
-        size += part_length;
-    }
+int
+see_msg_buffer_length(
+    const SeeMsgBuffer* buffer,
+    size_t*             length
+    )
+{
+    if (!buffer || !length)
+        return SEE_INVALID_ARGUMENT;
 
-    if (size > max) {
-        errno = EOVERFLOW;
-        see_runtime_error_new(error, errno);
-        return SEE_ERROR_RUNTIME;
-    }
+    *length = buffer->length;
 
-    *length = (uint32_t) size;
     return SEE_SUCCESS;
 }
 
-static int
-msg_buffer_add_part(
-    SeeMsgBuffer*       mbuf,
-    const SeeMsgPart*   mpart,
+int
+see_msg_buffer_add_part(
+    SeeMsgBuffer*       msg,
+    const SeeMsgPart*   part,
     SeeError**          error_out
     )
 {
-    int ret;
-    size_t size;
-#if !defined(NDEBUG)
-    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(mbuf);
-#endif
-    SeeMsgPart* copy = NULL;
-
-    ret = see_object_copy(
-        SEE_OBJECT(mpart),
-        SEE_OBJECT_REF(&copy),
-        error_out
-        );
-    if (ret)
-        goto fail;
-
-    ret = see_dynamic_array_add(mbuf->parts, &copy, error_out);
-    if (ret)
-        goto fail;
-
-    ret = see_msg_part_buffer_length(mpart, &size, error_out);
-    if (ret)
-        goto fail;
-
-    mbuf->length += size;
+    const SeeMsgBufferClass* cls;
+    if (!msg || !part)
+        return SEE_INVALID_ARGUMENT;
+    if(!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
 
-#if !defined(NDEBUG)
-    uint32_t length;
-    ret = cls->calc_length(mbuf, &length, error_out);
-    assert(length == mbuf->length);
-#endif
+    cls = SEE_MSG_BUFFER_GET_CLASS(msg);
 
-fail:
-    see_object_decref(SEE_OBJECT(copy));
-    return ret;
+    return cls->add_part(msg, part, error_out);
 }
 
-static int
-msg_buffer_get_part(
-    const SeeMsgBuffer* mbuf,
-    size_t              n,
-    SeeMsgPart**        mbpart,
-    SeeError**          error_out
+int
+see_msg_buffer_add_int32(
+    SeeMsgBuffer*   msg,
+    int32_t         value,
+    SeeError**      error_out
     )
 {
-    SeeMsgPart*  part = NULL;
-    SeeMsgPart** part_array = NULL;
-    part_array = see_dynamic_array_data(mbuf->parts);
+    return msg_buffer_add_scalar(
+        msg, SEE_MSG_PART_INT32_T, &value, sizeof(value), error_out
+        );
+}
 
-    size_t n_parts = see_dynamic_array_size(mbuf->parts);
-    if (n >= n_parts) {
-        see_index_error_new(error_out, n);
-        return SEE_ERROR_INDEX;
-    }
-    part = part_array[n];
+int
+see_msg_buffer_add_uint32(
+    SeeMsgBuffer*   msg,
+    uint32_t        value,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_scalar(
+        msg, SEE_MSG_PART_UINT32_T, &value, sizeof(value), error_out
+        );
+}
 
-    return see_object_copy(SEE_OBJECT(part), SEE_OBJECT_REF(mbpart), error_out);
+int
+see_msg_buffer_add_int64(
+    SeeMsgBuffer*   msg,
+    int64_t         value,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_scalar(
+        msg, SEE_MSG_PART_INT64_T, &value, sizeof(value), error_out
+        );
 }
 
-static int
-msg_buffer_num_parts(
-    const SeeMsgBuffer* msgbuf,
-    size_t*             size
+int
+see_msg_buffer_add_uint64(
+    SeeMsgBuffer*   msg,
+    uint64_t        value,
+    SeeError**      error_out
     )
 {
-    *size = see_dynamic_array_size(msgbuf->parts);
-    return SEE_SUCCESS;
+    return msg_buffer_add_scalar(
+        msg, SEE_MSG_PART_UINT64_T, &value, sizeof(value), error_out
+        );
 }
 
-static int
-msg_buffer_get_buffer(
-    SeeMsgBuffer*       msg,
-    void**              buffer_out,
-    size_t*             bufsize_out,
-    SeeError**          error_out
+int
+see_msg_buffer_add_float(
+    SeeMsgBuffer*   msg,
+    float           value,
+    SeeError**      error_out
     )
 {
-    int     ret;
-    char*   bytes = NULL;
+    return msg_buffer_add_scalar(
+        msg, SEE_MSG_PART_FLOAT_T, &value, sizeof(value), error_out
+        );
+}
 
-    uint32_t length, length_network;
-    size_t n, nwritten = 0;
-    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+int
+see_msg_buffer_add_double(
+    SeeMsgBuffer*   msg,
+    double          value,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_scalar(
+        msg, SEE_MSG_PART_DOUBLE_T, &value, sizeof(value), error_out
+        );
+}
 
-    length = msg->length;
-    length_network = see_host_to_network32(length);
+int
+see_msg_buffer_add_string(
+    SeeMsgBuffer*   msg,
+    const char*     value,
+    size_t          length,
+    SeeError**      error_out
+    )
+{
+    msg_record record;
 
-    cls->num_parts(msg, &n);
+    if (!msg || (!value && length))
+        return SEE_INVALID_ARGUMENT;
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
 
-    bytes = malloc(length);
-    if (!bytes) {
+    if (length > UINT32_MAX - MSG_RECORD_STRING_HEADER) {
+        errno = EOVERFLOW;
         see_runtime_error_new(error_out, errno);
         return SEE_ERROR_RUNTIME;
     }
 
-    // write the header.
-    const char* header = cls->msg_start;
-    size_t start_length = strlen(header);
-    memcpy(&bytes[nwritten], header, start_length);
-    nwritten += start_length;
-
-    uint16_t id = see_host_to_network16(msg->id);
-    memcpy(&bytes[nwritten], &id, sizeof(id));
-    nwritten += sizeof(id);
-
-    memcpy(&bytes[nwritten], &length_network, sizeof(length_network));
-    nwritten += sizeof(length_network);
-
-    if (n > 0) {
-        const SeeMsgPart **part_array = see_dynamic_array_data(msg->parts);
-        for (size_t i = 0; i < n; ++i) {
-
-            size_t partsize;
-            const SeeMsgPart *part = part_array[i];
-
-            ret = see_msg_part_write(part, &bytes[nwritten], error_out);
-            if (ret)
-                goto fail;
+    memset(&record, 0, sizeof(record));
+    record.value_type = SEE_MSG_PART_STRING_T;
+    record.length     = (uint32_t) (MSG_RECORD_STRING_HEADER + length);
 
-            ret = see_msg_part_buffer_length(part, &partsize, error_out);
-            if (ret)
-                goto fail;
+    return msg_buffer_append_record(msg, &record, value, 0, error_out);
+}
 
-            nwritten += partsize;
-        }
-    }
+int
+see_msg_buffer_add_int32_array(
+    SeeMsgBuffer*   msg,
+    const int32_t*  elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_array(
+        msg, SEE_MSG_PART_INT32_ARRAY_T, elements, n, error_out
+        );
+}
 
-    assert(nwritten == length);
+int
+see_msg_buffer_add_int64_array(
+    SeeMsgBuffer*   msg,
+    const int64_t*  elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_array(
+        msg, SEE_MSG_PART_INT64_ARRAY_T, elements, n, error_out
+        );
+}
 
-    *bufsize_out= nwritten;
-    *buffer_out = bytes;
-    return SEE_SUCCESS;
+int
+see_msg_buffer_add_float_array(
+    SeeMsgBuffer*   msg,
+    const float*    elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_array(
+        msg, SEE_MSG_PART_FLOAT_ARRAY_T, elements, n, error_out
+        );
+}
 
-fail:
+int
+see_msg_buffer_add_double_array(
+    SeeMsgBuffer*   msg,
+    const double*   elements,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_array(
+        msg, SEE_MSG_PART_DOUBLE_ARRAY_T, elements, n, error_out
+        );
+}
 
-    free(bytes);
-    return ret;
+int
+see_msg_buffer_add_bytes(
+    SeeMsgBuffer*   msg,
+    const void*     bytes,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    return msg_buffer_add_array(msg, SEE_MSG_PART_BYTES_T, bytes, n, error_out);
 }
 
-static int
-msg_buffer_from_buffer(
-    SeeMsgBuffer**  new_buf_out,
-    const void*     buffer,
-    size_t          bufsiz,
+int
+see_msg_buffer_add_bytes_ref(
+    SeeMsgBuffer*               msg,
+    const void*                 bytes,
+    size_t                      n,
+    see_msg_bytes_release_func  release,
+    void*                       context,
+    SeeError**                  error_out
+    )
+{
+    return msg_buffer_add_bytes_ref(
+        msg, bytes, n, release, context, error_out
+        );
+}
+
+int
+see_msg_buffer_add_bytes_object(
+    SeeMsgBuffer*   msg,
+    const void*     bytes,
+    size_t          n,
+    SeeObject*      owner,
     SeeError**      error_out
     )
 {
-    uint16_t        id, id_network;
-    uint32_t        length, length_network;
-    size_t          nread = 0;
-    int             ret;
-    SeeMsgBuffer*   msg = NULL;
-    const char*     bytes = buffer;
-    const char*     msg_start = g_see_msg_start;
-    size_t          start_length = strlen(msg_start);
+    if (!owner)
+        return SEE_INVALID_ARGUMENT;
 
-    char start[4] = {0};
+    int ret = msg_buffer_add_bytes_ref(
+        msg, bytes, n, msg_bytes_release_object, owner, error_out
+        );
+    if (ret)
+        return ret;
 
-    if (bufsiz < (strlen(g_see_msg_start) + sizeof(id) + sizeof(length))) {
-        see_msg_invalid_error_new(error_out);
-        return SEE_ERROR_MSG_INVALID;
-    }
+    see_object_ref(owner);
+    return SEE_SUCCESS;
+}
 
-    memcpy(&start[0], &bytes[nread], start_length);
-    if (memcmp(msg_start, start, start_length) != 0) {
-        see_msg_invalid_error_new(error_out);
-        return SEE_ERROR_MSG_INVALID;
-    }
-    nread += start_length;
+int
+see_msg_buffer_get_part(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    SeeMsgPart**        part,
+    SeeError**          error
+    )
+{
+    if (!msg || !part)
+        return SEE_INVALID_ARGUMENT;
+    if (!error || *error)
+        return SEE_INVALID_ARGUMENT;
 
-    memcpy(&id_network, &bytes[nread], sizeof(id_network));
-    id = see_network_to_host16(id_network);
-    nread += sizeof(id_network);
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+    return cls->get_part(msg, index, part, error);
+}
 
-    memcpy(&length_network, &bytes[nread], sizeof(length_network));
-    length = see_network_to_host32(length_network);
-    nread += sizeof(length);
+int
+see_msg_buffer_peek_part(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const SeeMsgPart**  part_out,
+    SeeError**          error_out
+    )
+{
+    if (!msg || !part_out)
+        return SEE_INVALID_ARGUMENT;
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
 
-    if (length > bufsiz) {
-        see_msg_invalid_error_new(error_out);
-        return SEE_ERROR_MSG_INVALID;
+    if (index >= see_dynamic_array_size(msg->parts)) {
+        see_index_error_new(error_out, index);
+        return SEE_ERROR_INDEX;
     }
 
-    ret = see_msg_buffer_new(&msg, id, error_out);
+    int ret = msg_buffer_cache_parts(msg, index + 1, error_out);
     if (ret)
         return ret;
 
-    while(nread < length) {
-
-        SeeMsgPart* part        = NULL;
-        size_t      partsize    = 0;
-
-        ret = see_msg_part_read(
-            &part,
-            &bytes[nread],
-            length - nread,
-            &partsize,
-            error_out
-            );
-        if (ret)
-            goto fail;
-
-        nread += partsize;
-
-        ret = see_msg_buffer_add_part(msg, part, error_out);
-        if (ret)
-            goto fail;
-        see_object_decref(SEE_OBJECT(part));
-    }
+    const SeeMsgPart** parts = see_dynamic_array_data(msg->part_cache);
+    *part_out = parts[index];
+    return SEE_SUCCESS;
+}
 
-    *new_buf_out = msg;
+int
+see_msg_buffer_get_int32_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    int32_t*            value,
+    SeeError**          error_out
+    )
+{
+    const msg_record* record;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
 
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_INT32_T, &record, error_out
+        );
+    if (ret == SEE_SUCCESS)
+        *value = record->value.int32_val;
     return ret;
+}
 
-fail:
+int
+see_msg_buffer_get_uint32_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    uint32_t*           value,
+    SeeError**          error_out
+    )
+{
+    const msg_record* record;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
 
-    see_object_decref(SEE_OBJECT(msg));
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_UINT32_T, &record, error_out
+        );
+    if (ret == SEE_SUCCESS)
+        *value = record->value.uint32_val;
     return ret;
 }
 
-/* **** implementation of the public API **** */
-
 int
-see_msg_buffer_new(SeeMsgBuffer** buf, uint16_t id, SeeError** error_out)
+see_msg_buffer_get_int64_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    int64_t*            value,
+    SeeError**          error_out
+    )
 {
-    const SeeObjectClass* cls = SEE_OBJECT_CLASS(see_msg_buffer_class());
-
-    // uint16_t is promoted to int when used in a function taking variable
-    // length aruguments (in "...") so lets promote it more explicitly.
-    int iid = id;
+    const msg_record* record;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
 
-    if (!cls)
-        return SEE_NOT_INITIALIZED;
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_INT64_T, &record, error_out
+        );
+    if (ret == SEE_SUCCESS)
+        *value = record->value.int64_val;
+    return ret;
+}
 
-    if (!buf || *buf || !error_out || *error_out)
+int
+see_msg_buffer_get_uint64_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    uint64_t*           value,
+    SeeError**          error_out
+    )
+{
+    const msg_record* record;
+    if (!value)
         return SEE_INVALID_ARGUMENT;
 
-    return cls->new_obj(cls, 0, SEE_OBJECT_REF(buf), iid, error_out);
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_UINT64_T, &record, error_out
+        );
+    if (ret == SEE_SUCCESS)
+        *value = record->value.uint64_val;
+    return ret;
 }
 
 int
-see_msg_buffer_set_id(
-    SeeMsgBuffer*   msg,
-    uint16_t        id
+see_msg_buffer_get_float_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    float*              value,
+    SeeError**          error_out
     )
 {
-    if (!msg)
+    const msg_record* record;
+    if (!value)
         return SEE_INVALID_ARGUMENT;
 
-    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
-
-    return cls->set_id(msg, id);
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_FLOAT_T, &record, error_out
+        );
+    if (ret == SEE_SUCCESS)
+        *value = record->value.float_val;
+    return ret;
 }
 
 int
-see_msg_buffer_get_id(
+see_msg_buffer_get_double_at(
     const SeeMsgBuffer* msg,
-    uint16_t*           id
+    size_t              index,
+    double*             value,
+    SeeError**          error_out
     )
 {
-    if (!msg || !id)
+    const msg_record* record;
+    if (!value)
         return SEE_INVALID_ARGUMENT;
 
-    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
-
-    return cls->get_id(msg, id);
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_DOUBLE_T, &record, error_out
+        );
+    if (ret == SEE_SUCCESS)
+        *value = record->value.double_val;
+    return ret;
 }
 
 int
-see_msg_buffer_length(
-    const SeeMsgBuffer* buffer,
-    size_t*             length
+see_msg_buffer_get_string_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const char**        str_out,
+    size_t*             length_out,
+    SeeError**          error_out
     )
 {
-    if (!buffer || !length)
+    const msg_record* record;
+    if (!str_out || !length_out)
         return SEE_INVALID_ARGUMENT;
 
-    *length = buffer->length;
+    int ret = msg_buffer_record_at(
+        msg, index, SEE_MSG_PART_STRING_T, &record, error_out
+        );
+    if (ret)
+        return ret;
 
+    *str_out    = msg_record_string(msg, record);
+    *length_out = msg_record_string_length(record);
     return SEE_SUCCESS;
 }
 
 int
-see_msg_buffer_add_part(
-    SeeMsgBuffer*       msg,
-    const SeeMsgPart*   part,
+see_msg_buffer_get_int32_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const int32_t**     elements_out,
+    size_t*             n_out,
     SeeError**          error_out
     )
 {
-    const SeeMsgBufferClass* cls;
-    if (!msg || !part)
-        return SEE_INVALID_ARGUMENT;
-    if(!error_out || *error_out)
-        return SEE_INVALID_ARGUMENT;
+    return msg_buffer_array_at(
+        msg,
+        index,
+        SEE_MSG_PART_INT32_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
 
-    cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+int
+see_msg_buffer_get_int64_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const int64_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_buffer_array_at(
+        msg,
+        index,
+        SEE_MSG_PART_INT64_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
 
-    return cls->add_part(msg, part, error_out);
+int
+see_msg_buffer_get_float_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const float**       elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_buffer_array_at(
+        msg,
+        index,
+        SEE_MSG_PART_FLOAT_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
 }
 
 int
-see_msg_buffer_get_part(
+see_msg_buffer_get_double_array_at(
     const SeeMsgBuffer* msg,
     size_t              index,
-    SeeMsgPart**        part,
-    SeeError**          error
+    const double**      elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
     )
 {
-    if (!msg || !part)
-        return SEE_INVALID_ARGUMENT;
-    if (!error || *error)
-        return SEE_INVALID_ARGUMENT;
+    return msg_buffer_array_at(
+        msg,
+        index,
+        SEE_MSG_PART_DOUBLE_ARRAY_T,
+        (const void**) elements_out,
+        n_out,
+        error_out
+        );
+}
 
-    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
-    return cls->get_part(msg, index, part, error);
+int
+see_msg_buffer_get_bytes_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const void**        bytes_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    )
+{
+    return msg_buffer_array_at(
+        msg, index, SEE_MSG_PART_BYTES_T, bytes_out, n_out, error_out
+        );
 }
 
 int
@@ -2089,6 +4023,69 @@ see_msg_buffer_get_buffer(
     return cls->get_buffer(msg, buf_out, size_out, error_out);
 }
 
+int
+see_msg_buffer_write_into(
+    const SeeMsgBuffer* msg,
+    void*               dst,
+    size_t              cap,
+    size_t*             written_out,
+    SeeError**          error_out
+    )
+{
+    if (!msg || !dst || !written_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgBufferClass* cls = SEE_MSG_BUFFER_GET_CLASS(msg);
+
+    return cls->write_into(msg, dst, cap, written_out, error_out);
+}
+
+#if defined(HAVE_SYS_UIO_H)
+
+int
+see_msg_buffer_to_iovec(
+    const SeeMsgBuffer* msg,
+    struct iovec*       iov,
+    int                 max_iov,
+    void*               scratch,
+    size_t              scratch_cap,
+    int*                n_iov_out,
+    size_t*             scratch_out,
+    SeeError**          error_out
+    )
+{
+    int n_iov;
+    size_t scratch_size;
+
+    if (!msg || (!iov && max_iov) || max_iov < 0 || (!scratch && scratch_cap))
+        return SEE_INVALID_ARGUMENT;
+
+    if (!n_iov_out || !scratch_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    msg_buffer_fill_iovec(msg, NULL, NULL, &n_iov, &scratch_size);
+
+    // Tell the caller how much room is required.
+    *n_iov_out      = n_iov;
+    *scratch_out    = scratch_size;
+
+    if (n_iov > max_iov || scratch_size > scratch_cap) {
+        errno = ENOBUFS;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    msg_buffer_fill_iovec(msg, iov, scratch, n_iov_out, scratch_out);
+    assert(*n_iov_out == n_iov && *scratch_out == scratch_size);
+
+    return SEE_SUCCESS;
+}
+
+#endif //if defined(HAVE_SYS_UIO_H)
+
 int
 see_msg_buffer_from_buffer(
     SeeMsgBuffer**  msg_out,
@@ -2128,6 +4125,7 @@ static int see_msg_buffer_class_init(SeeObjectClass* new_cls)
     new_cls->equal      = msg_buffer_equal;
     new_cls->not_equal  = msg_buffer_not_equal;
     new_cls->copy       = msg_buffer_copy;
+    new_cls->next_span  = msg_buffer_next_span;
     
     /* Set the function pointers of the own class here */
     SeeMsgBufferClass* cls  = (SeeMsgBufferClass*) new_cls;
@@ -2143,6 +4141,7 @@ static int see_msg_buffer_class_init(SeeObjectClass* new_cls)
     cls->num_parts          = msg_buffer_num_parts;
     cls->get_buffer         = msg_buffer_get_buffer;
     cls->from_buffer        = msg_buffer_from_buffer;
+    cls->write_into         = msg_buffer_write_into;
 
     return ret;
 }
@@ -2212,6 +4211,16 @@ msg_part_value_type_to_string(see_msg_part_value_t value)
             return "float";
         case SEE_MSG_PART_DOUBLE_T:
             return "double";
+        case SEE_MSG_PART_INT32_ARRAY_T:
+            return "int32_t[]";
+        case SEE_MSG_PART_INT64_ARRAY_T:
+            return "int64_t[]";
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+            return "float[]";
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+            return "double[]";
+        case SEE_MSG_PART_BYTES_T:
+            return "bytes";
         default:
             assert(0 == 1);
             return NULL;
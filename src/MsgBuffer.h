@@ -90,6 +90,10 @@
 
 #include <stdint.h>
 
+#if defined(HAVE_SYS_UIO_H)
+#include <sys/uio.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -143,8 +147,41 @@ typedef enum msg_part_value_t {
     SEE_MSG_PART_DOUBLE_T,
 
     /**
-     * \brief If a type larger or equal to this type is received we know the
-     * package is invalid.
+     * \brief The part contains an array of 32 bit signed integers.
+     *
+     * Arrays are encoded like strings, a 32 bit unsigned integer with the
+     * length of the part is followed by the elements in network byte
+     * order.
+     */
+    SEE_MSG_PART_INT32_ARRAY_T,
+    /**
+     * \brief The part contains an array of 64 bit signed integers.
+     */
+    SEE_MSG_PART_INT64_ARRAY_T,
+    /**
+     * \brief The part contains an array of floats.
+     */
+    SEE_MSG_PART_FLOAT_ARRAY_T,
+    /**
+     * \brief The part contains an array of doubles.
+     */
+    SEE_MSG_PART_DOUBLE_ARRAY_T,
+
+    /**
+     * \brief The part contains raw bytes.
+     *
+     * Bytes are encoded like strings, but they may contain 0 bytes and
+     * they are never 0 terminated. A SeeMsgBuffer may refer to the bytes
+     * of the caller instead of copying them, see
+     * see_msg_buffer_add_bytes_ref().
+     */
+    SEE_MSG_PART_BYTES_T,
+
+    /**
+     * \brief The last 5 bytes of a message may be a trailer with the
+     * CRC32C of the message, see see_msg_buffer_set_crc(). If a part with
+     * this type or a larger type is received we know the package is
+     * invalid.
      */
     SEE_MSG_PART_TRAILER,
 } see_msg_part_value_t;
@@ -182,6 +219,7 @@ struct SeeMsgPart {
         char*       str_val;
         double      double_val;
         float       float_val;
+        void*       array_val;
     } value;
 
     /**
@@ -560,6 +598,49 @@ struct SeeMsgPartClass {
         size_t*           part_size_out,
         SeeError**        error_out
         );
+
+    /**
+     * \brief Initialize this message part with an array.
+     *
+     * @param [in,out] msg_buf_p A pointer to a SeeMsgPart
+     * @param [in]     type      One of the SEE_MSG_PART_*_ARRAY_T types
+     *                           or SEE_MSG_PART_BYTES_T.
+     * @param [in]     elements  The elements are copied into the part.
+     * @param [in]     n         The number of elements.
+     * @param [out]    error_out An error will be returned here when something
+     *                           goes wrong
+     * @return SEE_SUCCESS, SEE_ERROR_RUNTIME
+     * @private
+     */
+    int (*write_array) (
+        SeeMsgPart*       msg_buf_p,
+        uint8_t           type,
+        const void*       elements,
+        size_t            n,
+        SeeError**        error_out
+        );
+
+    /**
+     * \brief Obtain the elements of an array part.
+     *
+     * @param [in]  msg_buf_p    A pointer to SeeMsgPart that contains an array
+     * @param [in]  type         One of the SEE_MSG_PART_*_ARRAY_T types
+     *                           or SEE_MSG_PART_BYTES_T.
+     * @param [out] elements_out Points to the elements owned by the part.
+     * @param [out] n_out        The number of elements.
+     * @param [out] error_out    A SeeError will be returned here when
+     *                           something goes wrong.
+     *
+     * @return SEE_SUCCESS, SEE_ERROR_MSG_PART_TYPE
+     * @private
+     */
+    int (*get_array) (
+        const SeeMsgPart* msg_buf_p,
+        uint8_t           type,
+        const void**      elements_out,
+        size_t*           n_out,
+        SeeError**        error_out
+        );
 };
 
 /* **** function style macro casts **** */
@@ -865,6 +946,142 @@ see_msg_part_get_double(
     SeeError**          error_out
     );
 
+/**
+ * @brief write an array of int32_t to the part.
+ *
+ * The elements are copied into the part, they are send in one part instead
+ * of one part per element.
+ *
+ * @param [in,out]  part        The part to which you would like to write.
+ * @param [in]      elements    The elements to write.
+ * @param [in]      n           The number of elements.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_part_write_int32_array(
+    SeeMsgPart*         part,
+    const int32_t*      elements,
+    size_t              n,
+    SeeError**          error_out
+    );
+
+/**
+ * @brief Obtain the elements of an int32_t array part.
+ *
+ * @param [in]  part            The part that contains the array.
+ * @param [out] elements_out    Points to the elements inside the part, they
+ *                              are valid until the part is modified or
+ *                              destroyed.
+ * @param [out] n_out           The number of elements.
+ * @param [out] error_out       If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_part_get_int32_array(
+    const SeeMsgPart*   part,
+    const int32_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_part_write_int32_array */
+SEE_EXPORT int
+see_msg_part_write_int64_array(
+    SeeMsgPart*         part,
+    const int64_t*      elements,
+    size_t              n,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_part_get_int32_array */
+SEE_EXPORT int
+see_msg_part_get_int64_array(
+    const SeeMsgPart*   part,
+    const int64_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_part_write_int32_array */
+SEE_EXPORT int
+see_msg_part_write_float_array(
+    SeeMsgPart*         part,
+    const float*        elements,
+    size_t              n,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_part_get_int32_array */
+SEE_EXPORT int
+see_msg_part_get_float_array(
+    const SeeMsgPart*   part,
+    const float**       elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_part_write_int32_array */
+SEE_EXPORT int
+see_msg_part_write_double_array(
+    SeeMsgPart*         part,
+    const double*       elements,
+    size_t              n,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_part_get_int32_array */
+SEE_EXPORT int
+see_msg_part_get_double_array(
+    const SeeMsgPart*   part,
+    const double**      elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/**
+ * @brief write raw bytes to the part.
+ *
+ * Unlike a string, the bytes may contain 0 bytes. The bytes are copied
+ * into the part.
+ *
+ * @param [in,out]  part        The part to which you would like to write.
+ * @param [in]      bytes       The bytes to write.
+ * @param [in]      n           The number of bytes.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_part_write_bytes(
+    SeeMsgPart*         part,
+    const void*         bytes,
+    size_t              n,
+    SeeError**          error_out
+    );
+
+/**
+ * @brief Obtain the bytes of a bytes part.
+ *
+ * @param [in]  part            The part that contains the bytes.
+ * @param [out] bytes_out       Points to the bytes inside the part, they
+ *                              are valid until the part is modified or
+ *                              destroyed.
+ * @param [out] n_out           The number of bytes.
+ * @param [out] error_out       If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_part_get_bytes(
+    const SeeMsgPart*   part,
+    const void**        bytes_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
 /**
  * @brief Determines the length that the SeeMsgPart requires for a data buffer
  *
@@ -964,6 +1181,15 @@ void see_msg_part_deinit();
 typedef struct SeeMsgBuffer SeeMsgBuffer;
 typedef struct SeeMsgBufferClass SeeMsgBufferClass;
 
+/**
+ * \brief Releases bytes that were added to a message by reference.
+ *
+ * @param [in] bytes    The bytes that were passed to
+ *                      see_msg_buffer_add_bytes_ref().
+ * @param [in] context  The context that was passed along with the bytes.
+ */
+typedef void (*see_msg_bytes_release_func)(void* bytes, void* context);
+
 /**
  * \brief represents a buffer into which SeeMsgParts can be added.
  *
@@ -977,11 +1203,12 @@ struct SeeMsgBuffer {
     SeeObject parent_obj;
 
     /**
-     * \brief The SeeMsgParts stored in the parts member
+     * \brief The parts of the message.
      *
      * A message can consist of multiple parts, all the parts are put into
      * the buffer in such a way that the remote end is able to tell which
-     * parts are embedded in the message.
+     * parts are embedded in the message. The parts are not stored as
+     * SeeMsgParts, but as compact records of their type, length and value.
      *
      * \private
      */
@@ -1001,6 +1228,35 @@ struct SeeMsgBuffer {
      * of its part.
      */
     uint32_t            length;
+
+    /**
+     * \brief The characters of all string parts and the elements of all
+     *        array parts, in host byte order.
+     *
+     * \private
+     */
+    char*               strings;
+
+    /** \brief The number of bytes used in strings. \private */
+    size_t              strings_size;
+
+    /** \brief The number of bytes allocated for strings. \private */
+    size_t              strings_capacity;
+
+    /**
+     * \brief SeeMsgParts created from the parts, NULL until they are needed.
+     *
+     * \private
+     */
+    SeeDynamicArray*    part_cache;
+
+    /**
+     * \brief Whether a CRC32C trailer is appended, when it is, length
+     *        includes the trailer.
+     *
+     * \private
+     */
+    int                 crc;
 };
 
 /**
@@ -1181,6 +1437,30 @@ struct SeeMsgBufferClass {
         size_t          buf_size,
         SeeError**      error_out
         );
+
+    /**
+     * \brief Serialize the message into memory provided by the caller.
+     *
+     * This is the workhorse of get_buffer, it allows to reuse one buffer
+     * for many messages.
+     *
+     * @param [in]  msg         The msg to be turned into a bytestream
+     * @param [out] dst         The bytes are written here.
+     * @param [in]  cap         The number of bytes available at dst.
+     * @param [out] written_out The number of bytes written, or when cap
+     *                          is too small, the number of bytes required.
+     * @param [out] error_out   If an error occurs it will be returned here.
+     *
+     * @return SEE_SUCCESS, SEE_ERROR_RUNTIME
+     * \private
+     */
+    int (*write_into) (
+        const SeeMsgBuffer* msg,
+        void*               dst,
+        size_t              cap,
+        size_t*             written_out,
+        SeeError**          error_out
+        );
 };
 
 /* **** function style macro casts **** */
@@ -1287,6 +1567,46 @@ see_msg_buffer_get_id (
     uint16_t*             id_out
     );
 
+/**
+ * \brief Append a CRC32C trailer to the message when it is serialized.
+ *
+ * The trailer is the type byte SEE_MSG_PART_TRAILER followed by the CRC32C
+ * of all preceding bytes of the message, it adds 5 bytes to the length of
+ * the message. see_msg_buffer_from_buffer(), see_msg_view_init() and
+ * hence SeeMsgDecoder reject a message whose CRC32C doesn't match, so
+ * corrupted bytes are detected instead of being parsed into garbage.
+ *
+ * The trailer isn't a part of the message, it doesn't show up in
+ * see_msg_buffer_num_parts(). Receivers that predate the trailer reject
+ * messages that have one, so enable it only when both ends support it.
+ *
+ * @param [in, out] msg         The message.
+ * @param [in]      enable      Non zero to append the trailer.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_set_crc(
+    SeeMsgBuffer*   msg,
+    int             enable,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain whether a CRC32C trailer is appended to the message.
+ *
+ * A message returned by see_msg_buffer_from_buffer() has the trailer
+ * enabled when the bytes had a valid trailer.
+ *
+ * @param [in]  msg         The message.
+ * @param [out] enabled_out 1 when the trailer is appended, 0 otherwise.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_buffer_get_crc(const SeeMsgBuffer* msg, int* enabled_out);
+
 /**
  * \brief add a MsgPart to the MsgBuffer
  *
@@ -1305,6 +1625,219 @@ see_msg_buffer_add_part(
     SeeError**          error_out
     );
 
+/**
+ * \brief Append an int32_t to the message.
+ *
+ * This has the same effect as writing the value to a SeeMsgPart and adding
+ * that part with see_msg_buffer_add_part(), but no SeeMsgPart is created.
+ *
+ * @param [in, out] msg         The message to which the value is appended.
+ * @param [in]      value       The value to append.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_add_int32(
+    SeeMsgBuffer*   msg,
+    int32_t         value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append an uint32_t to the message, see see_msg_buffer_add_int32().
+ */
+SEE_EXPORT int
+see_msg_buffer_add_uint32(
+    SeeMsgBuffer*   msg,
+    uint32_t        value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append an int64_t to the message, see see_msg_buffer_add_int32().
+ */
+SEE_EXPORT int
+see_msg_buffer_add_int64(
+    SeeMsgBuffer*   msg,
+    int64_t         value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append an uint64_t to the message, see see_msg_buffer_add_int32().
+ */
+SEE_EXPORT int
+see_msg_buffer_add_uint64(
+    SeeMsgBuffer*   msg,
+    uint64_t        value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append a float to the message, see see_msg_buffer_add_int32().
+ */
+SEE_EXPORT int
+see_msg_buffer_add_float(
+    SeeMsgBuffer*   msg,
+    float           value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append a double to the message, see see_msg_buffer_add_int32().
+ */
+SEE_EXPORT int
+see_msg_buffer_add_double(
+    SeeMsgBuffer*   msg,
+    double          value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append a string to the message.
+ *
+ * @param [in, out] msg         The message to which the string is appended.
+ * @param [in]      value       The characters of the string, they don't
+ *                              have to be '\0' terminated.
+ * @param [in]      length      The number of characters.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_add_string(
+    SeeMsgBuffer*   msg,
+    const char*     value,
+    size_t          length,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append an array of int32_t to the message as one part.
+ *
+ * The elements are converted to network byte order in bulk when the
+ * message is serialized, which is much cheaper than adding a part per
+ * element.
+ *
+ * @param [in, out] msg         The message to which the array is appended.
+ * @param [in]      elements    The elements to append.
+ * @param [in]      n           The number of elements.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_add_int32_array(
+    SeeMsgBuffer*   msg,
+    const int32_t*  elements,
+    size_t          n,
+    SeeError**      error_out
+    );
+
+/** \copydoc see_msg_buffer_add_int32_array */
+SEE_EXPORT int
+see_msg_buffer_add_int64_array(
+    SeeMsgBuffer*   msg,
+    const int64_t*  elements,
+    size_t          n,
+    SeeError**      error_out
+    );
+
+/** \copydoc see_msg_buffer_add_int32_array */
+SEE_EXPORT int
+see_msg_buffer_add_float_array(
+    SeeMsgBuffer*   msg,
+    const float*    elements,
+    size_t          n,
+    SeeError**      error_out
+    );
+
+/** \copydoc see_msg_buffer_add_int32_array */
+SEE_EXPORT int
+see_msg_buffer_add_double_array(
+    SeeMsgBuffer*   msg,
+    const double*   elements,
+    size_t          n,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append raw bytes to the message.
+ *
+ * Unlike a string, the bytes may contain 0 bytes. The bytes are copied
+ * into the message, use see_msg_buffer_add_bytes_ref() to prevent copying
+ * a large payload.
+ *
+ * @param [in, out] msg         The message to which the bytes are appended.
+ * @param [in]      bytes       The bytes to append.
+ * @param [in]      n           The number of bytes.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_add_bytes(
+    SeeMsgBuffer*   msg,
+    const void*     bytes,
+    size_t          n,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append raw bytes to the message without copying them.
+ *
+ * The message refers to the bytes of the caller, they must remain
+ * valid and unmodified until the message and all its copies are
+ * destroyed. Then release is called with the bytes and context. When
+ * serialized with see_msg_buffer_to_iovec(), the iovec points to the bytes
+ * of the caller, so they are never duplicated before they are written.
+ *
+ * @param [in, out] msg         The message to which the bytes are appended.
+ * @param [in]      bytes       The bytes to append.
+ * @param [in]      n           The number of bytes.
+ * @param [in]      release     Called when the bytes are no longer used,
+ *                              may be NULL.
+ * @param [in]      context     Passed to release.
+ * @param [out]     error_out   If an error occurs it is returned here, then
+ *                              release isn't called.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_add_bytes_ref(
+    SeeMsgBuffer*               msg,
+    const void*                 bytes,
+    size_t                      n,
+    see_msg_bytes_release_func  release,
+    void*                       context,
+    SeeError**                  error_out
+    );
+
+/**
+ * \brief Append raw bytes that are owned by a SeeObject without copying
+ *        them.
+ *
+ * Like see_msg_buffer_add_bytes_ref(), but the message keeps a reference
+ * to owner for as long as it uses the bytes.
+ *
+ * @param [in, out] msg         The message to which the bytes are appended.
+ * @param [in]      bytes       The bytes to append, they live inside owner.
+ * @param [in]      n           The number of bytes.
+ * @param [in]      owner       The object that owns the bytes.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_add_bytes_object(
+    SeeMsgBuffer*   msg,
+    const void*     bytes,
+    size_t          n,
+    SeeObject*      owner,
+    SeeError**      error_out
+    );
+
 /**
  * \brief Obtain a part from the message buffer.
  *
@@ -1328,6 +1861,207 @@ see_msg_buffer_get_part(
     SeeError**          error
     );
 
+/**
+ * \brief Borrow a part of the message without copying it.
+ *
+ * The first time a part is peeked at, the message creates a SeeMsgPart for
+ * it, thereafter the same part is returned. The part is owned by the
+ * message and remains valid as long as the message exists, the caller
+ * must not decref it. Use the see_msg_buffer_get_*_at() functions to read
+ * values without creating SeeMsgParts at all.
+ *
+ * @param [in]  msg         The message from whom you would like a part.
+ * @param [in]  index       The index of the part.
+ * @param [out] part_out    A pointer to the part is returned here.
+ * @param [out] error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_peek_part(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const SeeMsgPart**  part_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the int32_t value of a part without creating a SeeMsgPart.
+ *
+ * @param [in]  msg         The message that contains the value.
+ * @param [in]  index       The index of the part.
+ * @param [out] value       The value is returned here.
+ * @param [out] error_out   If the index is out of range or the part has
+ *                          another type an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_buffer_get_int32_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    int32_t*            value,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the uint32_t value of a part, see see_msg_buffer_get_int32_at().
+ */
+SEE_EXPORT int
+see_msg_buffer_get_uint32_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    uint32_t*           value,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the int64_t value of a part, see see_msg_buffer_get_int32_at().
+ */
+SEE_EXPORT int
+see_msg_buffer_get_int64_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    int64_t*            value,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the uint64_t value of a part, see see_msg_buffer_get_int32_at().
+ */
+SEE_EXPORT int
+see_msg_buffer_get_uint64_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    uint64_t*           value,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the float value of a part, see see_msg_buffer_get_int32_at().
+ */
+SEE_EXPORT int
+see_msg_buffer_get_float_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    float*              value,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the double value of a part, see see_msg_buffer_get_int32_at().
+ */
+SEE_EXPORT int
+see_msg_buffer_get_double_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    double*             value,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the string of a part without copying it.
+ *
+ * @param [in]  msg         The message that contains the string.
+ * @param [in]  index       The index of the part.
+ * @param [out] str_out     Points to the characters inside the message,
+ *                          they are NOT '\0' terminated. The pointer is
+ *                          valid until a part is added to the message.
+ * @param [out] length_out  The number of characters.
+ * @param [out] error_out   If the index is out of range or the part isn't
+ *                          a string an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_buffer_get_string_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const char**        str_out,
+    size_t*             length_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the elements of an int32_t array part without copying them.
+ *
+ * @param [in]  msg             The message that contains the array.
+ * @param [in]  index           The index of the part.
+ * @param [out] elements_out    Points to the elements inside the message,
+ *                              in host byte order. The pointer is valid
+ *                              until a part is added to the message.
+ * @param [out] n_out           The number of elements.
+ * @param [out] error_out       If the index is out of range or the part
+ *                              has another type an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_buffer_get_int32_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const int32_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_buffer_get_int32_array_at */
+SEE_EXPORT int
+see_msg_buffer_get_int64_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const int64_t**     elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_buffer_get_int32_array_at */
+SEE_EXPORT int
+see_msg_buffer_get_float_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const float**       elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/** \copydoc see_msg_buffer_get_int32_array_at */
+SEE_EXPORT int
+see_msg_buffer_get_double_array_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const double**      elements_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Obtain the bytes of a bytes part without copying them.
+ *
+ * @param [in]  msg         The message that contains the bytes.
+ * @param [in]  index       The index of the part.
+ * @param [out] bytes_out   Points to the bytes, they are valid as long as
+ *                          the message isn't modified or destroyed.
+ * @param [out] n_out       The number of bytes.
+ * @param [out] error_out   If the index is out of range or the part isn't
+ *                          a bytes part an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_buffer_get_bytes_at(
+    const SeeMsgBuffer* msg,
+    size_t              index,
+    const void**        bytes_out,
+    size_t*             n_out,
+    SeeError**          error_out
+    );
+
 /**
  * \brief obtain the number of parts in the msg.
  *
@@ -1363,6 +2097,94 @@ see_msg_buffer_get_buffer(
     SeeError**      error_out
     );
 
+/**
+ * \brief Obtain the number of bytes required to serialize the message.
+ *
+ * This is the number of bytes that see_msg_buffer_get_buffer returns
+ * and that see_msg_buffer_write_into needs. It is cached, so obtaining it
+ * is cheap.
+ *
+ * @param [in]  msg     The message whose length you would like to know.
+ * @param [out] length  The length in bytes is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_buffer_length(
+    const SeeMsgBuffer* msg,
+    size_t*             length
+    );
+
+/**
+ * \brief Serialize a message into a buffer owned by the caller.
+ *
+ * This writes the same bytes as see_msg_buffer_get_buffer, but it doesn't
+ * allocate, so a buffer may be reused for many messages. Use
+ * see_msg_buffer_length to find out how large dst should be.
+ *
+ * @param [in]  msg         The message to convey.
+ * @param [out] dst         The bytestream is written here.
+ * @param [in]  cap         The number of bytes available at dst.
+ * @param [out] written_out The number of bytes written. If cap is too small
+ *                          nothing is written, the required size is returned
+ *                          here and the function fails with ENOBUFS.
+ * @param [out] error_out   If an error occurs return it here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_write_into(
+    const SeeMsgBuffer* msg,
+    void*               dst,
+    size_t              cap,
+    size_t*             written_out,
+    SeeError**          error_out
+    );
+
+#if defined(HAVE_SYS_UIO_H)
+
+/**
+ * \brief Describe the serialized message as a list of iovecs.
+ *
+ * The concatenation of the iovecs is the same bytestream that
+ * see_msg_buffer_write_into writes, but long strings and bytes aren't
+ * copied: their iovec points to the characters inside the message or to
+ * the bytes that were added by reference. The header and the
+ * other parts are written to the scratch area of the caller. The result
+ * may be passed to writev(2) directly.
+ *
+ * The iovecs are valid until the message is modified or the scratch
+ * area is reused.
+ *
+ * @param [in]  msg         The message to convey.
+ * @param [out] iov         The iovecs are written here.
+ * @param [in]  max_iov     The number of iovecs available at iov.
+ * @param [out] scratch     The header and fixed size parts are written here.
+ * @param [in]  scratch_cap The number of bytes available at scratch.
+ * @param [out] n_iov_out   The number of iovecs used.
+ * @param [out] scratch_out The number of scratch bytes used.
+ *                          If max_iov or scratch_cap is too small nothing is
+ *                          written, the required sizes are returned in
+ *                          n_iov_out and scratch_out and the function fails
+ *                          with ENOBUFS.
+ * @param [out] error_out   If an error occurs return it here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_buffer_to_iovec(
+    const SeeMsgBuffer* msg,
+    struct iovec*       iov,
+    int                 max_iov,
+    void*               scratch,
+    size_t              scratch_cap,
+    int*                n_iov_out,
+    size_t*             scratch_out,
+    SeeError**          error_out
+    );
+
+#endif //if defined(HAVE_SYS_UIO_H)
+
 /**
  * \brief Construct a new message from a buffer.
  *
@@ -0,0 +1,412 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file MsgDecoder.c
+ * \brief Implements SeeMsgDecoder.
+ *
+ * \private
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MetaClass.h"
+#include "MsgDecoder.h"
+#include "RuntimeError.h"
+#include "utilities.h"
+
+/*
+ * The initial number of bytes allocated when bytes are fed.
+ */
+#define MSG_DECODER_MIN_CAPACITY 256
+
+/* **** functions that implement SeeMsgDecoder or override SeeObject **** */
+
+static int
+msg_decoder_init(
+    SeeMsgDecoder*              decoder,
+    const SeeMsgDecoderClass*   decoder_cls,
+    size_t                      max_length,
+    SeeError**                  error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(decoder);
+    (void) error_out;
+
+    parent_cls->object_init(
+        SEE_OBJECT(decoder),
+        SEE_OBJECT_CLASS(decoder_cls)
+        );
+
+    decoder->bytes      = NULL;
+    decoder->begin      = 0;
+    decoder->end        = 0;
+    decoder->capacity   = 0;
+    decoder->max_length = max_length;
+    decoder->discarded  = 0;
+
+    return SEE_SUCCESS;
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeMsgDecoderClass* decoder_cls = SEE_MSG_DECODER_CLASS(cls);
+    SeeMsgDecoder* decoder = SEE_MSG_DECODER(obj);
+
+    /*Extract parameters here from va_list args here.*/
+    size_t     max_length   = va_arg(args, size_t);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return decoder_cls->msg_decoder_init(
+        decoder,
+        decoder_cls,
+        max_length,
+        error_out
+        );
+}
+
+static void
+msg_decoder_destroy(SeeObject* obj)
+{
+    SeeMsgDecoder* decoder = SEE_MSG_DECODER(obj);
+    free(decoder->bytes);
+    see_object_class()->destroy(obj);
+}
+
+static int
+msg_decoder_feed(
+    SeeMsgDecoder*  decoder,
+    const void*     bytes,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    if (decoder->begin == decoder->end)
+        decoder->begin = decoder->end = 0;
+
+    if (n > decoder->capacity - decoder->end) {
+        // Make room by moving the start of an incomplete message to the front
+        size_t buffered = decoder->end - decoder->begin;
+        if (decoder->begin) {
+            memmove(decoder->bytes, &decoder->bytes[decoder->begin], buffered);
+            decoder->begin  = 0;
+            decoder->end    = buffered;
+        }
+
+        if (n > decoder->capacity - decoder->end) {
+            size_t capacity = decoder->capacity * 2;
+            if (capacity < MSG_DECODER_MIN_CAPACITY)
+                capacity = MSG_DECODER_MIN_CAPACITY;
+            if (capacity < decoder->end + n)
+                capacity = decoder->end + n;
+
+            unsigned char* new_bytes = realloc(decoder->bytes, capacity);
+            if (!new_bytes) {
+                see_runtime_error_new(error_out, errno);
+                return SEE_ERROR_RUNTIME;
+            }
+            decoder->bytes      = new_bytes;
+            decoder->capacity   = capacity;
+        }
+    }
+
+    memcpy(&decoder->bytes[decoder->end], bytes, n);
+    decoder->end += n;
+
+    return SEE_SUCCESS;
+}
+
+/*
+ * Skip n bytes that don't belong to a message.
+ */
+static void
+msg_decoder_discard(SeeMsgDecoder* decoder, size_t n)
+{
+    decoder->begin      += n;
+    decoder->discarded  += n;
+}
+
+static int
+msg_decoder_next_view(
+    SeeMsgDecoder*  decoder,
+    SeeMsgView*     view,
+    int*            found,
+    SeeError**      error_out
+    )
+{
+    const SeeMsgBufferClass* msg_cls = see_msg_buffer_class();
+    const char* msg_start   = msg_cls->msg_start;
+    size_t start_length     = strlen(msg_start);
+    size_t header_length    = start_length + sizeof(uint16_t) + sizeof(uint32_t);
+
+    *found = 0;
+
+    for (;;) {
+        size_t available = decoder->end - decoder->begin;
+        uint32_t length;
+
+        if (available == 0)
+            return SEE_SUCCESS;
+
+        const unsigned char* p = &decoder->bytes[decoder->begin];
+
+        if (available < start_length) {
+            // Wait for more bytes when this may be the start of a message.
+            if (memcmp(p, msg_start, available) == 0)
+                return SEE_SUCCESS;
+            msg_decoder_discard(decoder, 1);
+            continue;
+        }
+
+        if (memcmp(p, msg_start, start_length) != 0) {
+            const unsigned char* next = memchr(p + 1, msg_start[0], available - 1);
+            msg_decoder_discard(decoder, next ? (size_t) (next - p) : available);
+            continue;
+        }
+
+        if (available < header_length)
+            return SEE_SUCCESS;
+
+        memcpy(&length, p + start_length + sizeof(uint16_t), sizeof(length));
+        length = see_network_to_host32(length);
+
+        if (length < header_length ||
+            (decoder->max_length && length > decoder->max_length))
+        {
+            // This wasn't the start of a message.
+            msg_decoder_discard(decoder, 1);
+            continue;
+        }
+
+        if (available < length)
+            return SEE_SUCCESS;
+
+        SeeError* invalid = NULL;
+        int ret = see_msg_view_init(view, p, length, &invalid);
+        if (ret == SEE_ERROR_MSG_INVALID) {
+            see_object_decref(SEE_OBJECT(invalid));
+            msg_decoder_discard(decoder, 1);
+            continue;
+        }
+        else if (ret) {
+            if (invalid)
+                *error_out = invalid;
+            return ret;
+        }
+
+        decoder->begin += length;
+        *found = 1;
+        return SEE_SUCCESS;
+    }
+}
+
+static int
+msg_decoder_next(
+    SeeMsgDecoder*  decoder,
+    SeeMsgBuffer**  msg_out,
+    int*            found,
+    SeeError**      error_out
+    )
+{
+    const SeeMsgDecoderClass* cls = SEE_MSG_DECODER_GET_CLASS(decoder);
+    SeeMsgBuffer* msg = NULL;
+    SeeMsgView view;
+    size_t length;
+
+    int ret = cls->next_view(decoder, &view, found, error_out);
+    if (ret || !*found)
+        return ret;
+
+    see_msg_view_length(&view, &length);
+    ret = see_msg_buffer_from_buffer(&msg, view.bytes, length, error_out);
+    if (ret) {
+        *found = 0;
+        return ret;
+    }
+
+    if (*msg_out)
+        see_object_decref(SEE_OBJECT(*msg_out));
+    *msg_out = msg;
+
+    return SEE_SUCCESS;
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_msg_decoder_new(
+    SeeMsgDecoder** decoder_out,
+    size_t          max_length,
+    SeeError**      error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(see_msg_decoder_class());
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!decoder_out || *decoder_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+        cls,
+        0,
+        SEE_OBJECT_REF(decoder_out),
+        max_length,
+        error_out
+        );
+}
+
+int
+see_msg_decoder_feed(
+    SeeMsgDecoder*  decoder,
+    const void*     bytes,
+    size_t          n,
+    SeeError**      error_out
+    )
+{
+    if (!decoder || (!bytes && n) || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (n == 0)
+        return SEE_SUCCESS;
+
+    const SeeMsgDecoderClass* cls = SEE_MSG_DECODER_GET_CLASS(decoder);
+    return cls->feed(decoder, bytes, n, error_out);
+}
+
+int
+see_msg_decoder_next_view(
+    SeeMsgDecoder*  decoder,
+    SeeMsgView*     view,
+    int*            found,
+    SeeError**      error_out
+    )
+{
+    if (!decoder || !view || !found || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgDecoderClass* cls = SEE_MSG_DECODER_GET_CLASS(decoder);
+    return cls->next_view(decoder, view, found, error_out);
+}
+
+int
+see_msg_decoder_next(
+    SeeMsgDecoder*  decoder,
+    SeeMsgBuffer**  msg_out,
+    int*            found,
+    SeeError**      error_out
+    )
+{
+    if (!decoder || !msg_out || !found || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeMsgDecoderClass* cls = SEE_MSG_DECODER_GET_CLASS(decoder);
+    return cls->next(decoder, msg_out, found, error_out);
+}
+
+int
+see_msg_decoder_buffered(const SeeMsgDecoder* decoder, size_t* n_out)
+{
+    if (!decoder || !n_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *n_out = decoder->end - decoder->begin;
+    return SEE_SUCCESS;
+}
+
+int
+see_msg_decoder_discarded(const SeeMsgDecoder* decoder, size_t* n_out)
+{
+    if (!decoder || !n_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *n_out = decoder->discarded;
+    return SEE_SUCCESS;
+}
+
+/* **** initialization of the class **** */
+
+/**
+ * \brief A pointer to the global SeeMsgDecoderClass.
+ * \private
+ */
+SeeMsgDecoderClass* g_SeeMsgDecoderClass = NULL;
+
+static int see_msg_decoder_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the parent here */
+    new_cls->init       = init;
+    new_cls->name       = "SeeMsgDecoder";
+    new_cls->destroy    = msg_decoder_destroy;
+
+    /* Set the function pointers of the own class here */
+    SeeMsgDecoderClass* cls = (SeeMsgDecoderClass*) new_cls;
+
+    cls->msg_decoder_init   = msg_decoder_init;
+    cls->feed               = msg_decoder_feed;
+    cls->next_view          = msg_decoder_next_view;
+    cls->next               = msg_decoder_next;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeMsgDecoder(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_msg_decoder_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeMsgDecoderClass,
+        sizeof(SeeMsgDecoderClass),
+        sizeof(SeeMsgDecoder),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        see_msg_decoder_class_init
+        );
+
+    return ret;
+}
+
+void
+see_msg_decoder_deinit()
+{
+    if(!g_SeeMsgDecoderClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeMsgDecoderClass));
+    g_SeeMsgDecoderClass = NULL;
+}
+
+const SeeMsgDecoderClass*
+see_msg_decoder_class()
+{
+    return g_SeeMsgDecoderClass;
+}
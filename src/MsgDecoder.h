@@ -0,0 +1,277 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file MsgDecoder.h
+ * \brief Cuts a stream of bytes into SeeMsgBuffers.
+ *
+ * A SeeMsgDecoder doesn't read from a device itself. Bytes that are
+ * received in any way, from a serial device, a pipe, a socket or a file,
+ * are fed to the decoder in chunks of any size. Thereafter the complete
+ * messages can be taken from the decoder one by one, either as a
+ * SeeMsgBuffer or as a SeeMsgView.
+ *
+ * Bytes that don't belong to a valid message are skipped until the
+ * start of a new message is found, so the decoder recovers from garbage
+ * or lost bytes in the stream.
+ */
+
+#ifndef SEE_MSG_DECODER_H
+#define SEE_MSG_DECODER_H
+
+#include "SeeObject.h"
+#include "Error.h"
+#include "MsgBuffer.h"
+#include "MsgView.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SeeMsgDecoder SeeMsgDecoder;
+typedef struct SeeMsgDecoderClass SeeMsgDecoderClass;
+
+struct SeeMsgDecoder {
+    SeeObject parent_obj;
+
+    /** \private The bytes that have been fed, but aren't decoded yet. */
+    unsigned char*  bytes;
+
+    /** \private The first byte that hasn't been decoded. */
+    size_t          begin;
+
+    /** \private One past the last byte that has been fed. */
+    size_t          end;
+
+    /** \private The number of bytes allocated for bytes. */
+    size_t          capacity;
+
+    /** \private Longer messages are considered to be garbage, 0 = no limit */
+    size_t          max_length;
+
+    /** \private The number of bytes skipped while searching a message. */
+    size_t          discarded;
+};
+
+struct SeeMsgDecoderClass {
+    SeeObjectClass parent_cls;
+
+    int (*msg_decoder_init)(
+        SeeMsgDecoder*              decoder,
+        const SeeMsgDecoderClass*   decoder_cls,
+        size_t                      max_length,
+        SeeError**                  error_out
+        );
+
+    /**
+     * \brief Append bytes to the stream.
+     * \private
+     */
+    int (*feed)(
+        SeeMsgDecoder*  decoder,
+        const void*     bytes,
+        size_t          n,
+        SeeError**      error_out
+        );
+
+    /**
+     * \brief Obtain a view on the next complete message.
+     * \private
+     */
+    int (*next_view)(
+        SeeMsgDecoder*  decoder,
+        SeeMsgView*     view,
+        int*            found,
+        SeeError**      error_out
+        );
+
+    /**
+     * \brief Obtain the next complete message as SeeMsgBuffer.
+     * \private
+     */
+    int (*next)(
+        SeeMsgDecoder*  decoder,
+        SeeMsgBuffer**  msg_out,
+        int*            found,
+        SeeError**      error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeMsgDecoder derived instance back to a
+ *        pointer to SeeMsgDecoder.
+ */
+#define SEE_MSG_DECODER(obj)                      \
+    ((SeeMsgDecoder*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeMsgDecoder derived instance back
+ *        to a reference to SeeMsgDecoder*.
+ */
+#define SEE_MSG_DECODER_REF(ref)                      \
+    ((SeeMsgDecoder**) ref)
+
+/**
+ * \brief cast a pointer to SeeMsgDecoderClass derived class back to a
+ *        pointer to SeeMsgDecoderClass.
+ */
+#define SEE_MSG_DECODER_CLASS(cls)                      \
+    ((const SeeMsgDecoderClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeMsgDecoderClass from a instance of
+ *        derived from SeeMsgDecoder. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_MSG_DECODER_GET_CLASS(obj)                \
+    (SEE_MSG_DECODER_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new decoder.
+ *
+ * @param [out] decoder_out The new decoder is returned here.
+ * @param [in]  max_length  A header that announces a message longer than
+ *                          this is considered to be garbage. This prevents
+ *                          that a corrupted length makes the decoder wait
+ *                          forever. Use 0 to accept any length.
+ * @param [out] error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_NOT_INITIALIZED
+ */
+SEE_EXPORT int
+see_msg_decoder_new(
+    SeeMsgDecoder** decoder_out,
+    size_t          max_length,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append received bytes to the stream.
+ *
+ * The bytes are copied once into the decoder. Only the bytes of a message
+ * that isn't complete yet may be moved to make room for new bytes.
+ * Feeding invalidates the views returned by see_msg_decoder_next_view().
+ *
+ * @param [in, out] decoder     The decoder.
+ * @param [in]      bytes       The received bytes.
+ * @param [in]      n           The number of bytes.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_decoder_feed(
+    SeeMsgDecoder*  decoder,
+    const void*     bytes,
+    size_t          n,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain a view on the next complete message.
+ *
+ * Call this function until *found is 0 to obtain all the messages that
+ * have been received.
+ *
+ * @param [in, out] decoder     The decoder.
+ * @param [out]     view        A view on the message, the bytes it views are
+ *                              owned by the decoder and remain valid until
+ *                              the next call to see_msg_decoder_feed().
+ * @param [out]     found       1 when a message is returned, 0 when more
+ *                              bytes are required.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_decoder_next_view(
+    SeeMsgDecoder*  decoder,
+    SeeMsgView*     view,
+    int*            found,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain the next complete message.
+ *
+ * @param [in, out] decoder     The decoder.
+ * @param [out]     msg_out     If a message is found it is returned here,
+ *                              a message that *msg_out points to will be
+ *                              decreffed.
+ * @param [out]     found       1 when a message is returned, 0 when more
+ *                              bytes are required.
+ * @param [out]     error_out   If an error occurs it is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_decoder_next(
+    SeeMsgDecoder*  decoder,
+    SeeMsgBuffer**  msg_out,
+    int*            found,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain the number of bytes that are fed, but not yet decoded.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_decoder_buffered(const SeeMsgDecoder* decoder, size_t* n_out);
+
+/**
+ * \brief Obtain the number of bytes that were skipped, because they didn't
+ *        belong to a valid message.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_decoder_discarded(const SeeMsgDecoder* decoder, size_t* n_out);
+
+/**
+ * Gets the pointer to the SeeMsgDecoderClass table.
+ */
+SEE_EXPORT const SeeMsgDecoderClass*
+see_msg_decoder_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeMsgDecoder; make it ready for use.
+ */
+SEE_EXPORT
+int see_msg_decoder_init();
+
+/**
+ * Deinitialize SeeMsgDecoder, after SeeMsgDecoder has been deinitialized,
+ * all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_msg_decoder_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_MSG_DECODER_H
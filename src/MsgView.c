@@ -0,0 +1,614 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file MsgView.c
+ * \brief Decodes the parts of a serialized message in place.
+ *
+ * \private
+ */
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include "MsgView.h"
+#include "ByteOrderKernels.h"
+#include "Crc32c.h"
+#include "IndexError.h"
+#include "RuntimeError.h"
+#include "utilities.h"
+
+/*
+ * The size of the type byte and the length of a string or array part, the
+ * length of those parts includes these bytes.
+ */
+#define TYPE_SIZE       (sizeof(uint8_t))
+#define STRING_HEADER   (sizeof(uint8_t) + sizeof(uint32_t))
+
+/*
+ * The size of the optional trailer with the CRC32C of the message.
+ */
+#define TRAILER_SIZE    (sizeof(uint8_t) + sizeof(uint32_t))
+
+/*
+ * Returns the size of the elements of an array type.
+ */
+static size_t
+array_element_size(uint8_t type)
+{
+    switch (type) {
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+            return sizeof(uint32_t);
+        default:
+            return sizeof(uint64_t);
+    }
+}
+
+/*
+ * Returns the number of bytes of the part at bytes, or 0 when the part
+ * is invalid or doesn't fit in avail bytes.
+ */
+static size_t
+part_size(const unsigned char* bytes, size_t avail)
+{
+    uint32_t length;
+
+    if (avail < TYPE_SIZE)
+        return 0;
+
+    switch (bytes[0]) {
+        case SEE_MSG_PART_INT32_T:
+        case SEE_MSG_PART_UINT32_T:
+        case SEE_MSG_PART_FLOAT_T:
+            length = TYPE_SIZE + sizeof(uint32_t);
+            break;
+        case SEE_MSG_PART_INT64_T:
+        case SEE_MSG_PART_UINT64_T:
+        case SEE_MSG_PART_DOUBLE_T:
+            length = TYPE_SIZE + sizeof(uint64_t);
+            break;
+        case SEE_MSG_PART_STRING_T:
+        case SEE_MSG_PART_BYTES_T:
+            if (avail < STRING_HEADER)
+                return 0;
+            memcpy(&length, &bytes[TYPE_SIZE], sizeof(length));
+            length = see_network_to_host32(length);
+            if (length < STRING_HEADER)
+                return 0;
+            break;
+        case SEE_MSG_PART_INT32_ARRAY_T:
+        case SEE_MSG_PART_INT64_ARRAY_T:
+        case SEE_MSG_PART_FLOAT_ARRAY_T:
+        case SEE_MSG_PART_DOUBLE_ARRAY_T:
+            if (avail < STRING_HEADER)
+                return 0;
+            memcpy(&length, &bytes[TYPE_SIZE], sizeof(length));
+            length = see_network_to_host32(length);
+            if (length < STRING_HEADER ||
+                (length - STRING_HEADER) % array_element_size(bytes[0]))
+                return 0;
+            break;
+        default:
+            return 0;
+    }
+
+    if (length > avail)
+        return 0;
+
+    return length;
+}
+
+/*
+ * Returns the offset of part index, the parts have been validated by
+ * see_msg_view_init.
+ */
+static size_t
+view_seek(SeeMsgView* view, size_t index)
+{
+    assert(index < view->num_parts);
+
+    if (index < view->cursor_index) {
+        view->cursor_index  = 0;
+        view->cursor_offset = strlen(see_msg_buffer_class()->msg_start) +
+                              sizeof(view->id) + sizeof(view->length);
+    }
+
+    while (view->cursor_index < index) {
+        view->cursor_offset += part_size(
+            &view->bytes[view->cursor_offset],
+            view->length - view->cursor_offset
+            );
+        view->cursor_index++;
+    }
+
+    return view->cursor_offset;
+}
+
+/*
+ * Finds the part and checks its type, returns a pointer to its payload.
+ */
+static int
+view_payload(
+    SeeMsgView*             view,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    const unsigned char**   payload_out,
+    SeeError**              error_out
+    )
+{
+    if (!view || !payload_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (index >= view->num_parts) {
+        see_index_error_new(error_out, index);
+        return SEE_ERROR_INDEX;
+    }
+
+    const unsigned char* part = &view->bytes[view_seek(view, index)];
+    if (part[0] != type) {
+        see_msg_part_type_error_new(error_out, part[0], type);
+        return SEE_ERROR_MSG_PART_TYPE;
+    }
+
+    *payload_out = part + TYPE_SIZE;
+    return SEE_SUCCESS;
+}
+
+static int
+view_get32(
+    SeeMsgView*             view,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    uint32_t*               value,
+    SeeError**              error_out
+    )
+{
+    const unsigned char* payload;
+    uint32_t net_order;
+
+    int ret = view_payload(view, index, type, &payload, error_out);
+    if (ret)
+        return ret;
+
+    memcpy(&net_order, payload, sizeof(net_order));
+    *value = see_network_to_host32(net_order);
+    return SEE_SUCCESS;
+}
+
+static int
+view_get64(
+    SeeMsgView*             view,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    uint64_t*               value,
+    SeeError**              error_out
+    )
+{
+    const unsigned char* payload;
+    uint64_t net_order;
+
+    int ret = view_payload(view, index, type, &payload, error_out);
+    if (ret)
+        return ret;
+
+    memcpy(&net_order, payload, sizeof(net_order));
+    *value = see_network_to_host64(net_order);
+    return SEE_SUCCESS;
+}
+
+/*
+ * Obtains the payload of a string or bytes part, these don't have a byte
+ * order, so they are handed out without copying them.
+ */
+static int
+view_get_raw(
+    SeeMsgView*             view,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    const unsigned char**   raw_out,
+    size_t*                 length_out,
+    SeeError**              error_out
+    )
+{
+    const unsigned char* payload;
+    uint32_t length;
+
+    if (!raw_out || !length_out)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = view_payload(view, index, type, &payload, error_out);
+    if (ret)
+        return ret;
+
+    memcpy(&length, payload, sizeof(length));
+    length = see_network_to_host32(length);
+
+    *raw_out    = payload + sizeof(length);
+    *length_out = length - STRING_HEADER;
+    return SEE_SUCCESS;
+}
+
+/*
+ * Copies the elements of an array part to dst in host order.
+ */
+static int
+view_get_array(
+    SeeMsgView*             view,
+    size_t                  index,
+    see_msg_part_value_t    type,
+    void*                   dst,
+    size_t                  cap,
+    size_t*                 n_out,
+    SeeError**              error_out
+    )
+{
+    const unsigned char* payload;
+    uint32_t length;
+    size_t element_size = array_element_size(type);
+
+    if ((!dst && cap) || !n_out)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = view_payload(view, index, type, &payload, error_out);
+    if (ret)
+        return ret;
+
+    memcpy(&length, payload, sizeof(length));
+    length = see_network_to_host32(length);
+
+    size_t n = (length - STRING_HEADER) / element_size;
+    *n_out = n;
+    if (n > cap) {
+        errno = ENOBUFS;
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    if (element_size == sizeof(uint32_t))
+        see_network_to_host32_array(dst, payload + sizeof(length), n);
+    else
+        see_network_to_host64_array(dst, payload + sizeof(length), n);
+
+    return SEE_SUCCESS;
+}
+
+/* **** public API **** */
+
+int
+see_msg_view_init(
+    SeeMsgView*     view,
+    const void*     buffer,
+    size_t          bufsiz,
+    SeeError**      error_out
+    )
+{
+    const SeeMsgBufferClass* cls = see_msg_buffer_class();
+    const unsigned char* bytes = buffer;
+    uint16_t id;
+    uint32_t length;
+    size_t   nread, header_len, num_parts = 0;
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!view || !buffer || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    size_t start_length = strlen(cls->msg_start);
+    header_len = start_length + sizeof(id) + sizeof(length);
+
+    if (bufsiz < header_len ||
+        memcmp(bytes, cls->msg_start, start_length) != 0)
+    {
+        see_msg_invalid_error_new(error_out);
+        return SEE_ERROR_MSG_INVALID;
+    }
+    nread = start_length;
+
+    memcpy(&id, &bytes[nread], sizeof(id));
+    id = see_network_to_host16(id);
+    nread += sizeof(id);
+
+    memcpy(&length, &bytes[nread], sizeof(length));
+    length = see_network_to_host32(length);
+    nread += sizeof(length);
+
+    if (length < header_len || length > bufsiz) {
+        see_msg_invalid_error_new(error_out);
+        return SEE_ERROR_MSG_INVALID;
+    }
+
+    while (nread < length) {
+        if (bytes[nread] == SEE_MSG_PART_TRAILER &&
+            length - nread == TRAILER_SIZE)
+        {
+            uint32_t crc;
+            memcpy(&crc, &bytes[nread + TYPE_SIZE], sizeof(crc));
+            if (see_crc32c(0, bytes, nread) != see_network_to_host32(crc)) {
+                see_msg_invalid_error_new(error_out);
+                return SEE_ERROR_MSG_INVALID;
+            }
+            break;
+        }
+
+        size_t size = part_size(&bytes[nread], length - nread);
+        if (!size) {
+            see_msg_invalid_error_new(error_out);
+            return SEE_ERROR_MSG_INVALID;
+        }
+        nread += size;
+        num_parts++;
+    }
+
+    view->bytes         = bytes;
+    view->num_parts     = num_parts;
+    view->cursor_index  = 0;
+    view->cursor_offset = header_len;
+    view->length        = length;
+    view->id            = id;
+
+    return SEE_SUCCESS;
+}
+
+int
+see_msg_view_id(const SeeMsgView* view, uint16_t* id_out)
+{
+    if (!view || !id_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *id_out = view->id;
+    return SEE_SUCCESS;
+}
+
+int
+see_msg_view_length(const SeeMsgView* view, size_t* length_out)
+{
+    if (!view || !length_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *length_out = view->length;
+    return SEE_SUCCESS;
+}
+
+int
+see_msg_view_num_parts(const SeeMsgView* view, size_t* num_out)
+{
+    if (!view || !num_out)
+        return SEE_INVALID_ARGUMENT;
+
+    *num_out = view->num_parts;
+    return SEE_SUCCESS;
+}
+
+int
+see_msg_view_part_type(
+    SeeMsgView*     view,
+    size_t          index,
+    uint8_t*        type_out,
+    SeeError**      error_out
+    )
+{
+    if (!view || !type_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (index >= view->num_parts) {
+        see_index_error_new(error_out, index);
+        return SEE_ERROR_INDEX;
+    }
+
+    *type_out = view->bytes[view_seek(view, index)];
+    return SEE_SUCCESS;
+}
+
+int
+see_msg_view_get_int32(
+    SeeMsgView*     view,
+    size_t          index,
+    int32_t*        value,
+    SeeError**      error_out
+    )
+{
+    uint32_t host;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = view_get32(view, index, SEE_MSG_PART_INT32_T, &host, error_out);
+    if (ret == SEE_SUCCESS)
+        *value = (int32_t) host;
+    return ret;
+}
+
+int
+see_msg_view_get_uint32(
+    SeeMsgView*     view,
+    size_t          index,
+    uint32_t*       value,
+    SeeError**      error_out
+    )
+{
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
+
+    return view_get32(view, index, SEE_MSG_PART_UINT32_T, value, error_out);
+}
+
+int
+see_msg_view_get_int64(
+    SeeMsgView*     view,
+    size_t          index,
+    int64_t*        value,
+    SeeError**      error_out
+    )
+{
+    uint64_t host;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = view_get64(view, index, SEE_MSG_PART_INT64_T, &host, error_out);
+    if (ret == SEE_SUCCESS)
+        *value = (int64_t) host;
+    return ret;
+}
+
+int
+see_msg_view_get_uint64(
+    SeeMsgView*     view,
+    size_t          index,
+    uint64_t*       value,
+    SeeError**      error_out
+    )
+{
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
+
+    return view_get64(view, index, SEE_MSG_PART_UINT64_T, value, error_out);
+}
+
+int
+see_msg_view_get_float(
+    SeeMsgView*     view,
+    size_t          index,
+    float*          value,
+    SeeError**      error_out
+    )
+{
+    uint32_t host;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = view_get32(view, index, SEE_MSG_PART_FLOAT_T, &host, error_out);
+    if (ret == SEE_SUCCESS)
+        memcpy(value, &host, sizeof(*value));
+    return ret;
+}
+
+int
+see_msg_view_get_double(
+    SeeMsgView*     view,
+    size_t          index,
+    double*         value,
+    SeeError**      error_out
+    )
+{
+    uint64_t host;
+    if (!value)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = view_get64(view, index, SEE_MSG_PART_DOUBLE_T, &host, error_out);
+    if (ret == SEE_SUCCESS)
+        memcpy(value, &host, sizeof(*value));
+    return ret;
+}
+
+int
+see_msg_view_get_string(
+    SeeMsgView*     view,
+    size_t          index,
+    const char**    str_out,
+    size_t*         length_out,
+    SeeError**      error_out
+    )
+{
+    return view_get_raw(
+        view,
+        index,
+        SEE_MSG_PART_STRING_T,
+        (const unsigned char**) str_out,
+        length_out,
+        error_out
+        );
+}
+
+int
+see_msg_view_get_bytes(
+    SeeMsgView*     view,
+    size_t          index,
+    const void**    bytes_out,
+    size_t*         n_out,
+    SeeError**      error_out
+    )
+{
+    return view_get_raw(
+        view,
+        index,
+        SEE_MSG_PART_BYTES_T,
+        (const unsigned char**) bytes_out,
+        n_out,
+        error_out
+        );
+}
+
+int
+see_msg_view_get_int32_array(
+    SeeMsgView*     view,
+    size_t          index,
+    int32_t*        dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    )
+{
+    return view_get_array(
+        view, index, SEE_MSG_PART_INT32_ARRAY_T, dst, cap, n_out, error_out
+        );
+}
+
+int
+see_msg_view_get_int64_array(
+    SeeMsgView*     view,
+    size_t          index,
+    int64_t*        dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    )
+{
+    return view_get_array(
+        view, index, SEE_MSG_PART_INT64_ARRAY_T, dst, cap, n_out, error_out
+        );
+}
+
+int
+see_msg_view_get_float_array(
+    SeeMsgView*     view,
+    size_t          index,
+    float*          dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    )
+{
+    return view_get_array(
+        view, index, SEE_MSG_PART_FLOAT_ARRAY_T, dst, cap, n_out, error_out
+        );
+}
+
+int
+see_msg_view_get_double_array(
+    SeeMsgView*     view,
+    size_t          index,
+    double*         dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    )
+{
+    return view_get_array(
+        view, index, SEE_MSG_PART_DOUBLE_ARRAY_T, dst, cap, n_out, error_out
+        );
+}
@@ -0,0 +1,318 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file MsgView.h
+ * \brief A read only view on a serialized SeeMsgBuffer.
+ *
+ * see_msg_buffer_from_buffer() builds a SeeMsgBuffer with a SeeMsgPart
+ * for every part of the message. A SeeMsgView instead decodes the values
+ * directly from the received bytes. The frame is validated once by
+ * see_msg_view_init(), thereafter the parts may be inspected without
+ * allocating. Strings are returned as a pointer into the bytes and a length.
+ *
+ * A SeeMsgView is not a SeeObject, it is typically declared on the stack.
+ * It doesn't own the bytes, so they must outlive the view.
+ *
+ * Parts are located by walking the message, the view remembers the last
+ * part it visited, so visiting the parts in order is cheap.
+ */
+
+#ifndef SEE_MSG_VIEW_H
+#define SEE_MSG_VIEW_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "MsgBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief A view on the bytes of one serialized SeeMsgBuffer.
+ *
+ * The members are private, use the see_msg_view_* functions.
+ */
+typedef struct SeeMsgView {
+    /** \private The start of the message. */
+    const unsigned char*    bytes;
+    /** \private The number of parts in the message. */
+    size_t                  num_parts;
+    /** \private The index of the part at cursor_offset. */
+    size_t                  cursor_index;
+    /** \private The offset of the part cursor_index from bytes. */
+    size_t                  cursor_offset;
+    /** \private The length of the message including its header. */
+    uint32_t                length;
+    /** \private The id of the message. */
+    uint16_t                id;
+} SeeMsgView;
+
+/**
+ * \brief Initialize a view on a serialized message.
+ *
+ * The header and all parts are validated, so the getters below don't have
+ * to check the bytes anymore. When the message ends with a CRC32C trailer,
+ * the CRC32C is verified as well.
+ *
+ * @param [out] view      The view to initialize.
+ * @param [in]  buffer    The bytes as written by see_msg_buffer_get_buffer().
+ * @param [in]  bufsiz    The number of bytes available at buffer, this may
+ *                        be more than the length of the message.
+ * @param [out] error_out If the bytes don't contain a valid message
+ *                        a SeeMsgInvalidError is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_MSG_INVALID
+ */
+SEE_EXPORT int
+see_msg_view_init(
+    SeeMsgView*     view,
+    const void*     buffer,
+    size_t          bufsiz,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain the id of the message.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_view_id(const SeeMsgView* view, uint16_t* id_out);
+
+/**
+ * \brief Obtain the number of bytes of the message, including its header.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_view_length(const SeeMsgView* view, size_t* length_out);
+
+/**
+ * \brief Obtain the number of parts in the message.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_msg_view_num_parts(const SeeMsgView* view, size_t* num_out);
+
+/**
+ * \brief Obtain the type of a part.
+ *
+ * @param [in]  view        An initialized view.
+ * @param [in]  index       The index of the part.
+ * @param [out] type_out    One of the see_msg_part_value_t values.
+ * @param [out] error_out   A SeeIndexError when the index is out of range.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_msg_view_part_type(
+    SeeMsgView*     view,
+    size_t          index,
+    uint8_t*        type_out,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain an int32_t from a part of the message.
+ *
+ * @param [in]  view        An initialized view.
+ * @param [in]  index       The index of the part.
+ * @param [out] value       The value is returned here.
+ * @param [out] error_out   If the index is out of range or the part has
+ *                          another type an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_view_get_int32(
+    SeeMsgView*     view,
+    size_t          index,
+    int32_t*        value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain an uint32_t from a part, see see_msg_view_get_int32().
+ */
+SEE_EXPORT int
+see_msg_view_get_uint32(
+    SeeMsgView*     view,
+    size_t          index,
+    uint32_t*       value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain an int64_t from a part, see see_msg_view_get_int32().
+ */
+SEE_EXPORT int
+see_msg_view_get_int64(
+    SeeMsgView*     view,
+    size_t          index,
+    int64_t*        value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain an uint64_t from a part, see see_msg_view_get_int32().
+ */
+SEE_EXPORT int
+see_msg_view_get_uint64(
+    SeeMsgView*     view,
+    size_t          index,
+    uint64_t*       value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain a float from a part, see see_msg_view_get_int32().
+ */
+SEE_EXPORT int
+see_msg_view_get_float(
+    SeeMsgView*     view,
+    size_t          index,
+    float*          value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain a double from a part, see see_msg_view_get_int32().
+ */
+SEE_EXPORT int
+see_msg_view_get_double(
+    SeeMsgView*     view,
+    size_t          index,
+    double*         value,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain a string from a part without copying it.
+ *
+ * @param [in]  view        An initialized view.
+ * @param [in]  index       The index of the part.
+ * @param [out] str_out     Points into the bytes of the message. Note that
+ *                          the string is NOT '\0' terminated.
+ * @param [out] length_out  The number of bytes of the string.
+ * @param [out] error_out   If the index is out of range or the part isn't
+ *                          a string an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_view_get_string(
+    SeeMsgView*     view,
+    size_t          index,
+    const char**    str_out,
+    size_t*         length_out,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Obtain the bytes of a bytes part without copying them.
+ *
+ * @param [in]  view        An initialized view.
+ * @param [in]  index       The index of the part.
+ * @param [out] bytes_out   Points into the bytes of the message.
+ * @param [out] n_out       The number of bytes.
+ * @param [out] error_out   If the index is out of range or the part isn't
+ *                          a bytes part an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE
+ */
+SEE_EXPORT int
+see_msg_view_get_bytes(
+    SeeMsgView*     view,
+    size_t          index,
+    const void**    bytes_out,
+    size_t*         n_out,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Copy the elements of an int32_t array part.
+ *
+ * The elements inside the message are in network byte order and they
+ * may not be aligned, so they are converted while they are copied.
+ *
+ * @param [in]  view        An initialized view.
+ * @param [in]  index       The index of the part.
+ * @param [out] dst         The elements are written here in host order.
+ * @param [in]  cap         The number of elements that fit in dst.
+ * @param [out] n_out       The number of elements in the array. If cap is
+ *                          too small nothing is copied and the function fails
+ *                          with ENOBUFS.
+ * @param [out] error_out   If the index is out of range or the part has
+ *                          another type an error is returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX,
+ *         SEE_ERROR_MSG_PART_TYPE, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_msg_view_get_int32_array(
+    SeeMsgView*     view,
+    size_t          index,
+    int32_t*        dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    );
+
+/** \copydoc see_msg_view_get_int32_array */
+SEE_EXPORT int
+see_msg_view_get_int64_array(
+    SeeMsgView*     view,
+    size_t          index,
+    int64_t*        dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    );
+
+/** \copydoc see_msg_view_get_int32_array */
+SEE_EXPORT int
+see_msg_view_get_float_array(
+    SeeMsgView*     view,
+    size_t          index,
+    float*          dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    );
+
+/** \copydoc see_msg_view_get_int32_array */
+SEE_EXPORT int
+see_msg_view_get_double_array(
+    SeeMsgView*     view,
+    size_t          index,
+    double*         dst,
+    size_t          cap,
+    size_t*         n_out,
+    SeeError**      error_out
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_MSG_VIEW_H
@@ -0,0 +1,342 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <new>
+
+#include "MetaClass.h"
+#include "ObjectQueue.h"
+#include "RuntimeError.h"
+#include "TimeoutError.h"
+#include "cpp/ObjectQueue.hpp"
+
+/* **** functions that implement SeeObjectQueue or override SeeObject **** */
+
+static size_t
+round_capacity(size_t capacity)
+{
+    size_t n = 2;
+    while (n < capacity)
+        n <<= 1;
+    return n;
+}
+
+static int
+object_queue_init(
+    SeeObjectQueue*             queue,
+    const SeeObjectQueueClass*  queue_cls,
+    see_object_queue_kind       kind,
+    size_t                      capacity,
+    SeeError**                  error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(queue);
+
+    parent_cls->object_init(
+            SEE_OBJECT(queue),
+            SEE_OBJECT_CLASS(queue_cls)
+            );
+
+    queue->kind = kind;
+    capacity = round_capacity(capacity);
+
+    try {
+        see::ObjectQueue* priv;
+        if (kind == SEE_OBJECT_QUEUE_SPSC)
+            priv = new see::SpscQueue(capacity);
+        else
+            priv = new see::MpmcQueue(capacity);
+        queue->priv = static_cast<void*>(priv);
+    } catch (const std::bad_alloc&) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static see::ObjectQueue::ns
+timeout_ns(const SeeDuration* timeout)
+{
+    return see::ObjectQueue::ns(see_duration_nanos(timeout));
+}
+
+static int
+object_queue_push(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj,
+    const SeeDuration*  timeout,
+    SeeError**          error_out
+    )
+{
+    auto* priv = static_cast<see::ObjectQueue*>(queue->priv);
+
+    bool pushed;
+    if (timeout) {
+        see::ObjectQueue::ns ns = timeout_ns(timeout);
+        pushed = priv->push(*obj, &ns);
+    }
+    else
+        pushed = priv->push(*obj, nullptr);
+
+    if (!pushed) {
+        see_timeout_error_new(error_out);
+        return SEE_ERROR_TIMEOUT;
+    }
+
+    *obj = NULL;
+    return SEE_SUCCESS;
+}
+
+static int
+object_queue_pop(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj_out,
+    const SeeDuration*  timeout,
+    SeeError**          error_out
+    )
+{
+    auto* priv = static_cast<see::ObjectQueue*>(queue->priv);
+
+    void* p = nullptr;
+    bool popped;
+    if (timeout) {
+        see::ObjectQueue::ns ns = timeout_ns(timeout);
+        popped = priv->pop(p, &ns);
+    }
+    else
+        popped = priv->pop(p, nullptr);
+
+    if (!popped) {
+        see_timeout_error_new(error_out);
+        return SEE_ERROR_TIMEOUT;
+    }
+
+    *obj_out = static_cast<SeeObject*>(p);
+    return SEE_SUCCESS;
+}
+
+static void
+object_queue_destroy(SeeObject* obj)
+{
+    SeeObjectQueue* queue = SEE_OBJECT_QUEUE(obj);
+    auto* priv = static_cast<see::ObjectQueue*>(queue->priv);
+
+    if (priv) {
+        // The queue owns the references of the objects that are left.
+        void* p;
+        while (priv->try_pop(p))
+            see_object_decref(static_cast<SeeObject*>(p));
+        delete priv;
+    }
+
+    see_object_class()->destroy(obj);
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeObjectQueueClass* queue_cls = SEE_OBJECT_QUEUE_CLASS(cls);
+    SeeObjectQueue* queue = SEE_OBJECT_QUEUE(obj);
+
+    see_object_queue_kind kind  = (see_object_queue_kind) va_arg(args, int);
+    size_t capacity             = va_arg(args, size_t);
+    SeeError** error_out        = va_arg(args, SeeError**);
+
+    return queue_cls->object_queue_init(
+        queue,
+        queue_cls,
+        kind,
+        capacity,
+        error_out
+        );
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_object_queue_new(
+    SeeObjectQueue**        out,
+    see_object_queue_kind   kind,
+    size_t                  capacity,
+    SeeError**              error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_object_queue_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (kind != SEE_OBJECT_QUEUE_SPSC && kind != SEE_OBJECT_QUEUE_MPMC)
+        return SEE_INVALID_ARGUMENT;
+
+    if (capacity == 0 || capacity > (SIZE_MAX >> 1) / sizeof(void*))
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(out),
+            (int) kind,
+            capacity,
+            error_out
+            );
+}
+
+int
+see_object_queue_try_push(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !obj || !*obj || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (static_cast<see::ObjectQueue*>(queue->priv)->try_push(*obj))
+        *obj = NULL;
+
+    return SEE_SUCCESS;
+}
+
+int
+see_object_queue_push(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj,
+    const SeeDuration*  timeout,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !obj || !*obj || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeObjectQueueClass* cls = SEE_OBJECT_QUEUE_GET_CLASS(queue);
+    return cls->push(queue, obj, timeout, error_out);
+}
+
+int
+see_object_queue_try_pop(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj_out,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !obj_out || *obj_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    void* p;
+    if (static_cast<see::ObjectQueue*>(queue->priv)->try_pop(p))
+        *obj_out = static_cast<SeeObject*>(p);
+
+    return SEE_SUCCESS;
+}
+
+int
+see_object_queue_pop(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj_out,
+    const SeeDuration*  timeout,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !obj_out || *obj_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeObjectQueueClass* cls = SEE_OBJECT_QUEUE_GET_CLASS(queue);
+    return cls->pop(queue, obj_out, timeout, error_out);
+}
+
+size_t
+see_object_queue_capacity(const SeeObjectQueue* queue)
+{
+    if (!queue)
+        return 0;
+
+    return static_cast<const see::ObjectQueue*>(queue->priv)->capacity();
+}
+
+/* **** initialization of the class **** */
+
+SeeObjectQueueClass* g_SeeObjectQueueClass = NULL;
+
+static int
+object_queue_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init    = init;
+    new_cls->destroy = object_queue_destroy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeObjectQueue";
+
+    /* Set the function pointers of the own class here */
+    SeeObjectQueueClass* cls = (SeeObjectQueueClass*) new_cls;
+    cls->object_queue_init  = object_queue_init;
+    cls->push               = object_queue_push;
+    cls->pop                = object_queue_pop;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeObjectQueue(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_object_queue_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeObjectQueueClass,
+        sizeof(SeeObjectQueueClass),
+        sizeof(SeeObjectQueue),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        object_queue_class_init
+        );
+
+    return ret;
+}
+
+void
+see_object_queue_deinit()
+{
+    if(!g_SeeObjectQueueClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeObjectQueueClass));
+    g_SeeObjectQueueClass = NULL;
+}
+
+const SeeObjectQueueClass*
+see_object_queue_class()
+{
+    return g_SeeObjectQueueClass;
+}
@@ -0,0 +1,274 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ObjectQueue.h
+ * @brief A bounded lock free queue to hand SeeObjects to another thread.
+ *
+ * A SeeObjectQueue stores pointers to SeeObjects in a ring of fixed
+ * capacity. There are two kinds:
+ *
+ *  - SEE_OBJECT_QUEUE_SPSC may be used by one producing and one consuming
+ *    thread at a time. It is the fastest, a push or pop is a few plain
+ *    loads and stores.
+ *  - SEE_OBJECT_QUEUE_MPMC may be used by any number of producers and
+ *    consumers.
+ *
+ * The queue takes over the reference of the producer: a successful push
+ * sets the caller's pointer to NULL and the consumer receives the
+ * reference with the pop, so the reference count of the objects isn't
+ * touched. Objects that are still in the queue when it is destroyed are
+ * decreffed.
+ *
+ * The try functions never wait. The other functions wait for room or for
+ * an object for at most a SeeDuration, or forever when the duration is
+ * NULL. A waiting thread spins briefly, so a hand-off to a thread that is
+ * waiting takes well under a microsecond, and then sleeps until the other
+ * side signals it.
+ *
+ * @code
+ * // reader thread
+ * ret = see_object_queue_push(queue, SEE_OBJECT_REF(&msg), NULL, &error);
+ *
+ * // worker thread
+ * SeeObject* obj = NULL;
+ * ret = see_object_queue_pop(queue, &obj, timeout, &error);
+ * if (ret == SEE_ERROR_TIMEOUT)
+ *     ...
+ * @endcode
+ */
+
+#ifndef SEE_OBJECT_QUEUE_H
+#define SEE_OBJECT_QUEUE_H
+
+#include "SeeObject.h"
+#include "Duration.h"
+#include "Error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Which threads may use a SeeObjectQueue.
+ */
+typedef enum see_object_queue_kind {
+    /** One producer and one consumer */
+    SEE_OBJECT_QUEUE_SPSC,
+    /** Multiple producers and multiple consumers */
+    SEE_OBJECT_QUEUE_MPMC
+} see_object_queue_kind;
+
+typedef struct SeeObjectQueue SeeObjectQueue;
+typedef struct SeeObjectQueueClass SeeObjectQueueClass;
+
+struct SeeObjectQueue {
+    SeeObject parent_obj;
+    see_object_queue_kind kind;
+    void* priv;
+};
+
+struct SeeObjectQueueClass {
+    SeeObjectClass parent_cls;
+
+    int (*object_queue_init)(
+        SeeObjectQueue*             queue,
+        const SeeObjectQueueClass*  queue_cls,
+        see_object_queue_kind       kind,
+        size_t                      capacity,
+        SeeError**                  error_out
+        );
+
+    int (*push)(
+        SeeObjectQueue*     queue,
+        SeeObject**         obj,
+        const SeeDuration*  timeout,
+        SeeError**          error_out
+        );
+
+    int (*pop)(
+        SeeObjectQueue*     queue,
+        SeeObject**         obj_out,
+        const SeeDuration*  timeout,
+        SeeError**          error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeObjectQueue derived instance back to a
+ *        pointer to SeeObjectQueue.
+ */
+#define SEE_OBJECT_QUEUE(obj)                      \
+    ((SeeObjectQueue*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeObjectQueue derived instance
+ *        back to a reference to SeeObjectQueue*.
+ */
+#define SEE_OBJECT_QUEUE_REF(ref)                      \
+    ((SeeObjectQueue**) ref)
+
+/**
+ * \brief cast a pointer to SeeObjectQueueClass derived class back to a
+ *        pointer to SeeObjectQueueClass.
+ */
+#define SEE_OBJECT_QUEUE_CLASS(cls)                      \
+    ((const SeeObjectQueueClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeObjectQueueClass from a instance of
+ *        derived from SeeObjectQueue. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_OBJECT_QUEUE_GET_CLASS(obj)                \
+    (SEE_OBJECT_QUEUE_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new empty queue.
+ *
+ * @param [out] out         A pointer to a SeeObjectQueue* that is NULL.
+ * @param [in]  kind        SEE_OBJECT_QUEUE_SPSC or SEE_OBJECT_QUEUE_MPMC.
+ * @param [in]  capacity    The number of objects the queue can hold, it is
+ *                          rounded up to a power of two of at least 2.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_object_queue_new(
+    SeeObjectQueue**        out,
+    see_object_queue_kind   kind,
+    size_t                  capacity,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Append an object when there is room, without waiting.
+ *
+ * @param [in]      queue       The queue to append to.
+ * @param [in, out] obj         A reference to the object to append. When
+ *                              the object is queued, *obj is set to NULL.
+ *                              When the queue is full *obj is left
+ *                              untouched and the caller keeps its
+ *                              reference.
+ * @param [out]     error_out   Only set for invalid arguments.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_object_queue_try_push(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Append an object, wait for room when the queue is full.
+ *
+ * @param [in]      queue       The queue to append to.
+ * @param [in, out] obj         see doc for see_object_queue_try_push()
+ * @param [in]      timeout     The maximum time to wait, or NULL to wait
+ *                              until there is room.
+ * @param [out]     error_out   A timeout error when there was no room
+ *                              in time.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_TIMEOUT
+ */
+SEE_EXPORT int
+see_object_queue_push(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj,
+    const SeeDuration*  timeout,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Take the oldest object when there is one, without waiting.
+ *
+ * @param [in]  queue       The queue to take the object from.
+ * @param [out] obj_out     A pointer to a SeeObject* that is NULL. It
+ *                          receives the reference to the object, or stays
+ *                          NULL when the queue is empty.
+ * @param [out] error_out   Only set for invalid arguments.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_object_queue_try_pop(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Take the oldest object, wait for one when the queue is empty.
+ *
+ * @param [in]  queue       The queue to take the object from.
+ * @param [out] obj_out     A pointer to a SeeObject* that is NULL, it
+ *                          receives the reference to the object.
+ * @param [in]  timeout     The maximum time to wait, or NULL to wait until
+ *                          there is an object.
+ * @param [out] error_out   A timeout error when no object arrived in time.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_TIMEOUT
+ */
+SEE_EXPORT int
+see_object_queue_pop(
+    SeeObjectQueue*     queue,
+    SeeObject**         obj_out,
+    const SeeDuration*  timeout,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Get the number of objects the queue can hold.
+ */
+SEE_EXPORT size_t
+see_object_queue_capacity(const SeeObjectQueue* queue);
+
+/**
+ * Gets the pointer to the SeeObjectQueueClass table.
+ */
+SEE_EXPORT const SeeObjectQueueClass*
+see_object_queue_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeObjectQueue; make it ready for use.
+ */
+SEE_EXPORT
+int see_object_queue_init();
+
+/**
+ * Deinitialize SeeObjectQueue, after SeeObjectQueue has been
+ * deinitialized, all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_object_queue_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_OBJECT_QUEUE_H
@@ -0,0 +1,968 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MetaClass.h"
+#include "PriorityQueue.h"
+#include "IndexError.h"
+#include "RuntimeError.h"
+
+/*
+ * An entry in the heap is the handle, followed by the deadline of a timer
+ * and the element. The element is padded, so the next entry is aligned.
+ */
+#define HANDLE_SIZE sizeof(size_t)
+
+// The position of a handle that isn't in use.
+#define NO_POSITION SIZE_MAX
+
+#define ENTRY(queue, i)                                                     \
+    ((queue)->heap->elements + (i) * (queue)->heap->element_size)
+
+#define ENTRY_KEY(entry)                                                    \
+    ((entry) + HANDLE_SIZE)
+
+#define ENTRY_ELEMENT(queue, entry)                                         \
+    ((entry) + HANDLE_SIZE + (queue)->key_size)
+
+#define POSITIONS(queue)                                                    \
+    ((size_t*) (queue)->positions->elements)
+
+/* **** helpers **** */
+
+static size_t
+entry_handle(const char* entry)
+{
+    size_t handle;
+    memcpy(&handle, entry, sizeof(handle));
+    return handle;
+}
+
+static int
+compare_entries(const SeePriorityQueue* queue, const char* a, const char* b)
+{
+    // The comparison starts at the key, which is the element without one.
+    return queue->cmp(ENTRY_KEY(a), ENTRY_KEY(b), queue->cmp_data);
+}
+
+static int
+compare_objects(const void* a, const void* b, void* data)
+{
+    SeePriorityQueue* queue = data;
+    int result = 0;
+
+    // After the first failure every element is considered equal.
+    if (queue->cmp_ret)
+        return 0;
+
+    queue->cmp_ret = see_object_compare(
+        *(SeeObject* const*) a,
+        *(SeeObject* const*) b,
+        &result,
+        queue->cmp_error
+        );
+
+    return queue->cmp_ret ? 0 : result;
+}
+
+static int
+compare_deadlines(const void* a, const void* b, void* data)
+{
+    (void) data;
+    int64_t ka, kb;
+    memcpy(&ka, a, sizeof(ka));
+    memcpy(&kb, b, sizeof(kb));
+    return (ka > kb) - (ka < kb);
+}
+
+/*
+ * Store a copy of entry at index i and remember where its handle went.
+ */
+static void
+place(SeePriorityQueue* queue, size_t i, const char* entry)
+{
+    memcpy(ENTRY(queue, i), entry, queue->heap->element_size);
+    POSITIONS(queue)[entry_handle(entry)] = i;
+}
+
+/*
+ * The entry that moves is kept aside, the entries it passes are moved into
+ * the hole it leaves behind. That takes one copy per level instead of a swap.
+ */
+static void
+sift_up(SeePriorityQueue* queue, size_t i)
+{
+    const size_t entry_size = queue->heap->element_size;
+    char* moving = queue->scratch + entry_size;
+
+    memcpy(moving, ENTRY(queue, i), entry_size);
+    while (i > 0) {
+        size_t parent = (i - 1) / queue->arity;
+        if (compare_entries(queue, moving, ENTRY(queue, parent)) >= 0)
+            break;
+        place(queue, i, ENTRY(queue, parent));
+        i = parent;
+    }
+    place(queue, i, moving);
+}
+
+static void
+sift_down(SeePriorityQueue* queue, size_t i)
+{
+    const size_t entry_size = queue->heap->element_size;
+    const size_t n = queue->heap->size;
+    const size_t d = queue->arity;
+    char* moving = queue->scratch + entry_size;
+
+    memcpy(moving, ENTRY(queue, i), entry_size);
+
+    // i has a child as long as i * d + 1 < n.
+    while (n >= 2 && i <= (n - 2) / d) {
+        size_t first = i * d + 1;
+        size_t last = n - first > d ? first + d : n;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++)
+            if (compare_entries(queue, ENTRY(queue, c), ENTRY(queue, best)) < 0)
+                best = c;
+
+        if (compare_entries(queue, ENTRY(queue, best), moving) >= 0)
+            break;
+        place(queue, i, ENTRY(queue, best));
+        i = best;
+    }
+    place(queue, i, moving);
+}
+
+/*
+ * Move the entry at i up or down after its key changed.
+ */
+static void
+restore(SeePriorityQueue* queue, size_t i)
+{
+    if (i > 0 &&
+        compare_entries(
+            queue, ENTRY(queue, i), ENTRY(queue, (i - 1) / queue->arity)
+            ) < 0
+        )
+        sift_up(queue, i);
+    else
+        sift_down(queue, i);
+}
+
+static void
+heapify(SeePriorityQueue* queue)
+{
+    const size_t n = queue->heap->size;
+    if (n < 2)
+        return;
+
+    for (size_t i = (n - 2) / queue->arity + 1; i-- > 0;)
+        sift_down(queue, i);
+}
+
+static int
+take_handle(SeePriorityQueue* queue, size_t* handle, SeeError** error_out)
+{
+    SeeDynamicArray* free_handles = queue->free_handles;
+    size_t nfree = free_handles->size;
+
+    if (nfree) {
+        *handle = ((size_t*) free_handles->elements)[nfree - 1];
+        return see_dynamic_array_resize(free_handles, nfree - 1, NULL, error_out);
+    }
+
+    size_t new_handle = queue->positions->size;
+    size_t position = NO_POSITION;
+
+    // Reserve room to return every handle, so returning cannot fail.
+    int ret = see_dynamic_array_reserve(free_handles, new_handle + 1, error_out);
+    if (ret)
+        return ret;
+    ret = see_dynamic_array_add(queue->positions, &position, error_out);
+    if (ret)
+        return ret;
+
+    *handle = new_handle;
+    return SEE_SUCCESS;
+}
+
+static void
+release_handle(SeePriorityQueue* queue, size_t handle)
+{
+    SeeError* error = NULL;
+
+    POSITIONS(queue)[handle] = NO_POSITION;
+    see_dynamic_array_add(queue->free_handles, &handle, &error);
+}
+
+static int
+check_handle(
+    const SeePriorityQueue* queue,
+    size_t                  handle,
+    SeeError**              error_out
+    )
+{
+    if (!see_priority_queue_contains(queue, handle)) {
+        see_index_error_new(error_out, handle);
+        return SEE_ERROR_INDEX;
+    }
+    return SEE_SUCCESS;
+}
+
+/*
+ * Assemble an entry for a new element in the scratch space.
+ */
+static char*
+build_entry(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    const void*         key,
+    const void*         element
+    )
+{
+    char* entry = queue->scratch;
+
+    memcpy(entry, &handle, HANDLE_SIZE);
+    if (queue->key_size && key)
+        memcpy(ENTRY_KEY(entry), key, queue->key_size);
+    if (queue->element_size)
+        memcpy(ENTRY_ELEMENT(queue, entry), element, queue->element_size);
+
+    return entry;
+}
+
+/*
+ * Remove the entry at index i from the heap, hand out its element.
+ */
+static void
+take_out(SeePriorityQueue* queue, size_t i, void* element_out)
+{
+    char* entry = ENTRY(queue, i);
+    SeeError* error = NULL;
+
+    if (element_out)
+        memcpy(element_out, ENTRY_ELEMENT(queue, entry), queue->element_size);
+    else if (queue->objects)
+        see_object_decref(*(SeeObject**) ENTRY_ELEMENT(queue, entry));
+
+    release_handle(queue, entry_handle(entry));
+
+    size_t last = queue->heap->size - 1;
+    if (i != last)
+        place(queue, i, ENTRY(queue, last));
+
+    // Shrinking an array that isn't memory mapped cannot fail.
+    see_dynamic_array_resize(queue->heap, last, NULL, &error);
+
+    if (i < last)
+        restore(queue, i);
+}
+
+static void
+start_operation(SeePriorityQueue* queue, SeeError** error_out)
+{
+    queue->cmp_ret = SEE_SUCCESS;
+    queue->cmp_error = error_out;
+}
+
+/* **** functions that implement SeePriorityQueue or override SeeObject **** */
+
+static int
+priority_queue_init(
+    SeePriorityQueue*               queue,
+    const SeePriorityQueueClass*    queue_cls,
+    size_t                          element_size,
+    size_t                          key_size,
+    size_t                          arity,
+    see_compare_func                cmp,
+    void*                           cmp_data,
+    SeeError**                      error_out
+    )
+{
+    int ret;
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(queue);
+
+    parent_cls->object_init(
+            SEE_OBJECT(queue),
+            SEE_OBJECT_CLASS(queue_cls)
+            );
+
+    const size_t align = sizeof(size_t);
+    size_t padded = (element_size + align - 1) / align * align;
+    size_t entry_size = HANDLE_SIZE + key_size + padded;
+
+    queue->element_size = element_size;
+    queue->key_size     = key_size;
+    queue->arity        = arity;
+    queue->cmp          = cmp;
+    queue->cmp_data     = cmp_data;
+
+    ret = see_dynamic_array_new(
+        &queue->heap, entry_size, NULL, NULL, NULL, error_out
+        );
+    if (ret)
+        return ret;
+
+    ret = see_dynamic_array_new(
+        &queue->positions, sizeof(size_t), NULL, NULL, NULL, error_out
+        );
+    if (ret)
+        return ret;
+
+    ret = see_dynamic_array_new(
+        &queue->free_handles, sizeof(size_t), NULL, NULL, NULL, error_out
+        );
+    if (ret)
+        return ret;
+
+    queue->scratch = calloc(2, entry_size);
+    if (!queue->scratch) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+priority_queue_push(
+    SeePriorityQueue*   queue,
+    const void*         key,
+    const void*         element,
+    size_t*             handle_out,
+    SeeError**          error_out
+    )
+{
+    size_t handle;
+    start_operation(queue, error_out);
+
+    int ret = take_handle(queue, &handle, error_out);
+    if (ret)
+        return ret;
+
+    char* entry = build_entry(queue, handle, key, element);
+    ret = see_dynamic_array_add(queue->heap, entry, error_out);
+    if (ret) {
+        release_handle(queue, handle);
+        return ret;
+    }
+
+    if (queue->objects)
+        see_object_ref(*(SeeObject* const*) element);
+
+    sift_up(queue, queue->heap->size - 1);
+
+    if (handle_out)
+        *handle_out = handle;
+    return queue->cmp_ret;
+}
+
+static int
+priority_queue_pop(
+    SeePriorityQueue*   queue,
+    void*               element_out,
+    SeeError**          error_out
+    )
+{
+    if (queue->heap->size == 0) {
+        see_index_error_new(error_out, 0);
+        return SEE_ERROR_INDEX;
+    }
+
+    start_operation(queue, error_out);
+    take_out(queue, 0, element_out);
+    return queue->cmp_ret;
+}
+
+static int
+priority_queue_update(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    const void*         key,
+    const void*         element,
+    SeeError**          error_out
+    )
+{
+    int ret = check_handle(queue, handle, error_out);
+    if (ret)
+        return ret;
+
+    start_operation(queue, error_out);
+
+    size_t i = POSITIONS(queue)[handle];
+    char* entry = ENTRY(queue, i);
+
+    if (key)
+        memcpy(ENTRY_KEY(entry), key, queue->key_size);
+
+    if (element) {
+        SeeObject** obj = (SeeObject**) ENTRY_ELEMENT(queue, entry);
+        if (queue->objects) {
+            // Incref first, the new object may be the old one.
+            see_object_ref(*(SeeObject* const*) element);
+            see_object_decref(*obj);
+        }
+        memcpy(obj, element, queue->element_size);
+    }
+
+    restore(queue, i);
+    return queue->cmp_ret;
+}
+
+static int
+priority_queue_remove(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    void*               element_out,
+    SeeError**          error_out
+    )
+{
+    int ret = check_handle(queue, handle, error_out);
+    if (ret)
+        return ret;
+
+    start_operation(queue, error_out);
+    take_out(queue, POSITIONS(queue)[handle], element_out);
+    return queue->cmp_ret;
+}
+
+static void
+release_objects(SeePriorityQueue* queue)
+{
+    if (!queue->objects || !queue->heap)
+        return;
+
+    for (size_t i = 0; i < queue->heap->size; i++)
+        see_object_decref(
+            *(SeeObject**) ENTRY_ELEMENT(queue, ENTRY(queue, i))
+            );
+}
+
+static void
+priority_queue_destroy(SeeObject* obj)
+{
+    SeePriorityQueue* queue = SEE_PRIORITY_QUEUE(obj);
+
+    release_objects(queue);
+    see_object_decref(SEE_OBJECT(queue->heap));
+    see_object_decref(SEE_OBJECT(queue->positions));
+    see_object_decref(SEE_OBJECT(queue->free_handles));
+    free(queue->scratch);
+
+    see_object_class()->destroy(obj);
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeePriorityQueueClass* queue_cls = SEE_PRIORITY_QUEUE_CLASS(cls);
+    SeePriorityQueue* queue = SEE_PRIORITY_QUEUE(obj);
+
+    size_t element_size     = va_arg(args, size_t);
+    size_t key_size         = va_arg(args, size_t);
+    size_t arity            = va_arg(args, size_t);
+    see_compare_func cmp    = va_arg(args, see_compare_func);
+    void* cmp_data          = va_arg(args, void*);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return queue_cls->priority_queue_init(
+        queue,
+        queue_cls,
+        element_size,
+        key_size,
+        arity,
+        cmp,
+        cmp_data,
+        error_out
+        );
+}
+
+/* **** implementation of the public API **** */
+
+static int
+priority_queue_new(
+    SeePriorityQueue**  out,
+    size_t              element_size,
+    size_t              key_size,
+    size_t              arity,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_priority_queue_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out || !cmp)
+        return SEE_INVALID_ARGUMENT;
+
+    if (arity < 2 || element_size > SIZE_MAX / 4)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(out),
+            element_size,
+            key_size,
+            arity,
+            cmp,
+            data,
+            error_out
+            );
+}
+
+int
+see_priority_queue_new(
+    SeePriorityQueue**  out,
+    size_t              element_size,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    )
+{
+    return see_priority_queue_new_arity(
+        out, element_size, SEE_PRIORITY_QUEUE_DEFAULT_ARITY, cmp, data,
+        error_out
+        );
+}
+
+int
+see_priority_queue_new_arity(
+    SeePriorityQueue**  out,
+    size_t              element_size,
+    size_t              arity,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    )
+{
+    if (element_size == 0)
+        return SEE_INVALID_ARGUMENT;
+
+    return priority_queue_new(
+        out, element_size, 0, arity, cmp, data, error_out
+        );
+}
+
+int
+see_priority_queue_new_objects(SeePriorityQueue** out, SeeError** error_out)
+{
+    int ret = priority_queue_new(
+        out,
+        sizeof(SeeObject*),
+        0,
+        SEE_PRIORITY_QUEUE_DEFAULT_ARITY,
+        compare_objects,
+        NULL,
+        error_out
+        );
+    if (ret)
+        return ret;
+
+    (*out)->objects = 1;
+    (*out)->cmp_data = *out;
+    return SEE_SUCCESS;
+}
+
+int
+see_priority_queue_new_timers(
+    SeePriorityQueue**  out,
+    size_t              payload_size,
+    SeeError**          error_out
+    )
+{
+    return priority_queue_new(
+        out,
+        payload_size,
+        sizeof(int64_t),
+        SEE_PRIORITY_QUEUE_DEFAULT_ARITY,
+        compare_deadlines,
+        NULL,
+        error_out
+        );
+}
+
+int
+see_priority_queue_push(
+    SeePriorityQueue*   queue,
+    const void*         element,
+    size_t*             handle_out,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !element || !error_out || *error_out || queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    return cls->push(queue, NULL, element, handle_out, error_out);
+}
+
+int
+see_priority_queue_push_array(
+    SeePriorityQueue*       queue,
+    const SeeDynamicArray*  array,
+    size_t*                 handles_out,
+    SeeError**              error_out
+    )
+{
+    if (!queue || !array || !error_out || *error_out || queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+    if (array->element_size != queue->element_size)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    const size_t n = array->size;
+    int ret;
+
+    // Rebuilding costs O(size + n), sifting up every element O(n log size).
+    if (n <= queue->heap->size) {
+        for (size_t i = 0; i < n; i++) {
+            size_t* handle = handles_out ? &handles_out[i] : NULL;
+            ret = cls->push(
+                queue,
+                NULL,
+                array->elements + i * array->element_size,
+                handle,
+                error_out
+                );
+            if (ret)
+                return ret;
+        }
+        return SEE_SUCCESS;
+    }
+
+    ret = see_dynamic_array_reserve(
+        queue->heap, queue->heap->size + n, error_out
+        );
+    if (ret)
+        return ret;
+
+    start_operation(queue, error_out);
+    for (size_t i = 0; i < n && ret == SEE_SUCCESS; i++) {
+        const char* element = array->elements + i * array->element_size;
+        size_t handle;
+
+        ret = take_handle(queue, &handle, error_out);
+        if (ret)
+            break;
+
+        char* entry = build_entry(queue, handle, NULL, element);
+        POSITIONS(queue)[handle] = queue->heap->size;
+        ret = see_dynamic_array_add(queue->heap, entry, error_out);
+        if (ret) {
+            release_handle(queue, handle);
+            break;
+        }
+
+        if (queue->objects)
+            see_object_ref(*(SeeObject* const*) element);
+        if (handles_out)
+            handles_out[i] = handle;
+    }
+
+    // Keep the heap valid, also for the elements that did make it.
+    heapify(queue);
+
+    if (ret)
+        return ret;
+    return queue->cmp_ret;
+}
+
+int
+see_priority_queue_top(
+    const SeePriorityQueue* queue,
+    void*                   element_out,
+    SeeError**              error_out
+    )
+{
+    if (!queue || !element_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (queue->heap->size == 0) {
+        see_index_error_new(error_out, 0);
+        return SEE_ERROR_INDEX;
+    }
+
+    memcpy(
+        element_out,
+        ENTRY_ELEMENT(queue, ENTRY(queue, 0)),
+        queue->element_size
+        );
+    return SEE_SUCCESS;
+}
+
+int
+see_priority_queue_pop(
+    SeePriorityQueue*   queue,
+    void*               element_out,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    return cls->pop(queue, element_out, error_out);
+}
+
+int
+see_priority_queue_update(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    const void*         element,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !element || !error_out || *error_out || queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    return cls->update(queue, handle, NULL, element, error_out);
+}
+
+int
+see_priority_queue_remove(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    void*               element_out,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    return cls->remove(queue, handle, element_out, error_out);
+}
+
+int
+see_priority_queue_get(
+    const SeePriorityQueue* queue,
+    size_t                  handle,
+    void*                   element_out,
+    SeeError**              error_out
+    )
+{
+    if (!queue || !element_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    int ret = check_handle(queue, handle, error_out);
+    if (ret)
+        return ret;
+
+    const char* entry = ENTRY(queue, POSITIONS(queue)[handle]);
+    memcpy(element_out, ENTRY_ELEMENT(queue, entry), queue->element_size);
+    return SEE_SUCCESS;
+}
+
+int
+see_priority_queue_contains(const SeePriorityQueue* queue, size_t handle)
+{
+    if (!queue || handle >= queue->positions->size)
+        return 0;
+
+    return POSITIONS(queue)[handle] != NO_POSITION;
+}
+
+size_t
+see_priority_queue_size(const SeePriorityQueue* queue)
+{
+    if (!queue)
+        return 0;
+
+    return queue->heap->size;
+}
+
+void
+see_priority_queue_clear(SeePriorityQueue* queue)
+{
+    SeeError* error = NULL;
+
+    if (!queue)
+        return;
+
+    release_objects(queue);
+
+    // None of these arrays are memory mapped, so shrinking cannot fail.
+    see_dynamic_array_resize(queue->heap, 0, NULL, &error);
+    see_dynamic_array_resize(queue->positions, 0, NULL, &error);
+    see_dynamic_array_resize(queue->free_handles, 0, NULL, &error);
+}
+
+/* **** timers **** */
+
+int
+see_priority_queue_push_timer(
+    SeePriorityQueue*   queue,
+    const SeeTimePoint* deadline,
+    const void*         payload,
+    size_t*             handle_out,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !deadline || !error_out || *error_out || !queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+    if (!payload && queue->element_size)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    int64_t key = see_time_point_nanos(deadline);
+    return cls->push(queue, &key, payload, handle_out, error_out);
+}
+
+int
+see_priority_queue_reschedule(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    const SeeTimePoint* deadline,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !deadline || !error_out || *error_out || !queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    int64_t key = see_time_point_nanos(deadline);
+    return cls->update(queue, handle, &key, NULL, error_out);
+}
+
+int
+see_priority_queue_next_deadline(
+    const SeePriorityQueue* queue,
+    SeeTimePoint*           deadline,
+    SeeError**              error_out
+    )
+{
+    if (!queue || !deadline || !error_out || *error_out || !queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+
+    if (queue->heap->size == 0) {
+        see_index_error_new(error_out, 0);
+        return SEE_ERROR_INDEX;
+    }
+
+    int64_t key;
+    memcpy(&key, ENTRY_KEY(ENTRY(queue, 0)), sizeof(key));
+    return see_time_point_set_nanos(deadline, key);
+}
+
+int
+see_priority_queue_pop_expired(
+    SeePriorityQueue*   queue,
+    const SeeTimePoint* now,
+    void*               payload_out,
+    int*                expired,
+    SeeError**          error_out
+    )
+{
+    if (!queue || !now || !expired || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+    if (!queue->key_size)
+        return SEE_INVALID_ARGUMENT;
+
+    *expired = 0;
+    if (queue->heap->size == 0)
+        return SEE_SUCCESS;
+
+    int64_t key;
+    memcpy(&key, ENTRY_KEY(ENTRY(queue, 0)), sizeof(key));
+    if (key > see_time_point_nanos(now))
+        return SEE_SUCCESS;
+
+    const SeePriorityQueueClass* cls = SEE_PRIORITY_QUEUE_GET_CLASS(queue);
+    int ret = cls->pop(queue, payload_out, error_out);
+    if (ret == SEE_SUCCESS)
+        *expired = 1;
+    return ret;
+}
+
+/* **** initialization of the class **** */
+
+SeePriorityQueueClass* g_SeePriorityQueueClass = NULL;
+
+static int
+priority_queue_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init    = init;
+    new_cls->destroy = priority_queue_destroy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeePriorityQueue";
+
+    /* Set the function pointers of the own class here */
+    SeePriorityQueueClass* cls = (SeePriorityQueueClass*) new_cls;
+    cls->priority_queue_init    = priority_queue_init;
+    cls->push                   = priority_queue_push;
+    cls->pop                    = priority_queue_pop;
+    cls->update                 = priority_queue_update;
+    cls->remove                 = priority_queue_remove;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeePriorityQueue(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_priority_queue_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeePriorityQueueClass,
+        sizeof(SeePriorityQueueClass),
+        sizeof(SeePriorityQueue),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        priority_queue_class_init
+        );
+
+    return ret;
+}
+
+void
+see_priority_queue_deinit()
+{
+    if(!g_SeePriorityQueueClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeePriorityQueueClass));
+    g_SeePriorityQueueClass = NULL;
+}
+
+const SeePriorityQueueClass*
+see_priority_queue_class()
+{
+    return g_SeePriorityQueueClass;
+}
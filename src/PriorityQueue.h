@@ -0,0 +1,579 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file PriorityQueue.h
+ * @brief A priority queue, the element that is ordered first is on top.
+ *
+ * A SeePriorityQueue is a d-ary heap stored in a SeeDynamicArray. Pushing
+ * and popping take O(log n) comparisons, instead of the O(n) it takes to
+ * keep an array sorted. A heap with 4 children per node, the default, needs
+ * fewer levels than a binary heap and touches fewer cache lines.
+ *
+ * There are three flavors of queues:
+ *
+ *  - see_priority_queue_new() creates a queue of plain elements that are
+ *    ordered by a see_compare_func. The elements are moved bitwise.
+ *  - see_priority_queue_new_objects() creates a queue of SeeObject*, these
+ *    are ordered by see_object_compare(). The queue holds a reference to
+ *    the objects.
+ *  - see_priority_queue_new_timers() creates a queue of timers, a payload
+ *    with a deadline as SeeTimePoint. The timer with the earliest deadline
+ *    is on top. Use the timer functions below to add timers and to pop the
+ *    ones that have expired.
+ *
+ * Every push hands out a handle to the element. The handle stays valid
+ * until the element leaves the queue, and may be used to change the
+ * priority of the element or to remove it, e.g. to reschedule or cancel a
+ * timer. Handles are reused after the element has left the queue.
+ *
+ * @code
+ * size_t handle;
+ * ret = see_priority_queue_push_timer(timers, deadline, &event, &handle, &error);
+ *
+ * int expired;
+ * ret = see_priority_queue_pop_expired(timers, now, &event, &expired, &error);
+ * @endcode
+ */
+
+#ifndef SEE_PRIORITY_QUEUE_H
+#define SEE_PRIORITY_QUEUE_H
+
+#include "SeeObject.h"
+#include "DynamicArray.h"
+#include "TimePoint.h"
+#include "Error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief The number of children of a node when none is specified.
+ */
+#define SEE_PRIORITY_QUEUE_DEFAULT_ARITY 4
+
+typedef struct SeePriorityQueue SeePriorityQueue;
+typedef struct SeePriorityQueueClass SeePriorityQueueClass;
+
+struct SeePriorityQueue {
+    SeeObject parent_obj;
+
+    /**
+     * \brief The entries in heap order. An entry is the handle, the
+     *        deadline of timers and the element.
+     * \private
+     */
+    SeeDynamicArray*    heap;
+
+    /**
+     * \brief The index in heap of each handle, or SIZE_MAX for handles
+     *        that are free.
+     * \private
+     */
+    SeeDynamicArray*    positions;
+
+    /**
+     * \brief The handles that may be reused.
+     * \private
+     */
+    SeeDynamicArray*    free_handles;
+
+    /**
+     * \brief The size of the elements or payloads in bytes.
+     * \private
+     */
+    size_t              element_size;
+
+    /**
+     * \brief The number of children of a node.
+     * \private
+     */
+    size_t              arity;
+
+    /**
+     * \brief Orders the entries.
+     * \private
+     */
+    see_compare_func    cmp;
+    void*               cmp_data;
+
+    /**
+     * \brief The entries are SeeObject* to which the queue holds a
+     *        reference.
+     * \private
+     */
+    int                 objects;
+
+    /**
+     * \brief The size of the deadline in front of the payload of a timer,
+     *        0 for other queues.
+     * \private
+     */
+    size_t              key_size;
+
+    /**
+     * \brief Room for two entries, for building a new one and for the one
+     *        that is moved through the heap.
+     * \private
+     */
+    char*               scratch;
+
+    /**
+     * \brief The first error of see_object_compare() during an operation.
+     * \private
+     */
+    int                 cmp_ret;
+    SeeError**          cmp_error;
+};
+
+struct SeePriorityQueueClass {
+    SeeObjectClass parent_cls;
+
+    int (*priority_queue_init)(
+        SeePriorityQueue*               queue,
+        const SeePriorityQueueClass*    queue_cls,
+        size_t                          element_size,
+        size_t                          key_size,
+        size_t                          arity,
+        see_compare_func                cmp,
+        void*                           cmp_data,
+        SeeError**                      error_out
+        );
+
+    /*
+     * The key is the deadline of a timer, it is NULL for other queues.
+     * update keeps the current element when element is NULL.
+     */
+
+    int (*push)(
+        SeePriorityQueue*   queue,
+        const void*         key,
+        const void*         element,
+        size_t*             handle_out,
+        SeeError**          error_out
+        );
+
+    int (*pop)(
+        SeePriorityQueue*   queue,
+        void*               element_out,
+        SeeError**          error_out
+        );
+
+    int (*update)(
+        SeePriorityQueue*   queue,
+        size_t              handle,
+        const void*         key,
+        const void*         element,
+        SeeError**          error_out
+        );
+
+    int (*remove)(
+        SeePriorityQueue*   queue,
+        size_t              handle,
+        void*               element_out,
+        SeeError**          error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeePriorityQueue derived instance back to a
+ *        pointer to SeePriorityQueue.
+ */
+#define SEE_PRIORITY_QUEUE(obj)                      \
+    ((SeePriorityQueue*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeePriorityQueue derived instance
+ *        back to a reference to SeePriorityQueue*.
+ */
+#define SEE_PRIORITY_QUEUE_REF(ref)                      \
+    ((SeePriorityQueue**) ref)
+
+/**
+ * \brief cast a pointer to SeePriorityQueueClass derived class back to a
+ *        pointer to SeePriorityQueueClass.
+ */
+#define SEE_PRIORITY_QUEUE_CLASS(cls)                      \
+    ((const SeePriorityQueueClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeePriorityQueueClass from a instance of
+ *        derived from SeePriorityQueue. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_PRIORITY_QUEUE_GET_CLASS(obj)                \
+    (SEE_PRIORITY_QUEUE_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new empty queue of elements.
+ *
+ * @param [out] out             A pointer to a SeePriorityQueue* that is NULL.
+ * @param [in]  element_size    The size of the elements in bytes.
+ * @param [in]  cmp             The element for which cmp returns the lowest
+ *                              order is on top.
+ * @param [in]  data            Is passed to cmp.
+ * @param [out] error_out       A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_priority_queue_new(
+    SeePriorityQueue**  out,
+    size_t              element_size,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Create a new empty queue of elements with a given number of
+ *        children per node.
+ *
+ * @param [in]  arity   The number of children per node, at least 2.
+ *
+ * The other parameters are those of see_priority_queue_new().
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_priority_queue_new_arity(
+    SeePriorityQueue**  out,
+    size_t              element_size,
+    size_t              arity,
+    see_compare_func    cmp,
+    void*               data,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Create a new empty queue of SeeObject*, the smallest object
+ *        according to see_object_compare() is on top.
+ *
+ * The elements of this queue are SeeObject*. A push increments the
+ * reference count of the object, a pop hands the reference of the queue
+ * to the caller. When two objects cannot be compared, the operation
+ * returns the error of see_object_compare(). The object is in the queue
+ * nonetheless, but the order of the queue is unspecified until the
+ * objects that cannot be compared are removed.
+ *
+ * @param [out] out         A pointer to a SeePriorityQueue* that is NULL.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_priority_queue_new_objects(SeePriorityQueue** out, SeeError** error_out);
+
+/**
+ * \brief Create a new empty queue of timers.
+ *
+ * The elements of a timer queue are payloads, every payload has a
+ * deadline. Timers are added with see_priority_queue_push_timer() and
+ * rescheduled with see_priority_queue_reschedule(). The other functions
+ * copy out the payload only.
+ *
+ * @param [out] out             A pointer to a SeePriorityQueue* that is NULL.
+ * @param [in]  payload_size    The size of the payload of a timer in bytes.
+ * @param [out] error_out       A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_priority_queue_new_timers(
+    SeePriorityQueue**  out,
+    size_t              payload_size,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Add a copy of element to the queue.
+ *
+ * @param [in]  queue       The queue to add to, this may not be a timer
+ *                          queue.
+ * @param [in]  element     A pointer to the element, for object queues a
+ *                          pointer to the SeeObject*.
+ * @param [out] handle_out  If not NULL, it receives the handle of the
+ *                          element.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME or the error
+ *         of see_object_compare()
+ */
+SEE_EXPORT int
+see_priority_queue_push(
+    SeePriorityQueue*   queue,
+    const void*         element,
+    size_t*             handle_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Add all elements of an array to the queue.
+ *
+ * When the array is large compared to the queue, the heap is rebuilt
+ * from scratch, which takes O(n) instead of O(n log n) comparisons.
+ *
+ * @param [in]  queue       The queue to add to, this may not be a timer
+ *                          queue.
+ * @param [in]  array       An array with elements of the size of the
+ *                          elements of the queue.
+ * @param [out] handles_out If not NULL, an array of at least
+ *                          see_dynamic_array_size(array) handles, it
+ *                          receives the handles of the elements in the
+ *                          order of the array.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME or the error
+ *         of see_object_compare()
+ */
+SEE_EXPORT int
+see_priority_queue_push_array(
+    SeePriorityQueue*       queue,
+    const SeeDynamicArray*  array,
+    size_t*                 handles_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Copy the element on top of the queue.
+ *
+ * For object queues the object isn't increffed, the queue keeps its
+ * reference.
+ *
+ * @param [in]  queue       The queue.
+ * @param [out] element_out Receives a copy of the element.
+ * @param [out] error_out   An index error when the queue is empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_priority_queue_top(
+    const SeePriorityQueue* queue,
+    void*                   element_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Remove the element on top of the queue.
+ *
+ * @param [in]  queue       The queue.
+ * @param [out] element_out If not NULL, it receives the element. For object
+ *                          queues the caller receives the reference of the
+ *                          queue, when NULL the object is decreffed.
+ * @param [out] error_out   An index error when the queue is empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX or the error
+ *         of see_object_compare()
+ */
+SEE_EXPORT int
+see_priority_queue_pop(
+    SeePriorityQueue*   queue,
+    void*               element_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Replace the element of a handle and restore the order of the heap.
+ *
+ * The new element may be ordered before (decrease-key) or after the old
+ * one. For object queues the old object is decreffed and the new one
+ * increffed.
+ *
+ * @param [in]  queue       The queue, this may not be a timer queue.
+ * @param [in]  handle      A handle that was obtained by a push.
+ * @param [in]  element     The new element.
+ * @param [out] error_out   An index error when the handle isn't in use.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX or the error
+ *         of see_object_compare()
+ */
+SEE_EXPORT int
+see_priority_queue_update(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    const void*         element,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Remove the element of a handle from the queue.
+ *
+ * @param [in]  queue       The queue.
+ * @param [in]  handle      A handle that was obtained by a push.
+ * @param [out] element_out see doc for see_priority_queue_pop()
+ * @param [out] error_out   An index error when the handle isn't in use.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_INDEX or the error
+ *         of see_object_compare()
+ */
+SEE_EXPORT int
+see_priority_queue_remove(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    void*               element_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Copy the element of a handle.
+ *
+ * @param [in]  queue       The queue.
+ * @param [in]  handle      A handle that was obtained by a push.
+ * @param [out] element_out see doc for see_priority_queue_top()
+ * @param [out] error_out   An index error when the handle isn't in use.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_priority_queue_get(
+    const SeePriorityQueue* queue,
+    size_t                  handle,
+    void*                   element_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Check whether a handle refers to an element in the queue.
+ */
+SEE_EXPORT int
+see_priority_queue_contains(const SeePriorityQueue* queue, size_t handle);
+
+/**
+ * \brief Get the number of elements in the queue.
+ */
+SEE_EXPORT size_t
+see_priority_queue_size(const SeePriorityQueue* queue);
+
+/**
+ * \brief Remove all elements, for object queues they are decreffed.
+ */
+SEE_EXPORT void
+see_priority_queue_clear(SeePriorityQueue* queue);
+
+/* **** timers **** */
+
+/**
+ * \brief Add a timer to a timer queue.
+ *
+ * @param [in]  queue       A queue from see_priority_queue_new_timers().
+ * @param [in]  deadline    The time at which the timer expires.
+ * @param [in]  payload     A pointer to the payload that is copied.
+ * @param [out] handle_out  If not NULL, it receives the handle of the timer.
+ * @param [out] error_out   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_priority_queue_push_timer(
+    SeePriorityQueue*   queue,
+    const SeeTimePoint* deadline,
+    const void*         payload,
+    size_t*             handle_out,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Move the deadline of a timer.
+ *
+ * @param [in]  queue       A queue from see_priority_queue_new_timers().
+ * @param [in]  handle      The handle of the timer.
+ * @param [in]  deadline    The new deadline.
+ * @param [out] error_out   An index error when the handle isn't in use.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_priority_queue_reschedule(
+    SeePriorityQueue*   queue,
+    size_t              handle,
+    const SeeTimePoint* deadline,
+    SeeError**          error_out
+    );
+
+/**
+ * \brief Get the deadline of the first timer to expire.
+ *
+ * @param [in]  queue       A queue from see_priority_queue_new_timers().
+ * @param [out] deadline    Is set to the deadline of the timer on top.
+ * @param [out] error_out   An index error when the queue is empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_priority_queue_next_deadline(
+    const SeePriorityQueue* queue,
+    SeeTimePoint*           deadline,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Pop the first timer when it has expired.
+ *
+ * A timer has expired when its deadline isn't later than now. Call this
+ * in a loop until expired is 0 to handle all timers that have expired.
+ *
+ * @param [in]  queue       A queue from see_priority_queue_new_timers().
+ * @param [in]  now         The current time.
+ * @param [out] payload_out If not NULL, it receives the payload of the
+ *                          timer when it has expired.
+ * @param [out] expired     Is set to 1 when a timer was popped, else 0.
+ * @param [out] error_out   Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_priority_queue_pop_expired(
+    SeePriorityQueue*   queue,
+    const SeeTimePoint* now,
+    void*               payload_out,
+    int*                expired,
+    SeeError**          error_out
+    );
+
+/**
+ * Gets the pointer to the SeePriorityQueueClass table.
+ */
+SEE_EXPORT const SeePriorityQueueClass*
+see_priority_queue_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeePriorityQueue; make it ready for use.
+ */
+SEE_EXPORT
+int see_priority_queue_init();
+
+/**
+ * Deinitialize SeePriorityQueue, after SeePriorityQueue has been
+ * deinitialized, all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_priority_queue_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_PRIORITY_QUEUE_H
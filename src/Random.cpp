@@ -16,9 +16,11 @@
  */
 
 
+#include <new>
 #include "MetaClass.h"
 #include "Random.h"
 #include "cpp/Random.hpp"
+#include "cpp/Shuffle.hpp"
 
 static SeeRandom* global_random_device = NULL;
 
@@ -211,6 +213,32 @@ see_random_normal_float(SeeRandom* random, double mean, double std)
     return r->normal_float(mean, std);
 }
 
+int
+see_random_shuffle(
+    SeeRandom*  random,
+    void*       elements,
+    size_t      n,
+    size_t      elem_size
+    )
+{
+    if ((!elements && n) || elem_size == 0)
+        return SEE_INVALID_ARGUMENT;
+
+    if (n < 2)
+        return SEE_SUCCESS;
+
+    SeeRandom *sr = random != nullptr ? random : global_random_device;
+    auto *r = static_cast<Random *>(sr->priv);
+    try {
+        see::shuffle_bytes(elements, n, elem_size, r->generator());
+    } catch (const std::bad_alloc&) {
+        // The seeds of a parallel shuffle are allocated before anything
+        // is drawn or moved, so the range and the generator are unchanged.
+        return SEE_ERROR_RUNTIME;
+    }
+    return SEE_SUCCESS;
+}
+
 /* **** initialization of the class **** */
 
 SeeRandomClass* g_SeeRandomClass = NULL;
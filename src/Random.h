@@ -277,6 +277,32 @@ see_random_float_range(SeeRandom* random, double min, double max);
 SEE_EXPORT double
 see_random_normal_float(SeeRandom* random, double mean, double std);
 
+/**
+ * \brief Shuffle n elements of elem_size bytes in place.
+ *
+ * The elements are moved around bitwise. The random numbers are drawn in
+ * batches from the generator and large ranges are shuffled in parallel. The
+ * result only depends on the state of the generator, so seeding the generator
+ * with the same seed will give the same permutation on every machine.
+ *
+ * @param [in, out] random      The generator, NULL for the global generator.
+ * @param [in, out] elements    The first element of the range to shuffle.
+ * @param [in]      n           The number of elements.
+ * @param [in]      elem_size   The size of one element in bytes.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT when elements is NULL while
+ *         n is not 0 or when elem_size is 0 or SEE_ERROR_RUNTIME when
+ *         there was no memory for a parallel shuffle, the elements and
+ *         the generator are unchanged then.
+ */
+SEE_EXPORT int
+see_random_shuffle(
+    SeeRandom*  random,
+    void*       elements,
+    size_t      n,
+    size_t      elem_size
+    );
+
 /**
  * Gets the pointer to the SeeRandomClass table.
  */
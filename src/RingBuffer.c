@@ -0,0 +1,626 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MetaClass.h"
+#include "RingBuffer.h"
+#include "IndexError.h"
+#include "RuntimeError.h"
+#include "Span.h"
+
+/*
+ * head and tail count the elements that have been popped and pushed. They
+ * are only reduced to a position in the storage with the mask, so when they
+ * wrap around, tail - head still is the number of stored elements.
+ */
+#define RING_MASK(ring) ((ring)->capacity - 1)
+#define RING_ELEM(ring, count) \
+    ((ring)->elements + ((count) & RING_MASK(ring)) * (ring)->element_size)
+
+/* **** private helpers **** */
+
+static size_t
+ring_size(const SeeRingBuffer* ring)
+{
+    return ring->tail - ring->head;
+}
+
+static size_t
+round_up_pow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n && p <= SIZE_MAX / 2)
+        p <<= 1;
+    return p;
+}
+
+/*
+ * Split n elements starting at count in the part up to the end of the
+ * storage and the part that wraps around to its start.
+ */
+static void
+ring_segments(
+    const SeeRingBuffer*    ring,
+    size_t                  count,
+    size_t                  n,
+    SeeRingSpan*            span
+    )
+{
+    size_t pos = count & RING_MASK(ring);
+    size_t until_end = ring->capacity - pos;
+
+    span->first         = ring->elements + pos * ring->element_size;
+    span->first_size    = n < until_end ? n : until_end;
+    span->second        = ring->elements;
+    span->second_size   = n - span->first_size;
+}
+
+static void
+copy_in(SeeRingBuffer* ring, const char* src, size_t n)
+{
+    SeeRingSpan span;
+    if (n == 0)
+        return;
+
+    ring_segments(ring, ring->tail, n, &span);
+    memcpy(span.first, src, span.first_size * ring->element_size);
+    memcpy(
+        span.second,
+        src + span.first_size * ring->element_size,
+        span.second_size * ring->element_size
+        );
+}
+
+static void
+copy_out(const SeeRingBuffer* ring, size_t count, char* dest, size_t n)
+{
+    SeeRingSpan span;
+    if (n == 0)
+        return;
+
+    ring_segments(ring, count, n, &span);
+    memcpy(dest, span.first, span.first_size * ring->element_size);
+    memcpy(
+        dest + span.first_size * ring->element_size,
+        span.second,
+        span.second_size * ring->element_size
+        );
+}
+
+/* **** functions that implement SeeRingBuffer or override SeeObject **** */
+
+static int
+ring_buffer_reserve(SeeRingBuffer* ring, size_t capacity, SeeError** error_out)
+{
+    if (capacity <= ring->capacity)
+        return SEE_SUCCESS;
+
+    size_t new_capacity = round_up_pow2(capacity);
+    if (new_capacity < capacity ||
+        new_capacity > SIZE_MAX / ring->element_size) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    char* elements = malloc(new_capacity * ring->element_size);
+    if (!elements) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    // Store the elements from the start of the new storage.
+    size_t size = ring_size(ring);
+    copy_out(ring, ring->head, elements, size);
+
+    free(ring->elements);
+    ring->elements  = elements;
+    ring->capacity  = new_capacity;
+    ring->head      = 0;
+    ring->tail      = size;
+    return SEE_SUCCESS;
+}
+
+static int
+ring_buffer_init(
+    SeeRingBuffer*              ring,
+    const SeeRingBufferClass*   ring_cls,
+    size_t                      element_size,
+    size_t                      capacity,
+    int                         growable,
+    SeeError**                  error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(
+        ring
+        );
+
+    parent_cls->object_init(
+            SEE_OBJECT(ring),
+            SEE_OBJECT_CLASS(ring_cls)
+            );
+
+    ring->element_size  = element_size;
+    ring->growable      = growable != 0;
+    ring->capacity      = 1;
+
+    ring->elements = malloc(element_size);
+    if (!ring->elements) {
+        see_runtime_error_new(error_out, errno);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return ring_buffer_reserve(ring, capacity, error_out);
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeRingBufferClass* ring_cls = SEE_RING_BUFFER_CLASS(cls);
+    SeeRingBuffer* ring = SEE_RING_BUFFER(obj);
+
+    /*Extract parameters here from va_list args here.*/
+    size_t element_size     = va_arg(args, size_t);
+    size_t capacity         = va_arg(args, size_t);
+    int growable            = va_arg(args, int);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return ring_cls->ring_buffer_init(
+        ring,
+        ring_cls,
+        element_size,
+        capacity,
+        growable,
+        error_out
+        );
+}
+
+static void
+ring_buffer_destroy(SeeObject* obj)
+{
+    SeeRingBuffer* ring = SEE_RING_BUFFER(obj);
+
+    free(ring->elements);
+    see_object_class()->destroy(obj);
+}
+
+static int
+ring_buffer_copy(const SeeObject* self, SeeObject** out, SeeError** error_out)
+{
+    const SeeRingBuffer* ring = SEE_RING_BUFFER(self);
+    SeeRingBuffer* copy = NULL;
+    size_t size = ring_size(ring);
+
+    int ret = see_ring_buffer_new(
+        &copy,
+        ring->element_size,
+        ring->capacity,
+        ring->growable,
+        error_out
+        );
+    if (ret)
+        return ret;
+
+    copy_out(ring, ring->head, copy->elements, size);
+    copy->tail = size;
+
+    *out = SEE_OBJECT(copy);
+    return SEE_SUCCESS;
+}
+
+static int
+ring_buffer_push_n(
+    SeeRingBuffer*  ring,
+    const void*     elements,
+    size_t          n,
+    size_t*         pushed_out,
+    SeeError**      error_out
+    )
+{
+    size_t size = ring_size(ring);
+
+    if (n > ring->capacity - size) {
+        if (ring->growable) {
+            if (n > SIZE_MAX - size) {
+                see_runtime_error_new(error_out, ENOMEM);
+                return SEE_ERROR_RUNTIME;
+            }
+            int ret = ring_buffer_reserve(ring, size + n, error_out);
+            if (ret)
+                return ret;
+        }
+        else
+            n = ring->capacity - size;
+    }
+
+    copy_in(ring, elements, n);
+    ring->tail += n;
+
+    if (pushed_out)
+        *pushed_out = n;
+    return SEE_SUCCESS;
+}
+
+static int
+ring_buffer_pop_n(
+    SeeRingBuffer*  ring,
+    void*           elements_out,
+    size_t          n,
+    size_t*         popped_out,
+    SeeError**      error_out
+    )
+{
+    (void) error_out;
+    size_t size = ring_size(ring);
+    if (n > size)
+        n = size;
+
+    if (elements_out)
+        copy_out(ring, ring->head, elements_out, n);
+    ring->head += n;
+
+    if (popped_out)
+        *popped_out = n;
+    return SEE_SUCCESS;
+}
+
+static int
+ring_buffer_peek(
+    const SeeRingBuffer*    ring,
+    size_t                  offset,
+    void*                   element_out,
+    SeeError**              error_out
+    )
+{
+    if (offset >= ring_size(ring)) {
+        see_index_error_new(error_out, offset);
+        return SEE_ERROR_INDEX;
+    }
+
+    memcpy(
+        element_out,
+        RING_ELEM(ring, ring->head + offset),
+        ring->element_size
+        );
+    return SEE_SUCCESS;
+}
+
+static int
+ring_buffer_next_span(
+    const SeeObject*    self,
+    size_t*             cursor,
+    SeeSpan*            span_out,
+    SeeError**          error_out
+    )
+{
+    (void) error_out;
+    const SeeRingBuffer* ring = SEE_RING_BUFFER(self);
+    size_t size = ring_size(ring);
+    size_t start = *cursor < size ? *cursor : size;
+    size_t pos = (ring->head + start) & RING_MASK(ring);
+
+    // The elements wrap around the end of the storage at most once.
+    size_t n = size - start;
+    if (n > ring->capacity - pos)
+        n = ring->capacity - pos;
+
+    span_out->data      = ring->elements + pos * ring->element_size;
+    span_out->size      = n;
+    span_out->stride    = ring->element_size;
+    *cursor             = start + n;
+
+    return SEE_SUCCESS;
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_ring_buffer_new(
+    SeeRingBuffer** out,
+    size_t          element_size,
+    size_t          capacity,
+    int             growable,
+    SeeError**      error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_ring_buffer_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!out || !error_out || *out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (element_size == 0 || capacity == 0)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(out),
+            element_size,
+            capacity,
+            growable,
+            error_out
+            );
+}
+
+int
+see_ring_buffer_push(
+    SeeRingBuffer*  ring,
+    const void*     element,
+    SeeError**      error_out
+    )
+{
+    size_t pushed = 0;
+    int ret;
+
+    if (!ring || !element || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+    ret = cls->push_n(ring, element, 1, &pushed, error_out);
+    if (ret)
+        return ret;
+
+    if (pushed != 1) {
+        see_runtime_error_new(error_out, ENOBUFS);
+        return SEE_ERROR_RUNTIME;
+    }
+    return SEE_SUCCESS;
+}
+
+int
+see_ring_buffer_push_n(
+    SeeRingBuffer*  ring,
+    const void*     elements,
+    size_t          n,
+    size_t*         pushed_out,
+    SeeError**      error_out
+    )
+{
+    if (!ring || (!elements && n) || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+    return cls->push_n(ring, elements, n, pushed_out, error_out);
+}
+
+int
+see_ring_buffer_pop(
+    SeeRingBuffer*  ring,
+    void*           element_out,
+    SeeError**      error_out
+    )
+{
+    if (!ring || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (ring_size(ring) == 0) {
+        see_index_error_new(error_out, 0);
+        return SEE_ERROR_INDEX;
+    }
+
+    const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+    return cls->pop_n(ring, element_out, 1, NULL, error_out);
+}
+
+int
+see_ring_buffer_pop_n(
+    SeeRingBuffer*  ring,
+    void*           elements_out,
+    size_t          n,
+    size_t*         popped_out,
+    SeeError**      error_out
+    )
+{
+    if (!ring || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+    return cls->pop_n(ring, elements_out, n, popped_out, error_out);
+}
+
+int
+see_ring_buffer_peek(
+    const SeeRingBuffer*    ring,
+    size_t                  offset,
+    void*                   element_out,
+    SeeError**              error_out
+    )
+{
+    if (!ring || !element_out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+    return cls->peek(ring, offset, element_out, error_out);
+}
+
+int
+see_ring_buffer_read_span(const SeeRingBuffer* ring, SeeRingSpan* span)
+{
+    if (!ring || !span)
+        return SEE_INVALID_ARGUMENT;
+
+    ring_segments(ring, ring->head, ring_size(ring), span);
+    return SEE_SUCCESS;
+}
+
+int
+see_ring_buffer_consume(SeeRingBuffer* ring, size_t n, SeeError** error_out)
+{
+    if (!ring || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (n > ring_size(ring)) {
+        see_index_error_new(error_out, n);
+        return SEE_ERROR_INDEX;
+    }
+
+    ring->head += n;
+    return SEE_SUCCESS;
+}
+
+int
+see_ring_buffer_write_span(
+    SeeRingBuffer*  ring,
+    size_t          min_free,
+    SeeRingSpan*    span,
+    SeeError**      error_out
+    )
+{
+    if (!ring || !span || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    size_t size = ring_size(ring);
+    if (ring->growable && min_free > ring->capacity - size) {
+        if (min_free > SIZE_MAX - size) {
+            see_runtime_error_new(error_out, ENOMEM);
+            return SEE_ERROR_RUNTIME;
+        }
+
+        const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+        int ret = cls->reserve(ring, size + min_free, error_out);
+        if (ret)
+            return ret;
+    }
+
+    ring_segments(ring, ring->tail, ring->capacity - size, span);
+    return SEE_SUCCESS;
+}
+
+int
+see_ring_buffer_commit(SeeRingBuffer* ring, size_t n, SeeError** error_out)
+{
+    if (!ring || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (n > ring->capacity - ring_size(ring)) {
+        see_index_error_new(error_out, n);
+        return SEE_ERROR_INDEX;
+    }
+
+    ring->tail += n;
+    return SEE_SUCCESS;
+}
+
+int
+see_ring_buffer_reserve(
+    SeeRingBuffer*  ring,
+    size_t          capacity,
+    SeeError**      error_out
+    )
+{
+    if (!ring || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeRingBufferClass* cls = SEE_RING_BUFFER_GET_CLASS(ring);
+    return cls->reserve(ring, capacity, error_out);
+}
+
+void
+see_ring_buffer_clear(SeeRingBuffer* ring)
+{
+    if (ring)
+        ring->head = ring->tail = 0;
+}
+
+size_t
+see_ring_buffer_size(const SeeRingBuffer* ring)
+{
+    return ring ? ring_size(ring) : 0;
+}
+
+size_t
+see_ring_buffer_capacity(const SeeRingBuffer* ring)
+{
+    return ring ? ring->capacity : 0;
+}
+
+/* **** initialization of the class **** */
+
+SeeRingBufferClass* g_SeeRingBufferClass = NULL;
+
+static int ring_buffer_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init       = init;
+    new_cls->destroy    = ring_buffer_destroy;
+    new_cls->copy       = ring_buffer_copy;
+    new_cls->next_span  = ring_buffer_next_span;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeRingBuffer";
+
+    /* Set the function pointers of the own class here */
+    SeeRingBufferClass* cls = (SeeRingBufferClass*) new_cls;
+
+    cls->ring_buffer_init   = ring_buffer_init;
+    cls->push_n             = ring_buffer_push_n;
+    cls->pop_n              = ring_buffer_pop_n;
+    cls->peek               = ring_buffer_peek;
+    cls->reserve            = ring_buffer_reserve;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeRingBuffer(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_ring_buffer_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeRingBufferClass,
+        sizeof(SeeRingBufferClass),
+        sizeof(SeeRingBuffer),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        ring_buffer_class_init
+        );
+
+    return ret;
+}
+
+void
+see_ring_buffer_deinit()
+{
+    if(!g_SeeRingBufferClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeRingBufferClass));
+    g_SeeRingBufferClass = NULL;
+}
+
+const SeeRingBufferClass*
+see_ring_buffer_class()
+{
+    return g_SeeRingBufferClass;
+}
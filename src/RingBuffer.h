@@ -0,0 +1,404 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file RingBuffer.h
+ * \brief A first in first out queue in a circular buffer.
+ *
+ * Elements are pushed at the back and popped from the front in constant
+ * time. The capacity is always a power of two. A fixed ring buffer refuses
+ * elements when it is full, a growable one doubles its capacity.
+ *
+ * The elements are copied bitwise, the buffer is intended for plain data
+ * such as the bytes that are read from a SeeSerial device.
+ *
+ * Besides copying elements in and out, the stored elements and the free
+ * space can be accessed directly as a SeeRingSpan of at most two
+ * contiguous segments:
+ *
+ * @code
+ * SeeRingSpan span;
+ * ret = see_ring_buffer_write_span(ring, 256, &span, &error);
+ * // read at most span.first_size bytes into span.first, and when all of
+ * // them are read, at most span.second_size bytes into span.second.
+ * ret = see_ring_buffer_commit(ring, nread, &error);
+ *
+ * see_ring_buffer_read_span(ring, &span);
+ * // parse the bytes in span.first and span.second.
+ * ret = see_ring_buffer_consume(ring, nparsed, &error);
+ * @endcode
+ */
+
+#ifndef SEE_RING_BUFFER_H
+#define SEE_RING_BUFFER_H
+
+#include "SeeObject.h"
+#include "Error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SeeRingBuffer SeeRingBuffer;
+typedef struct SeeRingBufferClass SeeRingBufferClass;
+
+/**
+ * \brief Two contiguous segments of elements in a SeeRingBuffer.
+ *
+ * The elements of the first segment come before those of the second.
+ * When everything fits in one segment, second_size is 0.
+ */
+typedef struct SeeRingSpan {
+    /** \brief The first element of the first segment. */
+    void*   first;
+    /** \brief The number of elements in the first segment. */
+    size_t  first_size;
+    /** \brief The first element of the second segment. */
+    void*   second;
+    /** \brief The number of elements in the second segment. */
+    size_t  second_size;
+} SeeRingSpan;
+
+struct SeeRingBuffer {
+    SeeObject parent_obj;
+
+    /*expand SeeRingBuffer data here*/
+
+    /** \brief The storage, capacity * element_size bytes. \private */
+    char*   elements;
+    /** \brief The size of one element in bytes. \private */
+    size_t  element_size;
+    /** \brief The number of elements that fit, a power of two. \private */
+    size_t  capacity;
+    /** \brief The number of elements popped since the start. \private */
+    size_t  head;
+    /** \brief The number of elements pushed since the start. \private */
+    size_t  tail;
+    /** \brief Whether the capacity grows when the buffer is full. \private */
+    int     growable;
+};
+
+struct SeeRingBufferClass {
+    SeeObjectClass parent_cls;
+
+    int (*ring_buffer_init)(
+        SeeRingBuffer*              ring,
+        const SeeRingBufferClass*   ring_cls,
+        size_t                      element_size,
+        size_t                      capacity,
+        int                         growable,
+        SeeError**                  error_out
+        );
+
+    /* expand SeeRingBuffer class with extra functions here.*/
+
+    int (*push_n)(
+        SeeRingBuffer*  ring,
+        const void*     elements,
+        size_t          n,
+        size_t*         pushed_out,
+        SeeError**      error_out
+        );
+
+    int (*pop_n)(
+        SeeRingBuffer*  ring,
+        void*           elements_out,
+        size_t          n,
+        size_t*         popped_out,
+        SeeError**      error_out
+        );
+
+    int (*peek)(
+        const SeeRingBuffer*    ring,
+        size_t                  offset,
+        void*                   element_out,
+        SeeError**              error_out
+        );
+
+    int (*reserve)(SeeRingBuffer* ring, size_t capacity, SeeError** error_out);
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeRingBuffer derived instance back to a
+ *        pointer to SeeRingBuffer.
+ */
+#define SEE_RING_BUFFER(obj)                      \
+    ((SeeRingBuffer*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeRingBuffer derived instance back
+ *        to a reference to SeeRingBuffer*.
+ */
+#define SEE_RING_BUFFER_REF(ref)                      \
+    ((SeeRingBuffer**) ref)
+
+/**
+ * \brief cast a pointer to SeeRingBufferClass derived class back to a
+ *        pointer to SeeRingBufferClass.
+ */
+#define SEE_RING_BUFFER_CLASS(cls)                      \
+    ((const SeeRingBufferClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeRingBufferClass from a instance of
+ *        derived from SeeRingBuffer. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_RING_BUFFER_GET_CLASS(obj)                \
+    (SEE_RING_BUFFER_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new empty ring buffer.
+ *
+ * @param [out] out             A pointer to a SeeRingBuffer* that is NULL.
+ * @param [in]  element_size    The size of one element in bytes.
+ * @param [in]  capacity        The number of elements that fit, it is
+ *                              rounded up to a power of two.
+ * @param [in]  growable        When nonzero, the capacity doubles when an
+ *                              element is pushed on a full buffer.
+ * @param [out] error_out       A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_ring_buffer_new(
+    SeeRingBuffer** out,
+    size_t          element_size,
+    size_t          capacity,
+    int             growable,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Push one element at the back of the buffer.
+ *
+ * @param [in, out] ring        The buffer.
+ * @param [in]      element     The element to copy into the buffer.
+ * @param [out]     error_out   A runtime error with ENOBUFS when a fixed
+ *                              buffer is full, or ENOMEM when a growable
+ *                              buffer cannot grow.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_ring_buffer_push(
+    SeeRingBuffer*  ring,
+    const void*     element,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Push up to n elements at the back of the buffer.
+ *
+ * A growable buffer takes all elements, a fixed buffer takes as many as
+ * there is room for.
+ *
+ * @param [in, out] ring        The buffer.
+ * @param [in]      elements    An array of n elements.
+ * @param [in]      n           The number of elements to push.
+ * @param [out]     pushed_out  The number of elements that were pushed,
+ *                              may be NULL.
+ * @param [out]     error_out   A runtime error when a growable buffer
+ *                              cannot grow.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_ring_buffer_push_n(
+    SeeRingBuffer*  ring,
+    const void*     elements,
+    size_t          n,
+    size_t*         pushed_out,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Pop the element at the front of the buffer.
+ *
+ * @param [in, out] ring        The buffer.
+ * @param [out]     element_out Receives the element, may be NULL to drop it.
+ * @param [out]     error_out   An index error when the buffer is empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_ring_buffer_pop(
+    SeeRingBuffer*  ring,
+    void*           element_out,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Pop up to n elements from the front of the buffer.
+ *
+ * @param [in, out] ring            The buffer.
+ * @param [out]     elements_out    Room for n elements, may be NULL to drop
+ *                                  them.
+ * @param [in]      n               The maximum number of elements to pop.
+ * @param [out]     popped_out      The number of elements that were popped,
+ *                                  may be NULL.
+ * @param [out]     error_out       Must be a pointer to NULL.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_ring_buffer_pop_n(
+    SeeRingBuffer*  ring,
+    void*           elements_out,
+    size_t          n,
+    size_t*         popped_out,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Copy an element without removing it.
+ *
+ * @param [in]  ring        The buffer.
+ * @param [in]  offset      The position of the element, 0 is the front.
+ * @param [out] element_out Receives the element.
+ * @param [out] error_out   An index error when offset isn't smaller than
+ *                          the size of the buffer.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX
+ */
+SEE_EXPORT int
+see_ring_buffer_peek(
+    const SeeRingBuffer*    ring,
+    size_t                  offset,
+    void*                   element_out,
+    SeeError**              error_out
+    );
+
+/**
+ * \brief Get the stored elements as at most two segments.
+ *
+ * The span remains valid until the buffer is modified.
+ *
+ * @param [in]  ring    The buffer.
+ * @param [out] span    Receives the segments, front first.
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_ring_buffer_read_span(const SeeRingBuffer* ring, SeeRingSpan* span);
+
+/**
+ * \brief Remove n elements from the front after they have been used via
+ *        see_ring_buffer_read_span().
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX when there
+ *         are fewer than n elements.
+ */
+SEE_EXPORT int
+see_ring_buffer_consume(SeeRingBuffer* ring, size_t n, SeeError** error_out);
+
+/**
+ * \brief Get the free space as at most two segments.
+ *
+ * A growable buffer first grows until there is room for at least min_free
+ * elements, the span of a fixed buffer may be smaller than min_free.
+ * The span remains valid until the buffer is modified.
+ *
+ * @param [in, out] ring        The buffer.
+ * @param [in]      min_free    The number of elements one wants to write.
+ * @param [out]     span        Receives the free segments.
+ * @param [out]     error_out   A runtime error when the buffer cannot grow.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_ring_buffer_write_span(
+    SeeRingBuffer*  ring,
+    size_t          min_free,
+    SeeRingSpan*    span,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Append n elements that have been written via
+ *        see_ring_buffer_write_span().
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX when there
+ *         is no room for n elements.
+ */
+SEE_EXPORT int
+see_ring_buffer_commit(SeeRingBuffer* ring, size_t n, SeeError** error_out);
+
+/**
+ * \brief Make sure the buffer can hold capacity elements.
+ *
+ * This also works for buffers that aren't growable.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_ring_buffer_reserve(
+    SeeRingBuffer*  ring,
+    size_t          capacity,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Remove all elements.
+ */
+SEE_EXPORT void
+see_ring_buffer_clear(SeeRingBuffer* ring);
+
+/**
+ * \brief The number of elements in the buffer.
+ */
+SEE_EXPORT size_t
+see_ring_buffer_size(const SeeRingBuffer* ring);
+
+/**
+ * \brief The number of elements that fit in the buffer.
+ */
+SEE_EXPORT size_t
+see_ring_buffer_capacity(const SeeRingBuffer* ring);
+
+/**
+ * Gets the pointer to the SeeRingBufferClass table.
+ */
+SEE_EXPORT const SeeRingBufferClass*
+see_ring_buffer_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeRingBuffer; make it ready for use.
+ */
+SEE_EXPORT
+int see_ring_buffer_init();
+
+/**
+ * Deinitialize SeeRingBuffer, after SeeRingBuffer has been deinitialized,
+ * all functions in this header shouldn't be used anymore.
+ */
+SEE_EXPORT
+void see_ring_buffer_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_RING_BUFFER_H
@@ -34,6 +34,7 @@
 #include "errors.h"
 #include "IncomparableError.h"
 #include "CopyError.h"
+#include "Span.h"
 
 /* **** implementation of SeeObjects **** */
 
@@ -78,7 +79,6 @@ object_init(const SeeObjectClass* cls, SeeObject* object, va_list list)
 static int
 object_new(const SeeObjectClass* cls, size_t cls_sz, SeeObject** out, ...)
 {
-    (void) cls_sz; // Not used for regular object instances(its for the metaclass).
     SeeObject* new_instance = NULL;
     int ret;
 
@@ -86,7 +86,8 @@ object_new(const SeeObjectClass* cls, size_t cls_sz, SeeObject** out, ...)
     assert(out);
     assert(*out == NULL);
 
-    new_instance = calloc(1, cls->inst_size);
+    // Instances may ask for extra room behind their members.
+    new_instance = calloc(1, cls_sz > cls->inst_size ? cls_sz : cls->inst_size);
 
     if (!new_instance)
         return SEE_ERROR_RUNTIME;
@@ -336,7 +337,8 @@ static const SeeObjectClass g_class = {
     .not_equal  = object_not_equal,
     .greater_equal = object_greater_equal,
     .greater    = object_greater,
-    .copy       = NULL
+    .copy       = NULL,
+    .next_span  = NULL
 };
 
 static const SeeObjectClass* see_object_class_instance = &g_class;
@@ -562,6 +564,30 @@ see_object_copy(
     return SEE_ERROR_NOT_COPYABLE;
 }
 
+int
+see_object_next_span(
+    const SeeObject*    obj,
+    size_t*             cursor,
+    SeeSpan*            span_out,
+    SeeError**          error_out
+    )
+{
+    if (!obj || !cursor || !span_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeObjectClass* cls = SEE_OBJECT_GET_CLASS(obj);
+
+    if (cls->next_span)
+        return cls->next_span(obj, cursor, span_out, error_out);
+
+    see_error_new_msg(error_out, "The object is not a sequence");
+
+    return SEE_NOT_IMPLEMENTED;
+}
+
 int
 see_object_is_instance_of(
     const SeeObject*        obj,
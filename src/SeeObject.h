@@ -138,6 +138,7 @@ typedef struct SeeObjectClass SeeObjectClass;
 
 /* forward declaration */
 struct SeeError;
+struct SeeSpan;
 
 
 
@@ -218,6 +219,9 @@ struct SeeObjectClass {
      *                 The meta class uses this parameter to instantiate
      *                 new classes, which instance size is not determined
      *                 by the metaclass, but sizeof(my_new_class).
+     *                 Other classes may use a size larger than the size of
+     *                 their instances to store data directly after the
+     *                 instance, see see_dynamic_array_new_inline().
      * @param[out] obj The new initialized object will be stored in out.
      *                 obj should not be NULL, but *obj should.
      * @param ...      instance specific arguments that are use to initialize
@@ -461,6 +465,31 @@ struct SeeObjectClass {
         SeeObject**         out,
         struct SeeError**   error_out
         );
+
+    /**
+     * \brief Obtain the next contiguous run of elements of a sequence.
+     *
+     * Classes that hold a sequence of elements implement this function,
+     * SeeObject itself doesn't. The cursor is the index of the first element
+     * that hasn't been handed out yet, it starts at 0. The function returns
+     * a span of the elements from the cursor on that are stored contiguously
+     * and advances the cursor past them. When the cursor is at the end, an
+     * empty span is returned.
+     *
+     * @param [in]      self        The sequence.
+     * @param [in, out] cursor      The position in the sequence.
+     * @param [out]     span_out    The next elements.
+     * @param [out]     error_out   May not be NULL, whereas *error_out should
+     *                              be NULL.
+     *
+     * @return SEE_SUCCESS when everything went alright.
+     */
+    int (*next_span) (
+        const SeeObject*    self,
+        size_t*             cursor,
+        struct SeeSpan*     span_out,
+        struct SeeError**   error_out
+        );
 };
 
 /**
@@ -760,6 +789,30 @@ see_object_copy (
     struct SeeError**   error_out
     );
 
+/**
+ * \brief Obtain the next contiguous elements of a sequence container.
+ *
+ * Walk the elements of a container without copying them, see Span.h.
+ * In order to be walked, the class shall implement the
+ * SeeObjectClass->next_span method.
+ *
+ * @param [in]      obj         The container.
+ * @param [in, out] cursor      Should be 0 for the first call, it's advanced
+ *                              past the returned elements.
+ * @param [out]     span_out    The elements, its size is 0 at the end.
+ * @param [out]     error_out   If an error occurs it will be returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_NOT_IMPLEMENTED when obj
+ *         isn't a sequence.
+ */
+SEE_EXPORT int
+see_object_next_span(
+    const SeeObject*    obj,
+    size_t*             cursor,
+    struct SeeSpan*     span_out,
+    struct SeeError**   error_out
+    );
+
 /**
  * \brief Examine whether this instance is of a given class.
  *
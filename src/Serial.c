@@ -24,16 +24,17 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include "see_object_config.h"
 #include "MetaClass.h"
 #include "Serial.h"
+#include "RuntimeError.h"
 #include "utilities.h"
 
 #if defined(HAVE_TERMIOS_H)
 #include "posix/PosixSerial.h"
-#include "RuntimeError.h"
 
 #elif defined(_WIN32)
 #include "windows/WindowsSerial.h"
@@ -108,6 +109,12 @@ serial_destroy(SeeObject* obj)
     see_object_class()->destroy(obj);
 }
 
+/*
+ * Messages up to this size are serialized on the stack, larger ones
+ * need a buffer from the heap.
+ */
+#define SERIAL_MSG_STACK_BUFSIZE 512
+
 static int
 serial_write_msg(
     const SeeSerial* self,
@@ -116,12 +123,30 @@ serial_write_msg(
     )
 {
     const SeeSerialClass* cls = SEE_SERIAL_GET_CLASS(self);
-    void* buffer_data = NULL;
+    char  stack_buf[SERIAL_MSG_STACK_BUFSIZE];
+    char* buffer_data = stack_buf;
     char* write_ptr = NULL;
     size_t n_to_write;
     int ret = SEE_SUCCESS;
 
-    ret = see_msg_buffer_get_buffer(msg, &buffer_data, &n_to_write, error);
+    ret = see_msg_buffer_length(msg, &n_to_write);
+    if (ret) {
+        // Callers of write_msg expect an error whenever it fails.
+        see_runtime_error_new(error, EINVAL);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    if (n_to_write > sizeof(stack_buf)) {
+        buffer_data = malloc(n_to_write);
+        if (!buffer_data) {
+            see_runtime_error_new(error, errno);
+            return SEE_ERROR_RUNTIME;
+        }
+    }
+
+    ret = see_msg_buffer_write_into(
+        msg, buffer_data, n_to_write, &n_to_write, error
+        );
     if (ret)
         goto fail;
 
@@ -133,10 +158,22 @@ serial_write_msg(
     }
 
 fail:
-    free(buffer_data);
+    if (buffer_data != stack_buf)
+        free(buffer_data);
     return ret;
 }
 
+static int
+serial_write_msg_v(
+    const SeeSerial* self,
+    SeeMsgBuffer* msg,
+    SeeError** error
+    )
+{
+    const SeeSerialClass* cls = SEE_SERIAL_GET_CLASS(self);
+    return cls->write_msg(self, msg, error);
+}
+
 static int
 obtain_synced_msg_buffer(
     const SeeSerial*    self,
@@ -520,6 +557,26 @@ see_serial_write_msg (
     return cls ->write_msg(self, msg, error_out);
 }
 
+int
+see_serial_write_msg_v (
+    const SeeSerial*    self,
+    SeeMsgBuffer*       msg,
+    SeeError**          error_out
+    )
+{
+    const SeeSerialClass* cls;
+
+    if (!self || !msg)
+        return SEE_INVALID_ARGUMENT;
+
+    if (!error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    cls = SEE_SERIAL_GET_CLASS(self);
+
+    return cls->write_msg_v(self, msg, error_out);
+}
+
 int
 see_serial_read_msg (
     const SeeSerial*    self,
@@ -624,6 +681,7 @@ static int see_serial_class_init(SeeObjectClass* new_cls)
     SeeSerialClass* cls = (SeeSerialClass*) new_cls;
     cls->serial_init    = serial_init;
     cls->write_msg      = serial_write_msg;
+    cls->write_msg_v    = serial_write_msg_v;
     cls->read_msg       = serial_read_msg;
 
     // most functions are abstract...
@@ -406,6 +406,26 @@ struct SeeSerialClass {
         SeeFileDescriptor*  fd,
         SeeError**          error
         );
+
+    /**
+     * \brief Send a SeeMsgBuffer using scatter/gather output.
+     *
+     * The default implementation calls write_msg, a derived class that
+     * supports vectored writes may send the message without assembling it
+     * in one contiguous buffer first.
+     *
+     * @param [in]  self        The serial device
+     * @param [in]  msg         A pointer to a initialized SeeMsgBuffer.
+     * @param [out] error_out   If something goes wrong a msg will be
+     *                          returned here.
+     *
+     * @return SEE_SUCCESS, SEE_ERROR_RUNTIME
+     */
+    int (*write_msg_v) (
+        const SeeSerial*    self,
+        SeeMsgBuffer*       msg,
+        SeeError**          error_out
+        );
 };
 
 /* **** function style macro casts **** */
@@ -785,6 +805,28 @@ see_serial_write_msg (
     SeeError**          error_out
     );
 
+/**
+ * \brief Send a SeeMsgBuffer over the serial device with a vectored write.
+ *
+ * The bytes on the wire are the same as with see_serial_write_msg, but
+ * on platforms with writev(2) long strings of the message are written
+ * straight from the message instead of being copied into a buffer first.
+ * Other platforms fall back to see_serial_write_msg.
+ *
+ * @param [in]  self        The serial device
+ * @param [in]  msg         A pointer to a initialized SeeMsgBuffer.
+ * @param [out] error_out   If something goes wrong a msg will be
+ *                          returned here.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT, SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_serial_write_msg_v (
+    const SeeSerial*    self,
+    SeeMsgBuffer*       msg,
+    SeeError**          error_out
+    );
+
 /**
  * \brief Receive a SeeMsgBuffer from the serial device.
  *
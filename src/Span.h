@@ -0,0 +1,78 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file Span.h
+ * \brief A view on the elements of a sequence without copying them.
+ *
+ * A SeeSpan points to size elements that are stride bytes apart. It doesn't
+ * own the elements, it is valid until the container is modified.
+ *
+ * Containers that hold a sequence of elements, such as SeeDynamicArray,
+ * SeeStack, SeeRingBuffer and the parts of a SeeMsgBuffer, implement
+ * SeeObjectClass->next_span. It hands out the elements as one or more
+ * spans, so a generic algorithm can walk any of these containers. A
+ * contiguous container yields a single span, so the inner loop is as fast
+ * as a loop over a plain C array:
+ *
+ * @code
+ * size_t cursor = 0;
+ * SeeSpan span;
+ * while (1) {
+ *     ret = see_object_next_span(SEE_OBJECT(container), &cursor, &span, &error);
+ *     if (ret || span.size == 0)
+ *         break;
+ *     for (size_t i = 0; i < span.size; i++) {
+ *         const double* value = SEE_SPAN_AT(&span, i);
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef SEE_SPAN_H
+#define SEE_SPAN_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief A non owning view on elements that are stride bytes apart.
+ */
+typedef struct SeeSpan {
+    /** \brief The first element. */
+    void*   data;
+    /** \brief The number of elements. */
+    size_t  size;
+    /** \brief The distance between two elements in bytes. */
+    size_t  stride;
+} SeeSpan;
+
+/**
+ * \brief Obtain a pointer to element i of a (SeeSpan*) span.
+ */
+#define SEE_SPAN_AT(span, i)\
+    ((void*) ((char*) (span)->data + (i) * (span)->stride))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_SPAN_H
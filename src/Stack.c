@@ -16,9 +16,21 @@
  */
 
 
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
 #include "MetaClass.h"
 #include "Stack.h"
 #include "IndexError.h"
+#include "RuntimeError.h"
+#include "Span.h"
+
+/**
+ * \brief The number of elements that a stack holds before it allocates
+ * storage on the heap.
+ */
+#define STACK_INLINE_CAPACITY 8
 
 /* **** functions that implement SeeStack or override SeeObject **** */
 
@@ -50,12 +62,13 @@ stack_init(
             SEE_OBJECT_CLASS(stack_cls)
             );
 
-    int error = see_dynamic_array_new(
+    int error = see_dynamic_array_new_inline(
         &stack->array,
         element_size,
         cp_func,
         init_func,
         free_func,
+        STACK_INLINE_CAPACITY,
         error_out
     );
     if (error)
@@ -174,6 +187,97 @@ stack_push(SeeStack* stack, const void* element, SeeError** error_out)
     return see_dynamic_array_add(stack->array, element, error_out);
 }
 
+static int
+stack_push_n(
+    SeeStack*   stack,
+    const void* elements,
+    size_t      n,
+    SeeError**  error_out
+    )
+{
+    SeeDynamicArray* array = stack->array;
+    size_t size = array->size;
+    int ret;
+
+    if (n > SIZE_MAX - size) {
+        see_runtime_error_new(error_out, EOVERFLOW);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    if (size + n > array->capacity) {
+        // Grow like see_dynamic_array_add() would, but only once.
+        size_t capacity = array->capacity * 2;
+        if (capacity < size + n)
+            capacity = size + n;
+        ret = see_dynamic_array_reserve(array, capacity, error_out);
+        if (ret)
+            return ret;
+    }
+
+    char* dest = array->elements + size * array->element_size;
+    if (array->copy_element == memcpy) {
+        memcpy(dest, elements, n * array->element_size);
+    }
+    else {
+        const char* src = elements;
+        for (size_t i = 0; i < n; i++)
+            array->copy_element(
+                dest + i * array->element_size,
+                src + i * array->element_size,
+                array->element_size
+                );
+    }
+    array->size = size + n;
+
+    return SEE_SUCCESS;
+}
+
+static int
+stack_pop_n(SeeStack* stack, void* elements_out, size_t n, SeeError** error_out)
+{
+    SeeDynamicArray* array = stack->array;
+    size_t size = array->size;
+
+    if (n > size) {
+        // The deepest item that should be popped doesn't exist.
+        see_index_error_new(error_out, n - 1);
+        return SEE_ERROR_INDEX;
+    }
+
+    if (!elements_out)
+        return see_dynamic_array_resize(array, size - n, NULL, error_out);
+
+    // The elements are moved out, so they are neither copied nor freed.
+    memcpy(
+        elements_out,
+        array->elements + (size - n) * array->element_size,
+        n * array->element_size
+        );
+    array->size = size - n;
+
+    return SEE_SUCCESS;
+}
+
+static int
+stack_pop_into(SeeStack* stack, void* element_out, SeeError** error_out)
+{
+    return stack_pop_n(stack, element_out, 1, error_out);
+}
+
+static int
+stack_next_span(
+    const SeeObject*    self,
+    size_t*             cursor,
+    SeeSpan*            span_out,
+    SeeError**          error_out
+    )
+{
+    // From the bottom to the top of the stack.
+    return see_object_next_span(
+        SEE_OBJECT(SEE_STACK(self)->array), cursor, span_out, error_out
+        );
+}
+
 /* **** implementation of the public API **** */
 
 /*
@@ -245,6 +349,62 @@ see_stack_push(SeeStack* stack, const void* element, SeeError** error_out)
     return cls->push(stack, element, error_out);
 }
 
+int
+see_stack_pop_into(SeeStack* stack, void* out, SeeError** error_out)
+{
+    if(!stack || !out || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeStackClass* cls = SEE_STACK_GET_CLASS(stack);
+
+    return cls->pop_into(stack, out, error_out);
+}
+
+int
+see_stack_push_n(
+    SeeStack*   stack,
+    const void* src,
+    size_t      n,
+    SeeError**  error_out
+    )
+{
+    if(!stack || (!src && n) || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeStackClass* cls = SEE_STACK_GET_CLASS(stack);
+
+    return cls->push_n(stack, src, n, error_out);
+}
+
+int
+see_stack_pop_n(SeeStack* stack, void* out, size_t n, SeeError** error_out)
+{
+    if(!stack || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    const SeeStackClass* cls = SEE_STACK_GET_CLASS(stack);
+
+    return cls->pop_n(stack, out, n, error_out);
+}
+
+size_t
+see_stack_size(const SeeStack* stack)
+{
+    if (!stack)
+        return 0;
+
+    return see_dynamic_array_size(stack->array);
+}
+
+size_t
+see_stack_capacity(const SeeStack* stack)
+{
+    if (!stack)
+        return 0;
+
+    return see_dynamic_array_capacity(stack->array);
+}
+
 /* **** initialization of the class **** */
 
 SeeStackClass* g_SeeStackClass = NULL;
@@ -271,6 +431,7 @@ static int stack_class_init(SeeObjectClass* new_cls)
     // new_cls->greater_equal  = stack_greater_equal;
     // new_cls->greater        = stack_greater;
     new_cls->copy           = stack_copy;
+    new_cls->next_span      = stack_next_span;
 
     /* Set the function pointers of the own class here */
     SeeStackClass* cls = (SeeStackClass*) new_cls;
@@ -279,6 +440,9 @@ static int stack_class_init(SeeObjectClass* new_cls)
     cls->top        = stack_top;
     cls->pop        = stack_pop;
     cls->push       = stack_push;
+    cls->pop_into   = stack_pop_into;
+    cls->push_n     = stack_push_n;
+    cls->pop_n      = stack_pop_n;
     
     return ret;
 }
@@ -58,6 +58,22 @@ struct SeeStackClass {
     int (*pop)(SeeStack* stack, SeeError** error_out);
 
     int (*push)(SeeStack* stack, const void* element, SeeError** error_out);
+
+    int (*pop_into)(SeeStack* stack, void* element_out, SeeError** error_out);
+
+    int (*push_n)(
+        SeeStack*               stack,
+        const void*             elements,
+        size_t                  n,
+        SeeError**              error_out
+        );
+
+    int (*pop_n)(
+        SeeStack*               stack,
+        void*                   elements_out,
+        size_t                  n,
+        SeeError**              error_out
+        );
 };
 
 /* **** function style macro casts **** */
@@ -169,6 +185,66 @@ see_stack_pop(SeeStack* stack, SeeError** error_out);
 SEE_EXPORT int
 see_stack_push(SeeStack* stack, const void* new_element, SeeError** error_out);
 
+/**
+ * \brief Pop the top item from the stack and return it.
+ *
+ * This does what see_stack_top() followed by see_stack_pop() does, but
+ * the item is moved out of the stack instead of being copied. So the
+ * copy and free functions of the stack are not called and, if the items
+ * own resources, the caller owns them afterwards.
+ *
+ * @param stack [in, out]   The stack from which to pop the top item.
+ * @param out [out]         The item is returned here.
+ * @param error_out [out]   An index error when the stack is empty.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX.
+ */
+SEE_EXPORT int
+see_stack_pop_into(SeeStack* stack, void* out, SeeError** error_out);
+
+/**
+ * \brief Push n items on the stack at once.
+ *
+ * The items are pushed in order, so the last one ends up on top. Room for
+ * all of them is reserved first, when that fails the stack is unchanged.
+ * When the stack has no copy function, the items are copied with one
+ * memcpy.
+ *
+ * @param stack [in, out]   The stack on which to push the items.
+ * @param src [in]          A pointer to n consecutive items.
+ * @param n [in]            The number of items.
+ * @param error_out [out]   A runtime error when no memory is available.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME.
+ */
+SEE_EXPORT int
+see_stack_push_n(
+    SeeStack*   stack,
+    const void* src,
+    size_t      n,
+    SeeError**  error_out
+    );
+
+/**
+ * \brief Pop the n top items from the stack.
+ *
+ * The items are moved to out in the order in which they were pushed, so
+ * out holds the former top last and see_stack_push_n() with the same items
+ * restores the stack. Like see_stack_pop_into(), the copy and free
+ * functions are not called. When out is NULL the items are discarded and
+ * freed instead.
+ *
+ * @param stack [in, out]   The stack from which to pop the items.
+ * @param out [out]         Room for n items or NULL.
+ * @param n [in]            The number of items to pop.
+ * @param error_out [out]   An index error when there are fewer than n items,
+ *                          the stack is unchanged then.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_INDEX.
+ */
+SEE_EXPORT int
+see_stack_pop_n(SeeStack* stack, void* out, size_t n, SeeError** error_out);
+
 
 /**
  * \brief Obtain the number of items pushed on the stack.
@@ -0,0 +1,267 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <limits>
+#include <mutex>
+#include <new>
+
+#include "MetaClass.h"
+#include "ThreadPool.h"
+#include "RuntimeError.h"
+#include "cpp/ThreadPool.hpp"
+
+thread_local see::ThreadPool* see::ThreadPool::tl_pool = nullptr;
+thread_local size_t see::ThreadPool::tl_index = 0;
+
+// The pool that is used when NULL is passed, it is started on first use.
+static SeeThreadPool*   g_shared_pool = NULL;
+static std::mutex       g_shared_pool_mutex;
+
+static SeeThreadPool*
+shared_pool(SeeError** error_out)
+{
+    std::lock_guard<std::mutex> lock(g_shared_pool_mutex);
+    if (!g_shared_pool)
+        see_thread_pool_new(&g_shared_pool, 0, error_out);
+    return g_shared_pool;
+}
+
+/* **** functions that implement SeeThreadPool or override SeeObject **** */
+
+static int
+thread_pool_init(
+    SeeThreadPool*              pool,
+    const SeeThreadPoolClass*   pool_cls,
+    size_t                      num_threads,
+    SeeError**                  error_out
+    )
+{
+    const SeeObjectClass* parent_cls = SEE_OBJECT_GET_CLASS(pool);
+
+    parent_cls->object_init(
+            SEE_OBJECT(pool),
+            SEE_OBJECT_CLASS(pool_cls)
+            );
+
+    try {
+        pool->priv = static_cast<void*>(new see::ThreadPool(num_threads));
+    } catch (const std::bad_alloc&) {
+        see_runtime_error_new(error_out, ENOMEM);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    if (static_cast<see::ThreadPool*>(pool->priv)->size() == 0) {
+        see_runtime_error_new(error_out, EAGAIN);
+        return SEE_ERROR_RUNTIME;
+    }
+
+    return SEE_SUCCESS;
+}
+
+static int
+thread_pool_run(
+    SeeThreadPool*          pool,
+    size_t                  ntasks,
+    see_thread_pool_func    func,
+    void*                   data,
+    SeeError**              error_out
+    )
+{
+    (void) error_out;
+    auto* priv = static_cast<see::ThreadPool*>(pool->priv);
+
+    std::mutex  result_mutex;
+    size_t      failed_index = std::numeric_limits<size_t>::max();
+    int         result = SEE_SUCCESS;
+
+    priv->parallel(ntasks, [&](size_t index) {
+        int ret = func(index, data);
+        if (ret == SEE_SUCCESS)
+            return;
+
+        std::lock_guard<std::mutex> lock(result_mutex);
+        if (index < failed_index) {
+            failed_index = index;
+            result = ret;
+        }
+    });
+
+    return result;
+}
+
+static void
+thread_pool_destroy(SeeObject* obj)
+{
+    SeeThreadPool* pool = SEE_THREAD_POOL(obj);
+    auto* priv = static_cast<see::ThreadPool*>(pool->priv);
+    delete priv;
+
+    see_object_class()->destroy(obj);
+}
+
+static int
+init(const SeeObjectClass* cls, SeeObject* obj, va_list args)
+{
+    const SeeThreadPoolClass* pool_cls = SEE_THREAD_POOL_CLASS(cls);
+    SeeThreadPool* pool = SEE_THREAD_POOL(obj);
+
+    size_t num_threads      = va_arg(args, size_t);
+    SeeError** error_out    = va_arg(args, SeeError**);
+
+    return pool_cls->thread_pool_init(
+        pool,
+        pool_cls,
+        num_threads,
+        error_out
+        );
+}
+
+/* **** implementation of the public API **** */
+
+int
+see_thread_pool_new(
+    SeeThreadPool** pool_out,
+    size_t          num_threads,
+    SeeError**      error_out
+    )
+{
+    const SeeObjectClass* cls = SEE_OBJECT_CLASS(
+        see_thread_pool_class()
+        );
+
+    if (!cls)
+        return SEE_NOT_INITIALIZED;
+
+    if (!pool_out || !error_out || *pool_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    return cls->new_obj(
+            cls,
+            0,
+            SEE_OBJECT_REF(pool_out),
+            num_threads,
+            error_out
+            );
+}
+
+size_t
+see_thread_pool_num_threads(const SeeThreadPool* pool)
+{
+    if (!pool) {
+        SeeError* error = nullptr;
+        pool = shared_pool(&error);
+        see_object_decref(SEE_OBJECT(error));
+        if (!pool)
+            return 0;
+    }
+
+    return static_cast<const see::ThreadPool*>(pool->priv)->size();
+}
+
+int
+see_thread_pool_run(
+    SeeThreadPool*          pool,
+    size_t                  ntasks,
+    see_thread_pool_func    func,
+    void*                   data,
+    SeeError**              error_out
+    )
+{
+    if (!func || !error_out || *error_out)
+        return SEE_INVALID_ARGUMENT;
+
+    if (!pool) {
+        pool = shared_pool(error_out);
+        if (!pool)
+            return SEE_ERROR_RUNTIME;
+    }
+
+    const SeeThreadPoolClass* cls = SEE_THREAD_POOL_GET_CLASS(pool);
+    return cls->run(pool, ntasks, func, data, error_out);
+}
+
+/* **** initialization of the class **** */
+
+SeeThreadPoolClass* g_SeeThreadPoolClass = NULL;
+
+static int
+thread_pool_class_init(SeeObjectClass* new_cls)
+{
+    int ret = SEE_SUCCESS;
+
+    /* Override the functions on the SeeObject here */
+    new_cls->init    = init;
+    new_cls->destroy = thread_pool_destroy;
+
+    // Every class should have a unique name.
+    new_cls->name = "SeeThreadPool";
+
+    /* Set the function pointers of the own class here */
+    SeeThreadPoolClass* cls = (SeeThreadPoolClass*) new_cls;
+    cls->thread_pool_init   = thread_pool_init;
+    cls->run                = thread_pool_run;
+
+    return ret;
+}
+
+/**
+ * \private
+ * \brief this class initializes SeeThreadPool(Class).
+ *
+ * You might want to call this from the library initialization func.
+ */
+int
+see_thread_pool_init()
+{
+    int ret;
+    const SeeMetaClass* meta = see_meta_class_class();
+
+    ret = see_meta_class_new_class(
+        meta,
+        (SeeObjectClass**) &g_SeeThreadPoolClass,
+        sizeof(SeeThreadPoolClass),
+        sizeof(SeeThreadPool),
+        SEE_OBJECT_CLASS(see_object_class()),
+        sizeof(SeeObjectClass),
+        thread_pool_class_init
+        );
+
+    return ret;
+}
+
+void
+see_thread_pool_deinit()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_shared_pool_mutex);
+        see_object_decref(SEE_OBJECT(g_shared_pool));
+        g_shared_pool = NULL;
+    }
+
+    if(!g_SeeThreadPoolClass)
+        return;
+
+    see_object_decref(SEE_OBJECT(g_SeeThreadPoolClass));
+    g_SeeThreadPoolClass = NULL;
+}
+
+const SeeThreadPoolClass*
+see_thread_pool_class()
+{
+    return g_SeeThreadPoolClass;
+}
@@ -0,0 +1,210 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ThreadPool.h
+ * @brief A pool of worker threads that run a number of tasks in parallel.
+ *
+ * Every worker has its own queue of tasks, idle workers steal tasks from
+ * the queues of the others. The thread that calls see_thread_pool_run()
+ * helps running the tasks, so the run may also be started from a task
+ * that runs on the same pool.
+ *
+ * All functions that take a SeeThreadPool* allow to pass NULL, then a pool
+ * that is shared by the whole library is used. It has a thread for every
+ * core and is started the first time it is used.
+ *
+ * @code
+ * static int
+ * square(size_t index, void* data)
+ * {
+ *     double* values = data;
+ *     values[index] *= values[index];
+ *     return SEE_SUCCESS;
+ * }
+ *
+ * double values[100];
+ * // fill values
+ * ret = see_thread_pool_run(NULL, 100, square, values, &error);
+ * @endcode
+ */
+
+#ifndef SEE_THREAD_POOL_H
+#define SEE_THREAD_POOL_H
+
+#include "SeeObject.h"
+#include "Error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SeeThreadPool SeeThreadPool;
+typedef struct SeeThreadPoolClass SeeThreadPoolClass;
+
+/**
+ * \brief The type of the tasks run by a SeeThreadPool.
+ *
+ * @param [in] index    The index of the task, in [0, ntasks).
+ * @param [in] data     The data that is handed to see_thread_pool_run().
+ *
+ * @return SEE_SUCCESS or another value to indicate that the task failed.
+ */
+typedef int (*see_thread_pool_func)(size_t index, void* data);
+
+struct SeeThreadPool {
+    SeeObject parent_obj;
+    void* priv;
+};
+
+struct SeeThreadPoolClass {
+    SeeObjectClass parent_cls;
+
+    int (*thread_pool_init)(
+        SeeThreadPool*              pool,
+        const SeeThreadPoolClass*   pool_cls,
+        size_t                      num_threads,
+        SeeError**                  error_out
+        );
+
+    int (*run)(
+        SeeThreadPool*          pool,
+        size_t                  ntasks,
+        see_thread_pool_func    func,
+        void*                   data,
+        SeeError**              error_out
+        );
+};
+
+/* **** function style macro casts **** */
+
+/**
+ * \brief cast a pointer from a SeeThreadPool derived instance back to a
+ *        pointer to SeeThreadPool.
+ */
+#define SEE_THREAD_POOL(obj)                      \
+    ((SeeThreadPool*) obj)
+
+/**
+ * \brief cast a pointer to pointer from a SeeThreadPool derived instance back
+ *        to a reference to SeeThreadPool*.
+ */
+#define SEE_THREAD_POOL_REF(ref)                      \
+    ((SeeThreadPool**) ref)
+
+/**
+ * \brief cast a pointer to SeeThreadPoolClass derived class back to a
+ *        pointer to SeeThreadPoolClass.
+ */
+#define SEE_THREAD_POOL_CLASS(cls)                      \
+    ((const SeeThreadPoolClass*) cls)
+
+/**
+ * \brief obtain a pointer to SeeThreadPoolClass from a instance of
+ *        derived from SeeThreadPool. This macro is preferably
+ *        used when obtaining the class of a instance. When this
+ *        macro is used. Calling methods on the class will enable
+ *        polymorphism, because you'll get the derived class.
+ */
+#define SEE_THREAD_POOL_GET_CLASS(obj)                \
+    (SEE_THREAD_POOL_CLASS(see_object_get_class(SEE_OBJECT(obj)) )  )
+
+/* **** public functions **** */
+
+/**
+ * \brief Create a new thread pool and start its workers.
+ *
+ * @param [out] pool_out    A pointer to a SeeThreadPool* that is NULL.
+ * @param [in]  num_threads The number of workers, 0 means one per core.
+ * @param [out] error_out   A runtime error when the pool cannot be created.
+ *
+ * @return SEE_SUCCESS, SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME
+ */
+SEE_EXPORT int
+see_thread_pool_new(
+    SeeThreadPool** pool_out,
+    size_t          num_threads,
+    SeeError**      error_out
+    );
+
+/**
+ * \brief Get the number of worker threads of the pool.
+ *
+ * @param [in] pool A thread pool or NULL for the shared pool.
+ *
+ * @return the number of workers, or 0 when the shared pool cannot be started.
+ */
+SEE_EXPORT size_t
+see_thread_pool_num_threads(const SeeThreadPool* pool);
+
+/**
+ * \brief Call func(index, data) for every index in [0, ntasks) and wait
+ *        until all calls have returned.
+ *
+ * The tasks run concurrently, so they must not modify data that other
+ * tasks use. The error_out parameter is not handed to the tasks, a task
+ * that fails should return a value other than SEE_SUCCESS and may store
+ * the details in its part of data.
+ *
+ * @param [in]  pool        A thread pool or NULL for the shared pool.
+ * @param [in]  ntasks      The number of times func is called.
+ * @param [in]  func        The task.
+ * @param [in]  data        Is passed to func.
+ * @param [out] error_out   A runtime error when the shared pool cannot be
+ *                          started.
+ *
+ * @return SEE_SUCCESS when all tasks succeeded, otherwise the value
+ *         returned by the failing task with the lowest index.
+ *         SEE_INVALID_ARGUMENT or SEE_ERROR_RUNTIME when the tasks
+ *         could not be run.
+ */
+SEE_EXPORT int
+see_thread_pool_run(
+    SeeThreadPool*          pool,
+    size_t                  ntasks,
+    see_thread_pool_func    func,
+    void*                   data,
+    SeeError**              error_out
+    );
+
+/**
+ * Gets the pointer to the SeeThreadPoolClass table.
+ */
+SEE_EXPORT const SeeThreadPoolClass*
+see_thread_pool_class();
+
+/* **** class initialization functions **** */
+
+/**
+ * Initialize SeeThreadPool; make it ready for use.
+ */
+SEE_EXPORT
+int see_thread_pool_init();
+
+/**
+ * Deinitialize SeeThreadPool, after SeeThreadPool has been deinitialized,
+ * all functions in this header shouldn't be used anymore. This also stops
+ * the shared pool.
+ */
+SEE_EXPORT
+void see_thread_pool_deinit();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ifndef SEE_THREAD_POOL_H
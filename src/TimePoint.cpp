@@ -469,6 +469,36 @@ see_time_point_gt(
     return SEE_SUCCESS;
 }
 
+int64_t
+see_time_point_nanos(const SeeTimePoint* self)
+{
+    if (!self)
+        return 0;
+
+    const TimePoint* ts = static_cast<const TimePoint*>(self->priv_time);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        ts->get_time().time_since_epoch()
+        ).count();
+}
+
+int
+see_time_point_set_nanos(SeeTimePoint* self, int64_t ns)
+{
+    typedef std::chrono::steady_clock clock;
+
+    if (!self)
+        return SEE_INVALID_ARGUMENT;
+
+    TimePoint* ts = static_cast<TimePoint*>(self->priv_time);
+    *ts = TimePoint(
+        clock::time_point(
+            std::chrono::duration_cast<clock::duration>(
+                std::chrono::nanoseconds(ns)
+                )
+            )
+        );
+    return SEE_SUCCESS;
+}
 
 /* **** initialization of the class **** */
 
@@ -295,6 +295,27 @@ see_time_point_gt(
     int* result
     );
 
+/**
+ * @brief Get the timepoint as a number of nanoseconds since the epoch of
+ *        the clock.
+ *
+ * Unlike the timepoint itself, the number is cheap to store and compare,
+ * e.g. as the key of a priority queue.
+ *
+ * @return the nanoseconds since the epoch or 0 when self is NULL.
+ */
+SEE_EXPORT int64_t
+see_time_point_nanos(const SeeTimePoint* self);
+
+/**
+ * @brief Set the timepoint to a number of nanoseconds since the epoch of
+ *        the clock, the reverse of see_time_point_nanos().
+ *
+ * @return SEE_SUCCESS or SEE_INVALID_ARGUMENT
+ */
+SEE_EXPORT int
+see_time_point_set_nanos(SeeTimePoint* self, int64_t ns);
+
 /**
  * Gets the pointer to the SeeTimePointClass table.
  */
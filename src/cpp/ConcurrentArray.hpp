@@ -0,0 +1,206 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ConcurrentArray.hpp
+ * \brief Provides the private segmented storage of SeeConcurrentArray.
+ * \private
+ */
+
+#ifndef SEE_CONCURRENT_ARRAY_HPP
+#define SEE_CONCURRENT_ARRAY_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace see {
+
+/**
+ * \brief An append only array that never moves its elements.
+ *
+ * The elements live in segments, segment k holds first_size << k elements.
+ * A segment is allocated by the first thread that needs it, so growing
+ * never copies elements and readers never see memory that is released.
+ * push_back reserves an index with a single atomic increment, copies the
+ * element and then publishes it with a flag, so get only returns elements
+ * that have been completely written.
+ */
+class ConcurrentArray {
+
+    public:
+
+        static const size_t MAX_SEGMENTS = sizeof(size_t) * CHAR_BIT;
+
+        ConcurrentArray(size_t element_size, size_t first_size)
+            : m_element_size(element_size),
+              m_first_shift(0)
+        {
+            while ((size_t(1) << m_first_shift) < first_size)
+                m_first_shift++;
+
+            for (auto& segment : m_segments)
+                segment.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~ConcurrentArray()
+        {
+            for (auto& segment : m_segments)
+                delete segment.load(std::memory_order_relaxed);
+        }
+
+        ConcurrentArray(const ConcurrentArray&) = delete;
+        ConcurrentArray& operator=(const ConcurrentArray&) = delete;
+
+        size_t element_size() const
+        {
+            return m_element_size;
+        }
+
+        /**
+         * \brief The number of indices handed out by push_back, the last
+         *        ones may not be published yet.
+         */
+        size_t size() const
+        {
+            return m_size.value.load(std::memory_order_acquire);
+        }
+
+        /**
+         * \brief Append a copy of element and return its index.
+         *
+         * @throws std::bad_alloc when a segment cannot be allocated, the
+         *         reserved index is never published then.
+         */
+        size_t push_back(const void* element)
+        {
+            size_t index = m_size.value.fetch_add(
+                1, std::memory_order_relaxed
+                );
+
+            size_t offset;
+            Segment* segment = segment_for(index, offset);
+            std::memcpy(
+                segment->data.get() + offset * m_element_size,
+                element,
+                m_element_size
+                );
+            segment->ready[offset].store(1, std::memory_order_release);
+            return index;
+        }
+
+        /**
+         * \brief Get the element at index or nullptr when it hasn't been
+         *        published.
+         */
+        const void* at(size_t index) const
+        {
+            if (index >= size())
+                return nullptr;
+
+            size_t s, offset;
+            locate(index, s, offset);
+            const Segment* segment = m_segments[s].load(
+                std::memory_order_acquire
+                );
+            if (!segment ||
+                !segment->ready[offset].load(std::memory_order_acquire))
+                return nullptr;
+
+            return segment->data.get() + offset * m_element_size;
+        }
+
+    private:
+
+        struct Segment {
+            Segment(size_t n, size_t element_size)
+                : data(new char[n * element_size]),
+                  ready(new std::atomic<unsigned char>[n]())
+            {
+            }
+
+            std::unique_ptr<char[]>                         data;
+            std::unique_ptr<std::atomic<unsigned char>[]>   ready;
+        };
+
+        static unsigned floor_log2(size_t n)
+        {
+#if defined(__GNUC__)
+            return unsigned(sizeof(unsigned long long) * CHAR_BIT - 1) -
+                unsigned(__builtin_clzll(n));
+#else
+            unsigned r = 0;
+            while (n >>= 1)
+                r++;
+            return r;
+#endif
+        }
+
+        /*
+         * Segment s starts at index first_size * (2^s - 1), so the segment
+         * of index i is floor(log2(i / first_size + 1)).
+         */
+        void locate(size_t index, size_t& s, size_t& offset) const
+        {
+            s = floor_log2((index >> m_first_shift) + 1);
+            offset = index - (((size_t(1) << s) - 1) << m_first_shift);
+        }
+
+        Segment* segment_for(size_t index, size_t& offset)
+        {
+            size_t s;
+            locate(index, s, offset);
+
+            Segment* segment = m_segments[s].load(std::memory_order_acquire);
+            if (segment)
+                return segment;
+
+            Segment* fresh = new Segment(
+                size_t(1) << (s + m_first_shift), m_element_size
+                );
+            if (m_segments[s].compare_exchange_strong(
+                    segment,
+                    fresh,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+                return fresh;
+
+            // Another thread installed the segment first.
+            delete fresh;
+            return segment;
+        }
+
+        const size_t            m_element_size;
+        unsigned                m_first_shift;
+
+        // Producers only share this counter, keep it on its own cache line.
+        struct PaddedSize {
+            char                before[64];
+            std::atomic<size_t> value{0};
+            char                after[64];
+        };
+
+        PaddedSize              m_size;
+
+        std::atomic<Segment*>   m_segments[MAX_SEGMENTS];
+};
+
+} // namespace see
+
+#endif //ifndef SEE_CONCURRENT_ARRAY_HPP
@@ -0,0 +1,318 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ConcurrentStack.hpp
+ * \brief Provides the private lock free stack of SeeConcurrentStack.
+ * \private
+ */
+
+#ifndef SEE_CONCURRENT_STACK_HPP
+#define SEE_CONCURRENT_STACK_HPP
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace see {
+
+/**
+ * \brief A Treiber stack whose nodes are recycled instead of freed.
+ *
+ * The nodes live in segments that double in size and are only released
+ * when the stack is destroyed, so a thread that reads a node that was just
+ * popped by another thread never touches freed memory. Nodes are addressed
+ * by a 32 bit index, the head of a list packs that index together with a
+ * 32 bit tag that changes with every update. So a compare and swap fails
+ * when the head was popped and pushed again in the meantime, which
+ * prevents the ABA problem without a double width compare and swap.
+ *
+ * The popped nodes go onto a free list that works the same way.
+ */
+class ConcurrentStack {
+
+    public:
+
+        // The nodes in the first segment, segment k holds FIRST << k nodes.
+        static const unsigned FIRST_SHIFT   = 6;
+        static const size_t   MAX_SEGMENTS  = 32 - FIRST_SHIFT;
+        static const uint32_t MAX_NODES     =
+            uint32_t(((uint64_t(1) << MAX_SEGMENTS) - 1) << FIRST_SHIFT);
+
+        explicit ConcurrentStack(size_t element_size)
+            : m_element_size(element_size)
+        {
+            for (auto& segment : m_segments)
+                segment.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~ConcurrentStack()
+        {
+            for (auto& segment : m_segments)
+                delete segment.load(std::memory_order_relaxed);
+        }
+
+        ConcurrentStack(const ConcurrentStack&) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+        size_t element_size() const
+        {
+            return m_element_size;
+        }
+
+        /**
+         * \brief The number of elements, when other threads push or pop
+         *        at the same time this is a snapshot that may be off.
+         */
+        size_t size() const
+        {
+            return m_lists.size.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Push a copy of element.
+         *
+         * @throws std::bad_alloc or std::length_error when no node is
+         *         available.
+         */
+        void push(const void* element)
+        {
+            uint32_t node = new_node();
+            std::memcpy(data(node), element, m_element_size);
+
+            m_lists.size.fetch_add(1, std::memory_order_relaxed);
+            push_chain(m_lists.top, node, node);
+        }
+
+        /**
+         * \brief Push n elements with a single update of the top, the last
+         *        element ends up on top.
+         *
+         * Either all elements are pushed or, when an exception is thrown,
+         * none of them.
+         */
+        void push_n(const void* elements, size_t n)
+        {
+            if (n == 0)
+                return;
+
+            const char* src = static_cast<const char*>(elements);
+            uint32_t first = 0, last = 0;
+
+            try {
+                // Link the chain from the bottom to the top.
+                for (size_t i = 0; i < n; i++) {
+                    uint32_t node = new_node();
+                    std::memcpy(data(node), src + i * m_element_size,
+                                m_element_size);
+                    if (i == 0)
+                        last = node;
+                    else
+                        next(node).store(first, std::memory_order_relaxed);
+                    first = node;
+                }
+            } catch (...) {
+                if (first)
+                    push_chain(m_lists.free, first, last);
+                throw;
+            }
+
+            m_lists.size.fetch_add(n, std::memory_order_relaxed);
+            push_chain(m_lists.top, first, last);
+        }
+
+        /**
+         * \brief Pop the top element into out, out may be nullptr.
+         *
+         * @return false when the stack is empty.
+         */
+        bool try_pop(void* out)
+        {
+            uint32_t node = pop_node(m_lists.top);
+            if (!node)
+                return false;
+
+            m_lists.size.fetch_sub(1, std::memory_order_relaxed);
+            if (out)
+                std::memcpy(out, data(node), m_element_size);
+            push_chain(m_lists.free, node, node);
+            return true;
+        }
+
+    private:
+
+        struct Segment {
+            Segment(size_t n, size_t element_size)
+                : data(new char[n * element_size]),
+                  next(new std::atomic<uint32_t>[n]())
+            {
+            }
+
+            std::unique_ptr<char[]>                     data;
+            std::unique_ptr<std::atomic<uint32_t>[]>    next;
+        };
+
+        /*
+         * A head holds the index of the first node plus one in the low half,
+         * 0 is the empty list, and the tag in the high half.
+         */
+        static uint64_t make_head(uint32_t node, uint64_t old_head)
+        {
+            uint64_t tag = (old_head >> 32) + 1;
+            return (tag << 32) | node;
+        }
+
+        static uint32_t head_node(uint64_t head)
+        {
+            return uint32_t(head);
+        }
+
+        static unsigned floor_log2(size_t n)
+        {
+#if defined(__GNUC__)
+            return unsigned(sizeof(unsigned long long) * CHAR_BIT - 1) -
+                unsigned(__builtin_clzll(n));
+#else
+            unsigned r = 0;
+            while (n >>= 1)
+                r++;
+            return r;
+#endif
+        }
+
+        /*
+         * Segment s starts at index FIRST * (2^s - 1), see ConcurrentArray.
+         */
+        void locate(uint32_t node, size_t& s, size_t& offset) const
+        {
+            size_t index = node - 1;
+            s = floor_log2((index >> FIRST_SHIFT) + 1);
+            offset = index - (((size_t(1) << s) - 1) << FIRST_SHIFT);
+        }
+
+        std::atomic<uint32_t>& next(uint32_t node) const
+        {
+            size_t s, offset;
+            locate(node, s, offset);
+            return m_segments[s].load(std::memory_order_acquire)->next[offset];
+        }
+
+        char* data(uint32_t node) const
+        {
+            size_t s, offset;
+            locate(node, s, offset);
+            return m_segments[s].load(std::memory_order_acquire)->data.get() +
+                offset * m_element_size;
+        }
+
+        void push_chain(std::atomic<uint64_t>& list, uint32_t first, uint32_t last)
+        {
+            uint64_t head = list.load(std::memory_order_relaxed);
+            for (;;) {
+                next(last).store(head_node(head), std::memory_order_relaxed);
+                if (list.compare_exchange_weak(
+                        head,
+                        make_head(first, head),
+                        std::memory_order_release,
+                        std::memory_order_relaxed))
+                    return;
+            }
+        }
+
+        uint32_t pop_node(std::atomic<uint64_t>& list)
+        {
+            uint64_t head = list.load(std::memory_order_acquire);
+            for (;;) {
+                uint32_t node = head_node(head);
+                if (!node)
+                    return 0;
+
+                // When node was popped meanwhile, this is stale and the
+                // tag makes the exchange fail.
+                uint32_t successor = next(node).load(std::memory_order_relaxed);
+                if (list.compare_exchange_weak(
+                        head,
+                        make_head(successor, head),
+                        std::memory_order_acquire,
+                        std::memory_order_acquire))
+                    return node;
+            }
+        }
+
+        /*
+         * Take a node from the free list, or one that was never used.
+         */
+        uint32_t new_node()
+        {
+            uint32_t node = pop_node(m_lists.free);
+            if (node)
+                return node;
+
+            uint32_t fresh = m_lists.used.load(std::memory_order_relaxed);
+            do {
+                if (fresh == MAX_NODES)
+                    throw std::length_error("ConcurrentStack is full");
+            } while (!m_lists.used.compare_exchange_weak(
+                         fresh, fresh + 1, std::memory_order_relaxed));
+            node = fresh + 1;
+
+            size_t s, offset;
+            locate(node, s, offset);
+            if (!m_segments[s].load(std::memory_order_acquire))
+                install_segment(s);
+
+            return node;
+        }
+
+        void install_segment(size_t s)
+        {
+            Segment* expected = nullptr;
+            Segment* fresh = new Segment(
+                size_t(1) << (s + FIRST_SHIFT), m_element_size
+                );
+            if (!m_segments[s].compare_exchange_strong(
+                    expected,
+                    fresh,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire))
+                delete fresh; // Another thread was first.
+        }
+
+        const size_t                m_element_size;
+        std::atomic<Segment*>       m_segments[MAX_SEGMENTS];
+
+        // The heads are hot, keep them apart from each other and the rest.
+        struct Lists {
+            char                    before[64];
+            std::atomic<uint64_t>   top{0};
+            char                    between[64];
+            std::atomic<uint64_t>   free{0};
+            std::atomic<uint32_t>   used{0};
+            std::atomic<size_t>     size{0};
+            char                    after[64];
+        };
+
+        Lists                       m_lists;
+};
+
+} // namespace see
+
+#endif //ifndef SEE_CONCURRENT_STACK_HPP
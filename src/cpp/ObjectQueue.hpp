@@ -0,0 +1,356 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ObjectQueue.hpp
+ * \brief Provides the private bounded lock free queues of SeeObjectQueue.
+ * \private
+ */
+
+#ifndef SEE_OBJECT_QUEUE_HPP
+#define SEE_OBJECT_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace see {
+
+/**
+ * \brief The size that is assumed for a cache line.
+ */
+const size_t CACHE_LINE = 64;
+
+/**
+ * \brief A bounded queue of pointers, the blocking operations first spin
+ *        for a while and then sleep until the other side signals them.
+ */
+class ObjectQueue {
+
+    public:
+
+        typedef std::chrono::steady_clock   clock;
+        typedef std::chrono::nanoseconds    ns;
+
+        virtual ~ObjectQueue() = default;
+
+        virtual size_t capacity() const = 0;
+
+        /**
+         * \brief Append p, or return false when the queue is full.
+         */
+        bool try_push(void* p)
+        {
+            if (!do_try_push(p))
+                return false;
+            m_not_empty.notify();
+            return true;
+        }
+
+        /**
+         * \brief Take the oldest pointer, or return false when the queue
+         *        is empty.
+         */
+        bool try_pop(void*& p)
+        {
+            if (!do_try_pop(p))
+                return false;
+            m_not_full.notify();
+            return true;
+        }
+
+        /**
+         * \brief Append p, wait at most timeout for room, or forever when
+         *        timeout is nullptr.
+         */
+        bool push(void* p, const ns* timeout)
+        {
+            if (!wait(m_not_full, timeout, [&]() { return do_try_push(p); }))
+                return false;
+            m_not_empty.notify();
+            return true;
+        }
+
+        /**
+         * \brief Take the oldest pointer, wait at most timeout for one, or
+         *        forever when timeout is nullptr.
+         */
+        bool pop(void*& p, const ns* timeout)
+        {
+            if (!wait(m_not_empty, timeout, [&]() { return do_try_pop(p); }))
+                return false;
+            m_not_full.notify();
+            return true;
+        }
+
+    protected:
+
+        virtual bool do_try_push(void* p) = 0;
+        virtual bool do_try_pop(void*& p) = 0;
+
+    private:
+
+        /*
+         * Threads that sleep register themselves before they check the
+         * queue once more, the other side checks for sleepers after it
+         * modified the queue. Both do so with a read-modify-write of
+         * count, so whichever comes last sees what the other did.
+         */
+        struct Sleepers {
+            std::mutex                  mutex;
+            std::condition_variable     cv;
+            std::atomic<int>            count{0};
+
+            void notify()
+            {
+                if (count.fetch_add(0, std::memory_order_acq_rel) == 0)
+                    return;
+                {
+                    // A sleeper is either before its last check, or waiting.
+                    std::lock_guard<std::mutex> lock(mutex);
+                }
+                cv.notify_all();
+            }
+        };
+
+        // Spinning is cheaper than sleeping when the other side is active.
+        static const int SPINS  = 2000;
+        static const int YIELDS = 50;
+
+        /*
+         * Op must not notify the other side. It runs while the mutex of
+         * sleepers is held, and a thread that waits on the other side
+         * holds that mutex while it locks this one. The caller notifies
+         * after wait() has returned and released the mutex.
+         */
+        template<class Op>
+        bool wait(Sleepers& sleepers, const ns* timeout, const Op& op)
+        {
+            if (op())
+                return true;
+            if (timeout && timeout->count() <= 0)
+                return false;
+
+            const clock::time_point deadline = timeout ?
+                clock::now() + *timeout : clock::time_point::max();
+
+            for (int i = 0; i < SPINS + YIELDS; i++) {
+                if (op())
+                    return true;
+                if (i >= SPINS)
+                    std::this_thread::yield();
+            }
+
+            std::unique_lock<std::mutex> lock(sleepers.mutex);
+            sleepers.count.fetch_add(1, std::memory_order_acq_rel);
+
+            bool done;
+            for (;;) {
+                done = op();
+                if (done)
+                    break;
+                if (!timeout)
+                    sleepers.cv.wait(lock);
+                else if (sleepers.cv.wait_until(lock, deadline) ==
+                         std::cv_status::timeout) {
+                    done = op();
+                    break;
+                }
+            }
+
+            sleepers.count.fetch_sub(1, std::memory_order_relaxed);
+            return done;
+        }
+
+        Sleepers m_not_empty;
+        Sleepers m_not_full;
+};
+
+/**
+ * \brief A ring for one producer and one consumer.
+ *
+ * The producer and consumer each own an index on a separate cache line
+ * and keep a cached copy of the index of the other side, so they only
+ * touch the shared line when the ring looks full or empty.
+ */
+class SpscQueue : public ObjectQueue {
+
+    public:
+
+        explicit SpscQueue(size_t capacity)
+            : m_mask(capacity - 1),
+              m_slots(new void*[capacity])
+        {
+        }
+
+        size_t capacity() const override
+        {
+            return m_mask + 1;
+        }
+
+    protected:
+
+        bool do_try_push(void* p) override
+        {
+            const size_t tail = m_producer.index.load(std::memory_order_relaxed);
+            if (tail - m_producer.cached == capacity()) {
+                m_producer.cached = m_consumer.index.load(
+                    std::memory_order_acquire
+                    );
+                if (tail - m_producer.cached == capacity())
+                    return false;
+            }
+
+            m_slots[tail & m_mask] = p;
+            m_producer.index.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool do_try_pop(void*& p) override
+        {
+            const size_t head = m_consumer.index.load(std::memory_order_relaxed);
+            if (head == m_consumer.cached) {
+                m_consumer.cached = m_producer.index.load(
+                    std::memory_order_acquire
+                    );
+                if (head == m_consumer.cached)
+                    return false;
+            }
+
+            p = m_slots[head & m_mask];
+            m_consumer.index.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+
+        struct Side {
+            char                before[CACHE_LINE];
+            // The own index, written by this side only.
+            std::atomic<size_t> index{0};
+            // The last value of the index of the other side that was seen.
+            size_t              cached = 0;
+            char                after[CACHE_LINE];
+        };
+
+        const size_t                m_mask;
+        std::unique_ptr<void*[]>    m_slots;
+        Side                        m_producer;
+        Side                        m_consumer;
+};
+
+/**
+ * \brief A ring for many producers and consumers, after the bounded queue
+ *        of Dmitry Vyukov.
+ *
+ * Every cell has a sequence number that tells whether it is ready to be
+ * written or read in the current lap, so producers and consumers only
+ * contend on their own position counter.
+ */
+class MpmcQueue : public ObjectQueue {
+
+    public:
+
+        explicit MpmcQueue(size_t capacity)
+            : m_mask(capacity - 1),
+              m_cells(new Cell[capacity])
+        {
+            for (size_t i = 0; i < capacity; i++)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        size_t capacity() const override
+        {
+            return m_mask + 1;
+        }
+
+    protected:
+
+        bool do_try_push(void* p) override
+        {
+            Cell* cell;
+            size_t pos = m_enqueue.pos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = intptr_t(seq) - intptr_t(pos);
+                if (diff == 0) {
+                    if (m_enqueue.pos.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = m_enqueue.pos.load(std::memory_order_relaxed);
+            }
+
+            cell->data = p;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool do_try_pop(void*& p) override
+        {
+            Cell* cell;
+            size_t pos = m_dequeue.pos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+                if (diff == 0) {
+                    if (m_dequeue.pos.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = m_dequeue.pos.load(std::memory_order_relaxed);
+            }
+
+            p = cell->data;
+            cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+
+        struct Cell {
+            std::atomic<size_t> sequence;
+            void*               data = nullptr;
+        };
+
+        struct Position {
+            char                before[CACHE_LINE];
+            std::atomic<size_t> pos{0};
+            char                after[CACHE_LINE];
+        };
+
+        const size_t                m_mask;
+        std::unique_ptr<Cell[]>     m_cells;
+        Position                    m_enqueue;
+        Position                    m_dequeue;
+};
+
+} // namespace see
+
+#endif //ifndef SEE_OBJECT_QUEUE_HPP
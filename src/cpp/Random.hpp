@@ -166,6 +166,15 @@ class Random {
             return dist(gen);
         }
 
+        /**
+         * \brief return the underlying engine, e.g. for the shuffle engine
+         *        that needs raw 64 bit numbers.
+         */
+        std::mt19937_64& generator()
+        {
+            return gen;
+        }
+
     private:
 
         std::mt19937_64 gen;
@@ -0,0 +1,364 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file Shuffle.hpp
+ * \brief Provides the private shuffle engine used by SeeRandom and
+ *        SeeDynamicArray.
+ *
+ * Small ranges are shuffled with a Fisher-Yates shuffle whose random numbers
+ * are drawn in batches from the generator. Large ranges are cut into a number
+ * of blocks that only depends on the number of elements. The blocks are
+ * shuffled independently and merged pairwise using the MergeShuffle
+ * algorithm of Bacher et al. Every block and every merge obtains its own
+ * generator that is seeded from the generator of the caller, so the outcome
+ * is the same for a given seed whether or not the work is done on multiple
+ * threads.
+ *
+ * \private
+ */
+
+#ifndef SEE_SHUFFLE_HPP
+#define SEE_SHUFFLE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace see {
+
+/**
+ * \brief Draws random numbers in batches from a std::mt19937_64.
+ */
+class BatchedRandom {
+
+    public:
+
+        explicit BatchedRandom(std::mt19937_64& gen)
+            : m_gen(gen), m_pos(BATCH_SIZE), m_bits(0), m_nbits(0)
+        {
+        }
+
+        /**
+         * \brief return the next raw 64 bit random number.
+         */
+        uint64_t next()
+        {
+            if (m_pos == BATCH_SIZE)
+                refill();
+            return m_batch[m_pos++];
+        }
+
+        /**
+         * \brief return an unbiased number from the range [0, bound).
+         *
+         * \note bound must be larger than 0.
+         */
+        uint64_t bounded(uint64_t bound)
+        {
+#if defined(__SIZEOF_INT128__)
+            // Lemire's nearly divisionless method.
+            __uint128_t m = static_cast<__uint128_t>(next()) * bound;
+            uint64_t low = static_cast<uint64_t>(m);
+            if (low < bound) {
+                uint64_t threshold = (0 - bound) % bound;
+                while (low < threshold) {
+                    m = static_cast<__uint128_t>(next()) * bound;
+                    low = static_cast<uint64_t>(m);
+                }
+            }
+            return static_cast<uint64_t>(m >> 64);
+#else
+            uint64_t threshold = (0 - bound) % bound;
+            uint64_t r;
+            do {
+                r = next();
+            } while (r < threshold);
+            return r % bound;
+#endif
+        }
+
+        /**
+         * \brief return a random bit.
+         */
+        bool bit()
+        {
+            if (m_nbits == 0) {
+                m_bits = next();
+                m_nbits = 64;
+            }
+            bool b = m_bits & 1u;
+            m_bits >>= 1;
+            m_nbits--;
+            return b;
+        }
+
+    private:
+
+        static constexpr size_t BATCH_SIZE = 64;
+
+        void refill()
+        {
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+                m_batch[i] = m_gen();
+            m_pos = 0;
+        }
+
+        std::mt19937_64&    m_gen;
+        uint64_t            m_batch[BATCH_SIZE];
+        size_t              m_pos;
+        uint64_t            m_bits;
+        unsigned            m_nbits;
+};
+
+/**
+ * \brief Swaps two elements whose size is known at compile time, this
+ *        compiles to a few register moves.
+ */
+template<size_t N>
+struct FixedSwap {
+
+    size_t size() const
+    {
+        return N;
+    }
+
+    void operator()(char* a, char* b) const
+    {
+        unsigned char temp[N];
+        std::memcpy(temp, a, N);
+        std::memcpy(a, b, N);
+        std::memcpy(b, temp, N);
+    }
+};
+
+/**
+ * \brief Swaps two elements of arbitrary size via a small buffer on the
+ *        stack.
+ */
+struct GenericSwap {
+
+    explicit GenericSwap(size_t size)
+        : m_size(size)
+    {
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    void operator()(char* a, char* b) const
+    {
+        unsigned char temp[64];
+        size_t todo = m_size;
+        while (todo) {
+            size_t n = todo < sizeof(temp) ? todo : sizeof(temp);
+            std::memcpy(temp, a, n);
+            std::memcpy(a, b, n);
+            std::memcpy(b, temp, n);
+            a += n;
+            b += n;
+            todo -= n;
+        }
+    }
+
+    size_t m_size;
+};
+
+/**
+ * \brief A plain Fisher-Yates shuffle of the elements in [first, last).
+ */
+template<class Swap>
+void fisher_yates(char* base, size_t first, size_t last, BatchedRandom& rand,
+                  const Swap& swap)
+{
+    const size_t sz = swap.size();
+    for (size_t i = first; i + 1 < last; i++) {
+        size_t j = i + static_cast<size_t>(rand.bounded(last - i));
+        if (j != i)
+            swap(base + i * sz, base + j * sz);
+    }
+}
+
+/**
+ * \brief Merges two shuffled ranges [start, mid) and [mid, end) into one
+ *        shuffled range.
+ */
+template<class Swap>
+void merge(char* base, size_t start, size_t mid, size_t end,
+           BatchedRandom& rand, const Swap& swap)
+{
+    const size_t sz = swap.size();
+    size_t i = start, j = mid;
+
+    for (;;) {
+        if (rand.bit()) {
+            if (j == end)
+                break;
+            swap(base + i * sz, base + j * sz);
+            j++;
+        }
+        else if (i == j) {
+            break;
+        }
+        i++;
+    }
+
+    // One of both ranges is exhausted, insert the remainder.
+    for (; i < end; i++) {
+        size_t m = start + static_cast<size_t>(rand.bounded(i - start + 1));
+        if (m != i)
+            swap(base + i * sz, base + m * sz);
+    }
+}
+
+/**
+ * \brief Run task(k) for k in [0, ntasks), with multiple threads when
+ *        possible.
+ *
+ * The tasks must be independent of each other, if no threads can be started
+ * the remaining tasks are run on the calling thread.
+ */
+template<class Task>
+void run_tasks(size_t ntasks, const Task& task)
+{
+    size_t nthreads = std::thread::hardware_concurrency();
+    if (nthreads > ntasks)
+        nthreads = ntasks;
+
+    std::vector<std::thread> threads;
+    size_t started = 0;
+
+    if (nthreads > 1) {
+        try {
+            threads.reserve(nthreads - 1);
+            for (size_t t = 1; t < nthreads; t++) {
+                threads.emplace_back([&task, t, nthreads, ntasks]() {
+                    for (size_t k = t; k < ntasks; k += nthreads)
+                        task(k);
+                });
+                started = t;
+            }
+        } catch (...) {
+            // Fall through, the remaining work is done below.
+        }
+    }
+
+    // The calling thread does its own share and the share of threads that
+    // could not be started.
+    for (size_t k = 0; k < ntasks; k++) {
+        size_t owner = nthreads > 1 ? k % nthreads : 0;
+        if (owner == 0 || owner > started)
+            task(k);
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+/**
+ * \brief Below this number of elements per block a range is shuffled on the
+ *        calling thread with a single Fisher-Yates pass.
+ */
+constexpr size_t SHUFFLE_BLOCK_SIZE = size_t(1) << 16;
+
+/**
+ * \brief The maximum number of blocks a large range is divided into.
+ */
+constexpr size_t SHUFFLE_MAX_BLOCKS = 64;
+
+template<class Swap>
+void shuffle(char* base, size_t n, std::mt19937_64& gen, const Swap& swap)
+{
+    if (n < 2 * SHUFFLE_BLOCK_SIZE) {
+        BatchedRandom rand(gen);
+        fisher_yates(base, 0, n, rand, swap);
+        return;
+    }
+
+    // The number of blocks only depends on n, not on the machine.
+    size_t nblocks = 2;
+    while (nblocks < SHUFFLE_MAX_BLOCKS && n / (nblocks * 2) >= SHUFFLE_BLOCK_SIZE)
+        nblocks *= 2;
+
+    const size_t block = n / nblocks;
+    auto boundary = [block, nblocks, n](size_t k) {
+        return k == nblocks ? n : k * block;
+    };
+
+    // nblocks seeds for the blocks and nblocks - 1 for the merges.
+    std::vector<uint64_t> seeds(2 * nblocks - 1);
+    for (auto& seed : seeds)
+        seed = gen();
+
+    run_tasks(nblocks, [&](size_t k) {
+        std::mt19937_64 local(seeds[k]);
+        BatchedRandom rand(local);
+        fisher_yates(base, boundary(k), boundary(k + 1), rand, swap);
+    });
+
+    size_t seed_index = nblocks;
+    for (size_t width = 1; width < nblocks; width *= 2) {
+        const size_t nmerges = nblocks / (2 * width);
+        const size_t first_seed = seed_index;
+        run_tasks(nmerges, [&](size_t k) {
+            std::mt19937_64 local(seeds[first_seed + k]);
+            BatchedRandom rand(local);
+            size_t start = boundary(2 * k * width);
+            size_t mid   = boundary((2 * k + 1) * width);
+            size_t end   = boundary((2 * k + 2) * width);
+            merge(base, start, mid, end, rand, swap);
+        });
+        seed_index += nmerges;
+    }
+}
+
+/**
+ * \brief shuffle n elements of size elem_size starting at base.
+ */
+inline void
+shuffle_bytes(void* elements, size_t n, size_t elem_size, std::mt19937_64& gen)
+{
+    char* base = static_cast<char*>(elements);
+
+    switch (elem_size) {
+        case 1:
+            shuffle(base, n, gen, FixedSwap<1>());
+            break;
+        case 2:
+            shuffle(base, n, gen, FixedSwap<2>());
+            break;
+        case 4:
+            shuffle(base, n, gen, FixedSwap<4>());
+            break;
+        case 8:
+            shuffle(base, n, gen, FixedSwap<8>());
+            break;
+        case 16:
+            shuffle(base, n, gen, FixedSwap<16>());
+            break;
+        default:
+            shuffle(base, n, gen, GenericSwap(elem_size));
+    }
+}
+
+} // namespace see
+
+#endif //ifndef SEE_SHUFFLE_HPP
@@ -0,0 +1,273 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file ThreadPool.hpp
+ * \brief Provides the private work stealing thread pool.
+ * \private
+ */
+
+#ifndef SEE_THREAD_POOL_HPP
+#define SEE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace see {
+
+/**
+ * \brief A pool of threads that each have their own queue with tasks.
+ *
+ * Tasks that are submitted from a worker are pushed on the back of the
+ * queue of that worker, other tasks are distributed round robin. A worker
+ * takes tasks from the back of its own queue and when that is empty, it
+ * steals from the front of the queues of the other workers.
+ */
+class ThreadPool {
+
+    public:
+
+        using Task = std::function<void()>;
+
+        /**
+         * \brief Start num_threads workers, 0 means one per core. When
+         *        threads cannot be started, the pool has fewer workers.
+         */
+        explicit ThreadPool(size_t num_threads)
+        {
+            if (num_threads == 0)
+                num_threads = std::thread::hardware_concurrency();
+            if (num_threads == 0)
+                num_threads = 1;
+
+            for (size_t i = 0; i < num_threads; i++)
+                m_queues.emplace_back(new Queue);
+
+            try {
+                m_threads.reserve(num_threads);
+                for (size_t i = 0; i < num_threads; i++)
+                    m_threads.emplace_back(&ThreadPool::worker, this, i);
+            } catch (...) {
+                // Continue with the workers that have been started, they
+                // also empty the queues of the workers that are missing.
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleep_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto& thread : m_threads)
+                thread.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * \brief The number of worker threads.
+         */
+        size_t size() const
+        {
+            return m_threads.size();
+        }
+
+        /**
+         * \brief Queue a task, it will be run by one of the workers.
+         */
+        void submit(Task task)
+        {
+            size_t index;
+            if (tl_pool == this)
+                index = tl_index;
+            else
+                index = m_next_queue.fetch_add(1, std::memory_order_relaxed)
+                    % m_queues.size();
+
+            {
+                Queue& q = *m_queues[index];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                q.tasks.push_back(std::move(task));
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_sleep_mutex);
+                m_pending++;
+            }
+            m_wake.notify_one();
+        }
+
+        /**
+         * \brief Run one queued task on the calling thread.
+         *
+         * @return false when there was no task to run.
+         */
+        bool run_one()
+        {
+            Task task;
+            size_t home = tl_pool == this ? tl_index : 0;
+            if (!take(home, task))
+                return false;
+            task();
+            return true;
+        }
+
+        /**
+         * \brief Call f(k) for k in [0, ntasks) and wait until all calls
+         *        have returned.
+         *
+         * The calling thread runs tasks too while it waits, so this may
+         * also be used from within a task that runs on the pool. f must
+         * not throw.
+         */
+        template<class F>
+        void parallel(size_t ntasks, const F& f)
+        {
+            if (ntasks == 0)
+                return;
+
+            if (ntasks == 1 || m_threads.empty()) {
+                for (size_t k = 0; k < ntasks; k++)
+                    f(k);
+                return;
+            }
+
+            size_t remaining = ntasks;
+            std::mutex done_mutex;
+            std::condition_variable done;
+
+            // remaining is only touched with done_mutex locked, so this frame
+            // stays alive until the last task has released the mutex.
+            auto task = [&](size_t k) {
+                f(k);
+                std::lock_guard<std::mutex> lock(done_mutex);
+                if (--remaining == 0)
+                    done.notify_all();
+            };
+
+            for (size_t k = 1; k < ntasks; k++) {
+                try {
+                    // Small enough for std::function to store it inline.
+                    submit([&task, k]() { task(k); });
+                } catch (...) {
+                    // Out of memory, run the remaining tasks here.
+                    for (; k < ntasks; k++)
+                        task(k);
+                }
+            }
+
+            task(0);
+
+            for (;;) {
+                {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    if (remaining == 0)
+                        return;
+                }
+                if (run_one())
+                    continue;
+
+                // The last tasks are running on the workers.
+                std::unique_lock<std::mutex> lock(done_mutex);
+                done.wait(lock, [&]() { return remaining == 0; });
+                return;
+            }
+        }
+
+    private:
+
+        struct Queue {
+            std::mutex          mutex;
+            std::deque<Task>    tasks;
+        };
+
+        /**
+         * \brief Take a task from the back of the home queue, or steal one
+         *        from the front of another queue.
+         */
+        bool take(size_t home, Task& task)
+        {
+            const size_t n = m_queues.size();
+            for (size_t i = 0; i < n; i++) {
+                Queue& q = *m_queues[(home + i) % n];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (q.tasks.empty())
+                    continue;
+
+                if (i == 0) {
+                    task = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                }
+                else {
+                    task = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                }
+
+                std::lock_guard<std::mutex> sleep_lock(m_sleep_mutex);
+                m_pending--;
+                return true;
+            }
+            return false;
+        }
+
+        void worker(size_t index)
+        {
+            tl_pool  = this;
+            tl_index = index;
+
+            for (;;) {
+                Task task;
+                if (take(index, task)) {
+                    task();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_sleep_mutex);
+                m_wake.wait(lock, [this]() {
+                    return m_stop || m_pending > 0;
+                });
+                if (m_stop && m_pending <= 0)
+                    return;
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread>            m_threads;
+
+        std::mutex                          m_sleep_mutex;
+        std::condition_variable             m_wake;
+        // Tasks that are queued, but not yet taken.
+        long long                           m_pending = 0;
+        bool                                m_stop = false;
+
+        std::atomic<size_t>                 m_next_queue{0};
+
+        static thread_local ThreadPool*     tl_pool;
+        static thread_local size_t          tl_index;
+};
+
+} // namespace see
+
+#endif //ifndef SEE_THREAD_POOL_HPP
@@ -31,6 +31,7 @@
 #include "../TimeoutError.h"
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -269,6 +270,69 @@ posix_serial_write(
     return SEE_SUCCESS;
 }
 
+/*
+ * The number of iovecs and scratch bytes reserved on the stack for
+ * posix_serial_write_msg_v. Messages that need more use write_msg.
+ */
+#define POSIX_SERIAL_MAX_IOV        16
+#define POSIX_SERIAL_SCRATCH_SIZE   512
+
+static int
+posix_serial_write_msg_v(
+    const SeeSerial* self,
+    SeeMsgBuffer* msg,
+    SeeError** error_out
+    )
+{
+    const SeeSerialClass* cls = SEE_SERIAL_CLASS(
+        see_object_get_class(SEE_OBJECT(self))
+    );
+    SeePosixSerial* pself = SEE_POSIX_SERIAL(self);
+    struct iovec    iov_buf[POSIX_SERIAL_MAX_IOV];
+    char            scratch[POSIX_SERIAL_SCRATCH_SIZE];
+    struct iovec*   iov = iov_buf;
+    int             n_iov;
+    size_t          scratch_used;
+    SeeError*       too_small = NULL;
+
+    int ret = see_msg_buffer_to_iovec(
+        msg,
+        iov_buf,
+        POSIX_SERIAL_MAX_IOV,
+        scratch,
+        sizeof(scratch),
+        &n_iov,
+        &scratch_used,
+        &too_small
+        );
+    if (ret) {
+        // The message doesn't fit on the stack, serialize it as a whole.
+        see_object_decref(SEE_OBJECT(too_small));
+        return cls->write_msg(self, msg, error_out);
+    }
+
+    while (n_iov) {
+        ssize_t nwritten = writev(pself->fd, iov, n_iov);
+        if (nwritten < 0) {
+            see_runtime_error_new(error_out, errno);
+            return SEE_ERROR_RUNTIME;
+        }
+
+        // Skip what has been written and continue with the rest.
+        while (n_iov && (size_t) nwritten >= iov->iov_len) {
+            nwritten -= iov->iov_len;
+            iov++;
+            n_iov--;
+        }
+        if (n_iov) {
+            iov->iov_base = (char*) iov->iov_base + nwritten;
+            iov->iov_len -= nwritten;
+        }
+    }
+
+    return SEE_SUCCESS;
+}
+
 static int
 posix_serial_read(
     const SeeSerial* self,
@@ -605,6 +669,7 @@ static int see_posix_serial_class_init(SeeObjectClass* new_cls)
     serial_cls->set_min_rd_chars = posix_serial_set_min_rd_chars;
     serial_cls->get_min_rd_chars = posix_serial_get_min_rd_chars;
     serial_cls->fd          = posix_serial_fd;
+    serial_cls->write_msg_v = posix_serial_write_msg_v;
 
     /* Set the function pointers of the own class here */
     SeePosixSerialClass* cls = (SeePosixSerialClass*) new_cls;
@@ -56,6 +56,18 @@ typedef void (*see_free_func)(void* free_me);
  */
 typedef int (*see_init_func)(void* element, size_t num_bytes, void* data);
 
+/**
+ * \brief A function that determines the order of two elements.
+ *
+ * @param [in] a    The first element.
+ * @param [in] b    The second element.
+ * @param [in] data User data that is passed along with the function.
+ *
+ * @return a negative value when a should be ordered before b, a positive
+ *         value when a should be ordered after b and 0 when they are equal.
+ */
+typedef int (*see_compare_func)(const void* a, const void* b, void* data);
+
 /**
  * @brief Copy a seeobject by copying the pointer and increasing the reference
  *        count.
@@ -24,20 +24,32 @@
 #include "see_object_config.h"
 #include "MetaClass.h"
 #include "see_init.h"
+#include "BitArray.h"
+#include "ByteOrderKernels.h"
 #include "Clock.h"
+#include "ColumnTable.h"
+#include "ConcurrentArray.h"
+#include "ConcurrentStack.h"
 #include "CopyError.h"
+#include "Crc32c.h"
 #include "Duration.h"
 #include "DynamicArray.h"
+#include "DynamicArrayKernels.h"
 #include "Error.h"
 #include "atomic_operations.h"
 #include "IndexError.h"
 #include "RuntimeError.h"
 #include "TimePoint.h"
 #include "MsgBuffer.h"
+#include "MsgDecoder.h"
+#include "ObjectQueue.h"
 #include "OverflowError.h"
+#include "PriorityQueue.h"
 #include "Random.h"
+#include "RingBuffer.h"
 #include "Serial.h"
 #include "Stack.h"
+#include "ThreadPool.h"
 #include "TimeoutError.h"
 #include "IncomparableError.h"
 
@@ -87,14 +99,38 @@ initialize() {
         return ret;
 
     // Initialize the other objects.
+    ret = see_bit_array_init();
+    if (ret)
+        return ret;
+
+    ret = see_byte_order_kernels_init();
+    if (ret)
+        return ret;
+
     ret = see_clock_init();
     if (ret)
         return ret;
 
+    ret = see_column_table_init();
+    if (ret)
+        return ret;
+
+    ret = see_concurrent_array_init();
+    if (ret)
+        return ret;
+
+    ret = see_concurrent_stack_init();
+    if (ret)
+        return ret;
+
     ret = see_copy_error_init();
     if (ret)
         return ret;
 
+    ret = see_crc32c_init();
+    if (ret)
+        return ret;
+
     ret = see_duration_init();
     if (ret)
         return ret;
@@ -103,6 +139,10 @@ initialize() {
     if (ret)
         return ret;
 
+    ret = see_dynamic_array_kernels_init();
+    if (ret)
+        return ret;
+
     ret = see_error_init();
     if (ret)
         return ret;
@@ -119,6 +159,10 @@ initialize() {
     if (ret)
         return ret;
 
+    ret = see_msg_decoder_init();
+    if (ret)
+        return ret;
+
     ret = see_msg_invalid_error_init();
     if (ret)
         return ret;
@@ -131,14 +175,26 @@ initialize() {
     if (ret)
         return ret;
 
+    ret = see_object_queue_init();
+    if (ret)
+        return ret;
+
     ret = see_overflow_error_init();
     if (ret)
         return ret;
 
+    ret = see_priority_queue_init();
+    if (ret)
+        return ret;
+
     ret = see_random_init();
     if (ret)
         return ret;
 
+    ret = see_ring_buffer_init();
+    if (ret)
+        return ret;
+
     ret = see_runtime_error_init();
     if (ret)
         return ret;
@@ -151,6 +207,10 @@ initialize() {
     if (ret)
         return ret;
 
+    ret = see_thread_pool_init();
+    if (ret)
+        return ret;
+
     ret = see_timeout_error_init();
     if (ret)
         return ret;
@@ -176,7 +236,11 @@ initialize() {
 static void
 deinit()
 {
+    see_bit_array_deinit();
     see_clock_deinit();
+    see_column_table_deinit();
+    see_concurrent_array_deinit();
+    see_concurrent_stack_deinit();
     see_copy_error_deinit();
     see_duration_deinit();
     see_dynamic_array_deinit();
@@ -184,14 +248,19 @@ deinit()
     see_incomparable_error_deinit();
     see_index_error_deinit();
     see_msg_buffer_deinit();
+    see_msg_decoder_deinit();
     see_msg_invalid_error_deinit();
     see_msg_part_deinit();
     see_msg_part_type_error_deinit();
+    see_object_queue_deinit();
     see_overflow_error_deinit();
+    see_priority_queue_deinit();
     see_random_deinit();
+    see_ring_buffer_deinit();
     see_runtime_error_deinit();
     see_serial_deinit();
     see_stack_deinit();
+    see_thread_pool_deinit();
     see_timeout_error_deinit();
     see_time_point_deinit();
 
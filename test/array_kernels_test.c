@@ -0,0 +1,398 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "test_macros.h"
+#include "../src/DynamicArrayKernels.h"
+#include "../src/IndexError.h"
+
+static const char* SUITE_NAME = "SeeDynamicArray kernels";
+
+// Not a multiple of any vector width, so the scalar tails are tested too.
+#define NELEM 1003
+
+/*
+ * The values repeat with a period of 97, the minimum -48 is found first at
+ * index 0 and the maximum 48 at index 96.
+ */
+static int32_t
+test_value(size_t i)
+{
+    return (int32_t) (i % 97) - 48;
+}
+
+static int
+make_array(SeeDynamicArray** out, size_t elem_size, SeeError** error)
+{
+    int ret = see_dynamic_array_new_capacity(
+        out, elem_size, NULL, NULL, NULL, NELEM, error
+        );
+
+    for (size_t i = 0; i < NELEM && !ret; i++) {
+        int32_t v32 = test_value(i);
+        int64_t v64 = (int64_t) v32 * 1000000000LL;
+        const void* elem = elem_size == sizeof(int32_t) ?
+            (const void*) &v32 : (const void*) &v64;
+        ret = see_dynamic_array_add(*out, elem, error);
+    }
+    return ret;
+}
+
+static int
+fill_float(SeeDynamicArray** out, SeeError** error)
+{
+    int ret = see_dynamic_array_new(out, sizeof(float), NULL, NULL, NULL, error);
+    for (size_t i = 0; i < NELEM && !ret; i++) {
+        float v = (float) test_value(i) * 0.5f;
+        ret = see_dynamic_array_add(*out, &v, error);
+    }
+    return ret;
+}
+
+static int
+fill_double(SeeDynamicArray** out, SeeError** error)
+{
+    int ret = see_dynamic_array_new(out, sizeof(double), NULL, NULL, NULL, error);
+    for (size_t i = 0; i < NELEM && !ret; i++) {
+        double v = test_value(i) * 0.25;
+        ret = see_dynamic_array_add(*out, &v, error);
+    }
+    return ret;
+}
+
+static void
+check_int32(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    int64_t sum, expected = 0;
+    int32_t lo, hi;
+    size_t index, count, expected_count = 0;
+
+    int ret = make_array(&array, sizeof(int32_t), &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (size_t i = 0; i < NELEM; i++) {
+        expected += test_value(i);
+        expected_count += test_value(i) == 7;
+    }
+
+    ret = see_dynamic_array_sum_int32(array, &sum, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(sum, expected);
+
+    ret = see_dynamic_array_minmax_int32(array, &lo, &hi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(lo, -48);
+    CU_ASSERT_EQUAL(hi, 48);
+
+    ret = see_dynamic_array_argmin_int32(array, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 0);
+    ret = see_dynamic_array_argmax_int32(array, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 96);
+
+    ret = see_dynamic_array_count_int32(array, 7, &count, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(count, expected_count);
+
+    ret = see_dynamic_array_find_int32(array, 7, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 55);
+    ret = see_dynamic_array_find_int32(array, 1000, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, NELEM);
+
+    // The last element is only visited by the scalar tail.
+    int32_t last = 12345;
+    ret = see_dynamic_array_set(array, NELEM - 1, &last, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_argmax_int32(array, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, NELEM - 1);
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+check_int64(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    int64_t sum, expected = 0, lo, hi;
+    size_t index, count, expected_count = 0;
+
+    int ret = make_array(&array, sizeof(int64_t), &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (size_t i = 0; i < NELEM; i++) {
+        expected += test_value(i) * 1000000000LL;
+        expected_count += test_value(i) == -3;
+    }
+
+    ret = see_dynamic_array_sum_int64(array, &sum, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(sum, expected);
+
+    ret = see_dynamic_array_minmax_int64(array, &lo, &hi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(lo, -48000000000LL);
+    CU_ASSERT_EQUAL(hi, 48000000000LL);
+
+    ret = see_dynamic_array_argmax_int64(array, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 96);
+
+    ret = see_dynamic_array_count_int64(array, -3000000000LL, &count, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(count, expected_count);
+
+    // Only the lower 32 bits are equal, this mustn't match.
+    ret = see_dynamic_array_find_int64(
+        array, -3000000000LL + (1LL << 32), &index, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, NELEM);
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+check_floating_point(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* floats = NULL;
+    SeeDynamicArray* doubles= NULL;
+    double sum, expected_f = 0, expected_d = 0;
+    float flo, fhi;
+    double dlo, dhi;
+    size_t index, count, expected_count = 0;
+
+    int ret = fill_float(&floats, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = fill_double(&doubles, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (size_t i = 0; i < NELEM; i++) {
+        expected_f += test_value(i) * 0.5;
+        expected_d += test_value(i) * 0.25;
+        expected_count += test_value(i) == 0;
+    }
+
+    ret = see_dynamic_array_sum_float(floats, &sum, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(sum, expected_f, 1e-9);
+    ret = see_dynamic_array_sum_double(doubles, &sum, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(sum, expected_d, 1e-9);
+
+    ret = see_dynamic_array_minmax_float(floats, &flo, &fhi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(flo, -24.0, 0);
+    CU_ASSERT_DOUBLE_EQUAL(fhi, 24.0, 0);
+    ret = see_dynamic_array_minmax_double(doubles, &dlo, &dhi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(dlo, -12.0, 0);
+    CU_ASSERT_DOUBLE_EQUAL(dhi, 12.0, 0);
+
+    ret = see_dynamic_array_argmin_float(floats, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 0);
+    ret = see_dynamic_array_argmax_double(doubles, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 96);
+
+    ret = see_dynamic_array_count_float(floats, 0.0f, &count, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(count, expected_count);
+    ret = see_dynamic_array_find_double(doubles, 0.25, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 49);
+
+fail:
+    SEE_OBJECT_DECREF(floats);
+    SEE_OBJECT_DECREF(doubles);
+    SEE_OBJECT_DECREF(error);
+}
+
+/*
+ * NaN's are skipped by every table, also at the start, inside a vector and
+ * in the scalar tail.
+ */
+static void
+check_nan(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* floats = NULL;
+    SeeDynamicArray* doubles= NULL;
+    float flo, fhi;
+    double dlo, dhi;
+    size_t index;
+
+    int ret = fill_float(&floats, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = fill_double(&doubles, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // The minimum at 0 and the maximum at 96 are replaced by NaN.
+    float fnan = NAN;
+    double dnan = NAN;
+    size_t nans[] = {0, 1, 96, 500, NELEM - 1};
+    for (size_t i = 0; i < sizeof(nans) / sizeof(nans[0]); i++) {
+        ret = see_dynamic_array_set(floats, nans[i], &fnan, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        ret = see_dynamic_array_set(doubles, nans[i], &dnan, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_minmax_float(floats, &flo, &fhi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(flo, -24.0, 0);
+    CU_ASSERT_DOUBLE_EQUAL(fhi, 24.0, 0);
+    ret = see_dynamic_array_minmax_double(doubles, &dlo, &dhi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(dlo, -12.0, 0);
+    CU_ASSERT_DOUBLE_EQUAL(dhi, 12.0, 0);
+
+    ret = see_dynamic_array_argmin_float(floats, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 97);
+    ret = see_dynamic_array_argmax_float(floats, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 193);
+    ret = see_dynamic_array_argmin_double(doubles, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 97);
+    ret = see_dynamic_array_argmax_double(doubles, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 193);
+
+    // Without any number there is no index to return.
+    for (size_t i = 0; i < NELEM; i++) {
+        ret = see_dynamic_array_set(doubles, i, &dnan, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    ret = see_dynamic_array_minmax_double(doubles, &dlo, &dhi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(isnan(dlo) && isnan(dhi));
+    ret = see_dynamic_array_argmax_double(doubles, &index, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+
+fail:
+    SEE_OBJECT_DECREF(floats);
+    SEE_OBJECT_DECREF(doubles);
+    SEE_OBJECT_DECREF(error);
+}
+
+/*
+ * Only the best kernels are selected at start up, so force every table
+ * that runs on this cpu in turn.
+ */
+static void
+for_each_isa(void (*check)(void))
+{
+    const char* isas[] = {"scalar", "sse2", "avx2", "neon"};
+    int tested = 0;
+
+    for (size_t i = 0; i < sizeof(isas) / sizeof(isas[0]); i++) {
+        if (see_dynamic_array_kernels_select(isas[i]) != SEE_SUCCESS)
+            continue;
+        CU_ASSERT_STRING_EQUAL(see_dynamic_array_kernels_isa(), isas[i]);
+        check();
+        tested++;
+    }
+    see_dynamic_array_kernels_init();
+
+    CU_ASSERT_TRUE(tested >= 1);
+}
+
+static void
+kernels_int32(void)
+{
+    for_each_isa(check_int32);
+}
+
+static void
+kernels_int64(void)
+{
+    for_each_isa(check_int64);
+}
+
+static void
+kernels_floating_point(void)
+{
+    for_each_isa(check_floating_point);
+}
+
+static void
+kernels_nan(void)
+{
+    for_each_isa(check_nan);
+}
+
+static void
+kernels_errors(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    int64_t sum;
+    int32_t lo, hi;
+
+    int ret = see_dynamic_array_new(
+        &array, sizeof(int32_t), NULL, NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_dynamic_array_sum_int32(array, &sum, &error);
+    CU_ASSERT_EQUAL(ret, SEE_SUCCESS);
+    CU_ASSERT_EQUAL(sum, 0);
+
+    ret = see_dynamic_array_sum_int64(array, &sum, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+    ret = see_dynamic_array_minmax_int32(array, &lo, &hi, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_PTR_NOT_NULL(error);
+
+    CU_ASSERT_PTR_NOT_NULL(see_dynamic_array_kernels_isa());
+    CU_ASSERT_EQUAL(
+        see_dynamic_array_kernels_select("no such isa"), SEE_INVALID_ARGUMENT
+        );
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_array_kernels_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(kernels_int32);
+    SEE_UNIT_TEST_CREATE(kernels_int64);
+    SEE_UNIT_TEST_CREATE(kernels_floating_point);
+    SEE_UNIT_TEST_CREATE(kernels_nan);
+    SEE_UNIT_TEST_CREATE(kernels_errors);
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include "test_macros.h"
+#include "../src/DynamicArraySort.h"
+#include "../src/Duration.h"
+
+static const char* SUITE_NAME = "SeeDynamicArray sort";
+
+#define NELEM 5000
+
+typedef struct keyed {
+    int32_t key;
+    int32_t pos;
+} keyed;
+
+static int
+compare_int32(const void* a, const void* b, void* data)
+{
+    (void) data;
+    int32_t x = *(const int32_t*) a, y = *(const int32_t*) b;
+    return (x > y) - (x < y);
+}
+
+static int
+compare_keyed(const void* a, const void* b, void* data)
+{
+    (void) data;
+    const keyed* x = a;
+    const keyed* y = b;
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+// A deterministic sequence with many duplicates and negative values.
+static int32_t
+test_value(size_t i)
+{
+    return (int32_t) ((i * 7919) % 1009) - 500;
+}
+
+static void
+array_sort_comparator(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    SeeDynamicArray* keys   = NULL;
+
+    int ret = see_dynamic_array_new(
+        &array, sizeof(int32_t), NULL, NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_new(&keys, sizeof(keyed), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (size_t i = 0; i < NELEM; i++) {
+        int32_t v = test_value(i);
+        keyed k = {v % 10, (int32_t) i};
+        ret = see_dynamic_array_add(array, &v, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        ret = see_dynamic_array_add(keys, &k, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_sort(array, compare_int32, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const int32_t* values = see_dynamic_array_data(array);
+    for (size_t i = 1; i < NELEM; i++)
+        CU_ASSERT_FATAL(values[i - 1] <= values[i]);
+
+    // Sorting sorted input must work too.
+    ret = see_dynamic_array_sort(array, compare_int32, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    for (size_t i = 1; i < NELEM; i++)
+        CU_ASSERT_FATAL(values[i - 1] <= values[i]);
+
+    ret = see_dynamic_array_stable_sort(keys, compare_keyed, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const keyed* k = see_dynamic_array_data(keys);
+    for (size_t i = 1; i < NELEM; i++) {
+        CU_ASSERT_FATAL(k[i - 1].key <= k[i].key);
+        if (k[i - 1].key == k[i].key)
+            CU_ASSERT_FATAL(k[i - 1].pos < k[i].pos);
+    }
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(keys);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+array_sort_radix(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* i32    = NULL;
+    SeeDynamicArray* u64    = NULL;
+    SeeDynamicArray* small  = NULL;
+
+    int ret = see_dynamic_array_new(&i32, sizeof(int32_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_new(&u64, sizeof(uint64_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_new(&small, sizeof(int64_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (size_t i = 0; i < NELEM; i++) {
+        int32_t v = test_value(i) * 100000;
+        uint64_t u = (uint64_t) (i * 2654435761u) << 20;
+        ret = see_dynamic_array_add(i32, &v, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        ret = see_dynamic_array_add(u64, &u, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    for (int64_t i = 0; i < 10; i++) {
+        int64_t v = (i % 2 ? -1 : 1) * (i << 40);
+        ret = see_dynamic_array_add(small, &v, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_sort_int32(i32, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const int32_t* v32 = see_dynamic_array_data(i32);
+    CU_ASSERT_EQUAL(v32[0], -500 * 100000);
+    for (size_t i = 1; i < NELEM; i++)
+        CU_ASSERT_FATAL(v32[i - 1] <= v32[i]);
+
+    ret = see_dynamic_array_sort_uint64(u64, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const uint64_t* v64 = see_dynamic_array_data(u64);
+    for (size_t i = 1; i < NELEM; i++)
+        CU_ASSERT_FATAL(v64[i - 1] <= v64[i]);
+
+    ret = see_dynamic_array_sort_int64(small, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const int64_t* s64 = see_dynamic_array_data(small);
+    CU_ASSERT_EQUAL(s64[0], -(9LL << 40));
+    CU_ASSERT_EQUAL(s64[9], 8LL << 40);
+    for (size_t i = 1; i < 10; i++)
+        CU_ASSERT_FATAL(s64[i - 1] <= s64[i]);
+
+    ret = see_dynamic_array_sort_int64(i32, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+fail:
+    SEE_OBJECT_DECREF(i32);
+    SEE_OBJECT_DECREF(u64);
+    SEE_OBJECT_DECREF(small);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+array_sort_search_merge(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* a      = NULL;
+    SeeDynamicArray* b      = NULL;
+    SeeDynamicArray* merged = NULL;
+    const int32_t va[] = {1, 3, 3, 3, 7, 9};
+    const int32_t vb[] = {0, 3, 8, 10};
+    int32_t value;
+    size_t lo, hi;
+
+    int ret = see_dynamic_array_new(&a, sizeof(int32_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_new(&b, sizeof(int32_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_insert(a, 0, va, 6, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_insert(b, 0, vb, 4, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    value = 3;
+    ret = see_dynamic_array_lower_bound(a, &value, compare_int32, NULL, &lo, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_upper_bound(a, &value, compare_int32, NULL, &hi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(lo, 1);
+    CU_ASSERT_EQUAL(hi, 4);
+
+    value = 100;
+    ret = see_dynamic_array_lower_bound(a, &value, compare_int32, NULL, &lo, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(lo, 6);
+    value = -100;
+    ret = see_dynamic_array_upper_bound(a, &value, compare_int32, NULL, &hi, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(hi, 0);
+
+    ret = see_dynamic_array_merge(&merged, a, b, compare_int32, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_size(merged), 10);
+    const int32_t expected[] = {0, 1, 3, 3, 3, 3, 7, 8, 9, 10};
+    const int32_t* m = see_dynamic_array_data(merged);
+    for (size_t i = 0; i < 10; i++)
+        CU_ASSERT_EQUAL(m[i], expected[i]);
+
+fail:
+    SEE_OBJECT_DECREF(a);
+    SEE_OBJECT_DECREF(b);
+    SEE_OBJECT_DECREF(merged);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+array_sort_objects(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    SeeObject* plain        = NULL;
+    const int64_t ms[]      = {30, -5, 12, 0, 7};
+
+    int ret = see_dynamic_array_new(
+        &array,
+        sizeof(SeeDuration*),
+        see_copy_by_ref,
+        NULL,
+        see_free_see_object,
+        &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (size_t i = 0; i < sizeof(ms) / sizeof(ms[0]); i++) {
+        SeeDuration* dur = NULL;
+        ret = see_duration_new_ms(&dur, ms[i], &error);
+        SEE_UNIT_HANDLE_ERROR();
+        ret = see_dynamic_array_add(array, &dur, &error);
+        SEE_OBJECT_DECREF(dur);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_sort_objects(array, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    SeeDuration** durs = see_dynamic_array_data(array);
+    CU_ASSERT_DOUBLE_EQUAL(see_duration_seconds_f(durs[0]), -0.005, 1e-9);
+    CU_ASSERT_DOUBLE_EQUAL(see_duration_seconds_f(durs[4]), 0.030, 1e-9);
+
+    // A plain SeeObject doesn't implement compare.
+    ret = see_object_new(&plain);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_add(array, &plain, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_dynamic_array_sort_objects(array, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INCOMPARABLE);
+    CU_ASSERT_PTR_NOT_NULL(error);
+    CU_ASSERT_EQUAL(see_dynamic_array_size(array), 6);
+
+fail:
+    SEE_OBJECT_DECREF(plain);
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_array_sort_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(array_sort_comparator);
+    SEE_UNIT_TEST_CREATE(array_sort_radix);
+    SEE_UNIT_TEST_CREATE(array_sort_search_merge);
+    SEE_UNIT_TEST_CREATE(array_sort_objects);
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include "test_macros.h"
+#include "../src/BitArray.h"
+
+static const char* SUITE_NAME = "SeeBitArray";
+
+#define NBITS 1000
+
+static void
+bit_array_bits(void)
+{
+    SeeError* error     = NULL;
+    SeeBitArray* bits   = NULL;
+    int value;
+    size_t index, count;
+
+    int ret = see_bit_array_new(&bits, NBITS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_size(bits), NBITS);
+    CU_ASSERT_EQUAL(see_bit_array_count(bits), 0);
+
+    // Every third bit.
+    for (size_t i = 0; i < NBITS; i += 3) {
+        ret = see_bit_array_set(bits, i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT_EQUAL(see_bit_array_count(bits), (NBITS + 2) / 3);
+
+    ret = see_bit_array_test(bits, 999, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(value);
+    ret = see_bit_array_clear(bits, 999, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_test(bits, 999, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_FALSE(value);
+
+    ret = see_bit_array_test(bits, NBITS, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    ret = see_bit_array_find_first_set(bits, 1, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 3);
+    ret = see_bit_array_find_first_set(bits, 997, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, NBITS);
+
+    // Ranges within a word and across words.
+    ret = see_bit_array_set_range(bits, 0, NBITS, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_set_range(bits, 70, 80, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_set_range(bits, 100, 900, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_count(bits), 810);
+
+    ret = see_bit_array_count_range(bits, 75, 150, &count, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(count, 5 + 50);
+    ret = see_bit_array_find_first_set(bits, 80, &index, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(index, 100);
+
+    ret = see_bit_array_count_range(bits, 10, NBITS + 1, &count, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    // Shrinking drops the bits, growing doesn't bring them back.
+    ret = see_bit_array_resize(bits, 150, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_resize(bits, NBITS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_count(bits), 10 + 50);
+
+    for (int i = 0; i < 100; i++) {
+        ret = see_bit_array_push_back(bits, i % 2, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT_EQUAL(see_bit_array_size(bits), NBITS + 100);
+    CU_ASSERT_EQUAL(see_bit_array_count(bits), 10 + 50 + 50);
+
+fail:
+    SEE_OBJECT_DECREF(bits);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+bit_array_combine(void)
+{
+    SeeError* error         = NULL;
+    SeeBitArray* a          = NULL;
+    SeeBitArray* b          = NULL;
+    SeeBitArray* c          = NULL;
+    SeeDynamicArray* bytes  = NULL;
+    SeeDynamicArray* out    = NULL;
+
+    int ret = see_dynamic_array_new(&bytes, 1, NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    for (int i = 0; i < NBITS; i++) {
+        char flag = (char) (i % 2 ? 'x' : 0);
+        ret = see_dynamic_array_add(bytes, &flag, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    // a holds the odd bits, b the first half.
+    ret = see_bit_array_from_bytes(&a, bytes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_count(a), NBITS / 2);
+    ret = see_bit_array_new(&b, NBITS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_set_range(b, 0, NBITS / 2, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_object_copy(SEE_OBJECT(a), SEE_OBJECT_REF(&c), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_and(c, b, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_count(c), NBITS / 4);
+
+    ret = see_bit_array_or(c, b, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_count(c), NBITS / 2);
+
+    ret = see_bit_array_xor(c, a, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_bit_array_count(c), NBITS / 2);
+
+    ret = see_bit_array_to_bytes(a, &out, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_size(out), NBITS);
+    const unsigned char* flags = see_dynamic_array_data(out);
+    for (int i = 0; i < NBITS; i++)
+        CU_ASSERT_EQUAL_FATAL(flags[i], i % 2);
+
+    // The sizes must match.
+    ret = see_bit_array_resize(b, NBITS - 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_bit_array_and(a, b, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+fail:
+    SEE_OBJECT_DECREF(a);
+    SEE_OBJECT_DECREF(b);
+    SEE_OBJECT_DECREF(c);
+    SEE_OBJECT_DECREF(bytes);
+    SEE_OBJECT_DECREF(out);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_bit_array_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(bit_array_bits);
+    SEE_UNIT_TEST_CREATE(bit_array_combine);
+
+    return 0;
+}
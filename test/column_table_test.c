@@ -0,0 +1,189 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include "test_macros.h"
+#include "../src/ColumnTable.h"
+#include "../src/IndexError.h"
+
+static const char* SUITE_NAME = "SeeColumnTable suite";
+
+#define NROWS 1000
+
+enum {
+    COL_TIMESTAMP,
+    COL_CHANNEL,
+    COL_VALUE,
+    NCOLS
+};
+
+static const size_t column_sizes[NCOLS] = {
+    sizeof(int64_t),
+    sizeof(uint16_t),
+    sizeof(double)
+};
+
+static int
+fill_table(SeeColumnTable* table, SeeError** error)
+{
+    int ret = SEE_SUCCESS;
+    for (int i = 0; i < NROWS; i++) {
+        int64_t  ts      = i * 10;
+        uint16_t channel = (uint16_t) (i % 4);
+        double   value   = i * 0.5;
+        const void* row[NCOLS] = {&ts, &channel, &value};
+
+        ret = see_column_table_add_row(table, row, error);
+        if (ret)
+            return ret;
+    }
+    return ret;
+}
+
+static void
+column_table_create(void)
+{
+    SeeError* error         = NULL;
+    SeeColumnTable* table   = NULL;
+    const size_t bad[]      = {sizeof(int), 0};
+
+    int ret = see_column_table_new(&table, 0, column_sizes, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+    ret = see_column_table_new(&table, 2, bad, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+    ret = see_column_table_new(&table, NCOLS, column_sizes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    CU_ASSERT_EQUAL(see_column_table_num_columns(table), NCOLS);
+    CU_ASSERT_EQUAL(see_column_table_num_rows(table), 0);
+
+fail:
+    SEE_OBJECT_DECREF(table);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+column_table_views(void)
+{
+    SeeError* error         = NULL;
+    SeeColumnTable* table   = NULL;
+    SeeDynamicArray* column = NULL;
+    SeeColumnView view;
+    double sum = 0, expected = 0;
+
+    int ret = see_column_table_new(&table, NCOLS, column_sizes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = fill_table(table, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    CU_ASSERT_EQUAL(see_column_table_num_rows(table), NROWS);
+
+    for (size_t c = 0; c < NCOLS; c++) {
+        ret = see_column_table_column_view(table, c, &view, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL(view.size, NROWS);
+        CU_ASSERT_EQUAL(view.element_size, column_sizes[c]);
+        CU_ASSERT_EQUAL(
+            ((uintptr_t) view.data) % SEE_COLUMN_TABLE_ALIGNMENT, 0
+            );
+    }
+
+    ret = see_column_table_column_view(table, COL_VALUE, &view, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const double* values = view.data;
+    for (size_t i = 0; i < view.size; i++) {
+        sum += values[i];
+        expected += i * 0.5;
+    }
+    CU_ASSERT_DOUBLE_EQUAL(sum, expected, 1e-9);
+
+    ret = see_column_table_column(table, COL_CHANNEL, &column, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    uint16_t channel;
+    ret = see_dynamic_array_get(column, 5, &channel, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(channel, 1);
+
+    ret = see_column_table_column_view(table, NCOLS, &view, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_PTR_NOT_NULL(error);
+
+fail:
+    SEE_OBJECT_DECREF(table);
+    SEE_OBJECT_DECREF(error);
+}
+
+static int
+count_channel(const void* element, size_t row, void* data)
+{
+    (void) row;
+    size_t* count = data;
+    if (*((const uint16_t*) element) == 2)
+        (*count)++;
+    return SEE_SUCCESS;
+}
+
+static int
+stop_at_row(const void* element, size_t row, void* data)
+{
+    (void) element;
+    size_t* last = data;
+    *last = row;
+    return row == 10 ? SEE_ERROR_UNEXPECTED : SEE_SUCCESS;
+}
+
+static void
+column_table_foreach(void)
+{
+    SeeError* error         = NULL;
+    SeeColumnTable* table   = NULL;
+    size_t count = 0, last = 0;
+
+    int ret = see_column_table_new(&table, NCOLS, column_sizes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_column_table_reserve(table, NROWS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = fill_table(table, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_column_table_foreach(
+        table, COL_CHANNEL, count_channel, &count, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(count, NROWS / 4);
+
+    ret = see_column_table_foreach(
+        table, COL_TIMESTAMP, stop_at_row, &last, &error
+        );
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_UNEXPECTED);
+    CU_ASSERT_EQUAL(last, 10);
+
+fail:
+    SEE_OBJECT_DECREF(table);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_column_table_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(column_table_create);
+    SEE_UNIT_TEST_CREATE(column_table_views);
+    SEE_UNIT_TEST_CREATE(column_table_foreach);
+
+    return 0;
+}
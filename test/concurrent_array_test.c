@@ -0,0 +1,145 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "test_macros.h"
+#include "../src/ConcurrentArray.h"
+#include "../src/ThreadPool.h"
+
+static const char* SUITE_NAME = "SeeConcurrentArray";
+
+#define NPRODUCERS  4
+#define NEVENTS     20000
+
+typedef struct event {
+    uint32_t producer;
+    uint32_t seq;
+} event;
+
+static int
+produce(size_t index, void* data)
+{
+    SeeConcurrentArray* array = data;
+    SeeError* error = NULL;
+
+    for (uint32_t seq = 0; seq < NEVENTS; seq++) {
+        event ev = {(uint32_t) index, seq};
+        size_t pos;
+        int ret = see_concurrent_array_push_back(array, &ev, &pos, &error);
+        if (ret) {
+            see_object_decref(SEE_OBJECT(error));
+            return ret;
+        }
+        // Our own element is published as soon as push_back returns.
+        if (!see_concurrent_array_at(array, pos))
+            return SEE_ERROR_INDEX;
+    }
+    return SEE_SUCCESS;
+}
+
+static void
+concurrent_array_push_get(void)
+{
+    SeeError* error             = NULL;
+    SeeConcurrentArray* array   = NULL;
+    SeeConcurrentArray* other   = NULL;
+    int32_t value;
+    size_t index = 0;
+
+    int ret = see_concurrent_array_new_capacity(&array, sizeof(int32_t), 3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_concurrent_array_size(array), 0);
+    CU_ASSERT_EQUAL(see_concurrent_array_element_size(array), sizeof(int32_t));
+
+    // Crosses several segment boundaries: 4, 8, 16, ...
+    for (int32_t i = 0; i < 1000; i++) {
+        ret = see_concurrent_array_push_back(array, &i, &index, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL_FATAL(index, (size_t) i);
+    }
+    CU_ASSERT_EQUAL(see_concurrent_array_size(array), 1000);
+
+    for (size_t i = 0; i < 1000; i++) {
+        ret = see_concurrent_array_get(array, i, &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL_FATAL(value, (int32_t) i);
+    }
+
+    ret = see_concurrent_array_get(array, 1000, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_PTR_NOT_NULL(error);
+    CU_ASSERT_PTR_NULL(see_concurrent_array_at(array, 1000));
+
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+    ret = see_concurrent_array_new(&other, 0, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+    CU_ASSERT_PTR_NULL(other);
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+concurrent_array_producers(void)
+{
+    SeeError* error             = NULL;
+    SeeConcurrentArray* array   = NULL;
+    SeeThreadPool* pool         = NULL;
+    SeeDynamicArray* events     = NULL;
+    static uint32_t next[NPRODUCERS];
+
+    int ret = see_concurrent_array_new(&array, sizeof(event), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_thread_pool_new(&pool, NPRODUCERS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_thread_pool_run(pool, NPRODUCERS, produce, array, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_concurrent_array_size(array), NPRODUCERS * NEVENTS);
+
+    ret = see_concurrent_array_to_dynamic_array(array, &events, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_size(events), NPRODUCERS * NEVENTS);
+
+    // Every event is present once and the events of one producer keep
+    // their order.
+    memset(next, 0, sizeof(next));
+    const event* ev = see_dynamic_array_data(events);
+    for (size_t i = 0; i < NPRODUCERS * NEVENTS; i++) {
+        CU_ASSERT_FATAL(ev[i].producer < NPRODUCERS);
+        CU_ASSERT_EQUAL_FATAL(ev[i].seq, next[ev[i].producer]);
+        next[ev[i].producer]++;
+    }
+
+fail:
+    SEE_OBJECT_DECREF(events);
+    SEE_OBJECT_DECREF(pool);
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_concurrent_array_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(concurrent_array_push_get);
+    SEE_UNIT_TEST_CREATE(concurrent_array_producers);
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "test_macros.h"
+#include "../src/ConcurrentStack.h"
+#include "../src/ThreadPool.h"
+
+static const char* SUITE_NAME = "SeeConcurrentStack";
+
+#define NWORKERS    4
+#define NBUFFERS    16
+#define NROUNDS     20000
+
+static int
+borrow_buffers(size_t index, void* data)
+{
+    SeeConcurrentStack* free_list = data;
+    SeeError* error = NULL;
+    (void) index;
+
+    // Take a buffer from the free list and give it back again.
+    for (int round = 0; round < NROUNDS; round++) {
+        int32_t buffer;
+        int popped;
+        int ret = see_concurrent_stack_try_pop(
+            free_list, &buffer, &popped, &error
+            );
+        if (ret)
+            return ret;
+        if (!popped)
+            continue;
+
+        ret = see_concurrent_stack_push(free_list, &buffer, &error);
+        if (ret) {
+            see_object_decref(SEE_OBJECT(error));
+            return ret;
+        }
+    }
+    return SEE_SUCCESS;
+}
+
+static void
+concurrent_stack_push_pop(void)
+{
+    SeeError* error             = NULL;
+    SeeConcurrentStack* stack   = NULL;
+    SeeConcurrentStack* other   = NULL;
+    int32_t values[100];
+    int32_t value;
+    int popped;
+
+    int ret = see_concurrent_stack_new(&stack, sizeof(int32_t), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_concurrent_stack_size(stack), 0);
+    CU_ASSERT_EQUAL(see_concurrent_stack_element_size(stack), sizeof(int32_t));
+
+    ret = see_concurrent_stack_pop(stack, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_PTR_NOT_NULL(error);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    ret = see_concurrent_stack_try_pop(stack, &value, &popped, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_FALSE(popped);
+
+    // Crosses several segments of nodes.
+    for (int32_t i = 0; i < 1000; i++) {
+        ret = see_concurrent_stack_push(stack, &i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT_EQUAL(see_concurrent_stack_size(stack), 1000);
+
+    for (int32_t i = 999; i >= 500; i--) {
+        ret = see_concurrent_stack_pop(stack, &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL_FATAL(value, i);
+    }
+
+    // The last one ends up on top, the popped nodes are reused.
+    for (int32_t i = 0; i < 100; i++)
+        values[i] = 1000 + i;
+    ret = see_concurrent_stack_push_n(stack, values, 100, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_concurrent_stack_size(stack), 600);
+
+    for (int32_t i = 1099; i >= 1000; i--) {
+        ret = see_concurrent_stack_try_pop(stack, &value, &popped, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_TRUE_FATAL(popped);
+        CU_ASSERT_EQUAL_FATAL(value, i);
+    }
+
+    ret = see_concurrent_stack_pop(stack, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_concurrent_stack_pop(stack, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(value, 498);
+
+    ret = see_concurrent_stack_new(&other, 0, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+    CU_ASSERT_PTR_NULL(other);
+
+fail:
+    SEE_OBJECT_DECREF(stack);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+concurrent_stack_free_list(void)
+{
+    SeeError* error             = NULL;
+    SeeConcurrentStack* stack   = NULL;
+    SeeThreadPool* pool         = NULL;
+    int32_t buffers[NBUFFERS];
+    int seen[NBUFFERS];
+    int32_t value;
+
+    int ret = see_concurrent_stack_new(&stack, sizeof(int32_t), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_thread_pool_new(&pool, NWORKERS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int32_t i = 0; i < NBUFFERS; i++)
+        buffers[i] = i;
+    ret = see_concurrent_stack_push_n(stack, buffers, NBUFFERS, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_thread_pool_run(pool, NWORKERS, borrow_buffers, stack, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_concurrent_stack_size(stack), NBUFFERS);
+
+    // No buffer is lost or handed out twice.
+    memset(seen, 0, sizeof(seen));
+    for (int i = 0; i < NBUFFERS; i++) {
+        ret = see_concurrent_stack_pop(stack, &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_FATAL(value >= 0 && value < NBUFFERS);
+        CU_ASSERT_FALSE_FATAL(seen[value]);
+        seen[value] = 1;
+    }
+    CU_ASSERT_EQUAL(see_concurrent_stack_size(stack), 0);
+
+fail:
+    SEE_OBJECT_DECREF(pool);
+    SEE_OBJECT_DECREF(stack);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_concurrent_stack_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(concurrent_stack_push_pop);
+    SEE_UNIT_TEST_CREATE(concurrent_stack_free_list);
+
+    return 0;
+}
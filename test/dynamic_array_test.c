@@ -16,11 +16,15 @@
  */
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "test_macros.h"
 #include "../src/DynamicArray.h"
 #include "../src/IndexError.h"
 #include "../src/RuntimeError.h"
+#include "../src/Random.h"
 
 static const char* SUITE_NAME = "Dynamic array test";
 
@@ -299,6 +303,37 @@ static void array_capacity(void)
     see_object_decref(SEE_OBJECT(array));
 }
 
+static void array_shrink_empty(void)
+{
+    SeeDynamicArray* array = NULL;
+    SeeError*        error = NULL;
+    int value = 42;
+
+    int ret = see_dynamic_array_new_capacity(
+        &array, sizeof(int), NULL, NULL, NULL, 10, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    // Without inline storage, the heap block is released.
+    ret = see_dynamic_array_shrink_to_fit(array, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_capacity(array), 0);
+
+    ret = see_dynamic_array_add(array, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_resize(array, 0, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_shrink_to_fit(array, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_add(array, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(*(const int*) see_dynamic_array_data(array), 42);
+
+fail:
+    SEE_OBJECT_DECREF(error);
+    SEE_OBJECT_DECREF(array);
+}
+
 static void array_insert(void)
 {
     int ret;
@@ -476,6 +511,273 @@ fail:
     SEE_OBJECT_DECREF(array);
 }
 
+/*
+ * Large enough to be shuffled in blocks on multiple threads.
+ */
+#define LARGE_SHUFSIZ (300000)
+
+static int
+fill_and_shuffle(SeeDynamicArray** out, uint64_t seed, SeeError** error)
+{
+    int ret;
+    SeeRandom* rgen = NULL;
+
+    ret = see_random_new(&rgen, error);
+    if (ret)
+        return ret;
+    see_random_seed(rgen, seed);
+
+    ret = see_dynamic_array_new_capacity(
+        out, sizeof(uint32_t), NULL, NULL, NULL, LARGE_SHUFSIZ, error
+        );
+    if (ret)
+        goto fail;
+
+    for (uint32_t i = 0; i < LARGE_SHUFSIZ; i++) {
+        ret = see_dynamic_array_add(*out, &i, error);
+        if (ret)
+            goto fail;
+    }
+
+    ret = see_dynamic_array_shuffle(*out, rgen, error);
+
+fail:
+    see_object_decref(SEE_OBJECT(rgen));
+    return ret;
+}
+
+static void
+array_shuffle_reproducible(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* a      = NULL;
+    SeeDynamicArray* b      = NULL;
+    unsigned char* seen     = NULL;
+    size_t nfixed           = 0;
+    int is_permutation      = 1;
+
+    int ret = fill_and_shuffle(&a, 42, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = fill_and_shuffle(&b, 42, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    const uint32_t* da = see_dynamic_array_data(a);
+    const uint32_t* db = see_dynamic_array_data(b);
+
+    CU_ASSERT_EQUAL(memcmp(da, db, LARGE_SHUFSIZ * sizeof(uint32_t)), 0);
+
+    seen = calloc(LARGE_SHUFSIZ, 1);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(seen);
+    for (size_t i = 0; i < LARGE_SHUFSIZ; i++) {
+        if (da[i] >= LARGE_SHUFSIZ || seen[da[i]]) {
+            is_permutation = 0;
+            break;
+        }
+        seen[da[i]] = 1;
+        if (da[i] == i)
+            nfixed++;
+    }
+    CU_ASSERT_TRUE(is_permutation);
+    // On average one element remains at its position.
+    CU_ASSERT_TRUE(nfixed < 100);
+
+fail:
+    free(seen);
+    SEE_OBJECT_DECREF(error);
+    SEE_OBJECT_DECREF(a);
+    SEE_OBJECT_DECREF(b);
+}
+
+typedef struct {
+    unsigned char bytes[3];
+} three_bytes;
+
+static void
+array_shuffle_odd_size(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    int counts[SHUFSIZ]     = {0};
+
+    int ret = see_dynamic_array_new(
+        &array, sizeof(three_bytes), NULL, NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int i = 0; i < SHUFSIZ; i++) {
+        three_bytes tb = {{i, i, i}};
+        ret = see_dynamic_array_add(array, &tb, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_shuffle_range(array, 2, SHUFSIZ, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    const three_bytes* data = see_dynamic_array_data(array);
+    CU_ASSERT_EQUAL(data[0].bytes[0], 0);
+    CU_ASSERT_EQUAL(data[1].bytes[0], 1);
+    for (int i = 0; i < SHUFSIZ; i++) {
+        CU_ASSERT_EQUAL(data[i].bytes[0], data[i].bytes[2]);
+        counts[data[i].bytes[0] % SHUFSIZ]++;
+    }
+    for (int i = 0; i < SHUFSIZ; i++)
+        CU_ASSERT_EQUAL(counts[i], 1);
+
+    ret = see_dynamic_array_shuffle_range(array, 0, SHUFSIZ + 1, NULL, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+
+fail:
+    SEE_OBJECT_DECREF(error);
+    SEE_OBJECT_DECREF(array);
+}
+
+static void
+array_save_map(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    SeeDynamicArray* mapped = NULL;
+    SeeDynamicArray* copy   = NULL;
+    const char* path        = "see_array_save_map.bin";
+    const size_t n          = 10000;
+    double value            = 3.0;
+
+    int ret = see_dynamic_array_new(
+        &array, sizeof(double), NULL, NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    for (size_t i = 0; i < n; i++) {
+        double v = i * 0.5;
+        ret = see_dynamic_array_add(array, &v, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_save(array, path, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_dynamic_array_map(&mapped, path, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    CU_ASSERT(see_dynamic_array_is_mapped(mapped));
+    CU_ASSERT(!see_dynamic_array_is_mapped(array));
+    CU_ASSERT_EQUAL(see_dynamic_array_size(mapped), n);
+    CU_ASSERT_EQUAL(mapped->element_size, sizeof(double));
+    CU_ASSERT_EQUAL(((uintptr_t) see_dynamic_array_data(mapped)) % 64, 0);
+    CU_ASSERT_EQUAL(
+        memcmp(
+            see_dynamic_array_data(mapped),
+            see_dynamic_array_data(array),
+            n * sizeof(double)
+            ),
+        0
+        );
+
+    ret = see_dynamic_array_get(mapped, n - 1, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(value, (n - 1) * 0.5, 0);
+
+    // A mapped array is read only.
+    ret = see_dynamic_array_add(mapped, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_RUNTIME);
+    CU_ASSERT_PTR_NOT_NULL(error);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+    ret = see_dynamic_array_set(mapped, 0, &value, &error);
+    CU_ASSERT_PTR_NOT_NULL(error);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    // But its copy isn't.
+    ret = see_object_copy(SEE_OBJECT(mapped), SEE_OBJECT_REF(&copy), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT(!see_dynamic_array_is_mapped(copy));
+    ret = see_dynamic_array_add(copy, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_size(copy), n + 1);
+
+    SEE_OBJECT_DECREF(mapped);
+    mapped = NULL;
+
+    // Only arrays of plain data can be saved.
+    SEE_OBJECT_DECREF(array);
+    array = NULL;
+    ret = see_dynamic_array_new(
+        &array, sizeof(SeeObject*), see_copy_by_ref, NULL,
+        see_free_see_object, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_save(array, path, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+    ret = see_dynamic_array_map(&mapped, "does_not_exist.bin", &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_RUNTIME);
+    CU_ASSERT_PTR_NULL(mapped);
+
+fail:
+    remove(path);
+    SEE_OBJECT_DECREF(error);
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(mapped);
+    SEE_OBJECT_DECREF(copy);
+}
+
+static void
+array_inline_storage(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    SeeDynamicArray* copy   = NULL;
+    const size_t inline_cap = 4;
+
+    int ret = see_dynamic_array_new_inline(
+        &array, sizeof(int), NULL, NULL, NULL, inline_cap, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    // The inline storage lives directly behind the array.
+    const char* inline_data = see_dynamic_array_data(array);
+    CU_ASSERT_PTR_NOT_NULL(inline_data);
+    CU_ASSERT(inline_data >= (const char*) array + sizeof(SeeDynamicArray));
+    CU_ASSERT_EQUAL(see_dynamic_array_capacity(array), inline_cap);
+
+    for (int i = 0; i < (int) inline_cap; i++) {
+        ret = see_dynamic_array_add(array, &i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT_PTR_EQUAL(see_dynamic_array_data(array), inline_data);
+    CU_ASSERT_EQUAL(see_dynamic_array_capacity(array), inline_cap);
+
+    ret = see_object_copy(SEE_OBJECT(array), SEE_OBJECT_REF(&copy), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_capacity(copy), inline_cap);
+
+    // Spill to the heap.
+    for (int i = inline_cap; i < 10; i++) {
+        ret = see_dynamic_array_add(array, &i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT(see_dynamic_array_data(array) != (void*) inline_data);
+    const int* values = see_dynamic_array_data(array);
+    for (int i = 0; i < 10; i++)
+        CU_ASSERT_EQUAL(values[i], i);
+
+    // And move back.
+    ret = see_dynamic_array_resize(array, 3, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_shrink_to_fit(array, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(see_dynamic_array_data(array), inline_data);
+    CU_ASSERT_EQUAL(see_dynamic_array_capacity(array), inline_cap);
+    values = see_dynamic_array_data(array);
+    for (int i = 0; i < 3; i++)
+        CU_ASSERT_EQUAL(values[i], i);
+
+fail:
+    SEE_OBJECT_DECREF(error);
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(copy);
+}
+
 int add_dynamic_array_suite()
 {
     SEE_UNIT_SUITE_CREATE(NULL, NULL);
@@ -485,9 +787,14 @@ int add_dynamic_array_suite()
     SEE_UNIT_TEST_CREATE(array_add);
     SEE_UNIT_TEST_CREATE(array_set);
     SEE_UNIT_TEST_CREATE(array_capacity);
+    SEE_UNIT_TEST_CREATE(array_shrink_empty);
     SEE_UNIT_TEST_CREATE(array_insert);
     SEE_UNIT_TEST_CREATE(array_exception);
     SEE_UNIT_TEST_CREATE(array_shuffle);
+    SEE_UNIT_TEST_CREATE(array_shuffle_reproducible);
+    SEE_UNIT_TEST_CREATE(array_shuffle_odd_size);
+    SEE_UNIT_TEST_CREATE(array_save_map);
+    SEE_UNIT_TEST_CREATE(array_inline_storage);
 
     return 0;
 }
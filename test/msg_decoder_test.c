@@ -0,0 +1,166 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CUnit/CUnit.h>
+#include <string.h>
+#include "../src/MsgDecoder.h"
+#include "test_macros.h"
+
+static const char* SUITE_NAME = "SeeMsgDecoder suite";
+
+/*
+ * Serializes a message with an id, an int and a string into bytes.
+ */
+static size_t
+make_msg(uint16_t id, const char* str, char* bytes, size_t cap)
+{
+    SeeMsgBuffer* msg = NULL;
+    SeeError* error = NULL;
+    size_t written = 0;
+    int ret;
+
+    ret = see_msg_buffer_new(&msg, id, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int32(msg, id, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(msg, str, strlen(str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_write_into(msg, bytes, cap, &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+fail:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(error));
+    return written;
+}
+
+static void
+msg_decoder_chunks(void)
+{
+    SeeMsgDecoder*  decoder = NULL;
+    SeeMsgBuffer*   msg     = NULL;
+    SeeError*       error   = NULL;
+    char            stream[512];
+    size_t          n = 0, discarded, buffered;
+    uint16_t        ids[3];
+    int             nmsgs = 0, found, ret;
+    int32_t         value;
+
+    // Garbage, a message, a false start and garbage, two messages.
+    const char* junk1 = "xxSMx";
+    const char junk2[] = {'S', 'M', 'S', 'G', 0, 1, 0, 0, 0, 3, 'S', 'q'};
+
+    memcpy(&stream[n], junk1, strlen(junk1));
+    n += strlen(junk1);
+    n += make_msg(1, "first", &stream[n], sizeof(stream) - n);
+    memcpy(&stream[n], junk2, sizeof(junk2));
+    n += sizeof(junk2);
+    n += make_msg(2, "second", &stream[n], sizeof(stream) - n);
+    n += make_msg(3, "", &stream[n], sizeof(stream) - n);
+
+    ret = see_msg_decoder_new(&decoder, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // Feed the stream in chunks that don't line up with the messages.
+    for (size_t i = 0; i < n; i += 3) {
+        size_t chunk = n - i < 3 ? n - i : 3;
+        ret = see_msg_decoder_feed(decoder, &stream[i], chunk, &error);
+        SEE_UNIT_HANDLE_ERROR();
+
+        do {
+            ret = see_msg_decoder_next(decoder, &msg, &found, &error);
+            SEE_UNIT_HANDLE_ERROR();
+            if (found) {
+                CU_ASSERT_FATAL(nmsgs < 3);
+                see_msg_buffer_get_id(msg, &ids[nmsgs]);
+                ret = see_msg_buffer_get_int32_at(msg, 0, &value, &error);
+                SEE_UNIT_HANDLE_ERROR();
+                CU_ASSERT_EQUAL(value, ids[nmsgs]);
+                nmsgs++;
+            }
+        } while (found);
+    }
+
+    CU_ASSERT_EQUAL(nmsgs, 3);
+    CU_ASSERT_EQUAL(ids[0], 1);
+    CU_ASSERT_EQUAL(ids[1], 2);
+    CU_ASSERT_EQUAL(ids[2], 3);
+
+    see_msg_decoder_discarded(decoder, &discarded);
+    CU_ASSERT_EQUAL(discarded, strlen(junk1) + sizeof(junk2));
+    see_msg_decoder_buffered(decoder, &buffered);
+    CU_ASSERT_EQUAL(buffered, 0);
+
+fail:
+    see_object_decref(SEE_OBJECT(decoder));
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_decoder_views(void)
+{
+    SeeMsgDecoder*  decoder = NULL;
+    SeeError*       error   = NULL;
+    SeeMsgView      view;
+    char            stream[256];
+    size_t          n = 0, length;
+    const char*     str;
+    uint16_t        id;
+    int             found, ret;
+
+    n += make_msg(10, "a view", &stream[n], sizeof(stream) - n);
+    n += make_msg(11, "another view", &stream[n], sizeof(stream) - n);
+
+    // Messages longer than max_length are skipped.
+    ret = see_msg_decoder_new(&decoder, 30, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // Everything at once, the final byte is missing.
+    ret = see_msg_decoder_feed(decoder, stream, n - 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_decoder_next_view(decoder, &view, &found, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE_FATAL(found);
+    see_msg_view_id(&view, &id);
+    CU_ASSERT_EQUAL(id, 10);
+    ret = see_msg_view_get_string(&view, 1, &str, &length, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(length, strlen("a view"));
+    CU_ASSERT_EQUAL(strncmp(str, "a view", length), 0);
+
+    // The second message is 32 bytes long.
+    ret = see_msg_decoder_feed(decoder, &stream[n - 1], 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_decoder_next_view(decoder, &view, &found, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_FALSE(found);
+
+fail:
+    see_object_decref(SEE_OBJECT(decoder));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+int add_msg_decoder_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(msg_decoder_chunks);
+    SEE_UNIT_TEST_CREATE(msg_decoder_views);
+
+    return 0;
+}
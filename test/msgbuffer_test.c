@@ -19,6 +19,9 @@
 #include <stdio.h>
 #include <CUnit/CUnit.h>
 #include "../src/MsgBuffer.h"
+#include "../src/MsgView.h"
+#include "../src/utilities.h"
+#include "../src/Crc32c.h"
 #if defined(HAVE_WINDOWS_H)
 // Otherwise math.h doesn't include M_PI etc.
 #define _USE_MATH_DEFINES
@@ -524,6 +527,878 @@ fail:
     see_object_decref(SEE_OBJECT(error));
 }
 
+static void
+msg_buffer_write_into(void)
+{
+    SeeMsgBuffer*   msg     = NULL;
+    SeeMsgBuffer*   parsed  = NULL;
+    SeeMsgPart*     part    = NULL;
+    SeeError*       error   = NULL;
+    void*           heap_buf= NULL;
+    size_t          heap_len= 0, length = 0, written = 0;
+    char            small[8];
+    char            bytes[256];
+    int             ret, equal;
+    const char*     str = "write me in place";
+
+    ret = see_msg_buffer_new(&msg, 41, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_new(&part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_part_write_int32(part, -41, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_string(part, str, strlen(str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_buffer_length(msg, &length);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(length, 4 + 2 + 4 + (1 + 4) + (1 + 4 + strlen(str)));
+
+    // A buffer that is too small is rejected, but we learn the size needed.
+    ret = see_msg_buffer_write_into(msg, small, sizeof(small), &written, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_RUNTIME);
+    CU_ASSERT_EQUAL(written, length);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_msg_buffer_write_into(msg, bytes, sizeof(bytes), &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(written, length);
+
+    // The result should be identical to get_buffer.
+    ret = see_msg_buffer_get_buffer(msg, &heap_buf, &heap_len, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(heap_len, written);
+    CU_ASSERT_EQUAL(memcmp(heap_buf, bytes, written), 0);
+
+    ret = see_msg_buffer_from_buffer(&parsed, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(parsed), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+fail:
+    free(heap_buf);
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(parsed));
+    see_object_decref(SEE_OBJECT(part));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_view_parts(void)
+{
+    SeeMsgBuffer*   msg     = NULL;
+    SeeMsgPart*     part    = NULL;
+    SeeError*       error   = NULL;
+    SeeMsgView      view;
+    char            bytes[256];
+    size_t          written, num_parts, strlength;
+    const char*     str = "not copied";
+    const char*     strout = NULL;
+    uint16_t        id;
+    uint8_t         type;
+    int32_t         i32;
+    uint64_t        u64;
+    double          dbl;
+    int             ret;
+
+    ret = see_msg_buffer_new(&msg, 42, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_new(&part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_part_write_int32(part, -42, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_string(part, str, strlen(str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_uint64(part, UINT64_C(1) << 42, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_double(part, M_PI, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_buffer_write_into(msg, bytes, sizeof(bytes), &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_view_init(&view, bytes, sizeof(bytes), &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    see_msg_view_id(&view, &id);
+    CU_ASSERT_EQUAL(id, 42);
+    see_msg_view_num_parts(&view, &num_parts);
+    CU_ASSERT_EQUAL(num_parts, 4);
+
+    // Visit the parts out of order to exercise the cursor.
+    ret = see_msg_view_get_double(&view, 3, &dbl, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(dbl, M_PI);
+
+    ret = see_msg_view_get_int32(&view, 0, &i32, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(i32, -42);
+
+    ret = see_msg_view_get_string(&view, 1, &strout, &strlength, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(strlength, strlen(str));
+    CU_ASSERT_EQUAL(strncmp(strout, str, strlength), 0);
+    // header (10) + int32 part (5) + type and length of the string (5)
+    CU_ASSERT_PTR_EQUAL(strout, &bytes[20]);
+
+    ret = see_msg_view_part_type(&view, 2, &type, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(type, SEE_MSG_PART_UINT64_T);
+    ret = see_msg_view_get_uint64(&view, 2, &u64, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(u64, UINT64_C(1) << 42);
+
+    // Wrong type and out of range
+    ret = see_msg_view_get_int32(&view, 2, &i32, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_PART_TYPE);
+    CU_ASSERT_STRING_EQUAL(
+        see_error_msg(error),
+        "SeeMsgPartTypeError: "
+        "MessagePart is a uint64_t, but it is used as an int32_t"
+        );
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_msg_view_get_int32(&view, 4, &i32, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    // A truncated message is rejected.
+    ret = see_msg_view_init(&view, bytes, written - 1, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_INVALID);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    // So is a part with an unknown type.
+    bytes[10] = SEE_MSG_PART_TRAILER + 1;
+    ret = see_msg_view_init(&view, bytes, written, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_INVALID);
+
+fail:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(part));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_buffer_many_parts(void)
+{
+    SeeMsgBuffer*   msg     = NULL;
+    SeeMsgBuffer*   parsed  = NULL;
+    SeeMsgPart*     part    = NULL;
+    SeeError*       error   = NULL;
+    void*           bytes   = NULL;
+    size_t          nbytes, num_parts;
+    char            str[64];
+    char*           strout  = NULL;
+    int32_t         i32;
+    int             ret, equal;
+    const int       n = 50;
+
+    ret = see_msg_buffer_new(&msg, 43, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_new(&part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // Alternate ints and strings, so the strings outgrow their first arena.
+    for (int i = 0; i < n; i++) {
+        if (i % 2) {
+            snprintf(str, sizeof(str), "string part number %d", i);
+            ret = see_msg_part_write_string(part, str, strlen(str), &error);
+        }
+        else {
+            ret = see_msg_part_write_int32(part, i, &error);
+        }
+        SEE_UNIT_HANDLE_ERROR();
+        ret = see_msg_buffer_add_part(msg, part, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_msg_buffer_get_buffer(msg, &bytes, &nbytes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_from_buffer(&parsed, bytes, nbytes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_buffer_num_parts(parsed, &num_parts);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(num_parts, (size_t) n);
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(parsed), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    for (int i = 0; i < n; i++) {
+        ret = see_msg_buffer_get_part(parsed, i, &part, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        if (i % 2) {
+            snprintf(str, sizeof(str), "string part number %d", i);
+            ret = see_msg_part_get_string(part, &strout, &error);
+            SEE_UNIT_HANDLE_ERROR();
+            CU_ASSERT_STRING_EQUAL(strout, str);
+            free(strout);
+            strout = NULL;
+        }
+        else {
+            ret = see_msg_part_get_int32(part, &i32, &error);
+            SEE_UNIT_HANDLE_ERROR();
+            CU_ASSERT_EQUAL(i32, i);
+        }
+    }
+
+    ret = see_msg_buffer_get_part(parsed, n, &part, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+
+fail:
+    free(bytes);
+    free(strout);
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(parsed));
+    see_object_decref(SEE_OBJECT(part));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_buffer_add_values(void)
+{
+    SeeMsgBuffer*   direct  = NULL;
+    SeeMsgBuffer*   by_part = NULL;
+    SeeMsgPart*     part    = NULL;
+    SeeError*       error   = NULL;
+    const char*     str     = "appended";
+    size_t          len_direct, len_by_part;
+    int             ret, equal;
+
+    ret = see_msg_buffer_new(&direct, 44, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_new(&by_part, 44, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_new(&part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_buffer_add_int32(direct, -1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_uint32(direct, 2, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int64(direct, -3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_uint64(direct, 4, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_float(direct, 5.5f, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_double(direct, M_PI, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(direct, str, strlen(str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_part_write_int32(part, -1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_uint32(part, 2, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_int64(part, -3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_uint64(part, 4, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_float(part, 5.5f, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_double(part, M_PI, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_string(part, str, strlen(str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(by_part, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    see_msg_buffer_length(direct, &len_direct);
+    see_msg_buffer_length(by_part, &len_by_part);
+    CU_ASSERT_EQUAL(len_direct, len_by_part);
+
+    ret = see_object_equal(
+        SEE_OBJECT(direct), SEE_OBJECT(by_part), &equal, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+fail:
+    see_object_decref(SEE_OBJECT(direct));
+    see_object_decref(SEE_OBJECT(by_part));
+    see_object_decref(SEE_OBJECT(part));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_buffer_borrowed_parts(void)
+{
+    SeeMsgBuffer*       msg     = NULL;
+    SeeMsgBuffer*       empty   = NULL;
+    SeeError*           error   = NULL;
+    const SeeMsgPart*   part    = NULL;
+    const SeeMsgPart*   again   = NULL;
+    const char*         str     = "borrowed";
+    const char*         strout  = NULL;
+    size_t              strlength;
+    int32_t             i32;
+    uint64_t            u64;
+    float               flt;
+    int                 ret;
+
+    ret = see_msg_buffer_new(&msg, 45, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int32(msg, -45, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(msg, str, strlen(str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_uint64(msg, 45, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_float(msg, 4.5f, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_msg_buffer_get_int32_at(msg, 0, &i32, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(i32, -45);
+    ret = see_msg_buffer_get_string_at(msg, 1, &strout, &strlength, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(strlength, strlen(str));
+    CU_ASSERT_EQUAL(strncmp(strout, str, strlength), 0);
+    ret = see_msg_buffer_get_uint64_at(msg, 2, &u64, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(u64, 45);
+    ret = see_msg_buffer_get_float_at(msg, 3, &flt, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(flt, 4.5f);
+
+    ret = see_msg_buffer_get_int32_at(msg, 2, &i32, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_PART_TYPE);
+    CU_ASSERT_STRING_EQUAL(
+        see_error_msg(error),
+        "SeeMsgPartTypeError: "
+        "MessagePart is a uint64_t, but it is used as an int32_t"
+        );
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_msg_buffer_get_int32_at(msg, 4, &i32, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    // A peeked part belongs to the message, peeking twice gives the same one.
+    ret = see_msg_buffer_peek_part(msg, 2, &part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_peek_part(msg, 2, &again, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(part, again);
+    ret = see_msg_part_get_uint64(part, &u64, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(u64, 45);
+
+    ret = see_msg_buffer_peek_part(msg, 4, &part, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    // An empty string is a valid pointer, even when it is the only one.
+    ret = see_msg_buffer_new(&empty, 46, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(empty, "", 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_get_string_at(empty, 0, &strout, &strlength, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_NOT_NULL(strout);
+    CU_ASSERT_EQUAL(strlength, 0);
+
+fail:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(empty));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_buffer_arrays(void)
+{
+    SeeMsgBuffer*       msg     = NULL;
+    SeeMsgBuffer*       parsed  = NULL;
+    SeeMsgBuffer*       copy    = NULL;
+    SeeMsgPart*         part    = NULL;
+    SeeMsgPart*         read    = NULL;
+    SeeError*           error   = NULL;
+    SeeMsgView          view;
+    const int32_t*      i32s;
+    const double*       dbls;
+    const float*        flts;
+    const int64_t*      i64s;
+    int32_t             samples[1000];
+    int64_t             stamps[3] = {INT64_MIN, 0, INT64_MAX};
+    double              volts[5] = {-1.5, 0.0, 1.5, 3.25, 1e300};
+    double              view_volts[5];
+    char                bytes[8192];
+    size_t              n, length, written, part_size;
+    uint8_t             type;
+    int                 ret, equal;
+
+    for (size_t i = 0; i < 1000; i++)
+        samples[i] = (int32_t) (i * 2654435761u);
+
+    ret = see_msg_buffer_new(&msg, 48, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(msg, "odd", 3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int32_array(msg, samples, 1000, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_float_array(msg, NULL, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_double_array(msg, volts, 5, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int64_array(msg, stamps, 3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // One header per array instead of one per element.
+    see_msg_buffer_length(msg, &length);
+    CU_ASSERT_EQUAL(
+        length, 10 + (5 + 3) + (5 + 4000) + 5 + (5 + 5 * 8) + (5 + 3 * 8)
+        );
+
+    // The elements are aligned even though the string has an odd length.
+    ret = see_msg_buffer_get_int32_array_at(msg, 1, &i32s, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 1000);
+    CU_ASSERT_EQUAL((uintptr_t) i32s % sizeof(int32_t), 0);
+    CU_ASSERT_EQUAL(memcmp(i32s, samples, sizeof(samples)), 0);
+
+    ret = see_msg_buffer_get_double_array_at(msg, 1, &dbls, &n, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_PART_TYPE);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_msg_buffer_write_into(msg, bytes, sizeof(bytes), &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // The elements are send in network byte order.
+    int32_t first;
+    memcpy(&first, &bytes[10 + 8 + 5], sizeof(first));
+    CU_ASSERT_EQUAL((int32_t) see_network_to_host32(first), samples[0]);
+
+    ret = see_msg_buffer_from_buffer(&parsed, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(parsed), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    ret = see_msg_buffer_get_float_array_at(parsed, 2, &flts, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 0);
+    ret = see_msg_buffer_get_double_array_at(parsed, 3, &dbls, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 5);
+    CU_ASSERT_EQUAL(memcmp(dbls, volts, sizeof(volts)), 0);
+    ret = see_msg_buffer_get_int64_array_at(parsed, 4, &i64s, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 3);
+    CU_ASSERT_EQUAL(memcmp(i64s, stamps, sizeof(stamps)), 0);
+
+    ret = see_object_copy(SEE_OBJECT(parsed), SEE_OBJECT_REF(&copy), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(copy), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    // Arrays as SeeMsgParts
+    ret = see_msg_buffer_get_part(msg, 3, &part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    see_msg_part_value_type(part, &type);
+    CU_ASSERT_EQUAL(type, SEE_MSG_PART_DOUBLE_ARRAY_T);
+    ret = see_msg_part_get_double_array(part, &dbls, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 5);
+    CU_ASSERT_EQUAL(memcmp(dbls, volts, sizeof(volts)), 0);
+
+    ret = see_msg_part_write_int64_array(part, stamps, 3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write(part, bytes, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_read(&read, bytes, 5 + 3 * 8, &part_size, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(part_size, 5 + 3 * 8);
+    ret = see_object_equal(SEE_OBJECT(part), SEE_OBJECT(read), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    // A view converts while it copies.
+    ret = see_msg_buffer_write_into(msg, bytes, sizeof(bytes), &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_view_init(&view, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_view_get_double_array(&view, 3, view_volts, 2, &n, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_RUNTIME);
+    CU_ASSERT_EQUAL(n, 5);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+    ret = see_msg_view_get_double_array(&view, 3, view_volts, 5, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(memcmp(view_volts, volts, sizeof(volts)), 0);
+
+    // An array whose length isn't a multiple of the element size is invalid.
+    uint32_t bad_length = see_host_to_network32(5 + 4001);
+    memcpy(&bytes[10 + 8 + 1], &bad_length, sizeof(bad_length));
+    ret = see_msg_view_init(&view, bytes, written, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_INVALID);
+
+fail:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(parsed));
+    see_object_decref(SEE_OBJECT(copy));
+    see_object_decref(SEE_OBJECT(part));
+    see_object_decref(SEE_OBJECT(read));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+count_release(void* bytes, void* context)
+{
+    (void) bytes;
+    (*(int*) context)++;
+}
+
+static void
+msg_buffer_bytes(void)
+{
+    SeeMsgBuffer*       msg     = NULL;
+    SeeMsgBuffer*       parsed  = NULL;
+    SeeMsgBuffer*       copy    = NULL;
+    SeeMsgBuffer*       owned   = NULL;
+    SeeMsgPart*         part    = NULL;
+    SeeError*           error   = NULL;
+    SeeMsgView          view;
+    const void*         data;
+    const char          small[] = {'a', 0, 'b'};
+    char                image[4096];
+    char                bytes[8192];
+    size_t              n, length, written;
+    uint8_t             type;
+    int                 ret, equal, released = 0;
+
+    for (size_t i = 0; i < sizeof(image); i++)
+        image[i] = (char) (i % 7);
+
+    ret = see_msg_buffer_new(&msg, 49, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_bytes(msg, small, sizeof(small), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_bytes_ref(
+        msg, image, sizeof(image), count_release, &released, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    see_msg_buffer_length(msg, &length);
+    CU_ASSERT_EQUAL(length, 10 + (5 + sizeof(small)) + (5 + sizeof(image)));
+
+    // The image isn't copied into the message.
+    ret = see_msg_buffer_get_bytes_at(msg, 1, &data, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(data, image);
+    CU_ASSERT_EQUAL(n, sizeof(image));
+
+    ret = see_msg_buffer_get_string_at(msg, 0, (const char**) &data, &n, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_PART_TYPE);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+#if defined(HAVE_SYS_UIO_H)
+    struct iovec    iov[4];
+    char            scratch[64];
+    size_t          scratch_used;
+    int             n_iov;
+
+    ret = see_msg_buffer_to_iovec(
+        msg, iov, 4, scratch, sizeof(scratch), &n_iov, &scratch_used, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n_iov, 2);
+    CU_ASSERT_PTR_EQUAL(iov[1].iov_base, image);
+    CU_ASSERT_EQUAL(iov[1].iov_len, sizeof(image));
+#endif
+
+    // The copy shares the image, it is released when both are gone.
+    ret = see_object_copy(SEE_OBJECT(msg), SEE_OBJECT_REF(&copy), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(copy), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    ret = see_msg_buffer_write_into(msg, bytes, sizeof(bytes), &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(written, length);
+
+    see_object_decref(SEE_OBJECT(msg));
+    msg = NULL;
+    CU_ASSERT_EQUAL(released, 0);
+    see_object_decref(SEE_OBJECT(copy));
+    copy = NULL;
+    CU_ASSERT_EQUAL(released, 1);
+
+    // A received message owns its bytes.
+    ret = see_msg_buffer_from_buffer(&parsed, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_get_bytes_at(parsed, 0, &data, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, sizeof(small));
+    CU_ASSERT_EQUAL(memcmp(data, small, sizeof(small)), 0);
+
+    ret = see_msg_view_init(&view, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_view_get_bytes(&view, 1, &data, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(data, &bytes[10 + 5 + sizeof(small) + 5]);
+    CU_ASSERT_EQUAL(n, sizeof(image));
+    CU_ASSERT_EQUAL(memcmp(data, image, sizeof(image)), 0);
+
+    // Bytes that live inside another object keep that object alive.
+    ret = see_msg_buffer_get_bytes_at(parsed, 1, &data, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_new(&owned, 50, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_bytes_object(
+        owned, data, n, SEE_OBJECT(parsed), &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    see_object_decref(SEE_OBJECT(parsed));
+    parsed = NULL;
+
+    ret = see_msg_buffer_get_bytes_at(owned, 0, &data, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, sizeof(image));
+    CU_ASSERT_EQUAL(memcmp(data, image, sizeof(image)), 0);
+
+    // Bytes as SeeMsgPart
+    ret = see_msg_buffer_get_part(owned, 0, &part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    see_msg_part_value_type(part, &type);
+    CU_ASSERT_EQUAL(type, SEE_MSG_PART_BYTES_T);
+    ret = see_msg_part_write_bytes(part, small, sizeof(small), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_get_bytes(part, &data, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, sizeof(small));
+    CU_ASSERT_EQUAL(memcmp(data, small, sizeof(small)), 0);
+
+fail:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(parsed));
+    see_object_decref(SEE_OBJECT(copy));
+    see_object_decref(SEE_OBJECT(owned));
+    see_object_decref(SEE_OBJECT(part));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+static void
+msg_buffer_crc(void)
+{
+    SeeMsgBuffer*       msg     = NULL;
+    SeeMsgBuffer*       parsed  = NULL;
+    SeeMsgBuffer*       copy    = NULL;
+    SeeError*           error   = NULL;
+    SeeMsgView          view;
+    char                image[5000];
+    char                bytes[8192];
+    void*               buffer  = NULL;
+    size_t              length, written, bufsize, n;
+    uint32_t            crc;
+    int                 ret, equal, enabled;
+
+    for (size_t i = 0; i < sizeof(image); i++)
+        image[i] = (char) (i * 13);
+
+    ret = see_msg_buffer_new(&msg, 50, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int32(msg, 50, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(msg, "crc32c", 6, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_bytes_ref(
+        msg, image, sizeof(image), NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    // The trailer isn't a part, but it adds 5 bytes.
+    ret = see_msg_buffer_set_crc(msg, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    see_msg_buffer_length(msg, &length);
+    CU_ASSERT_EQUAL(length, 10 + 5 + (5 + 6) + (5 + sizeof(image)) + 5);
+    see_msg_buffer_num_parts(msg, &n);
+    CU_ASSERT_EQUAL(n, 3);
+
+    ret = see_msg_buffer_write_into(msg, bytes, sizeof(bytes), &written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(written, length);
+    CU_ASSERT_EQUAL(bytes[written - 5], SEE_MSG_PART_TRAILER);
+    memcpy(&crc, &bytes[written - 4], sizeof(crc));
+    CU_ASSERT_EQUAL(see_network_to_host32(crc), see_crc32c(0, bytes, written - 5));
+
+    ret = see_msg_buffer_get_buffer(msg, &buffer, &bufsize, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(bufsize, written);
+    CU_ASSERT_EQUAL(memcmp(buffer, bytes, written), 0);
+
+#if defined(HAVE_SYS_UIO_H)
+    struct iovec    iov[4];
+    char            scratch[64];
+    char            gathered[8192];
+    size_t          scratch_used, total = 0;
+    int             n_iov;
+
+    ret = see_msg_buffer_to_iovec(
+        msg, iov, 4, scratch, sizeof(scratch), &n_iov, &scratch_used, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    for (int i = 0; i < n_iov; i++) {
+        memcpy(&gathered[total], iov[i].iov_base, iov[i].iov_len);
+        total += iov[i].iov_len;
+    }
+    CU_ASSERT_EQUAL(total, written);
+    CU_ASSERT_EQUAL(memcmp(gathered, bytes, written), 0);
+#endif
+
+    ret = see_msg_buffer_from_buffer(&parsed, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    see_msg_buffer_get_crc(parsed, &enabled);
+    CU_ASSERT_TRUE(enabled);
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(parsed), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    ret = see_object_copy(SEE_OBJECT(parsed), SEE_OBJECT_REF(&copy), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_object_equal(SEE_OBJECT(msg), SEE_OBJECT(copy), &equal, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(equal);
+
+    ret = see_msg_view_init(&view, bytes, written, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    see_msg_view_num_parts(&view, &n);
+    CU_ASSERT_EQUAL(n, 3);
+
+    // A flipped bit in the payload is detected.
+    bytes[1000] ^= 0x10;
+    see_object_decref(SEE_OBJECT(parsed));
+    parsed = NULL;
+    ret = see_msg_buffer_from_buffer(&parsed, bytes, written, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_INVALID);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+    ret = see_msg_view_init(&view, bytes, written, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_MSG_INVALID);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_msg_buffer_set_crc(msg, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    see_msg_buffer_length(msg, &n);
+    CU_ASSERT_EQUAL(n, length - 5);
+
+fail:
+    free(buffer);
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(parsed));
+    see_object_decref(SEE_OBJECT(copy));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+#if defined(HAVE_SYS_UIO_H)
+
+static void
+msg_buffer_to_iovec(void)
+{
+    SeeMsgBuffer*   msg     = NULL;
+    SeeError*       error   = NULL;
+    struct iovec    iov[8];
+    char            scratch[64];
+    char            expected[512];
+    char            gathered[512];
+    char            long_str[200];
+    const char*     str;
+    size_t          length, written, scratch_used, total = 0;
+    int             n_iov, ret;
+
+    memset(long_str, 'x', sizeof(long_str));
+
+    ret = see_msg_buffer_new(&msg, 47, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_int32(msg, 47, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(msg, long_str, sizeof(long_str), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_string(msg, "short", 5, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_double(msg, 4.7, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // Too few iovecs, we learn what is required.
+    ret = see_msg_buffer_to_iovec(
+        msg, iov, 1, scratch, sizeof(scratch), &n_iov, &scratch_used, &error
+        );
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_RUNTIME);
+    CU_ASSERT_EQUAL(n_iov, 3);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_msg_buffer_to_iovec(
+        msg, iov, 8, scratch, sizeof(scratch), &n_iov, &scratch_used, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n_iov, 3);
+
+    // The long string isn't copied, the short one is.
+    ret = see_msg_buffer_get_string_at(msg, 1, &str, &length, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(iov[1].iov_base, str);
+    CU_ASSERT_EQUAL(iov[1].iov_len, sizeof(long_str));
+    CU_ASSERT_EQUAL(iov[0].iov_len + iov[2].iov_len, scratch_used);
+
+    for (int i = 0; i < n_iov; i++) {
+        memcpy(&gathered[total], iov[i].iov_base, iov[i].iov_len);
+        total += iov[i].iov_len;
+    }
+
+    ret = see_msg_buffer_write_into(
+        msg, expected, sizeof(expected), &written, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(total, written);
+    CU_ASSERT_EQUAL(memcmp(gathered, expected, written), 0);
+
+fail:
+    see_object_decref(SEE_OBJECT(msg));
+    see_object_decref(SEE_OBJECT(error));
+}
+
+#endif //if defined(HAVE_SYS_UIO_H)
+
 int add_msg_buffer_suite()
 {
     SEE_UNIT_SUITE_CREATE(NULL, NULL);
@@ -538,6 +1413,17 @@ int add_msg_buffer_suite()
 
     SEE_UNIT_TEST_CREATE(msg_buffer_buffer);
     SEE_UNIT_TEST_CREATE(msg_buffer_copy);
+    SEE_UNIT_TEST_CREATE(msg_buffer_many_parts);
+    SEE_UNIT_TEST_CREATE(msg_buffer_add_values);
+    SEE_UNIT_TEST_CREATE(msg_buffer_borrowed_parts);
+    SEE_UNIT_TEST_CREATE(msg_buffer_arrays);
+    SEE_UNIT_TEST_CREATE(msg_buffer_bytes);
+    SEE_UNIT_TEST_CREATE(msg_buffer_crc);
+    SEE_UNIT_TEST_CREATE(msg_buffer_write_into);
+#if defined(HAVE_SYS_UIO_H)
+    SEE_UNIT_TEST_CREATE(msg_buffer_to_iovec);
+#endif
+    SEE_UNIT_TEST_CREATE(msg_view_parts);
 
     return 0;
 }
@@ -0,0 +1,268 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include "test_macros.h"
+#include "../src/ObjectQueue.h"
+#include "../src/ThreadPool.h"
+#include "../src/utilities.h"
+
+static const char* SUITE_NAME = "SeeObjectQueue";
+
+#define NOBJECTS    20000
+#define NPRODUCERS  2
+
+static void
+object_queue_kind(see_object_queue_kind kind)
+{
+    SeeError* error         = NULL;
+    SeeObjectQueue* queue   = NULL;
+    SeeDuration* timeout    = NULL;
+    SeeObject* obj          = NULL;
+    SeeDuration* durs[5]    = {NULL};
+
+    int ret = see_object_queue_new(&queue, kind, 3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_object_queue_capacity(queue), 4);
+
+    ret = see_duration_new_ms(&timeout, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int i = 0; i < 5; i++) {
+        ret = see_duration_new_ms(&durs[i], i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    for (int i = 0; i < 4; i++) {
+        ret = see_object_queue_try_push(queue, SEE_OBJECT_REF(&durs[i]), &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_PTR_NULL(durs[i]);
+    }
+
+    // When full the caller keeps its reference.
+    ret = see_object_queue_try_push(queue, SEE_OBJECT_REF(&durs[4]), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_NOT_NULL(durs[4]);
+
+    ret = see_object_queue_push(queue, SEE_OBJECT_REF(&durs[4]), timeout, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_TIMEOUT);
+    CU_ASSERT_PTR_NOT_NULL(durs[4]);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    // The objects come out in order with their reference untouched.
+    for (int i = 0; i < 2; i++) {
+        ret = see_object_queue_try_pop(queue, &obj, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_PTR_NOT_NULL_FATAL(obj);
+        CU_ASSERT_EQUAL(see_duration_millis(SEE_DURATION(obj)), i);
+        CU_ASSERT_EQUAL(obj->refcount, 1);
+        SEE_OBJECT_DECREF(obj);
+        obj = NULL;
+    }
+
+    ret = see_object_queue_push(queue, SEE_OBJECT_REF(&durs[4]), NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_NULL(durs[4]);
+
+    for (int i = 2; i < 5; i++) {
+        ret = see_object_queue_pop(queue, &obj, timeout, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL(see_duration_millis(SEE_DURATION(obj)), i);
+        SEE_OBJECT_DECREF(obj);
+        obj = NULL;
+    }
+
+    ret = see_object_queue_try_pop(queue, &obj, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_NULL(obj);
+
+    ret = see_object_queue_pop(queue, &obj, timeout, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_TIMEOUT);
+    CU_ASSERT_PTR_NULL(obj);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    // The queue releases the objects that are left when it's destroyed.
+    ret = see_duration_new_ms(&durs[0], 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_object_queue_try_push(queue, SEE_OBJECT_REF(&durs[0]), &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+fail:
+    for (int i = 0; i < 5; i++)
+        SEE_OBJECT_DECREF(durs[i]);
+    SEE_OBJECT_DECREF(queue);
+    SEE_OBJECT_DECREF(timeout);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+object_queue_spsc(void)
+{
+    object_queue_kind(SEE_OBJECT_QUEUE_SPSC);
+}
+
+static void
+object_queue_mpmc(void)
+{
+    object_queue_kind(SEE_OBJECT_QUEUE_MPMC);
+}
+
+typedef struct hand_off {
+    SeeObjectQueue* queue;
+    size_t          nproducers;
+    size_t          nconsumers;
+    int64_t         sums[NPRODUCERS * 2];
+    // Every consumer writes only its own entry, like in sums.
+    int             out_of_order[NPRODUCERS * 2];
+    // When not 0, both sides pause now and then, so the other side sleeps.
+    int             pause_every;
+} hand_off;
+
+/*
+ * Sleeps long enough for the other side to stop spinning and wait.
+ */
+static int
+hand_off_pause(SeeError** error)
+{
+    SeeDuration* dur = NULL;
+    int ret = see_duration_new_us(&dur, 500, error);
+    if (ret == SEE_SUCCESS)
+        ret = see_sleep(dur);
+    SEE_OBJECT_DECREF(dur);
+    return ret;
+}
+
+static int
+hand_off_task(size_t index, void* data)
+{
+    hand_off* h = data;
+    SeeError* error = NULL;
+    int ret = SEE_SUCCESS;
+    const int n = NOBJECTS / (int) h->nproducers;
+
+    if (index < h->nproducers) {
+        for (int i = 0; i < n && ret == SEE_SUCCESS; i++) {
+            SeeDuration* dur = NULL;
+            if (h->pause_every && i % h->pause_every == 0)
+                ret = hand_off_pause(&error);
+            if (ret == SEE_SUCCESS)
+                ret = see_duration_new_ms(&dur, i, &error);
+            if (ret == SEE_SUCCESS)
+                ret = see_object_queue_push(
+                    h->queue, SEE_OBJECT_REF(&dur), NULL, &error
+                    );
+        }
+    }
+    else {
+        const int m = NOBJECTS / (int) h->nconsumers;
+        int64_t previous = -1;
+        for (int i = 0; i < m && ret == SEE_SUCCESS; i++) {
+            SeeObject* obj = NULL;
+            if (h->pause_every && i % h->pause_every == h->pause_every / 2)
+                ret = hand_off_pause(&error);
+            if (ret == SEE_SUCCESS)
+                ret = see_object_queue_pop(h->queue, &obj, NULL, &error);
+            if (ret)
+                break;
+            int64_t ms = see_duration_millis(SEE_DURATION(obj));
+            if (ms <= previous)
+                h->out_of_order[index] = 1;
+            previous = ms;
+            h->sums[index] += ms;
+            SEE_OBJECT_DECREF(obj);
+        }
+    }
+
+    SEE_OBJECT_DECREF(error);
+    return ret;
+}
+
+static void
+object_queue_hand_off(
+    see_object_queue_kind   kind,
+    size_t                  nproducers,
+    size_t                  capacity,
+    int                     pause_every
+    )
+{
+    SeeError* error         = NULL;
+    SeeThreadPool* pool     = NULL;
+    hand_off h              = {0};
+
+    h.nproducers = nproducers;
+    h.nconsumers = nproducers;
+    h.pause_every = pause_every;
+
+    int ret = see_object_queue_new(&h.queue, kind, capacity, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // Every task needs its own thread, since they wait on each other.
+    ret = see_thread_pool_new(&pool, 2 * nproducers, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_thread_pool_run(
+        pool, 2 * nproducers, hand_off_task, &h, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    int64_t n = NOBJECTS / (int64_t) nproducers;
+    int64_t total = 0;
+    for (size_t i = 0; i < 2 * nproducers; i++)
+        total += h.sums[i];
+    CU_ASSERT_EQUAL(total, (int64_t) nproducers * n * (n - 1) / 2);
+
+    // With one producer and one consumer, the order is kept.
+    if (nproducers == 1)
+        CU_ASSERT_FALSE(h.out_of_order[1]);
+
+fail:
+    SEE_OBJECT_DECREF(h.queue);
+    SEE_OBJECT_DECREF(pool);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+object_queue_threads(void)
+{
+    object_queue_hand_off(SEE_OBJECT_QUEUE_SPSC, 1, 64, 0);
+    object_queue_hand_off(SEE_OBJECT_QUEUE_MPMC, 1, 64, 0);
+    object_queue_hand_off(SEE_OBJECT_QUEUE_MPMC, NPRODUCERS, 64, 0);
+}
+
+static void
+object_queue_blocking(void)
+{
+    // The smallest queue is nearly always full or empty, so the producer
+    // and the consumer both wake each other up from the sleeping state.
+    object_queue_hand_off(SEE_OBJECT_QUEUE_SPSC, 1, 1, 0);
+    object_queue_hand_off(SEE_OBJECT_QUEUE_SPSC, 1, 1, 500);
+    object_queue_hand_off(SEE_OBJECT_QUEUE_MPMC, 1, 1, 500);
+    object_queue_hand_off(SEE_OBJECT_QUEUE_MPMC, NPRODUCERS, 1, 500);
+}
+
+int add_object_queue_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(object_queue_spsc);
+    SEE_UNIT_TEST_CREATE(object_queue_mpmc);
+    SEE_UNIT_TEST_CREATE(object_queue_threads);
+    SEE_UNIT_TEST_CREATE(object_queue_blocking);
+
+    return 0;
+}
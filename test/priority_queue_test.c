@@ -0,0 +1,289 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include "test_macros.h"
+#include "../src/PriorityQueue.h"
+
+static const char* SUITE_NAME = "SeePriorityQueue";
+
+#define NELEM 1000
+
+static int
+compare_int32(const void* a, const void* b, void* data)
+{
+    (void) data;
+    int32_t ia = *(const int32_t*) a;
+    int32_t ib = *(const int32_t*) b;
+    return (ia > ib) - (ia < ib);
+}
+
+static void
+priority_queue_arity(size_t arity)
+{
+    SeeError* error         = NULL;
+    SeePriorityQueue* queue = NULL;
+    size_t handles[NELEM];
+    uint32_t state          = 12345;
+    int32_t value, previous;
+
+    int ret = see_priority_queue_new_arity(
+        &queue, sizeof(int32_t), arity, compare_int32, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_priority_queue_pop(queue, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    for (size_t i = 0; i < NELEM; i++) {
+        state = state * 1103515245u + 12345u;
+        value = (int32_t) (state >> 8) % 100000;
+        ret = see_priority_queue_push(queue, &value, &handles[i], &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT_EQUAL(see_priority_queue_size(queue), NELEM);
+
+    // Decrease a key, so it moves to the top.
+    value = -1;
+    ret = see_priority_queue_update(queue, handles[500], &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_priority_queue_top(queue, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(value, -1);
+
+    // Increase it again, and remove another element.
+    value = 100001;
+    ret = see_priority_queue_update(queue, handles[500], &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_priority_queue_remove(queue, handles[10], NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_FALSE(see_priority_queue_contains(queue, handles[10]));
+
+    ret = see_priority_queue_get(queue, handles[10], &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    previous = INT32_MIN;
+    for (size_t i = 0; i < NELEM - 1; i++) {
+        ret = see_priority_queue_pop(queue, &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_FATAL(value >= previous);
+        previous = value;
+    }
+    CU_ASSERT_EQUAL(value, 100001);
+    CU_ASSERT_EQUAL(see_priority_queue_size(queue), 0);
+
+fail:
+    SEE_OBJECT_DECREF(queue);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+priority_queue_elements(void)
+{
+    priority_queue_arity(2);
+    priority_queue_arity(SEE_PRIORITY_QUEUE_DEFAULT_ARITY);
+    priority_queue_arity(7);
+}
+
+static void
+priority_queue_heapify(void)
+{
+    SeeError* error         = NULL;
+    SeePriorityQueue* queue = NULL;
+    SeeDynamicArray* array  = NULL;
+    size_t handles[NELEM];
+    int32_t value;
+
+    int ret = see_priority_queue_new(
+        &queue, sizeof(int32_t), compare_int32, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_new(
+        &array, sizeof(int32_t), NULL, NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int32_t i = NELEM; i > 0; i--) {
+        ret = see_dynamic_array_add(array, &i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    // Once rebuilt, and once pushed one by one.
+    ret = see_priority_queue_push_array(queue, array, handles, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_priority_queue_push_array(queue, array, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_priority_queue_size(queue), 2 * NELEM);
+
+    for (size_t i = 0; i < NELEM; i++) {
+        ret = see_priority_queue_get(queue, handles[i], &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL_FATAL(value, NELEM - (int32_t) i);
+    }
+
+    for (int32_t i = 0; i < 2 * NELEM; i++) {
+        ret = see_priority_queue_pop(queue, &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL_FATAL(value, i / 2 + 1);
+    }
+
+fail:
+    SEE_OBJECT_DECREF(queue);
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+priority_queue_objects(void)
+{
+    SeeError* error         = NULL;
+    SeePriorityQueue* queue = NULL;
+    SeeDuration* durs[4]    = {NULL};
+    SeeObject* obj          = NULL;
+    const int64_t ms[4]     = {30, 10, 40, 20};
+
+    int ret = see_priority_queue_new_objects(&queue, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int i = 0; i < 4; i++) {
+        ret = see_duration_new_ms(&durs[i], ms[i], &error);
+        SEE_UNIT_HANDLE_ERROR();
+        ret = see_priority_queue_push(queue, &durs[i], NULL, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL(SEE_OBJECT(durs[i])->refcount, 2);
+    }
+
+    ret = see_priority_queue_top(queue, &obj, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(obj, durs[1]);
+    obj = NULL;
+
+    // The reference of the queue goes to the caller.
+    ret = see_priority_queue_pop(queue, &obj, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(obj, durs[1]);
+    CU_ASSERT_EQUAL(obj->refcount, 2);
+    SEE_OBJECT_DECREF(obj);
+    obj = NULL;
+
+    ret = see_priority_queue_pop(queue, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(SEE_OBJECT(durs[3])->refcount, 1);
+
+    // Objects of other classes cannot be compared.
+    ret = see_object_new(&obj);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_priority_queue_push(queue, &obj, NULL, &error);
+    CU_ASSERT_NOT_EQUAL(ret, SEE_SUCCESS);
+    CU_ASSERT_PTR_NOT_NULL(error);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+    CU_ASSERT_EQUAL(see_priority_queue_size(queue), 3);
+
+fail:
+    // The remaining objects are released by the queue.
+    SEE_OBJECT_DECREF(queue);
+    for (int i = 0; i < 4; i++) {
+        if (durs[i])
+            CU_ASSERT_EQUAL(SEE_OBJECT(durs[i])->refcount, 1);
+        SEE_OBJECT_DECREF(durs[i]);
+    }
+    SEE_OBJECT_DECREF(obj);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+priority_queue_timers(void)
+{
+    SeeError* error         = NULL;
+    SeePriorityQueue* queue = NULL;
+    SeeTimePoint* tp        = NULL;
+    size_t handles[3];
+    const int64_t deadlines[3] = {300, 100, 200};
+    int payload, expired;
+
+    int ret = see_priority_queue_new_timers(&queue, sizeof(int), &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_time_point_new(&tp, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int i = 0; i < 3; i++) {
+        see_time_point_set_nanos(tp, deadlines[i]);
+        ret = see_priority_queue_push_timer(queue, tp, &i, &handles[i], &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    // Plain elements cannot be pushed to a timer queue.
+    ret = see_priority_queue_push(queue, &payload, NULL, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+    ret = see_priority_queue_next_deadline(queue, tp, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_time_point_nanos(tp), 100);
+
+    // Postpone the first timer, so the one at 200 is next.
+    see_time_point_set_nanos(tp, 250);
+    ret = see_priority_queue_reschedule(queue, handles[1], tp, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    see_time_point_set_nanos(tp, 199);
+    ret = see_priority_queue_pop_expired(queue, tp, &payload, &expired, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_FALSE(expired);
+
+    see_time_point_set_nanos(tp, 260);
+    ret = see_priority_queue_pop_expired(queue, tp, &payload, &expired, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(expired);
+    CU_ASSERT_EQUAL(payload, 2);
+    ret = see_priority_queue_pop_expired(queue, tp, &payload, &expired, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_TRUE(expired);
+    CU_ASSERT_EQUAL(payload, 1);
+    ret = see_priority_queue_pop_expired(queue, tp, &payload, &expired, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_FALSE(expired);
+
+    // Cancel the last one.
+    ret = see_priority_queue_remove(queue, handles[0], &payload, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(payload, 0);
+    CU_ASSERT_EQUAL(see_priority_queue_size(queue), 0);
+
+    ret = see_priority_queue_next_deadline(queue, tp, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+
+fail:
+    SEE_OBJECT_DECREF(queue);
+    SEE_OBJECT_DECREF(tp);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_priority_queue_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(priority_queue_elements);
+    SEE_UNIT_TEST_CREATE(priority_queue_heapify);
+    SEE_UNIT_TEST_CREATE(priority_queue_objects);
+    SEE_UNIT_TEST_CREATE(priority_queue_timers);
+
+    return 0;
+}
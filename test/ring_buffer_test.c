@@ -0,0 +1,185 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "test_macros.h"
+#include "../src/RingBuffer.h"
+
+static const char* SUITE_NAME = "SeeRingBuffer";
+
+static void
+ring_buffer_fixed(void)
+{
+    SeeError* error         = NULL;
+    SeeRingBuffer* ring     = NULL;
+    SeeRingBuffer* copy     = NULL;
+    int32_t values[8]       = {0, 1, 2, 3, 4, 5, 6, 7};
+    int32_t out[8];
+    int32_t value;
+    size_t n;
+
+    int ret = see_ring_buffer_new(&ring, sizeof(int32_t), 5, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_ring_buffer_capacity(ring), 8);
+    CU_ASSERT_EQUAL(see_ring_buffer_size(ring), 0);
+
+    ret = see_ring_buffer_pop(ring, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    // Move the front, so the elements wrap around the end of the storage.
+    ret = see_ring_buffer_push_n(ring, values, 6, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_ring_buffer_pop_n(ring, out, 5, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 5);
+    CU_ASSERT_EQUAL(out[4], 4);
+
+    ret = see_ring_buffer_push_n(ring, values, 8, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 7);
+    CU_ASSERT_EQUAL(see_ring_buffer_size(ring), 8);
+
+    ret = see_ring_buffer_push(ring, &values[0], &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_RUNTIME);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    ret = see_ring_buffer_peek(ring, 0, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(value, 5);
+    ret = see_ring_buffer_peek(ring, 7, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(value, 6);
+    ret = see_ring_buffer_peek(ring, 8, &value, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    ret = see_object_copy(SEE_OBJECT(ring), SEE_OBJECT_REF(&copy), &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    const int32_t expected[8] = {5, 0, 1, 2, 3, 4, 5, 6};
+    ret = see_ring_buffer_pop_n(ring, out, 100, &n, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(n, 8);
+    CU_ASSERT_EQUAL(memcmp(out, expected, sizeof(expected)), 0);
+    CU_ASSERT_EQUAL(see_ring_buffer_size(ring), 0);
+
+    CU_ASSERT_EQUAL(see_ring_buffer_size(copy), 8);
+    ret = see_ring_buffer_pop(copy, &value, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(value, 5);
+
+fail:
+    SEE_OBJECT_DECREF(ring);
+    SEE_OBJECT_DECREF(copy);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+ring_buffer_growable(void)
+{
+    SeeError* error         = NULL;
+    SeeRingBuffer* ring     = NULL;
+    uint16_t value;
+
+    int ret = see_ring_buffer_new(&ring, sizeof(uint16_t), 2, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (uint16_t i = 0; i < 1000; i++) {
+        ret = see_ring_buffer_push(ring, &i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        // Keep the front moving while the buffer grows.
+        if (i % 3 == 0) {
+            ret = see_ring_buffer_pop(ring, NULL, &error);
+            SEE_UNIT_HANDLE_ERROR();
+        }
+    }
+    CU_ASSERT_EQUAL(see_ring_buffer_size(ring), 1000 - 334);
+    CU_ASSERT_EQUAL(see_ring_buffer_capacity(ring), 1024);
+
+    // The remaining values are those that weren't popped, in order.
+    for (uint16_t expected = 334; expected < 1000; expected++) {
+        ret = see_ring_buffer_pop(ring, &value, &error);
+        SEE_UNIT_HANDLE_ERROR();
+        CU_ASSERT_EQUAL_FATAL(value, expected);
+    }
+
+fail:
+    SEE_OBJECT_DECREF(ring);
+    SEE_OBJECT_DECREF(error);
+}
+
+static void
+ring_buffer_spans(void)
+{
+    SeeError* error         = NULL;
+    SeeRingBuffer* ring     = NULL;
+    SeeRingSpan span;
+    const char* text        = "0123456789";
+    char out[16]            = {0};
+
+    int ret = see_ring_buffer_new(&ring, 1, 8, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_ring_buffer_push_n(ring, text, 6, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_ring_buffer_consume(ring, 4, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    // The free space is the end of the storage and the start.
+    ret = see_ring_buffer_write_span(ring, 6, &span, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(span.first_size, 2);
+    CU_ASSERT_EQUAL(span.second_size, 4);
+    memcpy(span.first, "ab", 2);
+    memcpy(span.second, "cd", 2);
+    ret = see_ring_buffer_commit(ring, 4, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    see_ring_buffer_read_span(ring, &span);
+    CU_ASSERT_EQUAL(span.first_size, 4);
+    CU_ASSERT_EQUAL(span.second_size, 2);
+    memcpy(out, span.first, span.first_size);
+    memcpy(out + span.first_size, span.second, span.second_size);
+    CU_ASSERT_STRING_EQUAL(out, "45abcd");
+
+    ret = see_ring_buffer_commit(ring, 3, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    SEE_OBJECT_DECREF(error);
+    error = NULL;
+
+    ret = see_ring_buffer_consume(ring, 7, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+
+fail:
+    SEE_OBJECT_DECREF(ring);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_ring_buffer_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(ring_buffer_fixed);
+    SEE_UNIT_TEST_CREATE(ring_buffer_growable);
+    SEE_UNIT_TEST_CREATE(ring_buffer_spans);
+
+    return 0;
+}
@@ -19,9 +19,15 @@
 #include <CUnit/CUnit.h>
 #include <assert.h>
 
+#include "test_macros.h"
 #include "../src/SeeObject.h"
 #include "../src/TimePoint.h"
 #include "../src/CopyError.h"
+#include "../src/DynamicArray.h"
+#include "../src/MsgBuffer.h"
+#include "../src/RingBuffer.h"
+#include "../src/Span.h"
+#include "../src/Stack.h"
 
 static const char* SUITE_NAME = "SeeObject suite";
 
@@ -181,6 +187,113 @@ fail:
 
 }
 
+/*
+ * Sums the int32_t elements of a sequence, returns the number of spans.
+ */
+static int
+sum_spans(const void* sequence, int64_t* sum, SeeError** error)
+{
+    size_t cursor = 0;
+    SeeSpan span;
+    int nspans = 0;
+
+    *sum = 0;
+    while (1) {
+        int ret = see_object_next_span(sequence, &cursor, &span, error);
+        if (ret)
+            return -1;
+        if (span.size == 0)
+            break;
+        for (size_t i = 0; i < span.size; i++)
+            *sum += *(const int32_t*) SEE_SPAN_AT(&span, i);
+        nspans++;
+    }
+    return nspans;
+}
+
+static void next_span(void)
+{
+    SeeObject* obj          = NULL;
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    SeeStack* stack         = NULL;
+    SeeRingBuffer* ring     = NULL;
+    SeeMsgBuffer* msg       = NULL;
+    SeeMsgPart* part        = NULL;
+    int32_t values[10]      = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    int64_t sum;
+    size_t cursor = 0;
+    SeeSpan span;
+    int ret;
+
+    ret = see_dynamic_array_new(
+        &array, sizeof(int32_t), NULL, NULL, NULL, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    for (int i = 0; i < 10; i++) {
+        ret = see_dynamic_array_add(array, &values[i], &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+    CU_ASSERT_EQUAL(sum_spans(array, &sum, &error), 1);
+    CU_ASSERT_EQUAL(sum, 55);
+
+    // A contiguous container points at its own storage.
+    ret = see_object_next_span(SEE_OBJECT(array), &cursor, &span, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_PTR_EQUAL(span.data, see_dynamic_array_data(array));
+    CU_ASSERT_EQUAL(span.stride, sizeof(int32_t));
+    CU_ASSERT_EQUAL(cursor, 10);
+
+    ret = see_stack_new(&stack, sizeof(int32_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_stack_push_n(stack, values, 4, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(sum_spans(stack, &sum, &error), 1);
+    CU_ASSERT_EQUAL(sum, 10);
+
+    // Let the elements of the ring buffer wrap around.
+    ret = see_ring_buffer_new(&ring, sizeof(int32_t), 8, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_ring_buffer_push_n(ring, values, 6, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_ring_buffer_pop_n(ring, NULL, 4, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_ring_buffer_push_n(ring, &values[6], 4, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(sum_spans(ring, &sum, &error), 2);
+    CU_ASSERT_EQUAL(sum, 5 + 6 + 7 + 8 + 9 + 10);
+
+    // The parts of a message are handed out as SeeMsgPart*.
+    ret = see_msg_buffer_new(&msg, 1, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_new(&part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_part_write_int32(part, 42, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_msg_buffer_add_part(msg, part, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    cursor = 0;
+    ret = see_object_next_span(SEE_OBJECT(msg), &cursor, &span, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(span.size, 1);
+    CU_ASSERT_EQUAL(span.stride, sizeof(SeeMsgPart*));
+
+    ret = see_object_new(&obj);
+    SEE_UNIT_HANDLE_ERROR();
+    cursor = 0;
+    ret = see_object_next_span(obj, &cursor, &span, &error);
+    CU_ASSERT_EQUAL(ret, SEE_NOT_IMPLEMENTED);
+    CU_ASSERT_PTR_NOT_NULL(error);
+
+fail:
+    SEE_OBJECT_DECREF(obj);
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(stack);
+    SEE_OBJECT_DECREF(ring);
+    SEE_OBJECT_DECREF(msg);
+    SEE_OBJECT_DECREF(part);
+    SEE_OBJECT_DECREF(error);
+}
 
 int add_see_object_suite(void)
 {
@@ -234,5 +347,15 @@ int add_see_object_suite(void)
         return CU_get_error();
     }
 
+    test = CU_add_test(suite, "next_span", next_span);
+    if (!test) {
+        fprintf(stderr,
+                "Unable to create test %s:%s\n ",
+                SUITE_NAME,
+                CU_get_error_msg()
+        );
+        return CU_get_error();
+    }
+
     return CU_get_error();
 }
@@ -136,6 +136,63 @@ fail:
     see_object_decref(SEE_OBJECT(stack));
 }
 
+void
+stack_bulk(void)
+{
+    SeeError* error = NULL;
+    SeeStack* stack = NULL;
+    int ret;
+    int values[ARRAY_SIZE];
+    int out[ARRAY_SIZE];
+    int val = -1;
+
+    for (int i = 0; i < ARRAY_SIZE; i++)
+        values[i] = i;
+
+    ret = see_stack_new(&stack, sizeof(int), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_stack_pop_into(stack, &val, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_EQUAL(val, -1);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_stack_push_n(stack, values, ARRAY_SIZE, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_stack_size(stack), ARRAY_SIZE);
+    CU_ASSERT(see_stack_capacity(stack) >= ARRAY_SIZE);
+
+    ret = see_stack_pop_into(stack, &val, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(val, ARRAY_SIZE - 1);
+
+    // The popped items are in the order in which they were pushed.
+    ret = see_stack_pop_n(stack, out, 10, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = memcmp(out, &values[ARRAY_SIZE - 11], 10 * sizeof(int));
+    CU_ASSERT_EQUAL(ret, 0);
+
+    // Too many items leaves the stack as it was.
+    ret = see_stack_pop_n(stack, out, ARRAY_SIZE, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_STRING_EQUAL(see_error_msg(error), "SeeIndexError: 1023");
+    CU_ASSERT_EQUAL(see_stack_size(stack), ARRAY_SIZE - 11);
+    see_object_decref(SEE_OBJECT(error));
+    error = NULL;
+
+    ret = see_stack_pop_n(stack, NULL, ARRAY_SIZE - 12, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_stack_top(stack, &val, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(val, 0);
+    CU_ASSERT_EQUAL(see_stack_size(stack), 1);
+
+fail:
+    see_object_decref(SEE_OBJECT(error));
+    see_object_decref(SEE_OBJECT(stack));
+}
+
 int
 add_stack_suite(void)
 {
@@ -143,6 +200,7 @@ add_stack_suite(void)
     SEE_UNIT_TEST_CREATE(stack_create);
     SEE_UNIT_TEST_CREATE(stack_push_pop);
     SEE_UNIT_TEST_CREATE(stack_error);
+    SEE_UNIT_TEST_CREATE(stack_bulk);
 
     return 0;
 }
@@ -25,12 +25,23 @@ extern "C" {
 
 int add_see_object_suite();
 int add_meta_suite();
+int add_bit_array_suite();
+int add_column_table_suite();
+int add_concurrent_array_suite();
+int add_concurrent_stack_suite();
 int add_dynamic_array_suite();
+int add_array_kernels_suite();
+int add_array_sort_suite();
 int add_error_suite();
 int add_msg_buffer_suite();
+int add_msg_decoder_suite();
+int add_object_queue_suite();
+int add_priority_queue_suite();
 int add_random_suite();
+int add_ring_buffer_suite();
 int add_serial_suite();
 int add_stack_suite();
+int add_thread_pool_suite();
 int add_time_suite();
 int add_utilities_suite();
 
@@ -0,0 +1,230 @@
+/*
+ * This file is part of see-object.
+ *
+ * see-object is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * see-object is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with see-object.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include "test_macros.h"
+#include "../src/ThreadPool.h"
+#include "../src/DynamicArrayParallel.h"
+
+static const char* SUITE_NAME = "SeeThreadPool";
+
+#define NTASKS  1000
+#define NELEM   100000
+
+typedef struct visits {
+    unsigned char   visited[NTASKS];
+    int             nested[NTASKS];
+} visits;
+
+static int
+count_task(size_t index, void* data)
+{
+    int* counts = data;
+    counts[index]++;
+    return SEE_SUCCESS;
+}
+
+static int
+visit_task(size_t index, void* data)
+{
+    visits* v = data;
+    v->visited[index]++;
+
+    if (index % 100 == 0) {
+        // Running on the shared pool from within a task must not deadlock.
+        SeeError* error = NULL;
+        int counts[10] = {0};
+        int ret = see_thread_pool_run(NULL, 10, count_task, counts, &error);
+        for (size_t i = 0; i < 10 && ret == SEE_SUCCESS; i++)
+            v->nested[index] += counts[i];
+    }
+
+    if (index == 500)
+        return SEE_ERROR_INDEX;
+    if (index == 700)
+        return SEE_ERROR_RUNTIME;
+    return SEE_SUCCESS;
+}
+
+static void
+thread_pool_run(void)
+{
+    SeeError* error         = NULL;
+    SeeThreadPool* pool     = NULL;
+    static visits v;
+
+    int ret = see_thread_pool_new(&pool, 3, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_thread_pool_num_threads(pool), 3);
+    CU_ASSERT(see_thread_pool_num_threads(NULL) >= 1);
+
+    ret = see_thread_pool_run(pool, NTASKS, visit_task, &v, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+    CU_ASSERT_PTR_NULL(error);
+
+    for (size_t i = 0; i < NTASKS; i++) {
+        CU_ASSERT_EQUAL_FATAL(v.visited[i], 1);
+        CU_ASSERT_EQUAL(v.nested[i], i % 100 == 0 ? 10 : 0);
+    }
+
+    ret = see_thread_pool_run(pool, 0, visit_task, &v, &error);
+    CU_ASSERT_EQUAL(ret, SEE_SUCCESS);
+    ret = see_thread_pool_run(pool, 1, NULL, &v, &error);
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+fail:
+    SEE_OBJECT_DECREF(pool);
+    SEE_OBJECT_DECREF(error);
+}
+
+static int
+double_chunk(void* chunk, size_t n, size_t first, void* ctx)
+{
+    int64_t* values = chunk;
+    (void) ctx;
+    for (size_t i = 0; i < n; i++) {
+        if (values[i] != (int64_t) (first + i))
+            return SEE_ERROR_INDEX;
+        values[i] *= 2;
+    }
+    return SEE_SUCCESS;
+}
+
+static int
+half_chunk(const void* in, void* out, size_t n, size_t first, void* ctx)
+{
+    const int64_t* values = in;
+    double* halves = out;
+    (void) first; (void) ctx;
+    for (size_t i = 0; i < n; i++)
+        halves[i] = values[i] / 2.0;
+    return SEE_SUCCESS;
+}
+
+static void
+array_parallel_for_map(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    SeeDynamicArray* halves = NULL;
+
+    int ret = see_dynamic_array_new(&array, sizeof(int64_t), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    ret = see_dynamic_array_new(&halves, sizeof(double), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    for (int64_t i = 0; i < NELEM; i++) {
+        ret = see_dynamic_array_add(array, &i, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_parallel_for(array, double_chunk, NULL, 777, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    const int64_t* values = see_dynamic_array_data(array);
+    for (size_t i = 0; i < NELEM; i++)
+        CU_ASSERT_EQUAL_FATAL(values[i], 2 * (int64_t) i);
+
+    // The elements have been doubled, so every chunk fails now.
+    ret = see_dynamic_array_parallel_for(array, double_chunk, NULL, 0, &error);
+    CU_ASSERT_EQUAL(ret, SEE_ERROR_INDEX);
+
+    ret = see_dynamic_array_parallel_map(halves, array, half_chunk, NULL, 0, &error);
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(see_dynamic_array_size(halves), NELEM);
+    const double* h = see_dynamic_array_data(halves);
+    for (size_t i = 0; i < NELEM; i++)
+        CU_ASSERT_FATAL(h[i] == (double) i);
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(halves);
+    SEE_OBJECT_DECREF(error);
+}
+
+static int
+sum_chunk(const void* chunk, size_t n, size_t first, void* partial, void* ctx)
+{
+    const double* values = chunk;
+    double* sum = partial;
+    (void) first; (void) ctx;
+    for (size_t i = 0; i < n; i++)
+        *sum += values[i];
+    return SEE_SUCCESS;
+}
+
+static void
+sum_combine(void* result, const void* partial, void* ctx)
+{
+    (void) ctx;
+    *(double*) result += *(const double*) partial;
+}
+
+static void
+array_parallel_reduce(void)
+{
+    SeeError* error         = NULL;
+    SeeDynamicArray* array  = NULL;
+    const double zero       = 0.0;
+    double sum = -1, again = -1;
+
+    int ret = see_dynamic_array_new(&array, sizeof(double), NULL, NULL, NULL, &error);
+    SEE_UNIT_HANDLE_ERROR();
+
+    ret = see_dynamic_array_parallel_reduce(
+        array, sum_chunk, sum_combine, &zero, &sum, sizeof(sum), NULL, 0, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(sum, 0.0);
+
+    for (size_t i = 0; i < NELEM; i++) {
+        double v = (i % 1000) * 0.1;
+        ret = see_dynamic_array_add(array, &v, &error);
+        SEE_UNIT_HANDLE_ERROR();
+    }
+
+    ret = see_dynamic_array_parallel_reduce(
+        array, sum_chunk, sum_combine, &zero, &sum, sizeof(sum), NULL, 1000, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_DOUBLE_EQUAL(sum, 100 * 499500 * 0.1, 1e-3);
+
+    // With the same grain the partials are combined in the same order.
+    ret = see_dynamic_array_parallel_reduce(
+        array, sum_chunk, sum_combine, &zero, &again, sizeof(again), NULL, 1000, &error
+        );
+    SEE_UNIT_HANDLE_ERROR();
+    CU_ASSERT_EQUAL(sum, again);
+
+    ret = see_dynamic_array_parallel_reduce(
+        array, sum_chunk, sum_combine, &zero, &sum, 0, NULL, 0, &error
+        );
+    CU_ASSERT_EQUAL(ret, SEE_INVALID_ARGUMENT);
+
+fail:
+    SEE_OBJECT_DECREF(array);
+    SEE_OBJECT_DECREF(error);
+}
+
+int add_thread_pool_suite()
+{
+    SEE_UNIT_SUITE_CREATE(NULL, NULL);
+    SEE_UNIT_TEST_CREATE(thread_pool_run);
+    SEE_UNIT_TEST_CREATE(array_parallel_for_map);
+    SEE_UNIT_TEST_CREATE(array_parallel_reduce);
+
+    return 0;
+}
@@ -35,10 +35,34 @@ int add_suites()
     if (res)
         return res;
 
+    res = add_bit_array_suite();
+    if (res)
+        return res;
+
+    res = add_column_table_suite();
+    if (res)
+        return res;
+
+    res = add_concurrent_array_suite();
+    if (res)
+        return res;
+
+    res = add_concurrent_stack_suite();
+    if (res)
+        return res;
+
     res = add_dynamic_array_suite();
     if (res)
         return res;
 
+    res = add_array_kernels_suite();
+    if (res)
+        return res;
+
+    res = add_array_sort_suite();
+    if (res)
+        return res;
+
     res = add_error_suite();
     if (res)
         return res;
@@ -47,10 +71,26 @@ int add_suites()
     if (res)
         return res;
 
+    res = add_msg_decoder_suite();
+    if (res)
+        return res;
+
+    res = add_object_queue_suite();
+    if (res)
+        return res;
+
+    res = add_priority_queue_suite();
+    if (res)
+        return res;
+
     res = add_random_suite();
     if (res)
         return res;
 
+    res = add_ring_buffer_suite();
+    if (res)
+        return res;
+
     res = add_serial_suite();
     if (res)
         return res;
@@ -58,6 +98,10 @@ int add_suites()
     res = add_stack_suite();
     if (res)
         return res;
+
+    res = add_thread_pool_suite();
+    if (res)
+        return res;
     
     res = add_time_suite();
     if (res)
@@ -18,8 +18,11 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "test_macros.h"
 #include "../src/utilities.h"
+#include "../src/ByteOrderKernels.h"
+#include "../src/Crc32c.h"
 #include <see_object_config.h>
 #include <stdint.h>
 
@@ -107,6 +110,69 @@ void host_to_network64(void)
     CU_ASSERT_EQUAL(result, network);
 }
 
+void swap_arrays(void)
+{
+    // Odd sizes and an unaligned source exercise the scalar tails.
+    uint32_t src32[37], dst32[37];
+    uint64_t src64[19], dst64[19];
+    unsigned char unaligned[1 + sizeof(src32)];
+
+    for (size_t i = 0; i < 37; i++)
+        src32[i] = (uint32_t) (0x01020304u * (i + 1));
+    for (size_t i = 0; i < 19; i++)
+        src64[i] = 0x0102030405060708u * (i + 1);
+
+    CU_ASSERT_PTR_NOT_NULL(see_byte_order_kernels_isa());
+
+    memcpy(&unaligned[1], src32, sizeof(src32));
+    see_host_to_network32_array(dst32, &unaligned[1], 37);
+    for (size_t i = 0; i < 37; i++)
+        CU_ASSERT_EQUAL(dst32[i], see_host_to_network32(src32[i]));
+
+    see_network_to_host32_array(dst32, dst32, 37);
+    CU_ASSERT_EQUAL(memcmp(dst32, src32, sizeof(src32)), 0);
+
+    see_host_to_network64_array(dst64, src64, 19);
+    for (size_t i = 0; i < 19; i++)
+        CU_ASSERT_EQUAL(dst64[i], see_host_to_network64(src64[i]));
+
+    see_network_to_host64_array(dst64, dst64, 19);
+    CU_ASSERT_EQUAL(memcmp(dst64, src64, sizeof(src64)), 0);
+}
+
+void crc32c(void)
+{
+    // The test vectors of RFC 3720, appendix B.4.
+    static unsigned char bytes[64 * 1024];
+    const char* digits = "123456789";
+
+    CU_ASSERT_PTR_NOT_NULL(see_crc32c_isa());
+    CU_ASSERT_EQUAL(see_crc32c(0, digits, strlen(digits)), 0xE3069283);
+
+    memset(bytes, 0, 32);
+    CU_ASSERT_EQUAL(see_crc32c(0, bytes, 32), 0x8A9136AA);
+    memset(bytes, 0xff, 32);
+    CU_ASSERT_EQUAL(see_crc32c(0, bytes, 32), 0x62A8AB43);
+    for (int i = 0; i < 32; i++)
+        bytes[i] = (unsigned char) i;
+    CU_ASSERT_EQUAL(see_crc32c(0, bytes, 32), 0x46DD794E);
+
+    // Chunks of odd sizes at odd offsets give the same crc, the large
+    // chunks are computed in blocks by the hardware kernels.
+    for (size_t i = 0; i < sizeof(bytes); i++)
+        bytes[i] = (unsigned char) (i * 131 + 7);
+
+    uint32_t whole = see_crc32c(0, bytes, sizeof(bytes)), crc = 0;
+    size_t offset = 0, chunk = 1;
+    while (offset < sizeof(bytes)) {
+        size_t n = sizeof(bytes) - offset < chunk ? sizeof(bytes) - offset : chunk;
+        crc = see_crc32c(crc, &bytes[offset], n);
+        offset += n;
+        chunk = chunk * 3 + 1;
+    }
+    CU_ASSERT_EQUAL(crc, whole);
+}
+
 int add_utilities_suite() {
 
     SEE_UNIT_SUITE_CREATE(NULL, NULL);
@@ -117,6 +183,8 @@ int add_utilities_suite() {
     SEE_UNIT_TEST_CREATE(host_to_network32);
     SEE_UNIT_TEST_CREATE(network_to_host64);
     SEE_UNIT_TEST_CREATE(host_to_network64);
+    SEE_UNIT_TEST_CREATE(swap_arrays);
+    SEE_UNIT_TEST_CREATE(crc32c);
 
     return 0;
 }